@@ -45,3 +45,8 @@ python setup.py build_ext --inplace
 mv compile_commands.json build
 
 pip install .
+
+if [ "$BUILD_BENCH" = "true" ]; then
+  cmake -S ./mesh_cut/Cpp/bench -B ./build/bench -DCMAKE_BUILD_TYPE=Release
+  cmake --build ./build/bench -j ${PROCESSOR_NUM}
+fi
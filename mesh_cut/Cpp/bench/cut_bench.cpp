@@ -0,0 +1,372 @@
+// cut_cpp 热点函数的基准测试程序
+//
+// 用程序化网格在不同规模与线程数下测试 farthest_point_sampling、
+// compute_min_radius_cover_all、run_parallel_region_growing、
+// toSubMeshSamplePoints 与 cutMesh，结果以 JSON 输出
+//
+// 用法：
+//   cut_bench [--generators icosphere,terrain,thin_shell,high_genus]
+//             [--sizes 10000,100000,1000000] [--threads 1,2,4]
+//             [--repeat 3] [--seeds 400] [--points 8192]
+//             [--max-cut-faces 1000000] [--output cut_bench.json]
+//
+// MCUT 与 mio 会向标准输出打印日志，因此结果总是写入 --output 指定的文件
+
+#include "cut_mesh.h"
+#include "mesh_generators.h"
+#include "region_growing.h"
+#include "sample.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <mio/mio.h>
+#include <omp.h>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+struct BenchOptions {
+  std::vector<std::string> generators = {"icosphere", "terrain", "thin_shell",
+                                         "high_genus"};
+  std::vector<size_t> sizes = {10000, 100000, 1000000};
+  std::vector<int> threads;
+  size_t repeat = 3;
+  int seeds = 400;
+  int points = 8192;
+  size_t max_cut_faces = 1000000;
+  std::string output = "cut_bench.json";
+};
+
+struct BenchRecord {
+  std::string generator;
+  size_t num_vertices;
+  size_t num_faces;
+  std::string benchmark;
+  int threads;
+  std::vector<double> seconds;
+  std::string error;
+};
+
+std::vector<std::string> split(const std::string &text) {
+  std::vector<std::string> items;
+  std::stringstream stream(text);
+  std::string item;
+  while (std::getline(stream, item, ',')) {
+    if (!item.empty()) {
+      items.push_back(item);
+    }
+  }
+  return items;
+}
+
+BenchOptions parse_options(int argc, char **argv) {
+  BenchOptions options;
+  for (int i = 1; i < argc; ++i) {
+    const std::string arg = argv[i];
+    if (i + 1 >= argc) {
+      throw std::runtime_error("missing value for " + arg);
+    }
+    const std::string value = argv[++i];
+
+    if (arg == "--generators") {
+      options.generators = split(value);
+    } else if (arg == "--sizes") {
+      options.sizes.clear();
+      for (const auto &item : split(value)) {
+        options.sizes.push_back(std::stoull(item));
+      }
+    } else if (arg == "--threads") {
+      for (const auto &item : split(value)) {
+        options.threads.push_back(std::stoi(item));
+      }
+    } else if (arg == "--repeat") {
+      options.repeat = std::max<size_t>(1, std::stoull(value));
+    } else if (arg == "--seeds") {
+      options.seeds = std::stoi(value);
+    } else if (arg == "--points") {
+      options.points = std::stoi(value);
+    } else if (arg == "--max-cut-faces") {
+      options.max_cut_faces = std::stoull(value);
+    } else if (arg == "--output") {
+      options.output = value;
+    } else {
+      throw std::runtime_error("unknown option " + arg);
+    }
+  }
+
+  // 默认线程数为 1, 2, 4, ... 直到 OpenMP 的最大线程数
+  if (options.threads.empty()) {
+    const int max_threads = omp_get_max_threads();
+    for (int t = 1; t < max_threads; t *= 2) {
+      options.threads.push_back(t);
+    }
+    options.threads.push_back(max_threads);
+  }
+  return options;
+}
+
+std::string json_escape(const std::string &text) {
+  std::string escaped;
+  for (const char c : text) {
+    switch (c) {
+    case '"':
+      escaped += "\\\"";
+      break;
+    case '\\':
+      escaped += "\\\\";
+      break;
+    case '\n':
+      escaped += "\\n";
+      break;
+    default:
+      if (static_cast<unsigned char>(c) < 0x20) {
+        char buffer[8];
+        std::snprintf(buffer, sizeof(buffer), "\\u%04x", c);
+        escaped += buffer;
+      } else {
+        escaped += c;
+      }
+    }
+  }
+  return escaped;
+}
+
+void write_json(std::ostream &out, const BenchOptions &options,
+                const std::vector<BenchRecord> &records) {
+  out << "{\n";
+  out << "  \"hardware_concurrency\": " << std::thread::hardware_concurrency()
+      << ",\n";
+  out << "  \"omp_max_threads\": " << omp_get_max_threads() << ",\n";
+  out << "  \"repeat\": " << options.repeat << ",\n";
+  out << "  \"seeds\": " << options.seeds << ",\n";
+  out << "  \"points_per_submesh\": " << options.points << ",\n";
+  out << "  \"results\": [";
+
+  for (size_t i = 0; i < records.size(); ++i) {
+    const auto &r = records[i];
+    out << (i == 0 ? "\n" : ",\n");
+    out << "    {\"generator\": \"" << json_escape(r.generator) << "\", "
+        << "\"num_vertices\": " << r.num_vertices << ", "
+        << "\"num_faces\": " << r.num_faces << ", "
+        << "\"benchmark\": \"" << json_escape(r.benchmark) << "\", "
+        << "\"threads\": " << r.threads << ", ";
+
+    if (!r.error.empty()) {
+      out << "\"error\": \"" << json_escape(r.error) << "\"}";
+      continue;
+    }
+
+    std::vector<double> sorted = r.seconds;
+    std::sort(sorted.begin(), sorted.end());
+    double mean = 0.0;
+    for (const double s : sorted) {
+      mean += s;
+    }
+    mean /= sorted.size();
+
+    out << "\"min_seconds\": " << sorted.front() << ", "
+        << "\"median_seconds\": " << sorted[sorted.size() / 2] << ", "
+        << "\"mean_seconds\": " << mean << ", \"seconds\": [";
+    for (size_t k = 0; k < r.seconds.size(); ++k) {
+      out << (k == 0 ? "" : ", ") << r.seconds[k];
+    }
+    out << "]}";
+  }
+
+  out << "\n  ]\n}\n";
+}
+
+// 重复执行并记录每次耗时，异常记录到结果中而不中断整个测试
+BenchRecord run_benchmark(const BenchMesh &mesh, const std::string &name,
+                          const int threads, const size_t repeat,
+                          const std::function<void()> &body) {
+  BenchRecord record{mesh.name, mesh.vertices.size(), mesh.faces.size(),
+                     name,      threads,              {},
+                     ""};
+  omp_set_num_threads(threads);
+  try {
+    for (size_t i = 0; i < repeat; ++i) {
+      const auto start = std::chrono::steady_clock::now();
+      body();
+      const auto end = std::chrono::steady_clock::now();
+      record.seconds.push_back(
+          std::chrono::duration<double>(end - start).count());
+    }
+  } catch (const std::exception &e) {
+    record.error = e.what();
+  }
+
+  std::cerr << "[cut_bench] " << mesh.name << " " << mesh.faces.size()
+            << " faces, " << name << ", " << threads << " threads: "
+            << (record.error.empty()
+                    ? std::to_string(record.seconds.front()) + " s"
+                    : "error: " + record.error)
+            << std::endl;
+  return record;
+}
+
+void write_obj(const std::string &path,
+               const std::vector<std::array<double, 3>> &vertices,
+               const std::vector<std::array<size_t, 3>> &faces) {
+  std::vector<double> flat_vertices;
+  flat_vertices.reserve(vertices.size() * 3);
+  for (const auto &v : vertices) {
+    flat_vertices.insert(flat_vertices.end(), v.begin(), v.end());
+  }
+  std::vector<uint32_t> face_sizes(faces.size(), 3);
+  std::vector<uint32_t> face_indices;
+  face_indices.reserve(faces.size() * 3);
+  for (const auto &f : faces) {
+    face_indices.insert(face_indices.end(), f.begin(), f.end());
+  }
+
+  mioWriteOBJ(path.c_str(), flat_vertices.data(), nullptr, nullptr,
+              face_sizes.data(), face_indices.data(), nullptr, nullptr,
+              vertices.size(), 0, 0, faces.size());
+}
+
+// 与网格包围盒一侧相交的小球，作为 cutMesh 的切割网格
+BenchMesh make_cut_sphere(const BenchMesh &mesh) {
+  std::array<double, 3> lower = mesh.vertices.front();
+  std::array<double, 3> upper = mesh.vertices.front();
+  for (const auto &v : mesh.vertices) {
+    for (size_t d = 0; d < 3; ++d) {
+      lower[d] = std::min(lower[d], v[d]);
+      upper[d] = std::max(upper[d], v[d]);
+    }
+  }
+  double extent = 0.0;
+  for (size_t d = 0; d < 3; ++d) {
+    extent = std::max(extent, upper[d] - lower[d]);
+  }
+
+  BenchMesh sphere = generateIcosphere(1280);
+  for (auto &v : sphere.vertices) {
+    v = {upper[0] + 0.3 * extent * v[0] - 0.1 * extent,
+         0.5 * (lower[1] + upper[1]) + 0.3 * extent * v[1],
+         0.5 * (lower[2] + upper[2]) + 0.3 * extent * v[2]};
+  }
+  return sphere;
+}
+
+torch::Tensor to_vertex_tensor(const BenchMesh &mesh) {
+  torch::Tensor tensor = torch::empty(
+      {static_cast<int64_t>(mesh.vertices.size()), 3},
+      torch::TensorOptions().dtype(torch::kFloat32));
+  float *ptr = tensor.data_ptr<float>();
+  for (size_t i = 0; i < mesh.vertices.size(); ++i) {
+    for (size_t d = 0; d < 3; ++d) {
+      ptr[i * 3 + d] = static_cast<float>(mesh.vertices[i][d]);
+    }
+  }
+  return tensor;
+}
+
+torch::Tensor to_face_tensor(const BenchMesh &mesh) {
+  torch::Tensor tensor =
+      torch::empty({static_cast<int64_t>(mesh.faces.size()), 3},
+                   torch::TensorOptions().dtype(torch::kInt32));
+  int *ptr = tensor.data_ptr<int>();
+  for (size_t i = 0; i < mesh.faces.size(); ++i) {
+    for (size_t d = 0; d < 3; ++d) {
+      ptr[i * 3 + d] = static_cast<int>(mesh.faces[i][d]);
+    }
+  }
+  return tensor;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  BenchOptions options;
+  try {
+    options = parse_options(argc, argv);
+  } catch (const std::exception &e) {
+    std::cerr << "[cut_bench] " << e.what() << std::endl;
+    return 1;
+  }
+
+  // cutMesh 将结果写入 ./output，输入网格写到临时目录
+  const std::filesystem::path work_dir =
+      std::filesystem::temp_directory_path() / "cut_bench";
+  std::filesystem::create_directories(work_dir);
+  std::filesystem::create_directories("output");
+
+  std::vector<BenchRecord> records;
+  for (const auto &generator : options.generators) {
+    for (const size_t size : options.sizes) {
+      const BenchMesh mesh = generateBenchMesh(generator, size);
+      const torch::Tensor vertex_tensor = to_vertex_tensor(mesh);
+      const torch::Tensor face_tensor = to_face_tensor(mesh);
+      const int seeds = std::min<int>(options.seeds, mesh.vertices.size());
+
+      // 种子与区域在各线程数间共享，保证每个阶段的输入一致
+      omp_set_num_threads(options.threads.back());
+      const torch::Tensor seed_tensor =
+          farthest_point_sampling(vertex_tensor, seeds);
+      const int *seed_ptr = seed_tensor.data_ptr<int>();
+      const std::vector<size_t> seed_indices(seed_ptr, seed_ptr + seeds);
+      const auto regions = run_parallel_region_growing(
+          mesh.vertices, mesh.faces, seed_indices, seed_indices.size());
+
+      for (const int threads : options.threads) {
+        records.push_back(run_benchmark(
+            mesh, "farthest_point_sampling", threads, options.repeat,
+            [&]() { farthest_point_sampling(vertex_tensor, seeds); }));
+
+        records.push_back(run_benchmark(
+            mesh, "compute_min_radius_cover_all", threads, options.repeat,
+            [&]() { compute_min_radius_cover_all(mesh.vertices, seed_indices); }));
+
+        records.push_back(run_benchmark(
+            mesh, "run_parallel_region_growing", threads, options.repeat,
+            [&]() {
+              run_parallel_region_growing(mesh.vertices, mesh.faces,
+                                          seed_indices, seed_indices.size());
+            }));
+
+        records.push_back(run_benchmark(
+            mesh, "toSubMeshSamplePoints", threads, options.repeat, [&]() {
+              toSubMeshSamplePoints(vertex_tensor, face_tensor, regions,
+                                    options.points);
+            }));
+      }
+
+      // MCUT 使用自带的线程池，只按最大线程数测试一次
+      if (mesh.faces.size() <= options.max_cut_faces) {
+        const std::string mesh_path =
+            (work_dir / (mesh.name + "_" + std::to_string(size) + ".obj"))
+                .string();
+        const std::string cut_path =
+            (work_dir / (mesh.name + "_" + std::to_string(size) + "_cut.obj"))
+                .string();
+        write_obj(mesh_path, mesh.vertices, mesh.faces);
+        const BenchMesh cut_sphere = make_cut_sphere(mesh);
+        write_obj(cut_path, cut_sphere.vertices, cut_sphere.faces);
+
+        records.push_back(run_benchmark(mesh, "cutMesh",
+                                        options.threads.back(), options.repeat,
+                                        [&]() { cutMesh(mesh_path, cut_path); }));
+      }
+    }
+  }
+
+  std::ofstream out(options.output);
+  if (!out) {
+    std::cerr << "[cut_bench] cannot write " << options.output << std::endl;
+    return 1;
+  }
+  write_json(out, options, records);
+  std::cerr << "[cut_bench] results written to " << options.output
+            << std::endl;
+  return 0;
+}
@@ -0,0 +1,310 @@
+#include "mesh_generators.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <unordered_map>
+
+namespace {
+
+using Vec3 = std::array<double, 3>;
+
+Vec3 normalize(const Vec3 &p) {
+  const double len = std::sqrt(p[0] * p[0] + p[1] * p[1] + p[2] * p[2]);
+  return {p[0] / len, p[1] / len, p[2] / len};
+}
+
+// 整数格点哈希得到[0, 1)的伪随机值
+double lattice_value(const int64_t x, const int64_t y, const uint32_t seed) {
+  uint64_t h = static_cast<uint64_t>(x) * 0x9E3779B97F4A7C15ULL ^
+               static_cast<uint64_t>(y) * 0xC2B2AE3D27D4EB4FULL ^ seed;
+  h ^= h >> 33;
+  h *= 0xFF51AFD7ED558CCDULL;
+  h ^= h >> 33;
+  h *= 0xC4CEB9FE1A85EC53ULL;
+  h ^= h >> 33;
+  return (h >> 11) * (1.0 / 9007199254740992.0);
+}
+
+double smooth_value_noise(const double x, const double y,
+                          const uint32_t seed) {
+  const double fx = std::floor(x);
+  const double fy = std::floor(y);
+  const int64_t ix = static_cast<int64_t>(fx);
+  const int64_t iy = static_cast<int64_t>(fy);
+  const double tx = x - fx;
+  const double ty = y - fy;
+  const double sx = tx * tx * (3.0 - 2.0 * tx);
+  const double sy = ty * ty * (3.0 - 2.0 * ty);
+
+  const double v00 = lattice_value(ix, iy, seed);
+  const double v10 = lattice_value(ix + 1, iy, seed);
+  const double v01 = lattice_value(ix, iy + 1, seed);
+  const double v11 = lattice_value(ix + 1, iy + 1, seed);
+  const double a = v00 + (v10 - v00) * sx;
+  const double b = v01 + (v11 - v01) * sx;
+  return a + (b - a) * sy;
+}
+
+// 上半球面的经纬网格，inward为true时面片朝内，返回赤道环首个顶点的索引
+size_t append_hemisphere(BenchMesh &mesh, const double radius,
+                         const size_t rings, const size_t segments,
+                         const bool inward) {
+  const size_t base = mesh.vertices.size();
+  mesh.vertices.push_back({0.0, 0.0, radius});
+  for (size_t i = 1; i <= rings; ++i) {
+    const double theta = 0.5 * M_PI * i / rings;
+    for (size_t j = 0; j < segments; ++j) {
+      const double phi = 2.0 * M_PI * j / segments;
+      mesh.vertices.push_back({radius * std::sin(theta) * std::cos(phi),
+                               radius * std::sin(theta) * std::sin(phi),
+                               radius * std::cos(theta)});
+    }
+  }
+
+  const auto ring_vertex = [&](const size_t ring, const size_t j) {
+    return base + 1 + (ring - 1) * segments + j % segments;
+  };
+  const auto add_face = [&](size_t a, size_t b, size_t c) {
+    if (inward) {
+      std::swap(b, c);
+    }
+    mesh.faces.push_back({a, b, c});
+  };
+
+  for (size_t j = 0; j < segments; ++j) {
+    add_face(base, ring_vertex(1, j), ring_vertex(1, j + 1));
+  }
+  for (size_t i = 1; i < rings; ++i) {
+    for (size_t j = 0; j < segments; ++j) {
+      const size_t a = ring_vertex(i, j);
+      const size_t b = ring_vertex(i + 1, j);
+      const size_t c = ring_vertex(i + 1, j + 1);
+      const size_t d = ring_vertex(i, j + 1);
+      add_face(a, b, c);
+      add_face(a, c, d);
+    }
+  }
+
+  return ring_vertex(rings, 0);
+}
+
+} // namespace
+
+BenchMesh generateIcosphere(const size_t &target_faces) {
+  BenchMesh mesh;
+  mesh.name = "icosphere";
+
+  const double t = (1.0 + std::sqrt(5.0)) / 2.0;
+  mesh.vertices = {{-1, t, 0}, {1, t, 0}, {-1, -t, 0}, {1, -t, 0},
+                   {0, -1, t}, {0, 1, t}, {0, -1, -t}, {0, 1, -t},
+                   {t, 0, -1}, {t, 0, 1}, {-t, 0, -1}, {-t, 0, 1}};
+  for (auto &v : mesh.vertices) {
+    v = normalize(v);
+  }
+  mesh.faces = {{0, 11, 5}, {0, 5, 1},  {0, 1, 7},   {0, 7, 10}, {0, 10, 11},
+                {1, 5, 9},  {5, 11, 4}, {11, 10, 2}, {10, 7, 6}, {7, 1, 8},
+                {3, 9, 4},  {3, 4, 2},  {3, 2, 6},   {3, 6, 8},  {3, 8, 9},
+                {4, 9, 5},  {2, 4, 11}, {6, 2, 10},  {8, 6, 7},  {9, 8, 1}};
+
+  // 每次细分将一个三角形分为四个，边中点投影回球面并在相邻面片间共享
+  while (mesh.faces.size() < target_faces) {
+    std::unordered_map<uint64_t, size_t> midpoints;
+    const auto midpoint = [&](const size_t a, const size_t b) {
+      const uint64_t key = (static_cast<uint64_t>(std::min(a, b)) << 32) |
+                           std::max(a, b);
+      const auto it = midpoints.find(key);
+      if (it != midpoints.end()) {
+        return it->second;
+      }
+      const Vec3 &p = mesh.vertices[a];
+      const Vec3 &q = mesh.vertices[b];
+      mesh.vertices.push_back(
+          normalize({p[0] + q[0], p[1] + q[1], p[2] + q[2]}));
+      midpoints.emplace(key, mesh.vertices.size() - 1);
+      return mesh.vertices.size() - 1;
+    };
+
+    std::vector<std::array<size_t, 3>> faces;
+    faces.reserve(mesh.faces.size() * 4);
+    for (const auto &f : mesh.faces) {
+      const size_t ab = midpoint(f[0], f[1]);
+      const size_t bc = midpoint(f[1], f[2]);
+      const size_t ca = midpoint(f[2], f[0]);
+      faces.push_back({f[0], ab, ca});
+      faces.push_back({f[1], bc, ab});
+      faces.push_back({f[2], ca, bc});
+      faces.push_back({ab, bc, ca});
+    }
+    mesh.faces.swap(faces);
+  }
+
+  return mesh;
+}
+
+BenchMesh generateNoisyTerrain(const size_t &target_faces,
+                               const uint32_t &seed) {
+  BenchMesh mesh;
+  mesh.name = "terrain";
+
+  const size_t n = std::max<size_t>(
+      2, static_cast<size_t>(std::ceil(std::sqrt(target_faces / 2.0))) + 1);
+
+  mesh.vertices.resize(n * n);
+  for (size_t i = 0; i < n; ++i) {
+    for (size_t j = 0; j < n; ++j) {
+      const double x = static_cast<double>(i) / (n - 1);
+      const double y = static_cast<double>(j) / (n - 1);
+
+      double height = 0.0;
+      double amplitude = 0.1;
+      double frequency = 4.0;
+      for (uint32_t octave = 0; octave < 6; ++octave) {
+        height += amplitude *
+                  smooth_value_noise(x * frequency, y * frequency, seed + octave);
+        amplitude *= 0.5;
+        frequency *= 2.0;
+      }
+      mesh.vertices[i * n + j] = {x, y, height};
+    }
+  }
+
+  mesh.faces.reserve(2 * (n - 1) * (n - 1));
+  for (size_t i = 0; i + 1 < n; ++i) {
+    for (size_t j = 0; j + 1 < n; ++j) {
+      const size_t a = i * n + j;
+      const size_t b = (i + 1) * n + j;
+      const size_t c = (i + 1) * n + j + 1;
+      const size_t d = i * n + j + 1;
+      mesh.faces.push_back({a, b, c});
+      mesh.faces.push_back({a, c, d});
+    }
+  }
+
+  return mesh;
+}
+
+BenchMesh generateThinShell(const size_t &target_faces) {
+  BenchMesh mesh;
+  mesh.name = "thin_shell";
+
+  // 内外两层半球面在赤道处用环带封口，得到单个连通的闭合薄壳，
+  // 每层半球面约有8 * rings^2个面片
+  const size_t rings = std::max<size_t>(
+      2, static_cast<size_t>(std::ceil(std::sqrt(target_faces / 16.0))));
+  const size_t segments = 4 * rings;
+  const size_t outer = append_hemisphere(mesh, 1.0, rings, segments, false);
+  const size_t inner = append_hemisphere(mesh, 0.98, rings, segments, true);
+
+  for (size_t j = 0; j < segments; ++j) {
+    const size_t o0 = outer + j;
+    const size_t o1 = outer + (j + 1) % segments;
+    const size_t i0 = inner + j;
+    const size_t i1 = inner + (j + 1) % segments;
+    mesh.faces.push_back({o0, i1, o1});
+    mesh.faces.push_back({o0, i0, i1});
+  }
+  return mesh;
+}
+
+BenchMesh generateHighGenus(const size_t &target_faces) {
+  BenchMesh mesh;
+  mesh.name = "high_genus";
+
+  // 体素厚板：每个周期4格，孔宽2格，板厚2格，每个孔约贡献80个面片
+  const size_t PITCH = 4;
+  const size_t HOLE = 2;
+  const size_t THICKNESS = 2;
+  const size_t holes = std::max<size_t>(
+      1, static_cast<size_t>(std::ceil(std::sqrt(target_faces / 80.0))));
+  const size_t nx = holes * PITCH + (PITCH - HOLE);
+  const size_t ny = nx;
+  const size_t nz = THICKNESS;
+
+  const auto solid = [&](const int64_t x, const int64_t y, const int64_t z) {
+    if (x < 0 || y < 0 || z < 0 || x >= static_cast<int64_t>(nx) ||
+        y >= static_cast<int64_t>(ny) || z >= static_cast<int64_t>(nz)) {
+      return false;
+    }
+    // 边缘留出WALL格的墙，之后每个周期的前HOLE格为孔
+    const int64_t WALL = PITCH - HOLE;
+    const bool hole_x = x >= WALL && x < static_cast<int64_t>(nx) - WALL &&
+                        (x - WALL) % PITCH < static_cast<int64_t>(HOLE);
+    const bool hole_y = y >= WALL && y < static_cast<int64_t>(ny) - WALL &&
+                        (y - WALL) % PITCH < static_cast<int64_t>(HOLE);
+    return !(hole_x && hole_y);
+  };
+
+  // 格点顶点按需创建
+  std::vector<size_t> corner_index((nx + 1) * (ny + 1) * (nz + 1), SIZE_MAX);
+  const auto corner = [&](const size_t x, const size_t y, const size_t z) {
+    size_t &idx = corner_index[(x * (ny + 1) + y) * (nz + 1) + z];
+    if (idx == SIZE_MAX) {
+      idx = mesh.vertices.size();
+      mesh.vertices.push_back({static_cast<double>(x) / nx,
+                               static_cast<double>(y) / nx,
+                               static_cast<double>(z) / nx});
+    }
+    return idx;
+  };
+
+  // 实体格与空格相邻处输出一个朝外的四边形，沿轴a的两条切向轴为u、v
+  for (size_t x = 0; x < nx; ++x) {
+    for (size_t y = 0; y < ny; ++y) {
+      for (size_t z = 0; z < nz; ++z) {
+        if (!solid(x, y, z)) {
+          continue;
+        }
+        const size_t cell[3] = {x, y, z};
+        for (size_t a = 0; a < 3; ++a) {
+          for (const int sign : {-1, 1}) {
+            int64_t neighbour[3] = {static_cast<int64_t>(x),
+                                    static_cast<int64_t>(y),
+                                    static_cast<int64_t>(z)};
+            neighbour[a] += sign;
+            if (solid(neighbour[0], neighbour[1], neighbour[2])) {
+              continue;
+            }
+
+            const size_t u = (a + 1) % 3;
+            const size_t v = (a + 2) % 3;
+            size_t quad[4];
+            const size_t offsets[4][2] = {{0, 0}, {1, 0}, {1, 1}, {0, 1}};
+            for (size_t k = 0; k < 4; ++k) {
+              size_t p[3] = {cell[0], cell[1], cell[2]};
+              p[a] += sign > 0 ? 1 : 0;
+              p[u] += offsets[k][0];
+              p[v] += offsets[k][1];
+              quad[k] = corner(p[0], p[1], p[2]);
+            }
+            if (sign > 0) {
+              mesh.faces.push_back({quad[0], quad[1], quad[2]});
+              mesh.faces.push_back({quad[0], quad[2], quad[3]});
+            } else {
+              mesh.faces.push_back({quad[0], quad[2], quad[1]});
+              mesh.faces.push_back({quad[0], quad[3], quad[2]});
+            }
+          }
+        }
+      }
+    }
+  }
+
+  return mesh;
+}
+
+BenchMesh generateBenchMesh(const std::string &name,
+                            const size_t &target_faces) {
+  if (name == "icosphere") {
+    return generateIcosphere(target_faces);
+  }
+  if (name == "terrain") {
+    return generateNoisyTerrain(target_faces, 42);
+  }
+  if (name == "thin_shell") {
+    return generateThinShell(target_faces);
+  }
+  if (name == "high_genus") {
+    return generateHighGenus(target_faces);
+  }
+  throw std::runtime_error("unknown mesh generator: " + name);
+}
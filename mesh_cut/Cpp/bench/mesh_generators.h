@@ -0,0 +1,43 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @brief 基准测试用的程序化网格
+ */
+struct BenchMesh {
+  std::string name;
+  std::vector<std::array<double, 3>> vertices;
+  std::vector<std::array<size_t, 3>> faces;
+};
+
+/**
+ * @brief 单位球面上的细分二十面体，面片数为不小于target_faces的20 * 4^k
+ */
+BenchMesh generateIcosphere(const size_t &target_faces);
+
+/**
+ * @brief 多倍频值噪声高度场构成的开放地形网格
+ */
+BenchMesh generateNoisyTerrain(const size_t &target_faces,
+                               const uint32_t &seed);
+
+/**
+ * @brief 内外两层相距很近、在赤道处封口的半球壳，考验按半径生长时跨层泄漏的情况
+ */
+BenchMesh generateThinShell(const size_t &target_faces);
+
+/**
+ * @brief 开有规则方孔阵列的厚板，亏格随面片数增长
+ */
+BenchMesh generateHighGenus(const size_t &target_faces);
+
+/**
+ * @brief 按名称生成网格，名称为 icosphere/terrain/thin_shell/high_genus
+ */
+BenchMesh generateBenchMesh(const std::string &name,
+                            const size_t &target_faces);
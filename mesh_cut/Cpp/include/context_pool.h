@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstddef>
+#include <mcut/mcut.h>
+
+/**
+ * @brief 从进程级MCUT上下文池借出一个上下文，析构时归还
+ *
+ * 创建上下文需要启动其API线程与计算线程池，销毁时再逐一join，
+ * 因此上下文在池中常驻复用。池中无空闲上下文时，若未达容量则新建，否则阻塞等待归还。
+ * 归还时释放该上下文中残留的连通分量，下一位借用者拿到的总是干净的上下文
+ */
+class ContextLease {
+public:
+  ContextLease();
+  ~ContextLease();
+
+  ContextLease(const ContextLease &) = delete;
+  ContextLease &operator=(const ContextLease &) = delete;
+
+  McContext get() const { return context_; }
+
+private:
+  McContext context_;
+  size_t generation_;
+};
+
+/**
+ * @brief 重新配置上下文池并立即预热
+ *
+ * 空闲的旧上下文被销毁，按新配置预先创建全部上下文；
+ * 仍被借出的旧上下文在归还时销毁。默认容量为硬件线程数，每个上下文不带辅助线程
+ *
+ * @param num_contexts 池容量，即可同时进行的切割数，0表示硬件线程数
+ * @param num_helper_threads 每个上下文的MCUT辅助计算线程数
+ */
+void configureContextPool(const size_t &num_contexts,
+                          const size_t &num_helper_threads);
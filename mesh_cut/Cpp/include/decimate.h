@@ -0,0 +1,44 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <vector>
+
+/**
+ * @brief 二次误差简化得到的代理网格
+ *
+ * vertices/faces 为简化后的网格，face_map 记录每个原始面片对应的代理面片，
+ * 长度等于原始面片数量
+ */
+struct ProxyMesh {
+  std::vector<std::array<double, 3>> vertices;
+  std::vector<std::array<size_t, 3>> faces;
+  std::vector<size_t> face_map;
+};
+
+/**
+ * @brief 用二次误差度量(QEM)边折叠将网格简化为代理网格
+ *
+ * 每轮并行计算所有边的折叠代价，再按代价从小到大选取互不相邻的边折叠，
+ * 直到面片数不超过target_face_num或没有可折叠的边。
+ * 边界边附加垂直约束平面，折叠前检查连接条件与面片翻转
+ *
+ * @param vertices 顶点坐标数组
+ * @param faces 面片数组
+ * @param target_face_num 目标面片数量
+ * @return ProxyMesh 代理网格及原始面片到代理面片的映射
+ */
+ProxyMesh decimate_to_proxy(const std::vector<std::array<double, 3>> &vertices,
+                            const std::vector<std::array<size_t, 3>> &faces,
+                            const size_t &target_face_num);
+
+/**
+ * @brief 将代理网格上的面片分组映射回原始网格
+ *
+ * @param proxy 代理网格
+ * @param proxy_face_groups 代理网格上的面片分组
+ * @return std::vector<std::vector<size_t>> 原始网格上的面片分组
+ */
+std::vector<std::vector<size_t>>
+project_proxy_face_groups(const ProxyMesh &proxy,
+                          const std::vector<std::vector<size_t>> &proxy_face_groups);
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <memory>
+#include <mio/mio.h>
+#include <string>
+
+/**
+ * @brief 内存映射的 .mbin 网格缓存文件
+ *
+ * 面片均为三角形；顶点法线按面积加权，与 Open3D 的 compute_vertex_normals 一致。
+ * 映射为写时复制，修改数组不会写回文件。各数组的生命周期与本对象相同
+ */
+class MappedMesh {
+public:
+  ~MappedMesh();
+
+  MappedMesh(const MappedMesh &) = delete;
+  MappedMesh &operator=(const MappedMesh &) = delete;
+
+  const MioMappedMesh &mesh() const { return mesh_; }
+
+  // 是否包含顶点-面片邻接（CSR形式）
+  bool hasVertexFaces() const { return mesh_.pVertexFaceOffsets != nullptr; }
+
+  // 映射缓存文件，文件不存在、已损坏或版本不符时返回空指针
+  static std::shared_ptr<MappedMesh> map(const std::string &cache_file_path);
+
+private:
+  MappedMesh() = default;
+
+  MioMappedMesh mesh_;
+};
+
+/**
+ * @brief 读取网格文件（.obj/.off/.ply/.glb），三角化并计算顶点法线后写入 .mbin 缓存文件
+ *
+ * 先写入临时文件再重命名，多个进程同时转换同一网格时读者只会看到完整的文件
+ *
+ * @param with_vertex_faces 是否同时写入顶点-面片邻接
+ */
+void convertMeshToCache(const std::string &mesh_file_path,
+                        const std::string &cache_file_path,
+                        const bool &with_vertex_faces);
+
+/**
+ * @brief 从缓存目录内存映射网格，缓存缺失或过期时先转换
+ *
+ * 缓存文件名由网格文件的绝对路径决定，并记录网格文件的大小与修改时间，
+ * 网格文件改变后重新转换
+ *
+ * @param cache_dir 缓存目录，为空时缓存文件放在网格文件旁
+ * @param with_vertex_faces 是否需要顶点-面片邻接，缓存中没有时重新转换
+ * @return std::shared_ptr<MappedMesh> 映射的网格
+ */
+std::shared_ptr<MappedMesh> loadMeshCached(const std::string &mesh_file_path,
+                                           const std::string &cache_dir,
+                                           const bool &with_vertex_faces);
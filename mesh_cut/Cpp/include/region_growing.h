@@ -33,6 +33,19 @@ struct PointCloud {
   }
 };
 
+/**
+ * @brief 多个分割粒度的区域生长结果，以CSR形式存放
+ *
+ * 第i个层级的区域为[level_offsets[i], level_offsets[i + 1])，
+ * 第r个区域的面片为face_indices[region_offsets[r], region_offsets[r + 1])
+ */
+struct MultiLevelSegmentation {
+  std::vector<size_t> levels;
+  std::vector<size_t> level_offsets;
+  std::vector<size_t> region_offsets;
+  std::vector<size_t> face_indices;
+};
+
 /**
  * @brief 计算覆盖所有顶点的最小半径
  *
@@ -84,3 +97,66 @@ run_parallel_region_growing(const std::vector<std::array<double, 3>> &vertices,
                             const std::vector<std::array<size_t, 3>> &faces,
                             const std::vector<size_t> &seed_indices,
                             size_t num_segments);
+
+/**
+ * @brief 以网格表面点为种子的区域生长算法
+ *
+ * 种子由所在面片与重心坐标给出（见farthest_surface_point_sampling），
+ * 区域从种子所在面片开始生长，粗网格无需先细分
+ *
+ * @param vertices 顶点坐标数组
+ * @param faces 面片数组
+ * @param seed_faces 种子所在面片索引
+ * @param seed_barycentrics 种子在所在面片内的重心坐标
+ * @return std::vector<std::vector<size_t>> 每个种子点对应的连通面片索引数组集合
+ */
+std::vector<std::vector<size_t>> run_parallel_region_growing_from_surface_seeds(
+    const std::vector<std::array<double, 3>> &vertices,
+    const std::vector<std::array<size_t, 3>> &faces,
+    const std::vector<size_t> &seed_faces,
+    const std::vector<std::array<double, 3>> &seed_barycentrics);
+
+/**
+ * @brief 质心Voronoi(CVT)区域划分，用Lloyd迭代均衡以表面点为种子的分割
+ *
+ * 先从种子所在面片按到生成元的距离沿连通关系泛洪做一次完整分配，
+ * 之后每轮迭代将生成元移到区域面积加权质心，仅对两侧生成元有移动的
+ * 区域边界面片做局部重分配，区域质心按改变的面片并行增量更新。
+ * 重分配后失去面片的区域只保留含生成元的连通块，其余面片重新归入相邻区域。
+ * 重复的种子面片会改选最近的未被占用的面片，每个区域非空。
+ * 区域面积变异系数的变化小于balance_tolerance或没有面片改变时停止
+ *
+ * @param vertices 顶点坐标数组
+ * @param faces 面片数组
+ * @param seed_faces 种子所在面片索引，数量不能超过面片数量
+ * @param seed_barycentrics 种子在所在面片内的重心坐标
+ * @param max_iterations 最大Lloyd迭代次数
+ * @param balance_tolerance 区域面积变异系数的收敛阈值
+ * @return std::vector<std::vector<size_t>> 每个种子对应的面片索引数组，互不重叠
+ */
+std::vector<std::vector<size_t>> run_cvt_region_growing(
+    const std::vector<std::array<double, 3>> &vertices,
+    const std::vector<std::array<size_t, 3>> &faces,
+    const std::vector<size_t> &seed_faces,
+    const std::vector<std::array<double, 3>> &seed_barycentrics,
+    const size_t &max_iterations, const double &balance_tolerance);
+
+/**
+ * @brief 一次计算多个分割粒度的区域生长
+ *
+ * 种子须按最远点采样的顺序给出，每个层级取前level个种子，
+ * 顶点到面片的映射与种子点坐标在所有层级间共享，各区域并行生长
+ *
+ * @param vertices 顶点坐标数组
+ * @param faces 面片数组
+ * @param seed_faces 种子所在面片索引，按采样顺序排列
+ * @param seed_barycentrics 种子在所在面片内的重心坐标
+ * @param levels 各层级的分割数量，均不超过种子数量
+ * @return MultiLevelSegmentation 所有层级的分割结果
+ */
+MultiLevelSegmentation run_multi_level_region_growing(
+    const std::vector<std::array<double, 3>> &vertices,
+    const std::vector<std::array<size_t, 3>> &faces,
+    const std::vector<size_t> &seed_faces,
+    const std::vector<std::array<double, 3>> &seed_barycentrics,
+    const std::vector<size_t> &levels);
@@ -0,0 +1,101 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief 压缩位图中一个16位高位键对应的容器
+ *
+ * 元素不超过ARRAY_CONTAINER_MAX个时以有序的低16位数组存放，
+ * 否则以65536位的位图存放
+ */
+struct BitmapContainer {
+  uint16_t key = 0;
+  uint32_t cardinality = 0;
+  std::vector<uint16_t> values;
+  std::vector<uint64_t> words;
+
+  bool isBitmap() const { return !words.empty(); }
+};
+
+/**
+ * @brief Roaring风格的压缩位图，存放一个区域包含的面片索引
+ */
+class CompressedBitmap {
+public:
+  static const uint32_t ARRAY_CONTAINER_MAX = 4096;
+
+  CompressedBitmap() = default;
+
+  /**
+   * @brief 由升序且不重复的索引构建位图
+   */
+  static CompressedBitmap fromSorted(const uint32_t *values, size_t count);
+
+  size_t cardinality() const;
+
+  bool contains(uint32_t value) const;
+
+  size_t intersectionCardinality(const CompressedBitmap &other) const;
+
+  void intersection(const CompressedBitmap &other,
+                    std::vector<uint32_t> &result) const;
+
+  void decode(std::vector<uint32_t> &result) const;
+
+  size_t memoryBytes() const;
+
+private:
+  std::vector<BitmapContainer> containers_;
+};
+
+/**
+ * @brief 区域成员索引：每个区域存为压缩位图，并建立面片到区域的反向映射
+ *
+ * 区域生长得到的区域相互重叠，直接存放size_t索引占用大量内存，
+ * 压缩位图按16位高位键分块，稀疏块存数组、稠密块存位图，
+ * 区域交集在位图块上按字做与运算并统计位数
+ */
+class RegionMembershipIndex {
+public:
+  /**
+   * @param regions 区域数组，每个元素是一个包含面片索引的数组，可重复、无序
+   * @param num_faces 面片数量，所有面片索引须小于该值
+   *
+   * 反向映射使用32位偏移，各区域去重后的面片数之和超过2^32时抛出异常
+   */
+  RegionMembershipIndex(const std::vector<std::vector<size_t>> &regions,
+                        const size_t &num_faces);
+
+  size_t numRegions() const { return regions_.size(); }
+
+  size_t numFaces() const { return face_offsets_.size() - 1; }
+
+  size_t regionSize(const size_t &region) const;
+
+  bool contains(const size_t &region, const size_t &face) const;
+
+  // 区域包含的面片索引，升序
+  std::vector<uint32_t> regionFaces(const size_t &region) const;
+
+  // 包含该面片的区域索引，升序
+  std::vector<uint32_t> regionsOfFace(const size_t &face) const;
+
+  // 两个区域共有的面片数量
+  size_t overlap(const size_t &region_a, const size_t &region_b) const;
+
+  // 两个区域共有的面片索引，升序
+  std::vector<uint32_t> intersection(const size_t &region_a,
+                                     const size_t &region_b) const;
+
+  // 压缩位图与反向映射占用的字节数
+  size_t memoryBytes() const;
+
+private:
+  void checkRegion(const size_t &region) const;
+
+  std::vector<CompressedBitmap> regions_;
+  std::vector<uint32_t> face_offsets_;
+  std::vector<uint32_t> face_regions_;
+};
@@ -0,0 +1,94 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mcut/mcut.h>
+#include <string>
+#include <vector>
+
+/**
+ * @brief 一次MCUT切割得到的全部碎片
+ *
+ * 数据存放在一块连续缓冲区中：新计算的结果位于堆内存，缓存命中的结果直接内存映射缓存文件。
+ * 各数组以指针给出，生命周期与本对象相同；未请求映射时 vertex_map/face_map 为空指针，
+ * 未请求三角化时 triangles 为空指针
+ */
+class DispatchResult {
+public:
+  struct Fragment {
+    McFragmentLocation location;
+    McPatchLocation patch_location;
+    const double *vertices;
+    size_t num_vertices;
+    const uint32_t *face_indices;
+    size_t num_face_indices;
+    const uint32_t *face_sizes;
+    size_t num_faces;
+    const uint32_t *triangles;
+    size_t num_triangle_indices;
+    const uint32_t *vertex_map;
+    const uint32_t *face_map;
+  };
+
+  ~DispatchResult();
+
+  DispatchResult(const DispatchResult &) = delete;
+  DispatchResult &operator=(const DispatchResult &) = delete;
+
+  const std::vector<Fragment> &fragments() const { return fragments_; }
+
+  // 结果是否来自磁盘缓存
+  bool fromCache() const { return mapped_ != nullptr; }
+
+private:
+  friend std::shared_ptr<const DispatchResult>
+  dispatchCached(McContext, const McFlags &, const double *, const uint32_t *,
+                 const uint32_t *, const uint32_t &, const uint32_t &,
+                 const double *, const uint32_t *, const uint32_t *,
+                 const uint32_t &, const uint32_t &, const bool &);
+
+  DispatchResult() = default;
+
+  // 解析缓冲区中的碎片表，格式不符时返回false
+  bool parse(const uint64_t *words, const size_t &num_words);
+
+  // 内存映射缓存文件，文件不存在或损坏时返回空指针
+  static std::shared_ptr<DispatchResult> map(const std::string &path,
+                                             const uint64_t key[2]);
+
+  std::vector<uint64_t> buffer_;
+  void *mapped_ = nullptr;
+  size_t mapped_size_ = 0;
+  std::vector<Fragment> fragments_;
+};
+
+/**
+ * @brief 执行mcDispatch并按内容寻址缓存切割结果
+ *
+ * 以源网格与切割网格的顶点/面片缓冲区、dispatch标志及上下文状态（扰动设置、输出绕向）的哈希为键，
+ * 碎片的顶点、面片、三角化、位置与（若请求）顶点/面片映射写入缓存目录中的单个文件，
+ * 重复切割时内存映射该文件而不再调用MCUT。缓存目录总大小超过上限时按最近使用时间淘汰。
+ * 未配置缓存目录时每次都执行切割
+ *
+ * @param context 用于切割的MCUT上下文，结果取出后其中的连通分量被释放
+ * @param flags mcDispatch标志，顶点数组须为MC_DISPATCH_VERTEX_ARRAY_DOUBLE
+ * @param with_triangulation 是否取出碎片的三角化面片
+ * @return std::shared_ptr<const DispatchResult> 切割结果
+ */
+std::shared_ptr<const DispatchResult> dispatchCached(
+    McContext context, const McFlags &flags, const double *src_vertices,
+    const uint32_t *src_face_indices, const uint32_t *src_face_sizes,
+    const uint32_t &num_src_vertices, const uint32_t &num_src_faces,
+    const double *cut_vertices, const uint32_t *cut_face_indices,
+    const uint32_t *cut_face_sizes, const uint32_t &num_cut_vertices,
+    const uint32_t &num_cut_faces, const bool &with_triangulation);
+
+/**
+ * @brief 配置进程级的切割结果磁盘缓存
+ *
+ * @param cache_dir 缓存目录，为空时关闭缓存
+ * @param max_bytes 缓存目录的总大小上限（字节）
+ */
+void configureResultCache(const std::string &cache_dir,
+                          const size_t &max_bytes);
@@ -2,12 +2,29 @@
 
 #include <random>
 #include <torch/extension.h>
+#include <tuple>
 #include <vector>
 
 // 最远点采样算法的C++实现
 torch::Tensor farthest_point_sampling(torch::Tensor points,
                                       int sample_point_num);
 
+/**
+ * @brief 在网格表面按面积均匀分布的候选点上做最远点采样
+ *
+ * 种子点不局限于网格顶点，粗网格无需先细分即可得到均匀分布的种子
+ *
+ * @param vertices 顶点坐标张量，形状为(N, 3)的torch::Tensor
+ * @param triangles 三角形面片张量，形状为(M, 3)的torch::Tensor
+ * @param sample_point_num 种子点数量
+ * @param candidate_num 候选表面点数量，小于sample_point_num时取sample_point_num
+ * @return std::tuple<torch::Tensor, torch::Tensor>
+ * 种子所在面片索引(K,)与其在面片内的重心坐标(K, 3)
+ */
+std::tuple<torch::Tensor, torch::Tensor>
+farthest_surface_point_sampling(torch::Tensor vertices, torch::Tensor triangles,
+                                int sample_point_num, int candidate_num);
+
 /**
  * @brief 对N个子网格进行并行采样，每个子网格采样M个点
  *
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief 单个球体裁剪得到的网格片
+ *
+ * vertices/faces 为局部编号的网格片，face_map 记录每个输出面片来自的源面片，
+ * vertex_map 记录每个输出顶点对应的源顶点，新生成的交点与圆弧点记为 -1
+ */
+struct SpherePatch {
+  std::vector<std::array<double, 3>> vertices;
+  std::vector<std::array<size_t, 3>> faces;
+  std::vector<size_t> face_map;
+  std::vector<int64_t> vertex_map;
+};
+
+/**
+ * @brief 用解析球面裁剪源网格，提取每个球内部的网格片
+ *
+ * 每个球通过面片质心KD树查询候选面片，再将候选三角形与精确球面求交，
+ * 沿平面与球面的交线圆弧按容差离散并重新三角化，多个球并行处理
+ *
+ * @param vertices 顶点坐标数组
+ * @param faces 面片数组
+ * @param centers 球心坐标数组
+ * @param radius 球半径
+ * @param tolerance 圆弧离散的最大弦高误差
+ * @return std::vector<SpherePatch> 每个球对应的内部网格片
+ */
+std::vector<SpherePatch>
+cut_mesh_by_spheres(const std::vector<std::array<double, 3>> &vertices,
+                    const std::vector<std::array<size_t, 3>> &faces,
+                    const std::vector<std::array<double, 3>> &centers,
+                    const double &radius, const double &tolerance);
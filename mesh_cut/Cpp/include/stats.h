@@ -0,0 +1,118 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/**
+ * @brief cut_cpp 各入口函数的分阶段统计
+ *
+ * 以 StatsScope 在当前线程上启用后，该线程调用的入口函数把阶段耗时与计数累加到其中；
+ * 未启用时记录操作只检查一个线程局部指针。阶段名按嵌套关系以"/"连接。
+ * CPU时间与峰值常驻内存为进程级数值，多个线程同时切割时会互相计入。
+ * 峰值常驻内存只读取（VmHWM 或 getrusage），不修改进程状态
+ */
+class CutStats {
+public:
+  struct Stage {
+    double wall_seconds = 0.0;
+    double cpu_seconds = 0.0;
+    size_t calls = 0;
+    // 阶段开始时可用的最大OpenMP线程数，利用率为 cpu / (wall * threads)
+    int threads = 0;
+    // 阶段结束时进程启动以来的峰值常驻内存，并非该阶段单独的峰值
+    size_t peak_rss_bytes = 0;
+  };
+
+  enum class CountKind { Sum, Max, Min };
+
+  struct Count {
+    int64_t value = 0;
+    CountKind kind = CountKind::Sum;
+  };
+
+  void addStage(const std::string &name, const double &wall_seconds,
+                const double &cpu_seconds, const int &threads,
+                const size_t &peak_rss_bytes);
+
+  void addCount(const std::string &name, const int64_t &value,
+                const CountKind &kind = CountKind::Sum);
+
+  // 合并另一份统计，阶段与计数按各自的方式累加
+  void merge(const CutStats &other);
+
+  void reset();
+
+  std::map<std::string, Stage> stages() const;
+  std::map<std::string, Count> counts() const;
+  size_t peakRssBytes() const;
+
+private:
+  mutable std::mutex mutex_;
+  std::map<std::string, Stage> stages_;
+  std::map<std::string, Count> counts_;
+  size_t peak_rss_bytes_ = 0;
+};
+
+/**
+ * @brief 在当前线程上启用统计，析构时恢复之前启用的对象（可嵌套）
+ */
+class StatsScope {
+public:
+  explicit StatsScope(CutStats *stats);
+  ~StatsScope();
+
+  StatsScope(const StatsScope &) = delete;
+  StatsScope &operator=(const StatsScope &) = delete;
+
+private:
+  CutStats *previous_;
+};
+
+/**
+ * @brief 当前线程上启用的统计对象，未启用时为空指针
+ */
+CutStats *activeStats();
+
+/**
+ * @brief 与 StatsScope 相同，供Python的 with 语句使用
+ */
+void pushActiveStats(CutStats *stats);
+void popActiveStats(CutStats *stats);
+
+/**
+ * @brief 记录一个阶段的墙钟时间、CPU时间、线程数与峰值常驻内存
+ *
+ * 只应在调用入口函数的线程上使用，不要放在OpenMP并行区内
+ */
+class StageTimer {
+public:
+  explicit StageTimer(const char *name);
+  ~StageTimer();
+
+  // 提前结束阶段，用于顺序排列的子阶段；之后析构不再记录
+  void stop();
+
+  StageTimer(const StageTimer &) = delete;
+  StageTimer &operator=(const StageTimer &) = delete;
+
+private:
+  CutStats *stats_;
+};
+
+/**
+ * @brief 向当前线程启用的统计对象累加计数，未启用时不做任何事
+ */
+void recordCount(const char *name, const int64_t &value,
+                 const CutStats::CountKind &kind = CutStats::CountKind::Sum);
+
+/**
+ * @brief 记录一组区域的数量、总面片数、最大/最小区域大小与重叠面片数
+ *
+ * 重叠面片数为各区域大小之和减去被覆盖的不同面片数
+ */
+void recordRegions(const std::vector<std::vector<size_t>> &regions,
+                   const size_t &num_faces);
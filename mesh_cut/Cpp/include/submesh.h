@@ -0,0 +1,27 @@
+#pragma once
+
+#include <torch/extension.h>
+#include <tuple>
+#include <vector>
+
+/**
+ * @brief 并行提取每个区域的紧凑子网格
+ *
+ * 每个线程持有一张按区域递增纪元号标记的全局到局部顶点映射表，
+ * 先统计各区域的顶点数量确定偏移，再并行写入各自的输出区间，
+ * 无需对每个区域清空映射表或分配临时数组
+ *
+ * @param vertices 顶点坐标张量，形状为(N, 3)的torch::Tensor
+ * @param triangles 三角形面片张量，形状为(M, 3)的torch::Tensor
+ * @param regions 区域数组，每个元素是一个包含面片索引的数组
+ * @return std::tuple<torch::Tensor, torch::Tensor, torch::Tensor,
+ * torch::Tensor, torch::Tensor>
+ * 依次为所有子网格拼接的顶点(V, 3)、局部编号的面片(F, 3)、
+ * 顶点偏移(R + 1)、面片偏移(R + 1)与局部到全局的顶点映射(V)，
+ * 第r个子网格的顶点为[vertex_offsets[r], vertex_offsets[r + 1])，
+ * 面片为[face_offsets[r], face_offsets[r + 1])
+ */
+std::tuple<torch::Tensor, torch::Tensor, torch::Tensor, torch::Tensor,
+           torch::Tensor>
+extract_submeshes(torch::Tensor vertices, torch::Tensor triangles,
+                  const std::vector<std::vector<size_t>> &regions);
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+/**
+ * @brief 外存分块切割，用于无法一次性载入内存的超大网格
+ *
+ * 1. 流式读取源网格OBJ，顶点写入磁盘并内存映射，面片按质心空间划分为磁盘上的分块，
+ *    超出预算的分块继续二分
+ * 2. 只载入与切割网格面片包围盒相交的分块，按连通分量逐个送入MCUT切割
+ * 3. 未载入的分块整体按射线奇偶性判定位于切割网格内外
+ * 4. 各分块的碎片按位置（above/below/undefined）流式写出，
+ *    原始顶点按全局编号、落在分块接缝上的新交点按量化坐标合并，实现跨分块拼接
+ *
+ * 碎片不做补洞（MC_DISPATCH_FILTER_FRAGMENT_SEALING_NONE）
+ *
+ * @param mesh_file_path 源网格OBJ文件路径
+ * @param cut_mesh_file_path 切割网格文件路径，切割网格整体载入内存
+ * @param output_folder 输出文件夹，分块临时文件存放于其中唯一命名的子文件夹并在结束后删除
+ * @param memory_budget_bytes 单个分块切割时的内存预算（字节），接缝交点的去重表不计入其中
+ * @return std::vector<std::string> 写出的碎片OBJ文件路径
+ */
+std::vector<std::string> cutMeshTiled(const std::string &mesh_file_path,
+                                      const std::string &cut_mesh_file_path,
+                                      const std::string &output_folder,
+                                      const size_t &memory_budget_bytes);
@@ -1,6 +1,15 @@
+#include "context_pool.h"
 #include "cut_mesh.h"
+#include "decimate.h"
+#include "mesh_cache.h"
 #include "region_growing.h"
+#include "region_index.h"
+#include "result_cache.h"
 #include "sample.h"
+#include "sphere_cut.h"
+#include "stats.h"
+#include "submesh.h"
+#include "tiled_cut.h"
 #include <pybind11/numpy.h>
 #include <pybind11/pybind11.h>
 #include <pybind11/stl.h>
@@ -11,17 +20,206 @@ PYBIND11_MODULE(cut_cpp, m) {
   m.doc() = "C++ implementation of mesh graph cut algorithm"; // optional module
                                                               // docstring
 
+  // 以下函数只读写各自的参数与局部状态（上下文池与结果缓存自带互斥锁），
+  // 调用期间释放GIL，多个Python线程可并发切割
+
   m.def("run_parallel_region_growing", &run_parallel_region_growing,
-        "Run parallel region growing algorithm");
+        "Run parallel region growing algorithm",
+        py::call_guard<py::gil_scoped_release>());
+
+  m.def("run_parallel_region_growing_from_surface_seeds",
+        &run_parallel_region_growing_from_surface_seeds,
+        "Run region growing from surface seeds",
+        py::call_guard<py::gil_scoped_release>());
+
+  m.def("run_cvt_region_growing", &run_cvt_region_growing,
+        "Run centroidal Voronoi region growing",
+        py::call_guard<py::gil_scoped_release>());
+
+  py::class_<MultiLevelSegmentation>(m, "MultiLevelSegmentation")
+      .def_readonly("levels", &MultiLevelSegmentation::levels)
+      .def_readonly("level_offsets", &MultiLevelSegmentation::level_offsets)
+      .def_readonly("region_offsets", &MultiLevelSegmentation::region_offsets)
+      .def_readonly("face_indices", &MultiLevelSegmentation::face_indices);
+
+  m.def("run_multi_level_region_growing", &run_multi_level_region_growing,
+        "Run region growing for several segment counts at once",
+        py::call_guard<py::gil_scoped_release>());
+
+  py::class_<RegionMembershipIndex>(m, "RegionMembershipIndex")
+      .def(py::init<const std::vector<std::vector<size_t>> &, const size_t &>(),
+           py::call_guard<py::gil_scoped_release>())
+      .def("num_regions", &RegionMembershipIndex::numRegions)
+      .def("num_faces", &RegionMembershipIndex::numFaces)
+      .def("region_size", &RegionMembershipIndex::regionSize)
+      .def("contains", &RegionMembershipIndex::contains)
+      .def("region_faces", &RegionMembershipIndex::regionFaces,
+           py::call_guard<py::gil_scoped_release>())
+      .def("regions_of_face", &RegionMembershipIndex::regionsOfFace)
+      .def("overlap", &RegionMembershipIndex::overlap,
+           py::call_guard<py::gil_scoped_release>())
+      .def("intersection", &RegionMembershipIndex::intersection,
+           py::call_guard<py::gil_scoped_release>())
+      .def("memory_bytes", &RegionMembershipIndex::memoryBytes);
 
   m.def("compute_min_radius_cover_all", &compute_min_radius_cover_all,
-        "region_growing.compute_min_radius_cover_all");
+        "region_growing.compute_min_radius_cover_all",
+        py::call_guard<py::gil_scoped_release>());
 
   m.def("farthest_point_sampling", &farthest_point_sampling,
-        "sample.farthest_point_sampling");
+        "sample.farthest_point_sampling",
+        py::call_guard<py::gil_scoped_release>());
+
+  m.def("farthest_surface_point_sampling", &farthest_surface_point_sampling,
+        "sample.farthest_surface_point_sampling",
+        py::call_guard<py::gil_scoped_release>());
 
   m.def("toSubMeshSamplePoints", &toSubMeshSamplePoints,
-        "sample.toSubMeshSamplePoints");
+        "sample.toSubMeshSamplePoints",
+        py::call_guard<py::gil_scoped_release>());
+
+  py::class_<ProxyMesh>(m, "ProxyMesh")
+      .def_readonly("vertices", &ProxyMesh::vertices)
+      .def_readonly("faces", &ProxyMesh::faces)
+      .def_readonly("face_map", &ProxyMesh::face_map);
+
+  m.def("decimate_to_proxy", &decimate_to_proxy, "decimate.decimate_to_proxy",
+        py::call_guard<py::gil_scoped_release>());
+
+  m.def("project_proxy_face_groups", &project_proxy_face_groups,
+        "decimate.project_proxy_face_groups",
+        py::call_guard<py::gil_scoped_release>());
+
+  m.def("extract_submeshes", &extract_submeshes, "submesh.extract_submeshes",
+        py::call_guard<py::gil_scoped_release>());
+
+  m.def("cutMesh", &cutMesh, "cut_mesh.cutMesh",
+        py::call_guard<py::gil_scoped_release>());
+
+  m.def("configureContextPool", &configureContextPool,
+        "context_pool.configureContextPool",
+        py::call_guard<py::gil_scoped_release>());
+
+  m.def("configureResultCache", &configureResultCache,
+        "result_cache.configureResultCache",
+        py::call_guard<py::gil_scoped_release>());
+
+  // with CutStats() as stats: 期间当前线程调用的入口函数记录到 stats 中
+  py::class_<CutStats>(m, "CutStats")
+      .def(py::init<>())
+      .def("reset", &CutStats::reset)
+      .def("merge", &CutStats::merge)
+      .def(
+          "add_stage",
+          [](CutStats &self, const std::string &name,
+             const double &wall_seconds, const double &cpu_seconds) {
+            self.addStage(name, wall_seconds, cpu_seconds, 1, 0);
+          },
+          "Record a stage measured outside cut_cpp")
+      .def("to_dict",
+           [](const CutStats &self) {
+             py::dict stages;
+             for (const auto &item : self.stages()) {
+               const CutStats::Stage &stage = item.second;
+               const double capacity = stage.wall_seconds * stage.threads;
+               py::dict entry;
+               entry["wall_seconds"] = stage.wall_seconds;
+               entry["cpu_seconds"] = stage.cpu_seconds;
+               entry["calls"] = stage.calls;
+               entry["threads"] = stage.threads;
+               entry["utilization"] =
+                   capacity > 0.0 ? stage.cpu_seconds / capacity : 0.0;
+               entry["peak_rss_bytes"] = stage.peak_rss_bytes;
+               stages[py::str(item.first)] = entry;
+             }
+             py::dict counts;
+             for (const auto &item : self.counts()) {
+               counts[py::str(item.first)] = item.second.value;
+             }
+             py::dict result;
+             result["stages"] = stages;
+             result["counts"] = counts;
+             result["peak_rss_bytes"] = self.peakRssBytes();
+             return result;
+           })
+      .def("__enter__",
+           [](CutStats &self) -> CutStats & {
+             pushActiveStats(&self);
+             return self;
+           },
+           py::return_value_policy::reference)
+      .def("__exit__", [](CutStats &self, const py::args &) {
+        popActiveStats(&self);
+        return false;
+      });
+
+  // 数组直接引用映射的缓存文件（写时复制），并持有 MappedMesh 使映射保持有效
+  py::class_<MappedMesh, std::shared_ptr<MappedMesh>>(m, "MappedMesh")
+      .def_property_readonly(
+          "vertices",
+          [](py::object self) {
+            const MioMappedMesh &mesh = self.cast<const MappedMesh &>().mesh();
+            return py::array_t<double>({size_t(mesh.numVertices), size_t(3)},
+                                       mesh.pVertices, self);
+          })
+      .def_property_readonly(
+          "normals",
+          [](py::object self) -> py::object {
+            const MioMappedMesh &mesh = self.cast<const MappedMesh &>().mesh();
+            if (mesh.pNormals == nullptr) {
+              return py::none();
+            }
+            return py::array_t<double>({size_t(mesh.numVertices), size_t(3)},
+                                       mesh.pNormals, self);
+          })
+      .def_property_readonly(
+          "triangles",
+          [](py::object self) {
+            const MioMappedMesh &mesh = self.cast<const MappedMesh &>().mesh();
+            return py::array_t<int32_t>(
+                {size_t(mesh.numFaces), size_t(3)},
+                reinterpret_cast<const int32_t *>(mesh.pFaceVertexIndices),
+                self);
+          })
+      .def_property_readonly(
+          "vertex_face_offsets",
+          [](py::object self) -> py::object {
+            const MioMappedMesh &mesh = self.cast<const MappedMesh &>().mesh();
+            if (mesh.pVertexFaceOffsets == nullptr) {
+              return py::none();
+            }
+            return py::array_t<uint32_t>(size_t(mesh.numVertices) + 1,
+                                         mesh.pVertexFaceOffsets, self);
+          })
+      .def_property_readonly(
+          "vertex_faces",
+          [](py::object self) -> py::object {
+            const MioMappedMesh &mesh = self.cast<const MappedMesh &>().mesh();
+            if (mesh.pVertexFaces == nullptr) {
+              return py::none();
+            }
+            return py::array_t<uint32_t>(
+                size_t(mesh.pVertexFaceOffsets[mesh.numVertices]),
+                mesh.pVertexFaces, self);
+          });
+
+  m.def("loadMeshCached", &loadMeshCached, "mesh_cache.loadMeshCached",
+        py::call_guard<py::gil_scoped_release>());
+
+  m.def("convertMeshToCache", &convertMeshToCache,
+        "mesh_cache.convertMeshToCache",
+        py::call_guard<py::gil_scoped_release>());
+
+  py::class_<SpherePatch>(m, "SpherePatch")
+      .def_readonly("vertices", &SpherePatch::vertices)
+      .def_readonly("faces", &SpherePatch::faces)
+      .def_readonly("face_map", &SpherePatch::face_map)
+      .def_readonly("vertex_map", &SpherePatch::vertex_map);
+
+  m.def("cut_mesh_by_spheres", &cut_mesh_by_spheres,
+        "sphere_cut.cut_mesh_by_spheres",
+        py::call_guard<py::gil_scoped_release>());
 
-  m.def("cutMesh", &cutMesh, "cut_mesh.cutMesh");
+  m.def("cutMeshTiled", &cutMeshTiled, "tiled_cut.cutMeshTiled",
+        py::call_guard<py::gil_scoped_release>());
 }
@@ -0,0 +1,161 @@
+#include "context_pool.h"
+#include <algorithm>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace {
+
+McContext createContext(const size_t &num_helper_threads) {
+  McContext context = MC_NULL_HANDLE;
+  if (mcCreateContextWithHelpers(&context, MC_NULL_HANDLE,
+                                 static_cast<uint32_t>(num_helper_threads)) !=
+      MC_NO_ERROR) {
+    throw std::runtime_error("mcCreateContextWithHelpers failed");
+  }
+  return context;
+}
+
+class ContextPool {
+public:
+  static ContextPool &instance() {
+    static ContextPool pool;
+    return pool;
+  }
+
+  ~ContextPool() {
+    for (const McContext &context : idle_) {
+      mcReleaseContext(context);
+    }
+  }
+
+  McContext acquire(size_t &generation) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    available_.wait(lock,
+                    [&]() { return !idle_.empty() || created_ < capacity_; });
+
+    generation = generation_;
+    if (!idle_.empty()) {
+      const McContext context = idle_.back();
+      idle_.pop_back();
+      return context;
+    }
+
+    // 新建上下文较慢，先占住名额再解锁创建
+    ++created_;
+    const size_t num_helper_threads = num_helper_threads_;
+    lock.unlock();
+
+    try {
+      return createContext(num_helper_threads);
+    } catch (...) {
+      lock.lock();
+      if (generation == generation_) {
+        --created_;
+      }
+      available_.notify_one();
+      throw;
+    }
+  }
+
+  void release(const McContext &context, const size_t &generation) {
+    mcReleaseConnectedComponents(context, 0, nullptr);
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (generation != generation_) {
+      lock.unlock();
+      mcReleaseContext(context);
+      return;
+    }
+    idle_.push_back(context);
+    lock.unlock();
+    available_.notify_one();
+  }
+
+  void configure(const size_t &num_contexts, const size_t &num_helper_threads) {
+    std::vector<McContext> stale;
+    std::vector<McContext> warmed;
+    size_t generation = 0;
+    size_t capacity = 0;
+
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stale.swap(idle_);
+      capacity_ = num_contexts > 0 ? num_contexts : defaultCapacity();
+      num_helper_threads_ = num_helper_threads;
+      generation = ++generation_;
+      capacity = capacity_;
+      // 预热的上下文事先占满名额，预热期间的借用者等待而不是另行创建
+      created_ = capacity_;
+    }
+
+    for (const McContext &context : stale) {
+      mcReleaseContext(context);
+    }
+
+    try {
+      for (size_t i = 0; i < capacity; ++i) {
+        warmed.push_back(createContext(num_helper_threads));
+      }
+    } catch (...) {
+      for (const McContext &context : warmed) {
+        mcReleaseContext(context);
+      }
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (generation == generation_) {
+          created_ = 0;
+        }
+      }
+      available_.notify_all();
+      throw;
+    }
+
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (generation == generation_) {
+        idle_.insert(idle_.end(), warmed.begin(), warmed.end());
+        warmed.clear();
+      }
+    }
+    available_.notify_all();
+
+    // 预热期间又被重新配置
+    for (const McContext &context : warmed) {
+      mcReleaseContext(context);
+    }
+  }
+
+private:
+  ContextPool() : capacity_(defaultCapacity()) {}
+
+  static size_t defaultCapacity() {
+    return std::max<size_t>(1, std::thread::hardware_concurrency());
+  }
+
+  std::mutex mutex_;
+  std::condition_variable available_;
+  std::vector<McContext> idle_;
+  size_t capacity_;
+  size_t num_helper_threads_ = 0;
+  size_t created_ = 0;
+  size_t generation_ = 0;
+};
+
+} // namespace
+
+ContextLease::ContextLease() : context_(MC_NULL_HANDLE), generation_(0) {
+  context_ = ContextPool::instance().acquire(generation_);
+}
+
+ContextLease::~ContextLease() {
+  ContextPool::instance().release(context_, generation_);
+}
+
+void configureContextPool(const size_t &num_contexts,
+                          const size_t &num_helper_threads) {
+  ContextPool::instance().configure(num_contexts, num_helper_threads);
+}
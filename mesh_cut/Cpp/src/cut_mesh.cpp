@@ -1,8 +1,12 @@
 #include "cut_mesh.h"
+#include "context_pool.h"
+#include "result_cache.h"
+#include "stats.h"
 #include <algorithm>
 #include <map>
 #include <mcut/mcut.h>
 #include <mio/mio.h>
+#include <stdexcept>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -17,19 +21,20 @@
 #endif                           // _WIN32
 #endif
 
-#define my_assert(cond)                                                        \
-  if (!(cond)) {                                                               \
-    fprintf(stderr, "MCUT error: %s\n", #cond);                                \
-    std::exit(1);                                                              \
-  }
+namespace {
+
+// 在作用域结束时释放 mio 分配的网格，异常路径也不会泄漏
+struct MioMeshGuard {
+  MioMesh &mesh;
+  ~MioMeshGuard() { mioFreeMesh(&mesh); }
+};
 
-void MCAPI_PTR mcDebugOutput(McDebugSource source, McDebugType type,
-                             McUint32 id, McDebugSeverity severity,
-                             size_t length, const char *message,
-                             const void *userParam);
+} // namespace
 
 void cutMesh(const std::string &mesh_file_path,
              const std::string &cut_mesh_file_path) {
+  StageTimer stage("cutMesh");
+
   MioMesh srcMesh = {
       nullptr, // pVertices
       nullptr, // pNormals
@@ -46,169 +51,89 @@ void cutMesh(const std::string &mesh_file_path,
 
   MioMesh cutMesh = srcMesh;
 
-  mioReadOBJ(mesh_file_path.c_str(), &srcMesh.pVertices, &srcMesh.pNormals,
-             &srcMesh.pTexCoords, &srcMesh.pFaceSizes,
-             &srcMesh.pFaceVertexIndices, &srcMesh.pFaceVertexTexCoordIndices,
-             &srcMesh.pFaceVertexNormalIndices, &srcMesh.numVertices,
-             &srcMesh.numNormals, &srcMesh.numTexCoords, &srcMesh.numFaces);
-
-  mioReadOBJ(cut_mesh_file_path.c_str(), &cutMesh.pVertices, &cutMesh.pNormals,
-             &cutMesh.pTexCoords, &cutMesh.pFaceSizes,
-             &cutMesh.pFaceVertexIndices, &cutMesh.pFaceVertexTexCoordIndices,
-             &cutMesh.pFaceVertexNormalIndices, &cutMesh.numVertices,
-             &cutMesh.numNormals, &cutMesh.numTexCoords, &cutMesh.numFaces);
+  MioMeshGuard src_guard{srcMesh};
+  MioMeshGuard cut_guard{cutMesh};
+
+  StageTimer read_stage("read");
+  // 按扩展名选择读取函数（.obj/.off/.ply/.glb）
+  if (mioRead(mesh_file_path.c_str(), &srcMesh.pVertices, &srcMesh.pFaceSizes,
+              &srcMesh.pFaceVertexIndices, &srcMesh.numVertices,
+              &srcMesh.numFaces) != 0 ||
+      mioRead(cut_mesh_file_path.c_str(), &cutMesh.pVertices,
+              &cutMesh.pFaceSizes, &cutMesh.pFaceVertexIndices,
+              &cutMesh.numVertices, &cutMesh.numFaces) != 0) {
+    throw std::runtime_error("failed to read " + mesh_file_path + " or " +
+                             cut_mesh_file_path);
+  }
+  read_stage.stop();
 
   //
-  // create a context
+  // borrow a context from the process-wide pool
   //
-  McContext context = MC_NULL_HANDLE;
-
-  // a debug context is created in case you load your own (possibly faulty)
-  // meshes
-  McResult status = mcCreateContext(&context, MC_DEBUG);
-
-  my_assert(status == MC_NO_ERROR);
-
-  //
-  // config debug output
-  //
-
-  McSize numBytes = 0;
-  McFlags contextFlags;
-
-  status = mcGetInfo(context, MC_CONTEXT_FLAGS, 0, nullptr, &numBytes);
-
-  my_assert(status == MC_NO_ERROR);
-
-  my_assert(sizeof(McFlags) == numBytes);
-
-  status =
-      mcGetInfo(context, MC_CONTEXT_FLAGS, numBytes, &contextFlags, nullptr);
-
-  my_assert(status == MC_NO_ERROR);
-
-  if (contextFlags & MC_DEBUG) { // did the user enable debugging mode?
-    mcDebugMessageCallback(context, mcDebugOutput, nullptr);
-    mcDebugMessageControl(context, McDebugSource::MC_DEBUG_SOURCE_ALL,
-                          McDebugType::MC_DEBUG_TYPE_ALL,
-                          McDebugSeverity::MC_DEBUG_SEVERITY_ALL, true);
-  }
+  ContextLease lease;
+  const McContext context = lease.get();
 
   //
   //  do the cutting (boolean ops)
   //
 
-  printf("\nInputs: \n\tSolid-A = %s'.\n\tSolid-B = '%s'\n\n",
-         mesh_file_path.c_str(), cut_mesh_file_path.c_str());
-
   // We can either let MCUT compute all possible meshes (including patches
   // etc.), or we can constrain the library runtime to compute exactly the
   // boolean op mesh we want. This 'constrained' case is done with the flags
   // that follow below.
   //
 
-  printf("operation start\n");
-
-  status = mcDispatch(
+  StageTimer dispatch_stage("dispatch");
+  const std::shared_ptr<const DispatchResult> result = dispatchCached(
       context,
       MC_DISPATCH_VERTEX_ARRAY_DOUBLE | // vertices are in array of doubles
           MC_DISPATCH_ENFORCE_GENERAL_POSITION | // perturb if necessary
+          // fragments are only kept for the requested locations, so both
+          // sides of the cut mesh must be asked for explicitly
+          MC_DISPATCH_FILTER_FRAGMENT_LOCATION_ABOVE |
+          MC_DISPATCH_FILTER_FRAGMENT_LOCATION_BELOW |
           MC_DISPATCH_FILTER_FRAGMENT_SEALING_NONE,
       // source mesh
       srcMesh.pVertices, srcMesh.pFaceVertexIndices, srcMesh.pFaceSizes,
       srcMesh.numVertices, srcMesh.numFaces,
       // cut mesh
       cutMesh.pVertices, cutMesh.pFaceVertexIndices, cutMesh.pFaceSizes,
-      cutMesh.numVertices, cutMesh.numFaces);
-
-  my_assert(status == MC_NO_ERROR);
+      cutMesh.numVertices, cutMesh.numFaces,
+      // only the triangulated faces are written out
+      true);
+  dispatch_stage.stop();
 
   //
   // query the number of available fragments
   // NOTE: a boolean operation shall always give fragments as output
   //
 
-  McUint32 connectedComponentCount = 0;
-  status =
-      mcGetConnectedComponents(context, MC_CONNECTED_COMPONENT_TYPE_FRAGMENT, 0,
-                               NULL, &connectedComponentCount);
-  my_assert(status == MC_NO_ERROR);
-
-  if (connectedComponentCount == 0) {
-    fprintf(stdout, "no connected components found\n");
-    exit(0);
+  if (result->fragments().empty()) {
+    throw std::runtime_error("no connected components found");
   }
 
-  std::vector<McConnectedComponent> connectedComponents(connectedComponentCount,
-                                                        MC_NULL_HANDLE);
-
-  status = mcGetConnectedComponents(
-      context, MC_CONNECTED_COMPONENT_TYPE_FRAGMENT,
-      (McUint32)connectedComponents.size(), connectedComponents.data(), NULL);
-
-  my_assert(status == MC_NO_ERROR);
-
-  //
-  // query the data of the output connected component from MCUT
-  //
-
-  McConnectedComponent cc = connectedComponents[0];
-
   //
-  // vertices
+  // the data of the output connected component (computed by MCUT or mapped
+  // from the result cache)
   //
 
-  numBytes = 0;
-  status = mcGetConnectedComponentData(
-      context, cc, MC_CONNECTED_COMPONENT_DATA_VERTEX_DOUBLE, 0, NULL,
-      &numBytes);
+  const DispatchResult::Fragment &cc = result->fragments()[0];
 
-  my_assert(status == MC_NO_ERROR);
-
-  McUint32 ccVertexCount = (McUint32)(numBytes / (sizeof(McDouble) * 3));
-  std::vector<McDouble> ccVertices((McSize)ccVertexCount * 3u, 0);
-  status = mcGetConnectedComponentData(
-      context, cc, MC_CONNECTED_COMPONENT_DATA_VERTEX_DOUBLE, numBytes,
-      (void *)ccVertices.data(), NULL);
-
-  my_assert(status == MC_NO_ERROR);
-
-  //
-  // faces
-  //
-  numBytes = 0;
+  McUint32 ccVertexCount = (McUint32)cc.num_vertices;
+  std::vector<McDouble> ccVertices(cc.vertices,
+                                   cc.vertices + 3 * cc.num_vertices);
 
   // triangulated faces
-  status = mcGetConnectedComponentData(
-      context, cc, MC_CONNECTED_COMPONENT_DATA_FACE_TRIANGULATION, 0, NULL,
-      &numBytes);
-
-  my_assert(status == MC_NO_ERROR);
-
-  std::vector<McUint32> ccFaceIndices(numBytes / sizeof(McUint32), 0);
-  status = mcGetConnectedComponentData(
-      context, cc, MC_CONNECTED_COMPONENT_DATA_FACE_TRIANGULATION, numBytes,
-      ccFaceIndices.data(), NULL);
-
-  my_assert(status == MC_NO_ERROR);
+  std::vector<McUint32> ccFaceIndices(cc.triangles,
+                                      cc.triangles + cc.num_triangle_indices);
 
   std::vector<McUint32> ccFaceSizes(ccFaceIndices.size() / 3, 3);
   /// ------------------------------------------------------------------------------------
 
   // Here we show, how to know when connected components pertain particular
   // boolean operations.
-  McPatchLocation patchLocation = (McPatchLocation)0;
-
-  status = mcGetConnectedComponentData(
-      context, cc, MC_CONNECTED_COMPONENT_DATA_PATCH_LOCATION,
-      sizeof(McPatchLocation), &patchLocation, NULL);
-  my_assert(status == MC_NO_ERROR);
-
-  McFragmentLocation fragmentLocation = (McFragmentLocation)0;
-  status = mcGetConnectedComponentData(
-      context, cc, MC_CONNECTED_COMPONENT_DATA_FRAGMENT_LOCATION,
-      sizeof(McFragmentLocation), &fragmentLocation, NULL);
-  my_assert(status == MC_NO_ERROR);
+  McPatchLocation patchLocation = cc.patch_location;
+  McFragmentLocation fragmentLocation = cc.location;
 
   //
   // reverse the vertex winding order, if required
@@ -236,6 +161,7 @@ void cutMesh(const std::string &mesh_file_path,
                           "_" + extract_fname(cut_mesh_file_path.c_str()) +
                           ".obj");
 
+  StageTimer write_stage("write");
   mioWriteOBJ(fpath.c_str(), ccVertices.data(),
               nullptr, // pNormals
               nullptr, // pTexCoords
@@ -246,85 +172,7 @@ void cutMesh(const std::string &mesh_file_path,
               0, // numNormals
               0, // numTexCoords
               (McUint32)ccFaceSizes.size());
+  write_stage.stop();
 
-  //
-  // free connected component data
-  //
-  status = mcReleaseConnectedComponents(context,
-                                        (McUint32)connectedComponents.size(),
-                                        connectedComponents.data());
-
-  my_assert(status == MC_NO_ERROR);
-
-  //
-  // We no longer need the mem of input meshes, so we can free it!
-  //
-  mioFreeMesh(&srcMesh);
-  mioFreeMesh(&cutMesh);
-
-  //
-  // destroy context
-  //
-  status = mcReleaseContext(context);
-
-  my_assert(status == MC_NO_ERROR);
-}
-
-void MCAPI_PTR mcDebugOutput(McDebugSource source, McDebugType type,
-                             McUint32 id, McDebugSeverity severity,
-                             size_t length, const char *message,
-                             const void *userParam) {
-  std::string debug_src;
-  switch (source) {
-  case MC_DEBUG_SOURCE_API:
-    debug_src = "API";
-    break;
-  case MC_DEBUG_SOURCE_KERNEL:
-    debug_src = "KERNEL";
-    break;
-  case MC_DEBUG_SOURCE_FRONTEND:
-    debug_src = "FRONTEND";
-  case MC_DEBUG_SOURCE_ALL:
-  case MC_DEBUG_SOURCE_IGNORE:
-    break;
-  }
-
-  std::string debug_type;
-  switch (type) {
-  case MC_DEBUG_TYPE_ERROR:
-    debug_type = "ERROR";
-    break;
-  case MC_DEBUG_TYPE_DEPRECATED_BEHAVIOR:
-    debug_type = "DEPRECATION";
-    break;
-  case MC_DEBUG_TYPE_OTHER:
-    // printf("Type: Other");
-    debug_type = "OTHER";
-    break;
-  case MC_DEBUG_TYPE_ALL:
-  case MC_DEBUG_TYPE_IGNORE:
-    break;
-  }
-
-  std::string severity_str;
-
-  switch (severity) {
-  case MC_DEBUG_SEVERITY_HIGH:
-    severity_str = "HIGH";
-    break;
-  case MC_DEBUG_SEVERITY_MEDIUM:
-    severity_str = "MEDIUM";
-    break;
-  case MC_DEBUG_SEVERITY_LOW:
-    severity_str = "LOW";
-    break;
-  case MC_DEBUG_SEVERITY_NOTIFICATION:
-    severity_str = "NOTIFICATION";
-    break;
-  case MC_DEBUG_SEVERITY_ALL:
-    break;
-  }
-
-  printf("MCUT[%d:%p,%s:%s:%s:%zu] %s\n", id, userParam, debug_src.c_str(),
-         debug_type.c_str(), severity_str.c_str(), length, message);
+  // the input meshes are freed by src_guard / cut_guard
 }
@@ -0,0 +1,566 @@
+#include "decimate.h"
+#include "region_growing.h"
+#include "stats.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+
+namespace {
+
+using Vec3 = std::array<double, 3>;
+
+// 对称4x4误差矩阵的上三角部分：
+// [q0 q1 q2 q3; q1 q4 q5 q6; q2 q5 q7 q8; q3 q6 q8 q9]
+using Quadric = std::array<double, 10>;
+
+// 边界约束平面的权重，相对于面片平面
+const double BOUNDARY_WEIGHT = 1000.0;
+
+inline Vec3 sub(const Vec3 &a, const Vec3 &b) {
+  return {a[0] - b[0], a[1] - b[1], a[2] - b[2]};
+}
+
+inline Vec3 add(const Vec3 &a, const Vec3 &b) {
+  return {a[0] + b[0], a[1] + b[1], a[2] + b[2]};
+}
+
+inline Vec3 scale(const Vec3 &a, const double s) {
+  return {a[0] * s, a[1] * s, a[2] * s};
+}
+
+inline double dot(const Vec3 &a, const Vec3 &b) {
+  return a[0] * b[0] + a[1] * b[1] + a[2] * b[2];
+}
+
+inline Vec3 cross(const Vec3 &a, const Vec3 &b) {
+  return {a[1] * b[2] - a[2] * b[1], a[2] * b[0] - a[0] * b[2],
+          a[0] * b[1] - a[1] * b[0]};
+}
+
+// 单位法向为n、过点p的平面乘以权重w得到的误差矩阵
+inline Quadric plane_quadric(const Vec3 &n, const Vec3 &p, const double w) {
+  const double d = -dot(n, p);
+  return {w * n[0] * n[0], w * n[0] * n[1], w * n[0] * n[2], w * n[0] * d,
+          w * n[1] * n[1], w * n[1] * n[2], w * n[1] * d,    w * n[2] * n[2],
+          w * n[2] * d,    w * d * d};
+}
+
+inline void add_quadric(Quadric &a, const Quadric &b) {
+  for (size_t i = 0; i < a.size(); ++i) {
+    a[i] += b[i];
+  }
+}
+
+inline double quadric_error(const Quadric &q, const Vec3 &p) {
+  const double x = p[0], y = p[1], z = p[2];
+  return q[0] * x * x + 2.0 * q[1] * x * y + 2.0 * q[2] * x * z +
+         2.0 * q[3] * x + q[4] * y * y + 2.0 * q[5] * y * z + 2.0 * q[6] * y +
+         q[7] * z * z + 2.0 * q[8] * z + q[9];
+}
+
+// 求误差最小的位置，矩阵接近奇异时返回false
+inline bool optimal_position(const Quadric &q, Vec3 &p) {
+  const double c00 = q[4] * q[7] - q[5] * q[5];
+  const double c01 = q[2] * q[5] - q[1] * q[7];
+  const double c02 = q[1] * q[5] - q[2] * q[4];
+  const double det = q[0] * c00 + q[1] * c01 + q[2] * c02;
+
+  const double trace = std::abs(q[0]) + std::abs(q[4]) + std::abs(q[7]);
+  if (std::abs(det) <= 1e-12 * trace * trace * trace) {
+    return false;
+  }
+
+  const double c11 = q[0] * q[7] - q[2] * q[2];
+  const double c12 = q[1] * q[2] - q[0] * q[5];
+  const double c22 = q[0] * q[4] - q[1] * q[1];
+  const Vec3 b = {-q[3], -q[6], -q[8]};
+  const double inv_det = 1.0 / det;
+  p = {(c00 * b[0] + c01 * b[1] + c02 * b[2]) * inv_det,
+       (c01 * b[0] + c11 * b[1] + c12 * b[2]) * inv_det,
+       (c02 * b[0] + c12 * b[1] + c22 * b[2]) * inv_det};
+  return true;
+}
+
+struct EdgeCollapse {
+  size_t a;
+  size_t b;
+  double cost;
+  Vec3 position;
+};
+
+class Decimator {
+public:
+  Decimator(const std::vector<std::array<double, 3>> &vertices,
+            const std::vector<std::array<size_t, 3>> &faces)
+      : positions_(vertices), faces_(faces),
+        quadrics_(vertices.size(), Quadric{}),
+        face_alive_(faces.size(), 1), vertex_faces_(vertices.size()),
+        boundary_(vertices.size(), 0), parent_(vertices.size()),
+        alive_face_num_(faces.size()) {
+    std::iota(parent_.begin(), parent_.end(), 0);
+
+    for (size_t i = 0; i < faces_.size(); ++i) {
+      for (const size_t v : faces_[i]) {
+        if (v >= positions_.size()) {
+          throw std::runtime_error("face vertex index out of range");
+        }
+        vertex_faces_[v].push_back(i);
+      }
+    }
+
+    initQuadrics();
+  }
+
+  void run(const size_t target_face_num) {
+    while (alive_face_num_ > target_face_num) {
+      if (collapseRound(target_face_num) == 0) {
+        break;
+      }
+    }
+  }
+
+  ProxyMesh build(const std::vector<std::array<double, 3>> &vertices) {
+    ProxyMesh proxy;
+
+    // 压缩存活的顶点与面片
+    std::vector<size_t> vertex_index(positions_.size(),
+                                     std::numeric_limits<size_t>::max());
+    std::vector<size_t> face_index(faces_.size(),
+                                   std::numeric_limits<size_t>::max());
+    for (size_t i = 0; i < faces_.size(); ++i) {
+      if (!face_alive_[i]) {
+        continue;
+      }
+      std::array<size_t, 3> face;
+      for (size_t j = 0; j < 3; ++j) {
+        size_t &idx = vertex_index[faces_[i][j]];
+        if (idx == std::numeric_limits<size_t>::max()) {
+          idx = proxy.vertices.size();
+          proxy.vertices.push_back(positions_[faces_[i][j]]);
+        }
+        face[j] = idx;
+      }
+      face_index[i] = proxy.faces.size();
+      proxy.faces.push_back(face);
+    }
+
+    proxy.face_map.assign(faces_.size(), 0);
+    if (proxy.faces.empty()) {
+      return proxy;
+    }
+
+    // 每个原始顶点最终折叠到的顶点
+    std::vector<size_t> root(parent_.size());
+    for (size_t v = 0; v < parent_.size(); ++v) {
+      root[v] = findRoot(v);
+    }
+
+    // 代理面片质心KD树，仅在折叠顶点周围没有存活面片时兜底使用
+    PointCloud cloud;
+    cloud.points.resize(proxy.faces.size());
+    for (size_t i = 0; i < proxy.faces.size(); ++i) {
+      const auto &face = proxy.faces[i];
+      cloud.points[i] = scale(add(add(proxy.vertices[face[0]],
+                                      proxy.vertices[face[1]]),
+                                  proxy.vertices[face[2]]),
+                              1.0 / 3.0);
+    }
+
+    using KDTreeType = nanoflann::KDTreeSingleIndexAdaptor<
+        nanoflann::L2_Simple_Adaptor<double, PointCloud>, PointCloud, 3>;
+
+    KDTreeType index(3, cloud, {10});
+    index.buildIndex();
+
+    // 原始面片映射到其顶点折叠后周围质心最近的代理面片
+#pragma omp parallel for schedule(dynamic, 1024)
+    for (int64_t i = 0; i < static_cast<int64_t>(faces_.size()); ++i) {
+      const auto &face = faces_[i];
+      const Vec3 centroid = scale(
+          add(add(vertices[face[0]], vertices[face[1]]), vertices[face[2]]),
+          1.0 / 3.0);
+
+      size_t best_face = std::numeric_limits<size_t>::max();
+      double best_dist = std::numeric_limits<double>::max();
+      for (const size_t v : face) {
+        for (const size_t f : vertex_faces_[root[v]]) {
+          if (!face_alive_[f]) {
+            continue;
+          }
+          const Vec3 d = sub(cloud.points[face_index[f]], centroid);
+          const double dist = dot(d, d);
+          if (dist < best_dist) {
+            best_dist = dist;
+            best_face = face_index[f];
+          }
+        }
+      }
+
+      if (best_face == std::numeric_limits<size_t>::max()) {
+        uint32_t ret_index = 0;
+        double out_dist_sqr = 0.0;
+        index.knnSearch(centroid.data(), 1, &ret_index, &out_dist_sqr);
+        best_face = ret_index;
+      }
+
+      proxy.face_map[i] = best_face;
+    }
+
+    return proxy;
+  }
+
+private:
+  void initQuadrics() {
+    // 面片平面误差按面积加权
+    std::vector<Quadric> face_quadrics(faces_.size());
+#pragma omp parallel for
+    for (int64_t i = 0; i < static_cast<int64_t>(faces_.size()); ++i) {
+      const auto &face = faces_[i];
+      const Vec3 n = cross(sub(positions_[face[1]], positions_[face[0]]),
+                           sub(positions_[face[2]], positions_[face[0]]));
+      const double len = std::sqrt(dot(n, n));
+      face_quadrics[i] =
+          len > 0.0 ? plane_quadric(scale(n, 1.0 / len), positions_[face[0]],
+                                    0.5 * len)
+                    : Quadric{};
+    }
+
+#pragma omp parallel for
+    for (int64_t v = 0; v < static_cast<int64_t>(positions_.size()); ++v) {
+      for (const size_t f : vertex_faces_[v]) {
+        add_quadric(quadrics_[v], face_quadrics[f]);
+      }
+    }
+
+    // 只属于一个面片的边为边界边，加上过该边且垂直于面片的约束平面
+    std::vector<std::array<size_t, 3>> edges;
+    edges.reserve(faces_.size() * 3);
+    for (size_t i = 0; i < faces_.size(); ++i) {
+      for (size_t j = 0; j < 3; ++j) {
+        const size_t a = faces_[i][j];
+        const size_t b = faces_[i][(j + 1) % 3];
+        edges.push_back({std::min(a, b), std::max(a, b), i});
+      }
+    }
+    std::sort(edges.begin(), edges.end());
+
+    for (size_t i = 0; i < edges.size();) {
+      size_t j = i + 1;
+      while (j < edges.size() && edges[j][0] == edges[i][0] &&
+             edges[j][1] == edges[i][1]) {
+        ++j;
+      }
+
+      if (j - i == 1) {
+        const size_t a = edges[i][0];
+        const size_t b = edges[i][1];
+        const auto &face = faces_[edges[i][2]];
+        const Vec3 e = sub(positions_[b], positions_[a]);
+        const Vec3 fn = cross(sub(positions_[face[1]], positions_[face[0]]),
+                              sub(positions_[face[2]], positions_[face[0]]));
+        const Vec3 n = cross(e, fn);
+        const double len = std::sqrt(dot(n, n));
+        if (len > 0.0) {
+          const Quadric q = plane_quadric(scale(n, 1.0 / len), positions_[a],
+                                          BOUNDARY_WEIGHT * dot(e, e));
+          add_quadric(quadrics_[a], q);
+          add_quadric(quadrics_[b], q);
+        }
+        boundary_[a] = 1;
+        boundary_[b] = 1;
+      }
+
+      i = j;
+    }
+  }
+
+  size_t findRoot(size_t v) {
+    size_t r = v;
+    while (parent_[r] != r) {
+      r = parent_[r];
+    }
+    while (parent_[v] != r) {
+      const size_t next = parent_[v];
+      parent_[v] = r;
+      v = next;
+    }
+    return r;
+  }
+
+  EdgeCollapse evaluate(const size_t a, const size_t b) const {
+    Quadric q = quadrics_[a];
+    add_quadric(q, quadrics_[b]);
+
+    EdgeCollapse collapse{a, b, 0.0, {}};
+    if (optimal_position(q, collapse.position)) {
+      collapse.cost = quadric_error(q, collapse.position);
+      return collapse;
+    }
+
+    // 矩阵奇异时在两个端点与中点中取误差最小者
+    const Vec3 candidates[3] = {positions_[a], positions_[b],
+                                scale(add(positions_[a], positions_[b]), 0.5)};
+    collapse.cost = std::numeric_limits<double>::max();
+    for (const Vec3 &p : candidates) {
+      const double cost = quadric_error(q, p);
+      if (cost < collapse.cost) {
+        collapse.cost = cost;
+        collapse.position = p;
+      }
+    }
+    return collapse;
+  }
+
+  void neighbours(const size_t v, std::vector<size_t> &result) const {
+    result.clear();
+    for (const size_t f : vertex_faces_[v]) {
+      if (!face_alive_[f]) {
+        continue;
+      }
+      for (const size_t u : faces_[f]) {
+        if (u != v) {
+          result.push_back(u);
+        }
+      }
+    }
+    std::sort(result.begin(), result.end());
+    result.erase(std::unique(result.begin(), result.end()), result.end());
+  }
+
+  bool canCollapse(const EdgeCollapse &c) {
+    size_t shared_faces = 0;
+    for (const size_t f : vertex_faces_[c.a]) {
+      if (face_alive_[f] && std::find(faces_[f].begin(), faces_[f].end(),
+                                      c.b) != faces_[f].end()) {
+        ++shared_faces;
+      }
+    }
+
+    // 两个边界顶点之间的内部边折叠后会把边界捏合成非流形顶点
+    if (boundary_[c.a] && boundary_[c.b] && shared_faces != 1) {
+      return false;
+    }
+
+    // 连接条件：两端点的公共邻点只能是共享面片的第三个顶点
+    neighbours(c.a, ring_a_);
+    neighbours(c.b, ring_b_);
+    common_.clear();
+    std::set_intersection(ring_a_.begin(), ring_a_.end(), ring_b_.begin(),
+                          ring_b_.end(), std::back_inserter(common_));
+    if (common_.size() != shared_faces) {
+      return false;
+    }
+
+    // 折叠后不能有面片翻转或退化
+    for (const size_t v : {c.a, c.b}) {
+      const size_t other = v == c.a ? c.b : c.a;
+      for (const size_t f : vertex_faces_[v]) {
+        if (!face_alive_[f]) {
+          continue;
+        }
+        const auto &face = faces_[f];
+        if (std::find(face.begin(), face.end(), other) != face.end()) {
+          continue;
+        }
+
+        Vec3 p[3];
+        for (size_t j = 0; j < 3; ++j) {
+          p[j] = positions_[face[j]];
+        }
+        const Vec3 n_old = cross(sub(p[1], p[0]), sub(p[2], p[0]));
+        for (size_t j = 0; j < 3; ++j) {
+          if (face[j] == v) {
+            p[j] = c.position;
+          }
+        }
+        const Vec3 n_new = cross(sub(p[1], p[0]), sub(p[2], p[0]));
+        if (dot(n_old, n_new) <= 0.0) {
+          return false;
+        }
+      }
+    }
+
+    return true;
+  }
+
+  // 将b折叠到a，并锁定新顶点的一环邻域，保证同一轮的折叠互不影响
+  void collapse(const EdgeCollapse &c, std::vector<char> &locked) {
+    positions_[c.a] = c.position;
+    add_quadric(quadrics_[c.a], quadrics_[c.b]);
+    boundary_[c.a] = boundary_[c.a] || boundary_[c.b];
+    parent_[c.b] = c.a;
+
+    for (const size_t f : vertex_faces_[c.b]) {
+      if (!face_alive_[f]) {
+        continue;
+      }
+      auto &face = faces_[f];
+      if (std::find(face.begin(), face.end(), c.a) != face.end()) {
+        face_alive_[f] = 0;
+        --alive_face_num_;
+        continue;
+      }
+      for (size_t &v : face) {
+        if (v == c.b) {
+          v = c.a;
+        }
+      }
+      vertex_faces_[c.a].push_back(f);
+    }
+    std::vector<size_t>().swap(vertex_faces_[c.b]);
+
+    auto &faces_of_a = vertex_faces_[c.a];
+    faces_of_a.erase(std::remove_if(faces_of_a.begin(), faces_of_a.end(),
+                                    [this](const size_t f) {
+                                      return !face_alive_[f];
+                                    }),
+                     faces_of_a.end());
+
+    locked[c.a] = 1;
+    locked[c.b] = 1;
+    for (const size_t f : faces_of_a) {
+      for (const size_t v : faces_[f]) {
+        locked[v] = 1;
+      }
+    }
+  }
+
+  size_t collapseRound(const size_t target_face_num) {
+    // 清理顶点面片表中已删除的面片
+#pragma omp parallel for schedule(dynamic, 1024)
+    for (int64_t v = 0; v < static_cast<int64_t>(vertex_faces_.size()); ++v) {
+      auto &vf = vertex_faces_[v];
+      vf.erase(std::remove_if(
+                   vf.begin(), vf.end(),
+                   [this](const size_t f) { return !face_alive_[f]; }),
+               vf.end());
+    }
+
+    std::vector<std::pair<size_t, size_t>> edges;
+    edges.reserve(alive_face_num_ * 3);
+    for (size_t i = 0; i < faces_.size(); ++i) {
+      if (!face_alive_[i]) {
+        continue;
+      }
+      for (size_t j = 0; j < 3; ++j) {
+        const size_t a = faces_[i][j];
+        const size_t b = faces_[i][(j + 1) % 3];
+        edges.emplace_back(std::min(a, b), std::max(a, b));
+      }
+    }
+    std::sort(edges.begin(), edges.end());
+    edges.erase(std::unique(edges.begin(), edges.end()), edges.end());
+
+    std::vector<EdgeCollapse> collapses(edges.size());
+#pragma omp parallel for
+    for (int64_t i = 0; i < static_cast<int64_t>(edges.size()); ++i) {
+      collapses[i] = evaluate(edges[i].first, edges[i].second);
+    }
+    std::sort(collapses.begin(), collapses.end(),
+              [](const EdgeCollapse &x, const EdgeCollapse &y) {
+                return x.cost < y.cost;
+              });
+
+    std::vector<char> locked(positions_.size(), 0);
+    size_t collapsed_num = 0;
+    for (const auto &c : collapses) {
+      if (alive_face_num_ <= target_face_num) {
+        break;
+      }
+      if (locked[c.a] || locked[c.b] || !canCollapse(c)) {
+        continue;
+      }
+      collapse(c, locked);
+      ++collapsed_num;
+    }
+
+    return collapsed_num;
+  }
+
+  std::vector<Vec3> positions_;
+  std::vector<std::array<size_t, 3>> faces_;
+  std::vector<Quadric> quadrics_;
+  std::vector<char> face_alive_;
+  std::vector<std::vector<size_t>> vertex_faces_;
+  std::vector<char> boundary_;
+  std::vector<size_t> parent_;
+  size_t alive_face_num_;
+
+  // canCollapse的临时缓冲
+  std::vector<size_t> ring_a_;
+  std::vector<size_t> ring_b_;
+  std::vector<size_t> common_;
+};
+
+} // namespace
+
+ProxyMesh decimate_to_proxy(const std::vector<std::array<double, 3>> &vertices,
+                            const std::vector<std::array<size_t, 3>> &faces,
+                            const size_t &target_face_num) {
+  StageTimer stage("decimate_to_proxy");
+
+  if (target_face_num == 0) {
+    throw std::runtime_error("target_face_num must be positive");
+  }
+
+  StageTimer collapse_stage("collapse");
+  Decimator decimator(vertices, faces);
+  decimator.run(target_face_num);
+  collapse_stage.stop();
+
+  StageTimer build_stage("build");
+  ProxyMesh proxy = decimator.build(vertices);
+  build_stage.stop();
+
+  recordCount("proxy_input_faces", faces.size());
+  recordCount("proxy_faces", proxy.faces.size());
+  return proxy;
+}
+
+std::vector<std::vector<size_t>>
+project_proxy_face_groups(const ProxyMesh &proxy,
+                          const std::vector<std::vector<size_t>> &proxy_face_groups) {
+  StageTimer stage("project_proxy_face_groups");
+
+  // 代理面片到原始面片的反向映射（CSR）
+  std::vector<size_t> offsets(proxy.faces.size() + 1, 0);
+  for (const size_t p : proxy.face_map) {
+    if (p >= proxy.faces.size()) {
+      throw std::runtime_error("face_map index out of range");
+    }
+    ++offsets[p + 1];
+  }
+  for (size_t i = 0; i < proxy.faces.size(); ++i) {
+    offsets[i + 1] += offsets[i];
+  }
+  std::vector<size_t> original_faces(proxy.face_map.size());
+  std::vector<size_t> cursor(offsets.begin(), offsets.end() - 1);
+  for (size_t i = 0; i < proxy.face_map.size(); ++i) {
+    original_faces[cursor[proxy.face_map[i]]++] = i;
+  }
+
+  for (const auto &group : proxy_face_groups) {
+    for (const size_t p : group) {
+      if (p >= proxy.faces.size()) {
+        throw std::runtime_error("proxy face index out of range");
+      }
+    }
+  }
+
+  std::vector<std::vector<size_t>> face_groups(proxy_face_groups.size());
+#pragma omp parallel for schedule(dynamic)
+  for (int64_t i = 0; i < static_cast<int64_t>(proxy_face_groups.size());
+       ++i) {
+    auto &group = face_groups[i];
+    for (const size_t p : proxy_face_groups[i]) {
+      group.insert(group.end(), original_faces.begin() + offsets[p],
+                   original_faces.begin() + offsets[p + 1]);
+    }
+  }
+
+  return face_groups;
+}
@@ -0,0 +1,239 @@
+#include "mesh_cache.h"
+#include "stats.h"
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <stdexcept>
+#include <unistd.h>
+#include <vector>
+
+namespace {
+
+// 网格文件的大小与修改时间，用于判断缓存是否过期；文件无法访问时返回false
+bool sourceStamp(const std::string &mesh_file_path,
+                 unsigned long long stamp[2]) {
+  std::error_code ec;
+  stamp[0] = std::filesystem::file_size(mesh_file_path, ec);
+  if (ec) {
+    return false;
+  }
+  const std::filesystem::file_time_type time =
+      std::filesystem::last_write_time(mesh_file_path, ec);
+  if (ec) {
+    return false;
+  }
+  stamp[1] = static_cast<unsigned long long>(time.time_since_epoch().count());
+  return true;
+}
+
+// FNV-1a，仅用于生成缓存文件名
+uint64_t hashPath(const std::string &path) {
+  uint64_t hash = 1469598103934665603ull;
+  for (const unsigned char c : path) {
+    hash ^= c;
+    hash *= 1099511628211ull;
+  }
+  return hash;
+}
+
+std::string cachePath(const std::string &mesh_file_path,
+                      const std::string &cache_dir) {
+  const std::filesystem::path source =
+      std::filesystem::absolute(mesh_file_path).lexically_normal();
+  if (cache_dir.empty()) {
+    return source.string() + ".mbin";
+  }
+
+  char hash[17];
+  std::snprintf(hash, sizeof(hash), "%016llx",
+                static_cast<unsigned long long>(hashPath(source.string())));
+  return (std::filesystem::path(cache_dir) /
+          (source.stem().string() + "_" + hash + ".mbin"))
+      .string();
+}
+
+} // namespace
+
+MappedMesh::~MappedMesh() { mioUnmapMBIN(&mesh_); }
+
+std::shared_ptr<MappedMesh>
+MappedMesh::map(const std::string &cache_file_path) {
+  std::shared_ptr<MappedMesh> mapped(new MappedMesh);
+  if (mioMapMBIN(cache_file_path.c_str(), &mapped->mesh_) != 0) {
+    return nullptr;
+  }
+  return mapped;
+}
+
+void convertMeshToCache(const std::string &mesh_file_path,
+                        const std::string &cache_file_path,
+                        const bool &with_vertex_faces) {
+  // 先记录时间戳再读取，读取期间文件被修改时缓存会被视为过期
+  unsigned long long stamp[2];
+  const bool stamped = sourceStamp(mesh_file_path, stamp);
+
+  const std::filesystem::path parent =
+      std::filesystem::path(cache_file_path).parent_path();
+  if (!parent.empty()) {
+    std::filesystem::create_directories(parent);
+  }
+
+  MioMesh source = {
+      nullptr, // pVertices
+      nullptr, // pNormals
+      nullptr, // pTexCoords
+      nullptr, // pFaceSizes
+      nullptr, // pFaceVertexIndices
+      nullptr, // pFaceVertexTexCoordIndices
+      nullptr, // pFaceVertexNormalIndices
+      0,       // numVertices
+      0,       // numNormals
+      0,       // numTexCoords
+      0,       // numFaces
+  };
+
+  if (mioRead(mesh_file_path.c_str(), &source.pVertices, &source.pFaceSizes,
+              &source.pFaceVertexIndices, &source.numVertices,
+              &source.numFaces) != 0 ||
+      !stamped) {
+    mioFreeMesh(&source);
+    throw std::runtime_error("failed to read " + mesh_file_path);
+  }
+
+  const size_t num_vertices = source.numVertices;
+
+  // 多边形按扇形三角化
+  std::vector<uint32_t> triangles;
+  triangles.reserve(3 * static_cast<size_t>(source.numFaces));
+  size_t offset = 0;
+  for (uint32_t f = 0; f < source.numFaces; ++f) {
+    const uint32_t size =
+        source.pFaceSizes != nullptr ? source.pFaceSizes[f] : 3;
+    const uint32_t *face = source.pFaceVertexIndices + offset;
+    offset += size;
+    for (uint32_t k = 2; k < size; ++k) {
+      triangles.insert(triangles.end(), {face[0], face[k - 1], face[k]});
+    }
+  }
+  const size_t num_faces = triangles.size() / 3;
+
+  for (const uint32_t &v : triangles) {
+    if (v >= num_vertices) {
+      mioFreeMesh(&source);
+      throw std::runtime_error("vertex index out of range in " +
+                               mesh_file_path);
+    }
+  }
+
+  // 面积加权的顶点法线：累加未归一化的面法线后归一化
+  std::vector<double> normals(3 * num_vertices, 0.0);
+  for (size_t f = 0; f < num_faces; ++f) {
+    const double *p0 = source.pVertices + 3 * triangles[3 * f];
+    const double *p1 = source.pVertices + 3 * triangles[3 * f + 1];
+    const double *p2 = source.pVertices + 3 * triangles[3 * f + 2];
+    const double e1[3] = {p1[0] - p0[0], p1[1] - p0[1], p1[2] - p0[2]};
+    const double e2[3] = {p2[0] - p0[0], p2[1] - p0[1], p2[2] - p0[2]};
+    const double n[3] = {e1[1] * e2[2] - e1[2] * e2[1],
+                         e1[2] * e2[0] - e1[0] * e2[2],
+                         e1[0] * e2[1] - e1[1] * e2[0]};
+    for (int k = 0; k < 3; ++k) {
+      double *normal = normals.data() + 3 * triangles[3 * f + k];
+      normal[0] += n[0];
+      normal[1] += n[1];
+      normal[2] += n[2];
+    }
+  }
+  for (size_t v = 0; v < num_vertices; ++v) {
+    double *normal = normals.data() + 3 * v;
+    const double length = std::sqrt(normal[0] * normal[0] +
+                                    normal[1] * normal[1] +
+                                    normal[2] * normal[2]);
+    if (length > 0.0) {
+      normal[0] /= length;
+      normal[1] /= length;
+      normal[2] /= length;
+    }
+  }
+
+  std::vector<uint32_t> vertex_face_offsets;
+  std::vector<uint32_t> vertex_faces;
+  if (with_vertex_faces) {
+    vertex_face_offsets.assign(num_vertices + 1, 0);
+    for (const uint32_t &v : triangles) {
+      vertex_face_offsets[v + 1]++;
+    }
+    for (size_t v = 0; v < num_vertices; ++v) {
+      vertex_face_offsets[v + 1] += vertex_face_offsets[v];
+    }
+    vertex_faces.resize(triangles.size());
+    std::vector<uint32_t> cursor(vertex_face_offsets.begin(),
+                                 vertex_face_offsets.end() - 1);
+    for (size_t f = 0; f < num_faces; ++f) {
+      for (int k = 0; k < 3; ++k) {
+        vertex_faces[cursor[triangles[3 * f + k]]++] =
+            static_cast<uint32_t>(f);
+      }
+    }
+  }
+
+  static std::atomic<uint64_t> counter(0);
+  const std::string temp = cache_file_path + "." + std::to_string(getpid()) +
+                           "." + std::to_string(counter.fetch_add(1)) +
+                           ".tmp";
+  const int status = mioWriteMBIN(
+      temp.c_str(), source.pVertices, normals.data(), nullptr,
+      triangles.data(),
+      with_vertex_faces ? vertex_face_offsets.data() : nullptr,
+      with_vertex_faces ? vertex_faces.data() : nullptr,
+      static_cast<unsigned int>(num_vertices),
+      static_cast<unsigned int>(num_faces), stamp);
+  mioFreeMesh(&source);
+
+  std::error_code ec;
+  if (status != 0) {
+    std::filesystem::remove(temp, ec);
+    throw std::runtime_error("failed to write " + cache_file_path);
+  }
+  std::filesystem::rename(temp, cache_file_path, ec);
+  if (ec) {
+    std::filesystem::remove(temp, ec);
+    throw std::runtime_error("failed to write " + cache_file_path);
+  }
+}
+
+std::shared_ptr<MappedMesh> loadMeshCached(const std::string &mesh_file_path,
+                                           const std::string &cache_dir,
+                                           const bool &with_vertex_faces) {
+  StageTimer stage("loadMeshCached");
+
+  unsigned long long stamp[2];
+  if (!std::filesystem::is_regular_file(mesh_file_path) ||
+      !sourceStamp(mesh_file_path, stamp)) {
+    throw std::runtime_error("mesh file not found: " + mesh_file_path);
+  }
+
+  const std::string cache_file_path = cachePath(mesh_file_path, cache_dir);
+
+  std::shared_ptr<MappedMesh> mapped = MappedMesh::map(cache_file_path);
+  if (mapped && mapped->mesh().sourceStamp[0] == stamp[0] &&
+      mapped->mesh().sourceStamp[1] == stamp[1] &&
+      (!with_vertex_faces || mapped->hasVertexFaces())) {
+    recordCount("mesh_cache_hits", 1);
+    return mapped;
+  }
+  mapped.reset();
+
+  StageTimer convert_stage("convert");
+  convertMeshToCache(mesh_file_path, cache_file_path, with_vertex_faces);
+  convert_stage.stop();
+  recordCount("mesh_cache_misses", 1);
+
+  mapped = MappedMesh::map(cache_file_path);
+  if (!mapped) {
+    throw std::runtime_error("failed to map " + cache_file_path);
+  }
+  return mapped;
+}
@@ -1,16 +1,16 @@
 #include "region_growing.h"
+#include "stats.h"
+#include <cmath>
+#include <cstdint>
 #include <iostream>
+#include <numeric>
+#include <stdexcept>
+#include <tuple>
 
-const double
-compute_min_radius_cover_all(const std::vector<std::array<double, 3>> &vertices,
-                             const std::vector<size_t> &seed_indices) {
-  // 构建点云数据
-  PointCloud cloud;
-  cloud.points.reserve(seed_indices.size());
-  for (size_t idx : seed_indices) {
-    cloud.points.push_back(vertices[idx]);
-  }
-
+// 计算覆盖所有顶点的最小半径，cloud为种子点坐标
+static double
+min_radius_cover_all(const std::vector<std::array<double, 3>> &vertices,
+                     const PointCloud &cloud) {
   // 构建KD树
   using KDTreeType = nanoflann::KDTreeSingleIndexAdaptor<
       nanoflann::L2_Simple_Adaptor<double, PointCloud>, PointCloud, 3>;
@@ -19,19 +19,34 @@ compute_min_radius_cover_all(const std::vector<std::array<double, 3>> &vertices,
   index.buildIndex();
 
   double max_min_dist = 0.0;
-  std::vector<uint32_t> ret_index(1);
-  std::vector<double> out_dist_sqr(1);
 
   // 对每个顶点，找到最近的种子点
-  for (size_t i = 0; i < vertices.size(); ++i) {
-    const double query_pt[3] = {vertices[i][0], vertices[i][1], vertices[i][2]};
-    index.knnSearch(query_pt, 1, ret_index.data(), out_dist_sqr.data());
-    max_min_dist = std::max(max_min_dist, out_dist_sqr[0]);
+#pragma omp parallel for reduction(max : max_min_dist)
+  for (int64_t i = 0; i < static_cast<int64_t>(vertices.size()); ++i) {
+    uint32_t ret_index = 0;
+    double out_dist_sqr = 0.0;
+    index.knnSearch(vertices[i].data(), 1, &ret_index, &out_dist_sqr);
+    max_min_dist = std::max(max_min_dist, out_dist_sqr);
   }
 
   return std::sqrt(max_min_dist);
 }
 
+const double
+compute_min_radius_cover_all(const std::vector<std::array<double, 3>> &vertices,
+                             const std::vector<size_t> &seed_indices) {
+  StageTimer stage("compute_min_radius_cover_all");
+
+  // 构建点云数据
+  PointCloud cloud;
+  cloud.points.reserve(seed_indices.size());
+  for (size_t idx : seed_indices) {
+    cloud.points.push_back(vertices[idx]);
+  }
+
+  return min_radius_cover_all(vertices, cloud);
+}
+
 const std::vector<std::vector<size_t>>
 build_vertex_to_face_map(const std::vector<std::array<size_t, 3>> &faces,
                          size_t num_vertices) {
@@ -53,34 +68,43 @@ double distance_squared(const std::array<double, 3> &p1,
   return dx * dx + dy * dy + dz * dz;
 }
 
-const std::vector<size_t> find_connected_faces(
-    size_t center_idx, const std::vector<std::array<double, 3>> &vertices,
+// 没有种子面片时的占位值
+static const size_t NO_SEED_FACE = std::numeric_limits<size_t>::max();
+
+// 从start_vertices开始，查找与球心center在radius内连通的所有面片
+static std::vector<size_t> grow_connected_faces(
+    const std::array<double, 3> &center,
+    const std::vector<size_t> &start_vertices, const size_t seed_face,
+    const std::vector<std::array<double, 3>> &vertices,
     const std::vector<std::array<size_t, 3>> &faces,
     const std::vector<std::vector<size_t>> &vertex_to_faces, double radius) {
   double radius_squared = radius * radius;
-  const auto &center = vertices[center_idx];
 
-  // 找到球内的顶点
-  std::unordered_set<size_t> vertices_in_ball;
-  for (size_t i = 0; i < vertices.size(); ++i) {
-    if (distance_squared(vertices[i], center) <= radius_squared) {
-      vertices_in_ball.insert(i);
-    }
-  }
+  // 只对搜索到的顶点判断是否在球内，不必遍历全部顶点
+  const auto in_ball = [&](const size_t vertex_idx) {
+    return distance_squared(vertices[vertex_idx], center) <= radius_squared;
+  };
 
   std::unordered_set<size_t> connected_faces;
   std::unordered_set<size_t> visited_vertices;
   std::queue<size_t> vertex_queue;
 
-  // 从中心点开始BFS
-  vertex_queue.push(center_idx);
+  // 从起始顶点开始BFS
+  for (size_t vertex_idx : start_vertices) {
+    vertex_queue.push(vertex_idx);
+  }
+
+  // 种子所在面片总属于该区域（粗网格上其顶点可能都不在球内）
+  if (seed_face != NO_SEED_FACE) {
+    connected_faces.insert(seed_face);
+  }
 
   while (!vertex_queue.empty()) {
     size_t current_vertex = vertex_queue.front();
     vertex_queue.pop();
 
     if (visited_vertices.count(current_vertex) > 0 ||
-        vertices_in_ball.count(current_vertex) == 0) {
+        !in_ball(current_vertex)) {
       continue;
     }
 
@@ -93,7 +117,7 @@ const std::vector<size_t> find_connected_faces(
       // 检查面片的所有顶点是否都在球内
       bool any_vertices_in_ball = false;
       for (size_t vertex_idx : face) {
-        if (vertices_in_ball.count(vertex_idx) > 0) {
+        if (in_ball(vertex_idx)) {
           any_vertices_in_ball = true;
           break;
         }
@@ -114,14 +138,26 @@ const std::vector<size_t> find_connected_faces(
   return std::vector<size_t>(connected_faces.begin(), connected_faces.end());
 }
 
+const std::vector<size_t> find_connected_faces(
+    size_t center_idx, const std::vector<std::array<double, 3>> &vertices,
+    const std::vector<std::array<size_t, 3>> &faces,
+    const std::vector<std::vector<size_t>> &vertex_to_faces, double radius) {
+  return grow_connected_faces(vertices[center_idx], {center_idx}, NO_SEED_FACE,
+                              vertices, faces, vertex_to_faces, radius);
+}
+
 std::vector<std::vector<size_t>>
 run_parallel_region_growing(const std::vector<std::array<double, 3>> &vertices,
                             const std::vector<std::array<size_t, 3>> &faces,
                             const std::vector<size_t> &seed_indices,
                             size_t num_segments) {
+  StageTimer stage("run_parallel_region_growing");
+
   // 计算覆盖半径
   const double radius = compute_min_radius_cover_all(vertices, seed_indices);
 
+  StageTimer grow_stage("grow");
+
   // 构建顶点到面片的映射
   const auto vertex_to_faces = build_vertex_to_face_map(faces, vertices.size());
 
@@ -137,6 +173,604 @@ run_parallel_region_growing(const std::vector<std::array<double, 3>> &vertices,
     // 将当前种子点的连通面片数组添加到结果中
     all_connected_faces.push_back(connected_faces);
   }
+  grow_stage.stop();
 
+  recordCount("seeds", seed_indices.size());
+  recordRegions(all_connected_faces, faces.size());
   return all_connected_faces;
 }
+
+// 由面片与重心坐标计算种子点坐标
+static std::vector<std::array<double, 3>> surface_seed_points(
+    const std::vector<std::array<double, 3>> &vertices,
+    const std::vector<std::array<size_t, 3>> &faces,
+    const std::vector<size_t> &seed_faces,
+    const std::vector<std::array<double, 3>> &seed_barycentrics) {
+  if (seed_faces.size() != seed_barycentrics.size()) {
+    throw std::runtime_error(
+        "seed_faces and seed_barycentrics must have the same length");
+  }
+
+  std::vector<std::array<double, 3>> points(seed_faces.size());
+  for (size_t i = 0; i < seed_faces.size(); ++i) {
+    if (seed_faces[i] >= faces.size()) {
+      throw std::runtime_error("seed face index out of range");
+    }
+    const auto &face = faces[seed_faces[i]];
+    for (size_t d = 0; d < 3; ++d) {
+      points[i][d] = seed_barycentrics[i][0] * vertices[face[0]][d] +
+                     seed_barycentrics[i][1] * vertices[face[1]][d] +
+                     seed_barycentrics[i][2] * vertices[face[2]][d];
+    }
+  }
+  return points;
+}
+
+std::vector<std::vector<size_t>> run_parallel_region_growing_from_surface_seeds(
+    const std::vector<std::array<double, 3>> &vertices,
+    const std::vector<std::array<size_t, 3>> &faces,
+    const std::vector<size_t> &seed_faces,
+    const std::vector<std::array<double, 3>> &seed_barycentrics) {
+  StageTimer stage("run_parallel_region_growing_from_surface_seeds");
+
+  PointCloud cloud;
+  cloud.points =
+      surface_seed_points(vertices, faces, seed_faces, seed_barycentrics);
+
+  // 计算覆盖半径，略微放大以免开方再平方的舍入误差把最远的顶点排除在球外
+  // （种子不在顶点上，恰好落在半径上的顶点总是存在）
+  StageTimer radius_stage("compute_min_radius_cover_all");
+  const double radius = min_radius_cover_all(vertices, cloud) * (1.0 + 1e-9);
+  radius_stage.stop();
+
+  StageTimer grow_stage("grow");
+
+  // 构建顶点到面片的映射
+  const auto vertex_to_faces = build_vertex_to_face_map(faces, vertices.size());
+
+  // 初始化结果数组，用于存储每个种子点对应的连通面片数组
+  std::vector<std::vector<size_t>> all_connected_faces;
+  all_connected_faces.reserve(seed_faces.size());
+
+  // 对每个种子点，从其所在面片的顶点开始区域生长
+  for (size_t i = 0; i < seed_faces.size(); ++i) {
+    const auto &face = faces[seed_faces[i]];
+    const auto connected_faces = grow_connected_faces(
+        cloud.points[i], {face[0], face[1], face[2]}, seed_faces[i], vertices,
+        faces, vertex_to_faces, radius);
+
+    all_connected_faces.push_back(connected_faces);
+  }
+  grow_stage.stop();
+
+  recordCount("seeds", seed_faces.size());
+  recordRegions(all_connected_faces, faces.size());
+  return all_connected_faces;
+}
+
+// 每个区域的面积加权质心累加量：{Σa·x, Σa·y, Σa·z, Σa}
+using RegionMoments = std::array<double, 4>;
+
+// 每轮Lloyd迭代中局部重分配的最大扫描次数
+static const size_t MAX_CVT_SWEEPS = 8;
+
+// 并行累加face_ids中面片的面积加权质心到其所属区域，sign为-1时从区域中减去
+static void
+reduce_region_moments(const std::vector<size_t> &face_ids,
+                      const std::vector<size_t> &labels,
+                      const std::vector<std::array<double, 3>> &face_centroids,
+                      const std::vector<double> &face_areas, const double sign,
+                      std::vector<RegionMoments> &moments) {
+#pragma omp parallel
+  {
+    std::vector<RegionMoments> local(moments.size(), RegionMoments{});
+
+#pragma omp for nowait
+    for (int64_t i = 0; i < static_cast<int64_t>(face_ids.size()); ++i) {
+      const size_t f = face_ids[i];
+      const double w = sign * face_areas[f];
+      auto &m = local[labels[f]];
+      m[0] += w * face_centroids[f][0];
+      m[1] += w * face_centroids[f][1];
+      m[2] += w * face_centroids[f][2];
+      m[3] += w;
+    }
+
+#pragma omp critical
+    for (size_t r = 0; r < moments.size(); ++r) {
+      for (size_t d = 0; d < 4; ++d) {
+        moments[r][d] += local[r][d];
+      }
+    }
+  }
+}
+
+// 区域面积的变异系数，用于衡量分割是否均衡
+static double region_area_variation(const std::vector<RegionMoments> &moments) {
+  double mean = 0.0;
+  for (const auto &m : moments) {
+    mean += m[3];
+  }
+  mean /= moments.size();
+  if (mean <= 0.0) {
+    return 0.0;
+  }
+
+  double variance = 0.0;
+  for (const auto &m : moments) {
+    variance += (m[3] - mean) * (m[3] - mean);
+  }
+  return std::sqrt(variance / moments.size()) / mean;
+}
+
+std::vector<std::vector<size_t>> run_cvt_region_growing(
+    const std::vector<std::array<double, 3>> &vertices,
+    const std::vector<std::array<size_t, 3>> &faces,
+    const std::vector<size_t> &seed_faces,
+    const std::vector<std::array<double, 3>> &seed_barycentrics,
+    const size_t &max_iterations, const double &balance_tolerance) {
+  StageTimer stage("run_cvt_region_growing");
+
+  // 生成元初始为种子点，生成元所在面片固定属于该区域，保证区域不会消失
+  std::vector<std::array<double, 3>> generators =
+      surface_seed_points(vertices, faces, seed_faces, seed_barycentrics);
+  std::vector<size_t> generator_faces(seed_faces);
+
+  const size_t num_regions = seed_faces.size();
+  std::vector<std::vector<size_t>> face_groups(num_regions);
+  if (num_regions == 0 || faces.empty()) {
+    return face_groups;
+  }
+  if (num_regions > faces.size()) {
+    throw std::runtime_error("more seeds than faces");
+  }
+
+  // 面片质心与面积
+  StageTimer initial_stage("initial_assignment");
+  std::vector<std::array<double, 3>> face_centroids(faces.size());
+  std::vector<double> face_areas(faces.size());
+#pragma omp parallel for
+  for (int64_t i = 0; i < static_cast<int64_t>(faces.size()); ++i) {
+    const auto &p0 = vertices[faces[i][0]];
+    const auto &p1 = vertices[faces[i][1]];
+    const auto &p2 = vertices[faces[i][2]];
+    const std::array<double, 3> e1 = {p1[0] - p0[0], p1[1] - p0[1],
+                                      p1[2] - p0[2]};
+    const std::array<double, 3> e2 = {p2[0] - p0[0], p2[1] - p0[1],
+                                      p2[2] - p0[2]};
+    const double nx = e1[1] * e2[2] - e1[2] * e2[1];
+    const double ny = e1[2] * e2[0] - e1[0] * e2[2];
+    const double nz = e1[0] * e2[1] - e1[1] * e2[0];
+    face_areas[i] = 0.5 * std::sqrt(nx * nx + ny * ny + nz * nz);
+    for (size_t d = 0; d < 3; ++d) {
+      face_centroids[i][d] = (p0[d] + p1[d] + p2[d]) / 3.0;
+    }
+  }
+
+  // 共享顶点的面片互为邻接
+  const auto vertex_to_faces = build_vertex_to_face_map(faces, vertices.size());
+  const auto for_each_neighbour = [&](const size_t f, const auto &visit) {
+    for (const size_t v : faces[f]) {
+      for (const size_t g : vertex_to_faces[v]) {
+        if (g != f) {
+          visit(g);
+        }
+      }
+    }
+  };
+
+  // 多个种子落在同一面片时，后出现的区域在泛洪中得不到任何面片：
+  // 为其改选沿邻接关系最近的未被占用的面片，生成元移到该面片质心
+  {
+    std::vector<char> taken(faces.size(), 0);
+    for (size_t r = 0; r < num_regions; ++r) {
+      if (!taken[generator_faces[r]]) {
+        taken[generator_faces[r]] = 1;
+        continue;
+      }
+
+      size_t replacement = NO_SEED_FACE;
+      std::unordered_set<size_t> visited = {generator_faces[r]};
+      std::queue<size_t> face_queue;
+      face_queue.push(generator_faces[r]);
+      while (!face_queue.empty() && replacement == NO_SEED_FACE) {
+        const size_t f = face_queue.front();
+        face_queue.pop();
+        for_each_neighbour(f, [&](const size_t g) {
+          if (replacement == NO_SEED_FACE && visited.insert(g).second) {
+            if (taken[g]) {
+              face_queue.push(g);
+            } else {
+              replacement = g;
+            }
+          }
+        });
+      }
+
+      // 所在连通块的面片都已被占用时取任一未占用的面片
+      if (replacement == NO_SEED_FACE) {
+        replacement = std::find(taken.begin(), taken.end(), 0) - taken.begin();
+      }
+
+      taken[replacement] = 1;
+      generator_faces[r] = replacement;
+      generators[r] = face_centroids[replacement];
+      recordCount("cvt_reseeded_generators", 1);
+    }
+  }
+
+  // 一次完整分配：按到生成元的距离从生成元所在面片开始沿连通关系泛洪
+  std::vector<size_t> labels(faces.size(), NO_SEED_FACE);
+  {
+    using QueueItem = std::tuple<double, size_t, size_t>;
+    std::priority_queue<QueueItem, std::vector<QueueItem>,
+                        std::greater<QueueItem>>
+        queue;
+    for (size_t r = 0; r < num_regions; ++r) {
+      queue.emplace(0.0, generator_faces[r], r);
+    }
+
+    while (!queue.empty()) {
+      const auto [dist, f, r] = queue.top();
+      queue.pop();
+      if (labels[f] != NO_SEED_FACE) {
+        continue;
+      }
+      labels[f] = r;
+      for_each_neighbour(f, [&](const size_t g) {
+        if (labels[g] == NO_SEED_FACE) {
+          queue.emplace(distance_squared(face_centroids[g], generators[r]), g,
+                        r);
+        }
+      });
+    }
+  }
+
+  // 不含种子的连通块按欧氏距离归入最近的生成元
+  {
+    PointCloud cloud;
+    cloud.points = generators;
+
+    using KDTreeType = nanoflann::KDTreeSingleIndexAdaptor<
+        nanoflann::L2_Simple_Adaptor<double, PointCloud>, PointCloud, 3>;
+
+    KDTreeType index(3, cloud, {10});
+    index.buildIndex();
+
+#pragma omp parallel for
+    for (int64_t i = 0; i < static_cast<int64_t>(faces.size()); ++i) {
+      if (labels[i] == NO_SEED_FACE) {
+        uint32_t ret_index = 0;
+        double out_dist_sqr = 0.0;
+        index.knnSearch(face_centroids[i].data(), 1, &ret_index,
+                        &out_dist_sqr);
+        labels[i] = ret_index;
+      }
+    }
+  }
+
+  std::vector<RegionMoments> moments(num_regions, RegionMoments{});
+  {
+    std::vector<size_t> all_faces(faces.size());
+    std::iota(all_faces.begin(), all_faces.end(), 0);
+    reduce_region_moments(all_faces, labels, face_centroids, face_areas, 1.0,
+                          moments);
+  }
+
+  const auto is_frontier = [&](const size_t f) {
+    bool frontier = false;
+    for_each_neighbour(f, [&](const size_t g) {
+      frontier = frontier || labels[g] != labels[f];
+    });
+    return frontier;
+  };
+
+  // 区域边界上的面片，之后只在这些面片上做重分配
+  std::vector<size_t> frontier;
+  for (size_t f = 0; f < faces.size(); ++f) {
+    if (is_frontier(f)) {
+      frontier.push_back(f);
+    }
+  }
+
+  initial_stage.stop();
+
+  StageTimer lloyd_stage("lloyd");
+  std::vector<char> pinned(faces.size(), 0);
+  std::vector<char> moved(num_regions, 0);
+  double previous_variation = region_area_variation(moments);
+
+  for (size_t iteration = 0; iteration < max_iterations; ++iteration) {
+    recordCount("cvt_iterations", 1);
+
+    // 生成元移动到区域质心，所在面片沿区域内邻接面片下降到离质心最近处
+#pragma omp parallel for schedule(dynamic)
+    for (int64_t r = 0; r < static_cast<int64_t>(num_regions); ++r) {
+      moved[r] = 0;
+      if (moments[r][3] <= 0.0) {
+        continue;
+      }
+      const std::array<double, 3> centroid = {moments[r][0] / moments[r][3],
+                                              moments[r][1] / moments[r][3],
+                                              moments[r][2] / moments[r][3]};
+      moved[r] = distance_squared(centroid, generators[r]) > 0.0;
+      generators[r] = centroid;
+
+      size_t current = generator_faces[r];
+      double current_dist = distance_squared(face_centroids[current], centroid);
+      for (bool improved = true; improved;) {
+        improved = false;
+        for_each_neighbour(current, [&](const size_t g) {
+          if (labels[g] != static_cast<size_t>(r)) {
+            return;
+          }
+          const double dist = distance_squared(face_centroids[g], centroid);
+          if (dist < current_dist) {
+            current = g;
+            current_dist = dist;
+            improved = true;
+          }
+        });
+      }
+      generator_faces[r] = current;
+    }
+
+    for (const size_t f : generator_faces) {
+      pinned[f] = 1;
+    }
+
+    // 只重分配两侧生成元有移动的边界面片
+    std::vector<size_t> active;
+    for (const size_t f : frontier) {
+      bool touched = moved[labels[f]];
+      for_each_neighbour(f, [&](const size_t g) {
+        touched = touched || moved[labels[g]];
+      });
+      if (touched) {
+        active.push_back(f);
+      }
+    }
+
+    size_t changed_num = 0;
+    std::vector<size_t> touched_faces;
+    // 本轮失去面片的区域，可能因此不再连通
+    std::vector<char> shrunk(num_regions, 0);
+    for (size_t sweep = 0; sweep < MAX_CVT_SWEEPS && !active.empty();
+         ++sweep) {
+      std::vector<size_t> proposals(active.size());
+#pragma omp parallel for
+      for (int64_t i = 0; i < static_cast<int64_t>(active.size()); ++i) {
+        const size_t f = active[i];
+        size_t best = labels[f];
+        if (!pinned[f]) {
+          double best_dist = distance_squared(face_centroids[f], generators[best]);
+          for_each_neighbour(f, [&](const size_t g) {
+            const double dist =
+                distance_squared(face_centroids[f], generators[labels[g]]);
+            if (dist < best_dist) {
+              best_dist = dist;
+              best = labels[g];
+            }
+          });
+        }
+        proposals[i] = best;
+      }
+
+      std::vector<size_t> changed;
+      std::vector<size_t> changed_labels;
+      for (size_t i = 0; i < active.size(); ++i) {
+        if (proposals[i] != labels[active[i]]) {
+          changed.push_back(active[i]);
+          changed_labels.push_back(proposals[i]);
+        }
+      }
+      if (changed.empty()) {
+        break;
+      }
+      changed_num += changed.size();
+
+      // 增量更新区域累加量
+      reduce_region_moments(changed, labels, face_centroids, face_areas, -1.0,
+                            moments);
+      for (size_t i = 0; i < changed.size(); ++i) {
+        shrunk[labels[changed[i]]] = 1;
+        labels[changed[i]] = changed_labels[i];
+      }
+      reduce_region_moments(changed, labels, face_centroids, face_areas, 1.0,
+                            moments);
+
+      // 下一次扫描只看改变的面片及其邻接面片
+      active.clear();
+      for (const size_t f : changed) {
+        active.push_back(f);
+        for_each_neighbour(f, [&](const size_t g) { active.push_back(g); });
+      }
+      std::sort(active.begin(), active.end());
+      active.erase(std::unique(active.begin(), active.end()), active.end());
+      touched_faces.insert(touched_faces.end(), active.begin(), active.end());
+    }
+
+    for (const size_t f : generator_faces) {
+      pinned[f] = 0;
+    }
+
+    // 局部重分配可能把区域切成多块：失去面片的区域只保留含生成元的连通块，
+    // 其余面片从相邻的连通区域按到生成元的距离重新泛洪
+    if (changed_num > 0) {
+      std::vector<char> connected(faces.size(), 0);
+#pragma omp parallel for schedule(dynamic)
+      for (int64_t r = 0; r < static_cast<int64_t>(num_regions); ++r) {
+        if (!shrunk[r]) {
+          continue;
+        }
+        std::vector<size_t> stack = {generator_faces[r]};
+        connected[generator_faces[r]] = 1;
+        while (!stack.empty()) {
+          const size_t f = stack.back();
+          stack.pop_back();
+          for_each_neighbour(f, [&](const size_t g) {
+            if (labels[g] == static_cast<size_t>(r) && !connected[g]) {
+              connected[g] = 1;
+              stack.push_back(g);
+            }
+          });
+        }
+      }
+
+      std::vector<char> orphaned(faces.size(), 0);
+      std::vector<size_t> orphans;
+      for (size_t f = 0; f < faces.size(); ++f) {
+        if (shrunk[labels[f]] && !connected[f]) {
+          orphaned[f] = 1;
+          orphans.push_back(f);
+        }
+      }
+
+      if (!orphans.empty()) {
+        reduce_region_moments(orphans, labels, face_centroids, face_areas,
+                              -1.0, moments);
+        std::vector<size_t> orphan_labels(orphans.size());
+        for (size_t i = 0; i < orphans.size(); ++i) {
+          orphan_labels[i] = labels[orphans[i]];
+        }
+
+        using QueueItem = std::tuple<double, size_t, size_t>;
+        std::priority_queue<QueueItem, std::vector<QueueItem>,
+                            std::greater<QueueItem>>
+            queue;
+        for (const size_t f : orphans) {
+          for_each_neighbour(f, [&](const size_t g) {
+            if (!orphaned[g]) {
+              queue.emplace(
+                  distance_squared(face_centroids[f], generators[labels[g]]),
+                  f, labels[g]);
+            }
+          });
+        }
+
+        while (!queue.empty()) {
+          const auto [dist, f, r] = queue.top();
+          queue.pop();
+          if (!orphaned[f]) {
+            continue;
+          }
+          orphaned[f] = 0;
+          labels[f] = r;
+          for_each_neighbour(f, [&](const size_t g) {
+            if (orphaned[g]) {
+              queue.emplace(distance_squared(face_centroids[g], generators[r]),
+                            g, r);
+            }
+          });
+        }
+
+        // 泛洪不到的面片（位于没有生成元的连通块）保留原标签
+        reduce_region_moments(orphans, labels, face_centroids, face_areas, 1.0,
+                              moments);
+        size_t reconnected_num = 0;
+        for (size_t i = 0; i < orphans.size(); ++i) {
+          if (labels[orphans[i]] == orphan_labels[i]) {
+            continue;
+          }
+          ++reconnected_num;
+          touched_faces.push_back(orphans[i]);
+          for_each_neighbour(orphans[i], [&](const size_t g) {
+            touched_faces.push_back(g);
+          });
+        }
+        changed_num += reconnected_num;
+        recordCount("cvt_reconnected_faces", reconnected_num);
+      }
+    }
+
+    recordCount("cvt_reassigned_faces", changed_num);
+
+    if (changed_num == 0) {
+      break;
+    }
+
+    // 增量维护边界面片集合
+    touched_faces.insert(touched_faces.end(), frontier.begin(), frontier.end());
+    std::sort(touched_faces.begin(), touched_faces.end());
+    touched_faces.erase(std::unique(touched_faces.begin(), touched_faces.end()),
+                        touched_faces.end());
+    frontier.clear();
+    for (const size_t f : touched_faces) {
+      if (is_frontier(f)) {
+        frontier.push_back(f);
+      }
+    }
+
+    const double variation = region_area_variation(moments);
+    if (std::abs(previous_variation - variation) < balance_tolerance) {
+      break;
+    }
+    previous_variation = variation;
+  }
+
+  lloyd_stage.stop();
+
+  for (size_t f = 0; f < faces.size(); ++f) {
+    face_groups[labels[f]].push_back(f);
+  }
+
+  recordCount("seeds", num_regions);
+  recordRegions(face_groups, faces.size());
+  return face_groups;
+}
+
+MultiLevelSegmentation run_multi_level_region_growing(
+    const std::vector<std::array<double, 3>> &vertices,
+    const std::vector<std::array<size_t, 3>> &faces,
+    const std::vector<size_t> &seed_faces,
+    const std::vector<std::array<double, 3>> &seed_barycentrics,
+    const std::vector<size_t> &levels) {
+  StageTimer stage("run_multi_level_region_growing");
+
+  for (const size_t level : levels) {
+    if (level == 0 || level > seed_faces.size()) {
+      throw std::runtime_error("level must be in [1, number of seeds]");
+    }
+  }
+
+  // 种子点坐标与顶点到面片的映射在所有层级间共享
+  const auto seed_points =
+      surface_seed_points(vertices, faces, seed_faces, seed_barycentrics);
+  const auto vertex_to_faces = build_vertex_to_face_map(faces, vertices.size());
+
+  MultiLevelSegmentation segmentation;
+  segmentation.levels = levels;
+  segmentation.level_offsets.reserve(levels.size() + 1);
+  segmentation.level_offsets.push_back(0);
+  segmentation.region_offsets.push_back(0);
+
+  for (const size_t level : levels) {
+    // 最远点采样的顺序是嵌套的，前level个种子即为该层级的种子
+    PointCloud cloud;
+    cloud.points.assign(seed_points.begin(), seed_points.begin() + level);
+    const double radius = min_radius_cover_all(vertices, cloud) * (1.0 + 1e-9);
+
+    std::vector<std::vector<size_t>> level_faces(level);
+#pragma omp parallel for schedule(dynamic)
+    for (int64_t i = 0; i < static_cast<int64_t>(level); ++i) {
+      const auto &face = faces[seed_faces[i]];
+      level_faces[i] = grow_connected_faces(
+          cloud.points[i], {face[0], face[1], face[2]}, seed_faces[i],
+          vertices, faces, vertex_to_faces, radius);
+    }
+
+    recordRegions(level_faces, faces.size());
+    for (const auto &region : level_faces) {
+      segmentation.face_indices.insert(segmentation.face_indices.end(),
+                                       region.begin(), region.end());
+      segmentation.region_offsets.push_back(segmentation.face_indices.size());
+    }
+    segmentation.level_offsets.push_back(segmentation.region_offsets.size() -
+                                         1);
+  }
+
+  recordCount("seeds", seed_faces.size());
+  recordCount("levels", levels.size());
+
+  return segmentation;
+}
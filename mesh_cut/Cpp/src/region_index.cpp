@@ -0,0 +1,348 @@
+#include "region_index.h"
+#include "stats.h"
+#include <algorithm>
+#include <stdexcept>
+
+namespace {
+
+const size_t BITMAP_WORDS = 1024;
+
+// 有序数组求交，长度悬殊时对长数组二分查找
+template <typename Visit>
+void intersect_arrays(const std::vector<uint16_t> &a,
+                      const std::vector<uint16_t> &b, const Visit &visit) {
+  const auto &small = a.size() <= b.size() ? a : b;
+  const auto &large = a.size() <= b.size() ? b : a;
+
+  if (small.size() * 32 < large.size()) {
+    auto it = large.begin();
+    for (const uint16_t v : small) {
+      it = std::lower_bound(it, large.end(), v);
+      if (it == large.end()) {
+        return;
+      }
+      if (*it == v) {
+        visit(v);
+      }
+    }
+    return;
+  }
+
+  size_t i = 0;
+  size_t j = 0;
+  while (i < small.size() && j < large.size()) {
+    if (small[i] < large[j]) {
+      ++i;
+    } else if (small[i] > large[j]) {
+      ++j;
+    } else {
+      visit(small[i]);
+      ++i;
+      ++j;
+    }
+  }
+}
+
+inline bool test_bit(const std::vector<uint64_t> &words, const uint16_t v) {
+  return (words[v >> 6] >> (v & 63)) & 1;
+}
+
+} // namespace
+
+CompressedBitmap CompressedBitmap::fromSorted(const uint32_t *values,
+                                              size_t count) {
+  CompressedBitmap bitmap;
+
+  size_t begin = 0;
+  while (begin < count) {
+    const uint16_t key = values[begin] >> 16;
+    size_t end = begin;
+    while (end < count && (values[end] >> 16) == key) {
+      ++end;
+    }
+
+    BitmapContainer container;
+    container.key = key;
+    container.cardinality = end - begin;
+    if (container.cardinality <= ARRAY_CONTAINER_MAX) {
+      container.values.resize(container.cardinality);
+      for (size_t i = begin; i < end; ++i) {
+        container.values[i - begin] = values[i] & 0xFFFF;
+      }
+    } else {
+      container.words.assign(BITMAP_WORDS, 0);
+      for (size_t i = begin; i < end; ++i) {
+        const uint16_t v = values[i] & 0xFFFF;
+        container.words[v >> 6] |= uint64_t(1) << (v & 63);
+      }
+    }
+    bitmap.containers_.push_back(std::move(container));
+
+    begin = end;
+  }
+
+  return bitmap;
+}
+
+size_t CompressedBitmap::cardinality() const {
+  size_t count = 0;
+  for (const auto &container : containers_) {
+    count += container.cardinality;
+  }
+  return count;
+}
+
+bool CompressedBitmap::contains(const uint32_t value) const {
+  const uint16_t key = value >> 16;
+  const auto it = std::lower_bound(
+      containers_.begin(), containers_.end(), key,
+      [](const BitmapContainer &c, const uint16_t k) { return c.key < k; });
+  if (it == containers_.end() || it->key != key) {
+    return false;
+  }
+
+  const uint16_t low = value & 0xFFFF;
+  if (it->isBitmap()) {
+    return test_bit(it->words, low);
+  }
+  return std::binary_search(it->values.begin(), it->values.end(), low);
+}
+
+size_t
+CompressedBitmap::intersectionCardinality(const CompressedBitmap &other) const {
+  size_t count = 0;
+
+  size_t i = 0;
+  size_t j = 0;
+  while (i < containers_.size() && j < other.containers_.size()) {
+    const auto &a = containers_[i];
+    const auto &b = other.containers_[j];
+    if (a.key < b.key) {
+      ++i;
+      continue;
+    }
+    if (a.key > b.key) {
+      ++j;
+      continue;
+    }
+
+    if (a.isBitmap() && b.isBitmap()) {
+      const uint64_t *wa = a.words.data();
+      const uint64_t *wb = b.words.data();
+      size_t bits = 0;
+#pragma omp simd reduction(+ : bits)
+      for (size_t w = 0; w < BITMAP_WORDS; ++w) {
+        bits += __builtin_popcountll(wa[w] & wb[w]);
+      }
+      count += bits;
+    } else if (a.isBitmap() || b.isBitmap()) {
+      const auto &bitmap = a.isBitmap() ? a : b;
+      const auto &array = a.isBitmap() ? b : a;
+      for (const uint16_t v : array.values) {
+        count += test_bit(bitmap.words, v);
+      }
+    } else {
+      intersect_arrays(a.values, b.values, [&](uint16_t) { ++count; });
+    }
+
+    ++i;
+    ++j;
+  }
+
+  return count;
+}
+
+void CompressedBitmap::intersection(const CompressedBitmap &other,
+                                    std::vector<uint32_t> &result) const {
+  result.clear();
+
+  size_t i = 0;
+  size_t j = 0;
+  while (i < containers_.size() && j < other.containers_.size()) {
+    const auto &a = containers_[i];
+    const auto &b = other.containers_[j];
+    if (a.key < b.key) {
+      ++i;
+      continue;
+    }
+    if (a.key > b.key) {
+      ++j;
+      continue;
+    }
+
+    const uint32_t high = uint32_t(a.key) << 16;
+    if (a.isBitmap() && b.isBitmap()) {
+      for (size_t w = 0; w < BITMAP_WORDS; ++w) {
+        uint64_t word = a.words[w] & b.words[w];
+        while (word != 0) {
+          result.push_back(high | (w << 6) | __builtin_ctzll(word));
+          word &= word - 1;
+        }
+      }
+    } else if (a.isBitmap() || b.isBitmap()) {
+      const auto &bitmap = a.isBitmap() ? a : b;
+      const auto &array = a.isBitmap() ? b : a;
+      for (const uint16_t v : array.values) {
+        if (test_bit(bitmap.words, v)) {
+          result.push_back(high | v);
+        }
+      }
+    } else {
+      intersect_arrays(a.values, b.values,
+                       [&](const uint16_t v) { result.push_back(high | v); });
+    }
+
+    ++i;
+    ++j;
+  }
+}
+
+void CompressedBitmap::decode(std::vector<uint32_t> &result) const {
+  result.clear();
+  result.reserve(cardinality());
+  for (const auto &container : containers_) {
+    const uint32_t high = uint32_t(container.key) << 16;
+    if (container.isBitmap()) {
+      for (size_t w = 0; w < BITMAP_WORDS; ++w) {
+        uint64_t word = container.words[w];
+        while (word != 0) {
+          result.push_back(high | (w << 6) | __builtin_ctzll(word));
+          word &= word - 1;
+        }
+      }
+    } else {
+      for (const uint16_t v : container.values) {
+        result.push_back(high | v);
+      }
+    }
+  }
+}
+
+size_t CompressedBitmap::memoryBytes() const {
+  size_t bytes = containers_.capacity() * sizeof(BitmapContainer);
+  for (const auto &container : containers_) {
+    bytes += container.values.capacity() * sizeof(uint16_t);
+    bytes += container.words.capacity() * sizeof(uint64_t);
+  }
+  return bytes;
+}
+
+RegionMembershipIndex::RegionMembershipIndex(
+    const std::vector<std::vector<size_t>> &regions, const size_t &num_faces) {
+  StageTimer stage("RegionMembershipIndex");
+
+  if (num_faces > UINT32_MAX || regions.size() > UINT32_MAX) {
+    throw std::runtime_error("region index supports at most 2^32 faces");
+  }
+  for (const auto &region : regions) {
+    for (const size_t f : region) {
+      if (f >= num_faces) {
+        throw std::runtime_error("region face index out of range");
+      }
+    }
+  }
+
+  // 各区域排序去重后压缩
+  regions_.resize(regions.size());
+#pragma omp parallel for schedule(dynamic)
+  for (int64_t r = 0; r < static_cast<int64_t>(regions.size()); ++r) {
+    std::vector<uint32_t> faces(regions[r].begin(), regions[r].end());
+    std::sort(faces.begin(), faces.end());
+    faces.erase(std::unique(faces.begin(), faces.end()), faces.end());
+    regions_[r] = CompressedBitmap::fromSorted(faces.data(), faces.size());
+  }
+
+  // 反向映射的偏移为32位，成员总数（各区域去重后的面片数之和）不能超出
+  size_t num_memberships = 0;
+  for (const auto &bitmap : regions_) {
+    num_memberships += bitmap.cardinality();
+  }
+  if (num_memberships > UINT32_MAX) {
+    throw std::runtime_error(
+        "region index supports at most 2^32 face-region memberships");
+  }
+
+  // 面片到区域的反向映射（CSR），按区域顺序填充，每个面片的区域自然升序
+  face_offsets_.assign(num_faces + 1, 0);
+  std::vector<uint32_t> faces;
+  for (const auto &bitmap : regions_) {
+    bitmap.decode(faces);
+    for (const uint32_t f : faces) {
+      ++face_offsets_[f + 1];
+    }
+  }
+  for (size_t f = 0; f < num_faces; ++f) {
+    face_offsets_[f + 1] += face_offsets_[f];
+  }
+
+  face_regions_.resize(face_offsets_[num_faces]);
+  std::vector<uint32_t> cursor(face_offsets_.begin(), face_offsets_.end() - 1);
+  for (size_t r = 0; r < regions_.size(); ++r) {
+    regions_[r].decode(faces);
+    for (const uint32_t f : faces) {
+      face_regions_[cursor[f]++] = r;
+    }
+  }
+
+  recordCount("region_index_bytes", memoryBytes());
+}
+
+void RegionMembershipIndex::checkRegion(const size_t &region) const {
+  if (region >= regions_.size()) {
+    throw std::runtime_error("region index out of range");
+  }
+}
+
+size_t RegionMembershipIndex::regionSize(const size_t &region) const {
+  checkRegion(region);
+  return regions_[region].cardinality();
+}
+
+bool RegionMembershipIndex::contains(const size_t &region,
+                                     const size_t &face) const {
+  checkRegion(region);
+  return face < numFaces() && regions_[region].contains(face);
+}
+
+std::vector<uint32_t>
+RegionMembershipIndex::regionFaces(const size_t &region) const {
+  checkRegion(region);
+  std::vector<uint32_t> faces;
+  regions_[region].decode(faces);
+  return faces;
+}
+
+std::vector<uint32_t>
+RegionMembershipIndex::regionsOfFace(const size_t &face) const {
+  if (face >= numFaces()) {
+    throw std::runtime_error("face index out of range");
+  }
+  return std::vector<uint32_t>(face_regions_.begin() + face_offsets_[face],
+                               face_regions_.begin() + face_offsets_[face + 1]);
+}
+
+size_t RegionMembershipIndex::overlap(const size_t &region_a,
+                                      const size_t &region_b) const {
+  checkRegion(region_a);
+  checkRegion(region_b);
+  return regions_[region_a].intersectionCardinality(regions_[region_b]);
+}
+
+std::vector<uint32_t>
+RegionMembershipIndex::intersection(const size_t &region_a,
+                                    const size_t &region_b) const {
+  checkRegion(region_a);
+  checkRegion(region_b);
+  std::vector<uint32_t> faces;
+  regions_[region_a].intersection(regions_[region_b], faces);
+  return faces;
+}
+
+size_t RegionMembershipIndex::memoryBytes() const {
+  size_t bytes = face_offsets_.capacity() * sizeof(uint32_t) +
+                 face_regions_.capacity() * sizeof(uint32_t);
+  for (const auto &bitmap : regions_) {
+    bytes += bitmap.memoryBytes();
+  }
+  return bytes;
+}
@@ -0,0 +1,502 @@
+#include "result_cache.h"
+#include "stats.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <stdexcept>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+
+// 缓存文件格式：头部 + 每个碎片一条记录 + 碎片数据，均按8字节对齐
+constexpr uint64_t kMagic = 0x4548434143524d43; // "MCRCACHE"
+constexpr uint64_t kVersion = 1;
+constexpr size_t kHeaderWords = 5;  // magic, version, key[2], num_fragments
+constexpr size_t kRecordWords = 11; // 见 appendFragment
+
+// 两路64位乘法-旋转哈希，用于内容寻址，不要求抗碰撞攻击
+class Hasher {
+public:
+  void update(const void *data, const size_t &num_bytes) {
+    const unsigned char *bytes = static_cast<const unsigned char *>(data);
+    size_t i = 0;
+    for (; i + 8 <= num_bytes; i += 8) {
+      uint64_t word;
+      std::memcpy(&word, bytes + i, 8);
+      mix(word);
+    }
+    uint64_t tail = 0;
+    if (i < num_bytes) {
+      std::memcpy(&tail, bytes + i, num_bytes - i);
+    }
+    mix(tail ^ (static_cast<uint64_t>(num_bytes) << 56));
+    mix(static_cast<uint64_t>(num_bytes));
+  }
+
+  void digest(uint64_t key[2]) const {
+    key[0] = finalize(a_ ^ rotl(b_, 17));
+    key[1] = finalize(b_ ^ rotl(a_, 41));
+  }
+
+private:
+  static uint64_t rotl(const uint64_t &x, const int &r) {
+    return (x << r) | (x >> (64 - r));
+  }
+
+  static uint64_t finalize(uint64_t x) {
+    x ^= x >> 30;
+    x *= 0xbf58476d1ce4e5b9ULL;
+    x ^= x >> 27;
+    x *= 0x94d049bb133111ebULL;
+    return x ^ (x >> 31);
+  }
+
+  void mix(const uint64_t &word) {
+    a_ = rotl(a_ ^ word, 31) * 0x9e3779b97f4a7c15ULL;
+    b_ = (rotl(b_ + word, 27) ^ a_) * 0xc2b2ae3d27d4eb4fULL;
+  }
+
+  uint64_t a_ = 0x243f6a8885a308d3ULL;
+  uint64_t b_ = 0x13198a2e03707344ULL;
+};
+
+struct CacheConfig {
+  std::mutex mutex;
+  std::string dir;
+  size_t max_bytes = 0;
+};
+
+CacheConfig &cacheConfig() {
+  static CacheConfig config;
+  return config;
+}
+
+template <typename T>
+std::vector<T> queryData(McContext context, McConnectedComponent cc,
+                         McFlags flag) {
+  McSize num_bytes = 0;
+  McResult status =
+      mcGetConnectedComponentData(context, cc, flag, 0, nullptr, &num_bytes);
+  if (status != MC_NO_ERROR) {
+    throw std::runtime_error("mcGetConnectedComponentData failed");
+  }
+  std::vector<T> data(num_bytes / sizeof(T));
+  status = mcGetConnectedComponentData(context, cc, flag, num_bytes,
+                                       data.data(), nullptr);
+  if (status != MC_NO_ERROR) {
+    throw std::runtime_error("mcGetConnectedComponentData failed");
+  }
+  return data;
+}
+
+size_t wordsFor(const size_t &num_bytes) { return (num_bytes + 7) / 8; }
+
+template <typename T>
+void appendArray(std::vector<uint64_t> &blob, const std::vector<T> &data) {
+  const size_t offset = blob.size();
+  blob.resize(offset + wordsFor(data.size() * sizeof(T)), 0);
+  if (!data.empty()) {
+    std::memcpy(blob.data() + offset, data.data(), data.size() * sizeof(T));
+  }
+}
+
+// 取出一个碎片的全部数据追加到缓冲区，记录位于 record 处
+void appendFragment(McContext context, McConnectedComponent cc,
+                    const McFlags &flags, const bool &with_triangulation,
+                    std::vector<uint64_t> &blob, const size_t &record) {
+  McFragmentLocation location = MC_FRAGMENT_LOCATION_UNDEFINED;
+  McPatchLocation patch_location = MC_PATCH_LOCATION_UNDEFINED;
+  mcGetConnectedComponentData(context, cc,
+                              MC_CONNECTED_COMPONENT_DATA_FRAGMENT_LOCATION,
+                              sizeof(McFragmentLocation), &location, nullptr);
+  mcGetConnectedComponentData(context, cc,
+                              MC_CONNECTED_COMPONENT_DATA_PATCH_LOCATION,
+                              sizeof(McPatchLocation), &patch_location, nullptr);
+
+  const std::vector<double> vertices =
+      queryData<double>(context, cc, MC_CONNECTED_COMPONENT_DATA_VERTEX_DOUBLE);
+  const std::vector<uint32_t> face_indices =
+      queryData<uint32_t>(context, cc, MC_CONNECTED_COMPONENT_DATA_FACE);
+  const std::vector<uint32_t> face_sizes =
+      queryData<uint32_t>(context, cc, MC_CONNECTED_COMPONENT_DATA_FACE_SIZE);
+  const std::vector<uint32_t> triangles =
+      with_triangulation
+          ? queryData<uint32_t>(context, cc,
+                                MC_CONNECTED_COMPONENT_DATA_FACE_TRIANGULATION)
+          : std::vector<uint32_t>();
+  const bool has_vertex_map = (flags & MC_DISPATCH_INCLUDE_VERTEX_MAP) != 0;
+  const bool has_face_map = (flags & MC_DISPATCH_INCLUDE_FACE_MAP) != 0;
+  const std::vector<uint32_t> vertex_map =
+      has_vertex_map ? queryData<uint32_t>(
+                           context, cc, MC_CONNECTED_COMPONENT_DATA_VERTEX_MAP)
+                     : std::vector<uint32_t>();
+  const std::vector<uint32_t> face_map =
+      has_face_map ? queryData<uint32_t>(context, cc,
+                                         MC_CONNECTED_COMPONENT_DATA_FACE_MAP)
+                   : std::vector<uint32_t>();
+
+  const uint64_t fields[kRecordWords] = {
+      static_cast<uint64_t>(location), static_cast<uint64_t>(patch_location),
+      vertices.size() / 3,             face_indices.size(),
+      face_sizes.size(),               triangles.size(),
+      has_vertex_map,                  has_face_map,
+      vertex_map.size(),               face_map.size(),
+      blob.size()};
+  std::memcpy(blob.data() + record, fields, sizeof(fields));
+
+  appendArray(blob, vertices);
+  appendArray(blob, face_indices);
+  appendArray(blob, face_sizes);
+  appendArray(blob, triangles);
+  appendArray(blob, vertex_map);
+  appendArray(blob, face_map);
+}
+
+std::vector<uint64_t> collectFragments(McContext context, const McFlags &flags,
+                                       const bool &with_triangulation,
+                                       const uint64_t key[2]) {
+  McUint32 num_fragments = 0;
+  if (mcGetConnectedComponents(context, MC_CONNECTED_COMPONENT_TYPE_FRAGMENT,
+                               0, nullptr, &num_fragments) != MC_NO_ERROR) {
+    throw std::runtime_error("mcGetConnectedComponents failed");
+  }
+  std::vector<McConnectedComponent> fragments(num_fragments, MC_NULL_HANDLE);
+  if (num_fragments > 0 &&
+      mcGetConnectedComponents(context, MC_CONNECTED_COMPONENT_TYPE_FRAGMENT,
+                               num_fragments, fragments.data(),
+                               nullptr) != MC_NO_ERROR) {
+    throw std::runtime_error("mcGetConnectedComponents failed");
+  }
+
+  // MCUT 不公开扰动重试次数，只能从片段的扰动向量判断本次分发是否发生了扰动
+  if (activeStats() != nullptr) {
+    recordCount("fragments", num_fragments);
+    if (num_fragments > 0) {
+      McDouble perturbation[3] = {0.0, 0.0, 0.0};
+      if (mcGetConnectedComponentData(
+              context, fragments[0],
+              MC_CONNECTED_COMPONENT_DATA_DISPATCH_PERTURBATION_VECTOR,
+              sizeof(perturbation), perturbation, nullptr) == MC_NO_ERROR &&
+          (perturbation[0] != 0.0 || perturbation[1] != 0.0 ||
+           perturbation[2] != 0.0)) {
+        recordCount("perturbed_dispatches", 1);
+      }
+    }
+  }
+
+  std::vector<uint64_t> blob(kHeaderWords + kRecordWords * num_fragments, 0);
+  blob[0] = kMagic;
+  blob[1] = kVersion;
+  blob[2] = key[0];
+  blob[3] = key[1];
+  blob[4] = num_fragments;
+
+  for (McUint32 i = 0; i < num_fragments; ++i) {
+    appendFragment(context, fragments[i], flags, with_triangulation, blob,
+                   kHeaderWords + kRecordWords * i);
+  }
+  return blob;
+}
+
+// 影响切割结果的上下文状态：扰动常数与次数、输出面片绕向及上下文标志
+void hashContextState(Hasher &hasher, McContext context) {
+  McFlags context_flags = 0;
+  McDouble general_position_constant = 0.0;
+  McUint32 general_position_attempts = 0;
+  McConnectedComponentFaceWindingOrder winding_order =
+      MC_CONNECTED_COMPONENT_FACE_WINDING_ORDER_AS_GIVEN;
+  if (mcGetInfo(context, MC_CONTEXT_FLAGS, sizeof(context_flags),
+                &context_flags, nullptr) != MC_NO_ERROR ||
+      mcGetInfo(context, MC_CONTEXT_GENERAL_POSITION_ENFORCEMENT_CONSTANT,
+                sizeof(general_position_constant), &general_position_constant,
+                nullptr) != MC_NO_ERROR ||
+      mcGetInfo(context, MC_CONTEXT_GENERAL_POSITION_ENFORCEMENT_ATTEMPTS,
+                sizeof(general_position_attempts), &general_position_attempts,
+                nullptr) != MC_NO_ERROR ||
+      mcGetInfo(context, MC_CONTEXT_CONNECTED_COMPONENT_FACE_WINDING_ORDER,
+                sizeof(winding_order), &winding_order,
+                nullptr) != MC_NO_ERROR) {
+    throw std::runtime_error("mcGetInfo failed");
+  }
+  hasher.update(&context_flags, sizeof(context_flags));
+  hasher.update(&general_position_constant, sizeof(general_position_constant));
+  hasher.update(&general_position_attempts, sizeof(general_position_attempts));
+  hasher.update(&winding_order, sizeof(winding_order));
+}
+
+std::string keyName(const uint64_t key[2]) {
+  char name[40];
+  std::snprintf(name, sizeof(name), "%016llx%016llx",
+                static_cast<unsigned long long>(key[0]),
+                static_cast<unsigned long long>(key[1]));
+  return std::string(name) + ".bin";
+}
+
+// 先写临时文件再改名，并发写入同一个键时读者总能看到完整文件
+void storeBlob(const std::filesystem::path &path,
+               const std::vector<uint64_t> &blob) {
+  static std::atomic<uint64_t> counter(0);
+  const std::filesystem::path temp =
+      path.string() + "." + std::to_string(getpid()) + "." +
+      std::to_string(counter.fetch_add(1)) + ".tmp";
+  {
+    std::ofstream out(temp, std::ios::binary);
+    out.write(reinterpret_cast<const char *>(blob.data()),
+              static_cast<std::streamsize>(blob.size() * sizeof(uint64_t)));
+    if (!out) {
+      std::error_code ec;
+      std::filesystem::remove(temp, ec);
+      return;
+    }
+  }
+  std::error_code ec;
+  std::filesystem::rename(temp, path, ec);
+  if (ec) {
+    std::filesystem::remove(temp, ec);
+  }
+}
+
+// 以文件修改时间作为最近使用时间，超出上限时从最久未用的文件开始删除
+void evict(const std::filesystem::path &dir, const size_t &max_bytes) {
+  struct Entry {
+    std::filesystem::path path;
+    std::filesystem::file_time_type time;
+    uintmax_t size;
+  };
+  std::vector<Entry> entries;
+  uintmax_t total = 0;
+
+  std::error_code ec;
+  for (const auto &item : std::filesystem::directory_iterator(dir, ec)) {
+    if (item.path().extension() != ".bin") {
+      continue;
+    }
+    std::error_code item_ec;
+    const uintmax_t size = item.file_size(item_ec);
+    const std::filesystem::file_time_type time =
+        item.last_write_time(item_ec);
+    if (item_ec) {
+      continue;
+    }
+    entries.push_back({item.path(), time, size});
+    total += size;
+  }
+
+  if (total <= max_bytes) {
+    return;
+  }
+
+  std::sort(entries.begin(), entries.end(),
+            [](const Entry &a, const Entry &b) { return a.time < b.time; });
+  for (const Entry &entry : entries) {
+    if (total <= max_bytes) {
+      break;
+    }
+    // 已被映射的文件删除后映射仍然有效
+    if (std::filesystem::remove(entry.path, ec)) {
+      total -= entry.size;
+    }
+  }
+}
+
+} // namespace
+
+DispatchResult::~DispatchResult() {
+  if (mapped_ != nullptr) {
+    munmap(mapped_, mapped_size_);
+  }
+}
+
+bool DispatchResult::parse(const uint64_t *words, const size_t &num_words) {
+  if (num_words < kHeaderWords || words[0] != kMagic || words[1] != kVersion) {
+    return false;
+  }
+  const uint64_t num_fragments = words[4];
+  if (num_fragments > (num_words - kHeaderWords) / kRecordWords) {
+    return false;
+  }
+
+  fragments_.clear();
+  fragments_.reserve(num_fragments);
+  for (uint64_t i = 0; i < num_fragments; ++i) {
+    const uint64_t *record = words + kHeaderWords + kRecordWords * i;
+    const uint64_t counts[6] = {3 * record[2] * sizeof(double),
+                                record[3] * sizeof(uint32_t),
+                                record[4] * sizeof(uint32_t),
+                                record[5] * sizeof(uint32_t),
+                                record[8] * sizeof(uint32_t),
+                                record[9] * sizeof(uint32_t)};
+    const uint64_t *arrays[6];
+    uint64_t offset = record[10];
+    for (int j = 0; j < 6; ++j) {
+      const uint64_t num_array_words = wordsFor(counts[j]);
+      if (offset > num_words || num_array_words > num_words - offset) {
+        return false;
+      }
+      arrays[j] = words + offset;
+      offset += num_array_words;
+    }
+
+    Fragment fragment;
+    fragment.location = static_cast<McFragmentLocation>(record[0]);
+    fragment.patch_location = static_cast<McPatchLocation>(record[1]);
+    fragment.vertices = reinterpret_cast<const double *>(arrays[0]);
+    fragment.num_vertices = record[2];
+    fragment.face_indices = reinterpret_cast<const uint32_t *>(arrays[1]);
+    fragment.num_face_indices = record[3];
+    fragment.face_sizes = reinterpret_cast<const uint32_t *>(arrays[2]);
+    fragment.num_faces = record[4];
+    fragment.triangles =
+        record[5] > 0 ? reinterpret_cast<const uint32_t *>(arrays[3])
+                      : nullptr;
+    fragment.num_triangle_indices = record[5];
+    fragment.vertex_map =
+        record[6] ? reinterpret_cast<const uint32_t *>(arrays[4]) : nullptr;
+    fragment.face_map =
+        record[7] ? reinterpret_cast<const uint32_t *>(arrays[5]) : nullptr;
+    fragments_.push_back(fragment);
+  }
+  return true;
+}
+
+std::shared_ptr<DispatchResult> DispatchResult::map(const std::string &path,
+                                                    const uint64_t key[2]) {
+  const int fd = open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    return nullptr;
+  }
+  struct stat info;
+  if (fstat(fd, &info) != 0 || info.st_size <= 0 ||
+      info.st_size % sizeof(uint64_t) != 0) {
+    close(fd);
+    return nullptr;
+  }
+  const size_t size = static_cast<size_t>(info.st_size);
+  void *data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (data == MAP_FAILED) {
+    return nullptr;
+  }
+
+  std::shared_ptr<DispatchResult> result(new DispatchResult);
+  result->mapped_ = data;
+  result->mapped_size_ = size;
+  const uint64_t *words = static_cast<const uint64_t *>(data);
+  const size_t num_words = size / sizeof(uint64_t);
+  if (num_words < kHeaderWords || words[2] != key[0] || words[3] != key[1] ||
+      !result->parse(words, num_words)) {
+    return nullptr;
+  }
+  return result;
+}
+
+std::shared_ptr<const DispatchResult> dispatchCached(
+    McContext context, const McFlags &flags, const double *src_vertices,
+    const uint32_t *src_face_indices, const uint32_t *src_face_sizes,
+    const uint32_t &num_src_vertices, const uint32_t &num_src_faces,
+    const double *cut_vertices, const uint32_t *cut_face_indices,
+    const uint32_t *cut_face_sizes, const uint32_t &num_cut_vertices,
+    const uint32_t &num_cut_faces, const bool &with_triangulation) {
+  if ((flags & MC_DISPATCH_VERTEX_ARRAY_DOUBLE) == 0) {
+    throw std::invalid_argument("dispatchCached requires double vertices");
+  }
+
+  StageTimer stage("mcDispatch");
+  recordCount("dispatches", 1);
+
+  std::string dir;
+  size_t max_bytes = 0;
+  {
+    CacheConfig &config = cacheConfig();
+    std::lock_guard<std::mutex> lock(config.mutex);
+    dir = config.dir;
+    max_bytes = config.max_bytes;
+  }
+
+  // 面片尺寸为空指针时表示全部为三角形
+  auto hashMesh = [](Hasher &hasher, const double *vertices,
+                     const uint32_t *face_indices, const uint32_t *face_sizes,
+                     const uint32_t &num_vertices, const uint32_t &num_faces) {
+    size_t num_indices = 3 * static_cast<size_t>(num_faces);
+    if (face_sizes != nullptr) {
+      num_indices = 0;
+      for (uint32_t f = 0; f < num_faces; ++f) {
+        num_indices += face_sizes[f];
+      }
+      hasher.update(face_sizes, num_faces * sizeof(uint32_t));
+    } else {
+      hasher.update(&num_faces, sizeof(num_faces));
+    }
+    hasher.update(vertices, 3 * static_cast<size_t>(num_vertices) *
+                                sizeof(double));
+    hasher.update(face_indices, num_indices * sizeof(uint32_t));
+  };
+
+  uint64_t key[2] = {0, 0};
+  std::filesystem::path path;
+  if (!dir.empty()) {
+    Hasher hasher;
+    hasher.update(&flags, sizeof(flags));
+    hasher.update(&with_triangulation, sizeof(with_triangulation));
+    hashContextState(hasher, context);
+    hashMesh(hasher, src_vertices, src_face_indices, src_face_sizes,
+             num_src_vertices, num_src_faces);
+    hashMesh(hasher, cut_vertices, cut_face_indices, cut_face_sizes,
+             num_cut_vertices, num_cut_faces);
+    hasher.digest(key);
+
+    path = std::filesystem::path(dir) / keyName(key);
+    std::shared_ptr<DispatchResult> cached = DispatchResult::map(path, key);
+    if (cached) {
+      std::error_code ec;
+      std::filesystem::last_write_time(
+          path, std::filesystem::file_time_type::clock::now(), ec);
+      recordCount("dispatch_cache_hits", 1);
+      return cached;
+    }
+  }
+
+  const McResult status =
+      mcDispatch(context, flags, src_vertices, src_face_indices, src_face_sizes,
+                 num_src_vertices, num_src_faces, cut_vertices,
+                 cut_face_indices, cut_face_sizes, num_cut_vertices,
+                 num_cut_faces);
+  if (status != MC_NO_ERROR) {
+    mcReleaseConnectedComponents(context, 0, nullptr);
+    throw std::runtime_error("mcDispatch failed");
+  }
+
+  std::shared_ptr<DispatchResult> result(new DispatchResult);
+  try {
+    result->buffer_ = collectFragments(context, flags, with_triangulation, key);
+  } catch (...) {
+    mcReleaseConnectedComponents(context, 0, nullptr);
+    throw;
+  }
+  mcReleaseConnectedComponents(context, 0, nullptr);
+  result->parse(result->buffer_.data(), result->buffer_.size());
+
+  if (!dir.empty()) {
+    storeBlob(path, result->buffer_);
+    evict(dir, max_bytes);
+  }
+  return result;
+}
+
+void configureResultCache(const std::string &cache_dir,
+                          const size_t &max_bytes) {
+  if (!cache_dir.empty()) {
+    std::filesystem::create_directories(cache_dir);
+  }
+  CacheConfig &config = cacheConfig();
+  std::lock_guard<std::mutex> lock(config.mutex);
+  config.dir = cache_dir;
+  config.max_bytes = max_bytes;
+}
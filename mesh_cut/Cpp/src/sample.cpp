@@ -1,5 +1,6 @@
 #include "sample.h"
-#include <iostream>
+#include "stats.h"
+#include <algorithm>
 #include <omp.h>
 
 // 计算两点之间的欧氏距离的平方
@@ -14,37 +15,18 @@ inline float compute_distance_squared(const float *p1, const float *p2,
   return dist;
 }
 
-torch::Tensor farthest_point_sampling(torch::Tensor points,
-                                      int sample_point_num) {
-  // 检查输入张量的维度
-  if (points.dim() != 2) {
-    throw std::runtime_error("Input points must be a 2D tensor");
-  }
-
-  const int num_points = points.size(0);
-  const int dim = points.size(1);
-
-  // 获取指向数据的指针
-  const float *points_ptr = points.data_ptr<float>();
-
-  if (sample_point_num > num_points) {
-    throw std::runtime_error(
-        "Sample size cannot be larger than the number of points");
-  }
-
+// 在num_points个dim维点上做最远点采样，first_idx为第一个采样点
+static std::vector<int> sample_farthest_indices(const float *points_ptr,
+                                                const int num_points,
+                                                const int dim,
+                                                const int sample_point_num,
+                                                const int first_idx) {
   // 初始化结果数组和距离数组
   std::vector<int> sampled_indices(sample_point_num);
   std::vector<float> distances(num_points,
                                std::numeric_limits<float>::infinity());
 
-  // 使用随机数生成器选择第一个点
-  std::random_device rd;
-  std::mt19937 gen(rd());
-  std::uniform_int_distribution<> dis(0, num_points - 1);
-  sampled_indices[0] = dis(gen);
-
-  std::cout << "[INFO][sample::farthest_point_sampling]" << std::endl;
-  std::cout << "\t start sample fps points..." << std::endl;
+  sampled_indices[0] = first_idx;
 
   // 主循环
   for (int i = 1; i < sample_point_num; ++i) {
@@ -81,16 +63,41 @@ torch::Tensor farthest_point_sampling(torch::Tensor points,
     }
 
     sampled_indices[i] = max_idx;
+  }
 
-    /*
-    // 打印进度（每10%打印一次）
-    if ((i + 1) % (sample_point_num / 10) == 0) {
-      std::cout << "\t " << (i + 1) * 100 / sample_point_num << "% completed"
-                << std::endl;
-    }
-    */
+  return sampled_indices;
+}
+
+torch::Tensor farthest_point_sampling(torch::Tensor points,
+                                      int sample_point_num) {
+  StageTimer stage("farthest_point_sampling");
+
+  // 检查输入张量的维度
+  if (points.dim() != 2) {
+    throw std::runtime_error("Input points must be a 2D tensor");
+  }
+
+  const int num_points = points.size(0);
+  const int dim = points.size(1);
+
+  // 获取指向数据的指针
+  const float *points_ptr = points.data_ptr<float>();
+
+  if (sample_point_num > num_points) {
+    throw std::runtime_error(
+        "Sample size cannot be larger than the number of points");
   }
 
+  // 使用随机数生成器选择第一个点
+  std::random_device rd;
+  std::mt19937 gen(rd());
+  std::uniform_int_distribution<> dis(0, num_points - 1);
+
+  std::vector<int> sampled_indices = sample_farthest_indices(
+      points_ptr, num_points, dim, sample_point_num, dis(gen));
+  recordCount("fps_points", num_points);
+  recordCount("samples", sample_point_num);
+
   // 将结果转换为torch::Tensor
   auto options = torch::TensorOptions().dtype(torch::kInt32);
   torch::Tensor result =
@@ -129,13 +136,10 @@ inline float compute_triangle_area(const float *v0, const float *v1,
   return 0.5f * std::sqrt(area);
 }
 
-// 在三角形内部均匀采样点
-inline void sample_triangle_uniform(const float *v0, const float *v1,
-                                    const float *v2, float *point, int dim,
-                                    std::mt19937 &gen) {
+// 生成三角形内均匀分布的重心坐标
+inline void sample_barycentric_uniform(float *barycentric, std::mt19937 &gen) {
   std::uniform_real_distribution<float> dist(0.0f, 1.0f);
 
-  // 生成重心坐标
   float r1 = dist(gen);
   float r2 = dist(gen);
 
@@ -145,18 +149,146 @@ inline void sample_triangle_uniform(const float *v0, const float *v1,
     r2 = 1.0f - r2;
   }
 
-  float r0 = 1.0f - r1 - r2;
+  barycentric[0] = 1.0f - r1 - r2;
+  barycentric[1] = r1;
+  barycentric[2] = r2;
+}
+
+// 在三角形内部均匀采样点
+inline void sample_triangle_uniform(const float *v0, const float *v1,
+                                    const float *v2, float *point, int dim,
+                                    std::mt19937 &gen) {
+  // 生成重心坐标
+  float r[3];
+  sample_barycentric_uniform(r, gen);
 
   // 计算采样点坐标
   for (int d = 0; d < dim; ++d) {
-    point[d] = r0 * v0[d] + r1 * v1[d] + r2 * v2[d];
+    point[d] = r[0] * v0[d] + r[1] * v1[d] + r[2] * v2[d];
+  }
+}
+
+std::tuple<torch::Tensor, torch::Tensor>
+farthest_surface_point_sampling(torch::Tensor vertices, torch::Tensor triangles,
+                                int sample_point_num, int candidate_num) {
+  StageTimer stage("farthest_surface_point_sampling");
+
+  // 检查输入张量的维度
+  if (vertices.dim() != 2 || triangles.dim() != 2) {
+    throw std::runtime_error("Input tensors have incorrect dimensions");
+  }
+
+  const int dim = vertices.size(1);
+  if (dim != 3) {
+    throw std::runtime_error(
+        "Triangle area calculation only supports 3D points");
+  }
+
+  const float *vertices_ptr = vertices.data_ptr<float>();
+  const int *triangles_ptr = triangles.data_ptr<int>();
+  const int num_faces = triangles.size(0);
+
+  if (sample_point_num <= 0 || num_faces == 0) {
+    throw std::runtime_error("Sample size and face count must be positive");
+  }
+
+  candidate_num = std::max(candidate_num, sample_point_num);
+
+  // 面积前缀和，按面积比例选取候选点所在的面片
+  StageTimer candidates_stage("candidates");
+  std::vector<float> face_areas(num_faces);
+
+#pragma omp parallel for
+  for (int f = 0; f < num_faces; ++f) {
+    const float *v0 = vertices_ptr + triangles_ptr[f * 3] * dim;
+    const float *v1 = vertices_ptr + triangles_ptr[f * 3 + 1] * dim;
+    const float *v2 = vertices_ptr + triangles_ptr[f * 3 + 2] * dim;
+    face_areas[f] = compute_triangle_area(v0, v1, v2, dim);
   }
+
+  std::vector<double> cumulative_areas(num_faces);
+  double total_area = 0.0;
+  for (int f = 0; f < num_faces; ++f) {
+    total_area += face_areas[f];
+    cumulative_areas[f] = total_area;
+  }
+
+  if (total_area <= 0.0) {
+    throw std::runtime_error("Mesh surface area is zero");
+  }
+
+  // 候选点：所在面片、重心坐标与三维坐标
+  std::vector<int> candidate_faces(candidate_num);
+  std::vector<float> candidate_barycentrics(candidate_num * 3);
+  std::vector<float> candidate_points(candidate_num * dim);
+
+#pragma omp parallel
+  {
+    // 每个线程使用不同的随机数生成器种子
+    std::random_device rd;
+    std::mt19937 gen(rd());
+    std::uniform_real_distribution<double> area_dist(0.0, total_area);
+
+#pragma omp for
+    for (int i = 0; i < candidate_num; ++i) {
+      const double target = area_dist(gen);
+      int face_idx = static_cast<int>(
+          std::upper_bound(cumulative_areas.begin(), cumulative_areas.end(),
+                           target) -
+          cumulative_areas.begin());
+      face_idx = std::min(face_idx, num_faces - 1);
+
+      float *barycentric = candidate_barycentrics.data() + i * 3;
+      sample_barycentric_uniform(barycentric, gen);
+
+      const float *v0 = vertices_ptr + triangles_ptr[face_idx * 3] * dim;
+      const float *v1 = vertices_ptr + triangles_ptr[face_idx * 3 + 1] * dim;
+      const float *v2 = vertices_ptr + triangles_ptr[face_idx * 3 + 2] * dim;
+      float *point = candidate_points.data() + i * dim;
+      for (int d = 0; d < dim; ++d) {
+        point[d] = barycentric[0] * v0[d] + barycentric[1] * v1[d] +
+                   barycentric[2] * v2[d];
+      }
+
+      candidate_faces[i] = face_idx;
+    }
+  }
+
+  candidates_stage.stop();
+
+  // 候选点已随机分布，直接以第一个候选点为起点
+  StageTimer fps_stage("farthest_point_sampling");
+  const std::vector<int> sampled_indices = sample_farthest_indices(
+      candidate_points.data(), candidate_num, dim, sample_point_num, 0);
+  fps_stage.stop();
+  recordCount("fps_points", candidate_num);
+  recordCount("seeds", sample_point_num);
+
+  torch::Tensor seed_faces =
+      torch::empty({sample_point_num}, torch::TensorOptions().dtype(torch::kInt32));
+  torch::Tensor seed_barycentrics = torch::empty(
+      {sample_point_num, 3}, torch::TensorOptions().dtype(torch::kFloat32));
+  int *seed_faces_ptr = seed_faces.data_ptr<int>();
+  float *seed_barycentrics_ptr = seed_barycentrics.data_ptr<float>();
+
+  for (int i = 0; i < sample_point_num; ++i) {
+    const int candidate_idx = sampled_indices[i];
+    seed_faces_ptr[i] = candidate_faces[candidate_idx];
+    for (int j = 0; j < 3; ++j) {
+      seed_barycentrics_ptr[i * 3 + j] =
+          candidate_barycentrics[candidate_idx * 3 + j];
+    }
+  }
+
+  return std::make_tuple(seed_faces, seed_barycentrics);
 }
 
 torch::Tensor
 toSubMeshSamplePoints(torch::Tensor vertices, torch::Tensor triangles,
                       const std::vector<std::vector<size_t>> &face_groups,
                       const int &points_per_submesh) {
+  StageTimer stage("toSubMeshSamplePoints");
+
   // 检查输入张量的维度
   if (vertices.dim() != 2 || triangles.dim() != 2) {
     throw std::runtime_error("Input tensors have incorrect dimensions");
@@ -168,6 +300,8 @@ toSubMeshSamplePoints(torch::Tensor vertices, torch::Tensor triangles,
   const int *triangles_ptr = triangles.data_ptr<int>();
 
   const int NUM_SUBMESHES = face_groups.size();
+  recordCount("samples", static_cast<int64_t>(NUM_SUBMESHES) *
+                             points_per_submesh);
 
   // 创建结果张量
   auto options = torch::TensorOptions().dtype(torch::kFloat32);
@@ -175,37 +309,34 @@ toSubMeshSamplePoints(torch::Tensor vertices, torch::Tensor triangles,
       torch::zeros({NUM_SUBMESHES, points_per_submesh, dim}, options);
   float *result_ptr = result.data_ptr<float>();
 
-  std::cout << "[INFO][sample::toSubMeshSamplePoints]" << std::endl;
-  std::cout << "\t start uniform sampling on submeshes..." << std::endl;
+  if (dim != 3) {
+    throw std::runtime_error(
+        "Triangle area calculation only supports 3D points");
+  }
+
+  const int num_faces = triangles.size(0);
+
+  // 面片面积表：各子网格相互重叠，每个面片只计算一次面积
+  std::vector<float> face_areas(num_faces);
+
+#pragma omp parallel for
+  for (int f = 0; f < num_faces; ++f) {
+    const float *v0 = vertices_ptr + triangles_ptr[f * 3] * dim;
+    const float *v1 = vertices_ptr + triangles_ptr[f * 3 + 1] * dim;
+    const float *v2 = vertices_ptr + triangles_ptr[f * 3 + 2] * dim;
+    face_areas[f] = compute_triangle_area(v0, v1, v2, dim);
+  }
 
-  // 为每个子网格收集三角形和计算面积
-  std::vector<std::vector<int>> submesh_triangles(NUM_SUBMESHES);
-  std::vector<std::vector<float>> submesh_areas(NUM_SUBMESHES);
-  std::vector<float> submesh_total_area(NUM_SUBMESHES, 0.0f);
+  // 每个子网格的总面积，采样时按各三角形面积占比分配点数
+  std::vector<float> submesh_areas(NUM_SUBMESHES, 0.0f);
 
-  // 直接使用提供的面片组
+#pragma omp parallel for schedule(dynamic)
   for (int submesh_id = 0; submesh_id < NUM_SUBMESHES; ++submesh_id) {
-    const auto &face_indices = face_groups[submesh_id];
-
-    // 将面片索引添加到子网格三角形列表
-    for (size_t i = 0; i < face_indices.size(); ++i) {
-      size_t f = face_indices[i];
-      submesh_triangles[submesh_id].push_back(static_cast<int>(f));
-
-      // 获取三角形顶点
-      int v0_idx = triangles_ptr[f * 3];
-      int v1_idx = triangles_ptr[f * 3 + 1];
-      int v2_idx = triangles_ptr[f * 3 + 2];
-
-      const float *v0 = vertices_ptr + v0_idx * dim;
-      const float *v1 = vertices_ptr + v1_idx * dim;
-      const float *v2 = vertices_ptr + v2_idx * dim;
-
-      // 计算三角形面积
-      float area = compute_triangle_area(v0, v1, v2, dim);
-      submesh_areas[submesh_id].push_back(area);
-      submesh_total_area[submesh_id] += area;
+    float sum = 0.0f;
+    for (const auto &face_idx : face_groups[submesh_id]) {
+      sum += face_areas[face_idx];
     }
+    submesh_areas[submesh_id] = sum;
   }
 
 // 并行处理每个子网格
@@ -217,9 +348,8 @@ toSubMeshSamplePoints(torch::Tensor vertices, torch::Tensor triangles,
 
 #pragma omp for schedule(dynamic)
     for (int submesh_id = 0; submesh_id < NUM_SUBMESHES; ++submesh_id) {
-      const auto &triangle_indices = submesh_triangles[submesh_id];
-      const auto &areas = submesh_areas[submesh_id];
-      const float total_area = submesh_total_area[submesh_id];
+      const auto &triangle_indices = face_groups[submesh_id];
+      const float total_area = submesh_areas[submesh_id];
 
       if (triangle_indices.empty() || total_area <= 0.0f) {
         // 如果子网格为空或面积为零，填充零
@@ -238,7 +368,7 @@ toSubMeshSamplePoints(torch::Tensor vertices, torch::Tensor triangles,
 
       for (size_t i = 0; i < triangle_indices.size(); ++i) {
         // 根据面积比例分配点数
-        float area_ratio = areas[i] / total_area;
+        float area_ratio = face_areas[triangle_indices[i]] / total_area;
         int num_points = static_cast<int>(area_ratio * points_per_submesh);
         points_per_triangle[i] = num_points;
         total_assigned += num_points;
@@ -250,9 +380,10 @@ toSubMeshSamplePoints(torch::Tensor vertices, torch::Tensor triangles,
         // 将剩余点分配给最大的三角形
         int max_area_idx = 0;
         float max_area = 0.0f;
-        for (size_t i = 0; i < areas.size(); ++i) {
-          if (areas[i] > max_area) {
-            max_area = areas[i];
+        for (size_t i = 0; i < triangle_indices.size(); ++i) {
+          const float area = face_areas[triangle_indices[i]];
+          if (area > max_area) {
+            max_area = area;
             max_area_idx = i;
           }
         }
@@ -299,6 +430,5 @@ toSubMeshSamplePoints(torch::Tensor vertices, torch::Tensor triangles,
     }
   }
 
-  std::cout << "\t uniform sampling completed" << std::endl;
   return result;
 }
@@ -0,0 +1,427 @@
+#include "sphere_cut.h"
+#include "region_growing.h"
+#include "stats.h"
+#include <cmath>
+#include <stdexcept>
+#include <unordered_map>
+
+namespace {
+
+using Vec3 = std::array<double, 3>;
+
+inline Vec3 sub(const Vec3 &a, const Vec3 &b) {
+  return {a[0] - b[0], a[1] - b[1], a[2] - b[2]};
+}
+
+inline Vec3 add(const Vec3 &a, const Vec3 &b) {
+  return {a[0] + b[0], a[1] + b[1], a[2] + b[2]};
+}
+
+inline Vec3 scale(const Vec3 &a, const double s) {
+  return {a[0] * s, a[1] * s, a[2] * s};
+}
+
+inline double dot(const Vec3 &a, const Vec3 &b) {
+  return a[0] * b[0] + a[1] * b[1] + a[2] * b[2];
+}
+
+inline Vec3 cross(const Vec3 &a, const Vec3 &b) {
+  return {a[1] * b[2] - a[2] * b[1], a[2] * b[0] - a[0] * b[2],
+          a[0] * b[1] - a[1] * b[0]};
+}
+
+// 顶点键：原始顶点为 {v, v, 2}，边上交点为 {lo, hi, k}，k 为沿 lo->hi 方向的根序号
+using PointKey = std::array<size_t, 3>;
+
+struct PointKeyHash {
+  size_t operator()(const PointKey &k) const {
+    size_t h = std::hash<size_t>()(k[0]);
+    h ^= std::hash<size_t>()(k[1]) + 0x9e3779b97f4a7c15ULL + (h << 6) + (h >> 2);
+    h ^= std::hash<size_t>()(k[2]) + 0x9e3779b97f4a7c15ULL + (h << 6) + (h >> 2);
+    return h;
+  }
+};
+
+// 裁剪多边形上的一个点，shared 为 false 表示圆弧上新生成的点
+struct ClipPoint {
+  Vec3 p;
+  bool shared;
+  PointKey key;
+};
+
+// 球与平面相交得到的圆
+struct PlaneCircle {
+  Vec3 center;
+  Vec3 normal;
+  double radius;
+};
+
+class PatchBuilder {
+public:
+  explicit PatchBuilder(SpherePatch &patch) : patch_(patch) {}
+
+  size_t addPoint(const ClipPoint &point) {
+    if (!point.shared) {
+      return addVertex(point.p, -1);
+    }
+
+    const auto it = key_to_local_.find(point.key);
+    if (it != key_to_local_.end()) {
+      return it->second;
+    }
+
+    const bool is_source_vertex = point.key[2] == 2;
+    const size_t local_idx = addVertex(
+        point.p, is_source_vertex ? static_cast<int64_t>(point.key[0]) : -1);
+    key_to_local_.emplace(point.key, local_idx);
+    return local_idx;
+  }
+
+  void addFace(const size_t &a, const size_t &b, const size_t &c,
+               const size_t &source_face) {
+    patch_.faces.push_back({a, b, c});
+    patch_.face_map.push_back(source_face);
+  }
+
+private:
+  size_t addVertex(const Vec3 &p, const int64_t &source_vertex) {
+    patch_.vertices.push_back(p);
+    patch_.vertex_map.push_back(source_vertex);
+    return patch_.vertices.size() - 1;
+  }
+
+  SpherePatch &patch_;
+  std::unordered_map<PointKey, size_t, PointKeyHash> key_to_local_;
+};
+
+// 求线段 lo->hi 与球面的交点参数，仅保留 (0, 1) 内的根
+// 交点个数与端点内外状态保持一致，避免数值误差在顶点附近产生伪交点
+int segment_sphere_roots(const Vec3 &p0, const Vec3 &p1, const bool &p0_inside,
+                         const bool &p1_inside, const Vec3 &center,
+                         const double &radius_squared, double roots[2],
+                         size_t root_ids[2]) {
+  if (p0_inside && p1_inside) {
+    return 0;
+  }
+
+  const Vec3 d = sub(p1, p0);
+  const Vec3 f = sub(p0, center);
+  const double a = dot(d, d);
+  if (a <= 0.0) {
+    return 0;
+  }
+
+  const double b = 2.0 * dot(f, d);
+  const double c = dot(f, f) - radius_squared;
+  const double disc = b * b - 4.0 * a * c;
+  if (disc <= 0.0) {
+    return 0;
+  }
+
+  const double s = std::sqrt(disc);
+  const double t[2] = {(-b - s) / (2.0 * a), (-b + s) / (2.0 * a)};
+  const double eps = 1e-9;
+
+  // 一端在球内时只有一个交点：p0 在内为离开点，p1 在内为进入点
+  // 交点与球内端点重合时由该端点代替，靠近球外端点时截断到线段上
+  if (p0_inside || p1_inside) {
+    const size_t k = p0_inside ? 1 : 0;
+    const double inside_dist = p0_inside ? t[k] : 1.0 - t[k];
+    if (inside_dist <= eps) {
+      return 0;
+    }
+    roots[0] = std::min(t[k], 1.0);
+    roots[0] = std::max(roots[0], 0.0);
+    root_ids[0] = k;
+    return 1;
+  }
+
+  // 两端都在球外时交点成对出现
+  if (t[0] > 0.0 && t[1] < 1.0 && t[1] - t[0] > eps) {
+    roots[0] = t[0];
+    roots[1] = t[1];
+    root_ids[0] = 0;
+    root_ids[1] = 1;
+    return 2;
+  }
+  return 0;
+}
+
+// 沿圆弧逆时针（绕平面法向）从 from 到 to 插入离散点，不包含两个端点
+// 仅 full_circle 时绕行整圆，from 与 to 重合时不插入任何点
+void append_arc(std::vector<ClipPoint> &polygon, const PlaneCircle &circle,
+                const Vec3 &from, const Vec3 &to, const double &max_step,
+                const bool &full_circle) {
+  const Vec3 u = sub(from, circle.center);
+  const Vec3 w = sub(to, circle.center);
+  const Vec3 v = cross(circle.normal, u);
+
+  double angle = 2.0 * M_PI;
+  if (!full_circle) {
+    const Vec3 gap = sub(to, from);
+    const double eps = 1e-9 * circle.radius;
+    if (dot(gap, gap) <= eps * eps) {
+      return;
+    }
+
+    angle = std::atan2(dot(circle.normal, cross(u, w)), dot(u, w));
+    if (angle <= 0.0) {
+      angle += 2.0 * M_PI;
+    }
+  }
+
+  const size_t steps = std::max<size_t>(
+      full_circle ? 3 : 1, static_cast<size_t>(std::ceil(angle / max_step)));
+  const double delta = angle / static_cast<double>(steps);
+
+  for (size_t i = 1; i < steps; ++i) {
+    const double phi = delta * static_cast<double>(i);
+    const Vec3 p = add(circle.center, add(scale(u, std::cos(phi)),
+                                          scale(v, std::sin(phi))));
+    polygon.push_back({p, false, {0, 0, 0}});
+  }
+}
+
+// 将三角形与球求交，得到按源面片绕向排列的凸多边形
+void clip_triangle_by_sphere(
+    std::vector<ClipPoint> &polygon,
+    const std::vector<std::array<double, 3>> &vertices,
+    const std::array<size_t, 3> &face, const bool inside[3],
+    const PlaneCircle &circle, const Vec3 &center, const double &radius_squared,
+    const double &tolerance) {
+  polygon.clear();
+
+  const double max_step =
+      circle.radius > tolerance
+          ? 2.0 * std::acos(1.0 - tolerance / circle.radius)
+          : 2.0 * M_PI;
+
+  bool pending_arc = false;
+  bool wrap_arc = false;
+
+  const auto emit = [&](const ClipPoint &point) {
+    if (pending_arc) {
+      if (polygon.empty()) {
+        wrap_arc = true;
+      } else {
+        append_arc(polygon, circle, polygon.back().p, point.p, max_step,
+                   false);
+      }
+      pending_arc = false;
+    }
+    polygon.push_back(point);
+  };
+
+  for (size_t i = 0; i < 3; ++i) {
+    const size_t vi = face[i];
+    const size_t vj = face[(i + 1) % 3];
+
+    if (inside[i]) {
+      emit({vertices[vi], true, {vi, vi, 2}});
+    } else {
+      pending_arc = true;
+    }
+
+    // 交点按 lo->hi 的规范方向计算，保证相邻面片共享同一交点
+    const size_t lo = std::min(vi, vj);
+    const size_t hi = std::max(vi, vj);
+    double roots[2];
+    size_t root_ids[2];
+    const bool lo_inside = vi == lo ? inside[i] : inside[(i + 1) % 3];
+    const bool hi_inside = vi == lo ? inside[(i + 1) % 3] : inside[i];
+    const int root_num =
+        segment_sphere_roots(vertices[lo], vertices[hi], lo_inside, hi_inside,
+                             center, radius_squared, roots, root_ids);
+
+    const Vec3 dir = sub(vertices[hi], vertices[lo]);
+    for (int r = 0; r < root_num; ++r) {
+      const int k = vi == lo ? r : root_num - 1 - r;
+      const Vec3 p = add(vertices[lo], scale(dir, roots[k]));
+      emit({p, true, {lo, hi, root_ids[k]}});
+    }
+  }
+
+  // 仅与球面相切时不产生有效区域
+  if (polygon.size() < 2) {
+    polygon.clear();
+    return;
+  }
+
+  if (pending_arc || wrap_arc) {
+    append_arc(polygon, circle, polygon.back().p, polygon.front().p, max_step,
+               false);
+  }
+}
+
+// 判断点是否位于三角形内部（点已在三角形所在平面上）
+bool point_in_triangle(const Vec3 &p, const Vec3 &a, const Vec3 &b,
+                       const Vec3 &c, const Vec3 &normal) {
+  return dot(normal, cross(sub(b, a), sub(p, a))) >= 0.0 &&
+         dot(normal, cross(sub(c, b), sub(p, b))) >= 0.0 &&
+         dot(normal, cross(sub(a, c), sub(p, c))) >= 0.0;
+}
+
+void cut_faces_by_sphere(SpherePatch &patch,
+                         const std::vector<std::array<double, 3>> &vertices,
+                         const std::vector<std::array<size_t, 3>> &faces,
+                         const std::vector<size_t> &candidate_faces,
+                         const Vec3 &center, const double &radius,
+                         const double &tolerance) {
+  const double radius_squared = radius * radius;
+  // 到球面距离小于 eps 的顶点视为在球面上并按球内处理，
+  // 其出入交点与顶点重合，由 segment_sphere_roots 去掉
+  const double on_sphere_radius = radius * (1.0 + 1e-9);
+  const double on_sphere_radius_squared = on_sphere_radius * on_sphere_radius;
+
+  PatchBuilder builder(patch);
+  std::vector<ClipPoint> polygon;
+  std::vector<size_t> local_ids;
+
+  for (size_t face_idx : candidate_faces) {
+    const auto &face = faces[face_idx];
+    const Vec3 &a = vertices[face[0]];
+    const Vec3 &b = vertices[face[1]];
+    const Vec3 &c = vertices[face[2]];
+
+    bool inside[3];
+    for (size_t i = 0; i < 3; ++i) {
+      const Vec3 d = sub(vertices[face[i]], center);
+      inside[i] = dot(d, d) <= on_sphere_radius_squared;
+    }
+
+    // 完全位于球内的面片直接保留
+    if (inside[0] && inside[1] && inside[2]) {
+      builder.addFace(builder.addPoint({a, true, {face[0], face[0], 2}}),
+                      builder.addPoint({b, true, {face[1], face[1], 2}}),
+                      builder.addPoint({c, true, {face[2], face[2], 2}}),
+                      face_idx);
+      continue;
+    }
+
+    Vec3 normal = cross(sub(b, a), sub(c, a));
+    const double normal_length = std::sqrt(dot(normal, normal));
+    if (normal_length <= 0.0) {
+      continue;
+    }
+    normal = scale(normal, 1.0 / normal_length);
+
+    const double plane_dist = dot(normal, sub(center, a));
+    if (std::abs(plane_dist) >= radius) {
+      continue;
+    }
+
+    PlaneCircle circle;
+    circle.center = sub(center, scale(normal, plane_dist));
+    circle.normal = normal;
+    circle.radius = std::sqrt(radius_squared - plane_dist * plane_dist);
+
+    clip_triangle_by_sphere(polygon, vertices, face, inside, circle, center,
+                            radius_squared, tolerance);
+
+    // 圆完全落在三角形内部时没有任何边界交点
+    if (polygon.empty() &&
+        point_in_triangle(circle.center, a, b, c, normal)) {
+      Vec3 axis = std::abs(normal[0]) < 0.9 ? Vec3{1.0, 0.0, 0.0}
+                                            : Vec3{0.0, 1.0, 0.0};
+      Vec3 u = cross(normal, axis);
+      u = scale(u, circle.radius / std::sqrt(dot(u, u)));
+      const Vec3 start = add(circle.center, u);
+
+      polygon.push_back({start, false, {0, 0, 0}});
+      const double max_step =
+          circle.radius > tolerance
+              ? 2.0 * std::acos(1.0 - tolerance / circle.radius)
+              : 2.0 * M_PI;
+      append_arc(polygon, circle, start, start, max_step, true);
+    }
+
+    if (polygon.size() < 3) {
+      continue;
+    }
+
+    local_ids.clear();
+    for (const auto &point : polygon) {
+      local_ids.push_back(builder.addPoint(point));
+    }
+
+    // 三角形与圆盘的交集为凸多边形，直接扇形三角化
+    for (size_t i = 1; i + 1 < local_ids.size(); ++i) {
+      builder.addFace(local_ids[0], local_ids[i], local_ids[i + 1], face_idx);
+    }
+  }
+}
+
+} // namespace
+
+std::vector<SpherePatch>
+cut_mesh_by_spheres(const std::vector<std::array<double, 3>> &vertices,
+                    const std::vector<std::array<size_t, 3>> &faces,
+                    const std::vector<std::array<double, 3>> &centers,
+                    const double &radius, const double &tolerance) {
+  StageTimer stage("cut_mesh_by_spheres");
+
+  if (radius <= 0.0) {
+    throw std::runtime_error("radius must be positive");
+  }
+  if (tolerance <= 0.0) {
+    throw std::runtime_error("tolerance must be positive");
+  }
+
+  std::vector<SpherePatch> patches(centers.size());
+  if (faces.empty() || centers.empty()) {
+    return patches;
+  }
+
+  // 以面片质心构建KD树，查询半径需额外加上面片的最大外接半径
+  PointCloud cloud;
+  cloud.points.resize(faces.size());
+  double max_face_extent = 0.0;
+  for (size_t i = 0; i < faces.size(); ++i) {
+    const auto &face = faces[i];
+    Vec3 centroid = scale(
+        add(add(vertices[face[0]], vertices[face[1]]), vertices[face[2]]),
+        1.0 / 3.0);
+    cloud.points[i] = centroid;
+    for (size_t j = 0; j < 3; ++j) {
+      const Vec3 d = sub(vertices[face[j]], centroid);
+      max_face_extent = std::max(max_face_extent, dot(d, d));
+    }
+  }
+  max_face_extent = std::sqrt(max_face_extent);
+
+  using KDTreeType = nanoflann::KDTreeSingleIndexAdaptor<
+      nanoflann::L2_Simple_Adaptor<double, PointCloud>, PointCloud, 3>;
+
+  KDTreeType index(3, cloud, {10});
+  index.buildIndex();
+
+  const double search_radius = radius + max_face_extent;
+  const double search_radius_squared = search_radius * search_radius;
+
+#pragma omp parallel for schedule(dynamic)
+  for (int64_t i = 0; i < static_cast<int64_t>(centers.size()); ++i) {
+    std::vector<nanoflann::ResultItem<uint32_t, double>> matches;
+    index.radiusSearch(centers[i].data(), search_radius_squared, matches,
+                       nanoflann::SearchParameters(0, false));
+
+    std::vector<size_t> candidate_faces;
+    candidate_faces.reserve(matches.size());
+    for (const auto &match : matches) {
+      candidate_faces.push_back(match.first);
+    }
+    std::sort(candidate_faces.begin(), candidate_faces.end());
+
+    cut_faces_by_sphere(patches[i], vertices, faces, candidate_faces,
+                        centers[i], radius, tolerance);
+  }
+
+  if (activeStats() != nullptr) {
+    int64_t patch_faces = 0;
+    for (const SpherePatch &patch : patches) {
+      patch_faces += patch.faces.size();
+    }
+    recordCount("sphere_patches", patches.size());
+    recordCount("sphere_patch_faces", patch_faces);
+  }
+  return patches;
+}
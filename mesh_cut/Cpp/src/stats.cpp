@@ -0,0 +1,246 @@
+#include "stats.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <omp.h>
+#include <stdexcept>
+#include <sys/resource.h>
+
+namespace {
+
+struct Frame {
+  std::string path;
+  std::chrono::steady_clock::time_point wall_start;
+  double cpu_start;
+  int threads;
+};
+
+thread_local CutStats *active_stats = nullptr;
+thread_local std::vector<Frame> frames;
+// pushActiveStats 保存的先前对象
+thread_local std::vector<CutStats *> pushed_stats;
+
+double processCpuSeconds() {
+  timespec ts;
+  clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts);
+  return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+// 进程启动以来的峰值常驻内存，只读取不重置
+size_t readPeakRss() {
+#if defined(__linux__)
+  FILE *file = fopen("/proc/self/status", "r");
+  if (file != nullptr) {
+    char line[256];
+    size_t kb = 0;
+    while (fgets(line, sizeof(line), file) != nullptr) {
+      if (std::strncmp(line, "VmHWM:", 6) == 0) {
+        kb = std::strtoull(line + 6, nullptr, 10);
+        break;
+      }
+    }
+    fclose(file);
+    if (kb > 0) {
+      return kb * 1024;
+    }
+  }
+#endif
+  rusage usage;
+  if (getrusage(RUSAGE_SELF, &usage) != 0) {
+    return 0;
+  }
+#if defined(__APPLE__)
+  return static_cast<size_t>(usage.ru_maxrss);
+#else
+  return static_cast<size_t>(usage.ru_maxrss) * 1024;
+#endif
+}
+
+void mergeCount(CutStats::Count &count, const int64_t &value,
+                const CutStats::CountKind &kind, const bool &is_new) {
+  count.kind = kind;
+  if (is_new) {
+    count.value = value;
+    return;
+  }
+  switch (kind) {
+  case CutStats::CountKind::Sum:
+    count.value += value;
+    break;
+  case CutStats::CountKind::Max:
+    count.value = std::max(count.value, value);
+    break;
+  case CutStats::CountKind::Min:
+    count.value = std::min(count.value, value);
+    break;
+  }
+}
+
+} // namespace
+
+void CutStats::addStage(const std::string &name, const double &wall_seconds,
+                        const double &cpu_seconds, const int &threads,
+                        const size_t &peak_rss_bytes) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  Stage &stage = stages_[name];
+  stage.wall_seconds += wall_seconds;
+  stage.cpu_seconds += cpu_seconds;
+  stage.calls += 1;
+  stage.threads = std::max(stage.threads, threads);
+  stage.peak_rss_bytes = std::max(stage.peak_rss_bytes, peak_rss_bytes);
+  peak_rss_bytes_ = std::max(peak_rss_bytes_, peak_rss_bytes);
+}
+
+void CutStats::addCount(const std::string &name, const int64_t &value,
+                        const CountKind &kind) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  const auto it = counts_.emplace(name, Count());
+  mergeCount(it.first->second, value, kind, it.second);
+}
+
+void CutStats::merge(const CutStats &other) {
+  if (&other == this) {
+    throw std::runtime_error("cannot merge stats into itself");
+  }
+  const std::map<std::string, Stage> other_stages = other.stages();
+  const std::map<std::string, Count> other_counts = other.counts();
+  const size_t other_peak = other.peakRssBytes();
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (const auto &item : other_stages) {
+    Stage &stage = stages_[item.first];
+    stage.wall_seconds += item.second.wall_seconds;
+    stage.cpu_seconds += item.second.cpu_seconds;
+    stage.calls += item.second.calls;
+    stage.threads = std::max(stage.threads, item.second.threads);
+    stage.peak_rss_bytes =
+        std::max(stage.peak_rss_bytes, item.second.peak_rss_bytes);
+  }
+  for (const auto &item : other_counts) {
+    const auto it = counts_.emplace(item.first, Count());
+    mergeCount(it.first->second, item.second.value, item.second.kind,
+               it.second);
+  }
+  peak_rss_bytes_ = std::max(peak_rss_bytes_, other_peak);
+}
+
+void CutStats::reset() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  stages_.clear();
+  counts_.clear();
+  peak_rss_bytes_ = 0;
+}
+
+std::map<std::string, CutStats::Stage> CutStats::stages() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return stages_;
+}
+
+std::map<std::string, CutStats::Count> CutStats::counts() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return counts_;
+}
+
+size_t CutStats::peakRssBytes() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return peak_rss_bytes_;
+}
+
+StatsScope::StatsScope(CutStats *stats) : previous_(active_stats) {
+  active_stats = stats;
+}
+
+StatsScope::~StatsScope() { active_stats = previous_; }
+
+CutStats *activeStats() { return active_stats; }
+
+void pushActiveStats(CutStats *stats) {
+  pushed_stats.push_back(active_stats);
+  active_stats = stats;
+}
+
+void popActiveStats(CutStats *stats) {
+  if (pushed_stats.empty() || active_stats != stats) {
+    throw std::runtime_error("stats are not active on this thread");
+  }
+  active_stats = pushed_stats.back();
+  pushed_stats.pop_back();
+}
+
+StageTimer::StageTimer(const char *name) : stats_(active_stats) {
+  if (stats_ == nullptr) {
+    return;
+  }
+
+  std::string path = name;
+  if (!frames.empty()) {
+    path = frames.back().path + "/" + path;
+  }
+
+  frames.push_back({std::move(path), std::chrono::steady_clock::now(),
+                    processCpuSeconds(), omp_get_max_threads()});
+}
+
+StageTimer::~StageTimer() { stop(); }
+
+void StageTimer::stop() {
+  if (stats_ == nullptr) {
+    return;
+  }
+
+  Frame frame = std::move(frames.back());
+  frames.pop_back();
+
+  const double wall_seconds = std::chrono::duration<double>(
+                                  std::chrono::steady_clock::now() -
+                                  frame.wall_start)
+                                  .count();
+  const double cpu_seconds = processCpuSeconds() - frame.cpu_start;
+  stats_->addStage(frame.path, wall_seconds, cpu_seconds, frame.threads,
+                   readPeakRss());
+  stats_ = nullptr;
+}
+
+void recordCount(const char *name, const int64_t &value,
+                 const CutStats::CountKind &kind) {
+  if (active_stats != nullptr) {
+    active_stats->addCount(name, value, kind);
+  }
+}
+
+void recordRegions(const std::vector<std::vector<size_t>> &regions,
+                   const size_t &num_faces) {
+  if (active_stats == nullptr) {
+    return;
+  }
+
+  std::vector<char> covered(num_faces, 0);
+  int64_t total = 0;
+  int64_t num_covered = 0;
+  int64_t max_size = 0;
+  int64_t min_size = regions.empty() ? 0 : INT64_MAX;
+  for (const auto &region : regions) {
+    const int64_t size = static_cast<int64_t>(region.size());
+    total += size;
+    max_size = std::max(max_size, size);
+    min_size = std::min(min_size, size);
+    for (const size_t f : region) {
+      if (f < num_faces && !covered[f]) {
+        covered[f] = 1;
+        ++num_covered;
+      }
+    }
+  }
+
+  using Kind = CutStats::CountKind;
+  active_stats->addCount("regions", static_cast<int64_t>(regions.size()));
+  active_stats->addCount("region_faces", total);
+  active_stats->addCount("region_size_max", max_size, Kind::Max);
+  active_stats->addCount("region_size_min", min_size, Kind::Min);
+  active_stats->addCount("region_overlap_faces", total - num_covered);
+  active_stats->addCount("region_uncovered_faces",
+                         static_cast<int64_t>(num_faces) - num_covered);
+}
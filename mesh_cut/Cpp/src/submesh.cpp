@@ -0,0 +1,160 @@
+#include "submesh.h"
+#include "stats.h"
+#include <algorithm>
+#include <cstdint>
+#include <omp.h>
+#include <stdexcept>
+
+namespace {
+
+// 按纪元号标记的全局到局部顶点映射表，切换区域时只需递增纪元号
+struct VertexRemap {
+  std::vector<uint32_t> epochs;
+  std::vector<int32_t> local_indices;
+  uint32_t epoch = 0;
+
+  explicit VertexRemap(const size_t num_vertices)
+      : epochs(num_vertices, 0), local_indices(num_vertices, 0) {}
+
+  void nextRegion() {
+    if (++epoch == 0) {
+      // 纪元号回绕时清空标记
+      std::fill(epochs.begin(), epochs.end(), 0);
+      epoch = 1;
+    }
+  }
+
+  // 返回顶点的局部编号，首次出现时分配为next_local并返回true
+  bool map(const int32_t vertex, const int32_t next_local, int32_t &local) {
+    if (epochs[vertex] == epoch) {
+      local = local_indices[vertex];
+      return false;
+    }
+    epochs[vertex] = epoch;
+    local_indices[vertex] = next_local;
+    local = next_local;
+    return true;
+  }
+};
+
+} // namespace
+
+std::tuple<torch::Tensor, torch::Tensor, torch::Tensor, torch::Tensor,
+           torch::Tensor>
+extract_submeshes(torch::Tensor vertices, torch::Tensor triangles,
+                  const std::vector<std::vector<size_t>> &regions) {
+  StageTimer stage("extract_submeshes");
+
+  if (vertices.dim() != 2 || vertices.size(1) != 3) {
+    throw std::runtime_error("vertices must have shape (N, 3)");
+  }
+  if (triangles.dim() != 2 || triangles.size(1) != 3) {
+    throw std::runtime_error("triangles must have shape (M, 3)");
+  }
+
+  const int64_t num_vertices = vertices.size(0);
+  const int64_t num_faces = triangles.size(0);
+  const float *vertices_ptr = vertices.data_ptr<float>();
+  const int *triangles_ptr = triangles.data_ptr<int>();
+
+  bool valid_triangles = true;
+#pragma omp parallel for reduction(&& : valid_triangles)
+  for (int64_t i = 0; i < num_faces * 3; ++i) {
+    valid_triangles = valid_triangles && triangles_ptr[i] >= 0 &&
+                      triangles_ptr[i] < num_vertices;
+  }
+  if (!valid_triangles) {
+    throw std::runtime_error("triangle vertex index out of range");
+  }
+
+  const int64_t num_regions = regions.size();
+
+  // 面片偏移可直接由区域大小得到
+  auto index_options = torch::TensorOptions().dtype(torch::kInt64);
+  torch::Tensor face_offsets = torch::empty({num_regions + 1}, index_options);
+  int64_t *face_offsets_ptr = face_offsets.data_ptr<int64_t>();
+  face_offsets_ptr[0] = 0;
+  for (int64_t r = 0; r < num_regions; ++r) {
+    for (const size_t f : regions[r]) {
+      if (f >= static_cast<size_t>(num_faces)) {
+        throw std::runtime_error("region face index out of range");
+      }
+    }
+    face_offsets_ptr[r + 1] = face_offsets_ptr[r] + regions[r].size();
+  }
+
+  // 第一遍：统计各区域的顶点数量
+  torch::Tensor vertex_offsets = torch::empty({num_regions + 1}, index_options);
+  int64_t *vertex_offsets_ptr = vertex_offsets.data_ptr<int64_t>();
+  vertex_offsets_ptr[0] = 0;
+
+#pragma omp parallel
+  {
+    VertexRemap remap(num_vertices);
+
+#pragma omp for schedule(dynamic)
+    for (int64_t r = 0; r < num_regions; ++r) {
+      remap.nextRegion();
+      int32_t count = 0;
+      int32_t local = 0;
+      for (const size_t f : regions[r]) {
+        for (int j = 0; j < 3; ++j) {
+          if (remap.map(triangles_ptr[f * 3 + j], count, local)) {
+            ++count;
+          }
+        }
+      }
+      vertex_offsets_ptr[r + 1] = count;
+    }
+  }
+
+  for (int64_t r = 0; r < num_regions; ++r) {
+    vertex_offsets_ptr[r + 1] += vertex_offsets_ptr[r];
+  }
+
+  const int64_t total_vertices = vertex_offsets_ptr[num_regions];
+  const int64_t total_faces = face_offsets_ptr[num_regions];
+  recordCount("submesh_vertices", total_vertices);
+  recordCount("submesh_faces", total_faces);
+
+  torch::Tensor submesh_vertices = torch::empty(
+      {total_vertices, 3}, torch::TensorOptions().dtype(torch::kFloat32));
+  torch::Tensor submesh_faces = torch::empty(
+      {total_faces, 3}, torch::TensorOptions().dtype(torch::kInt32));
+  torch::Tensor vertex_map = torch::empty({total_vertices}, index_options);
+  float *submesh_vertices_ptr = submesh_vertices.data_ptr<float>();
+  int *submesh_faces_ptr = submesh_faces.data_ptr<int>();
+  int64_t *vertex_map_ptr = vertex_map.data_ptr<int64_t>();
+
+  // 第二遍：按相同顺序重新编号，直接写入各区域的输出区间
+#pragma omp parallel
+  {
+    VertexRemap remap(num_vertices);
+
+#pragma omp for schedule(dynamic)
+    for (int64_t r = 0; r < num_regions; ++r) {
+      remap.nextRegion();
+      const int64_t vertex_begin = vertex_offsets_ptr[r];
+      int *faces_out = submesh_faces_ptr + face_offsets_ptr[r] * 3;
+      int32_t count = 0;
+      int32_t local = 0;
+      for (const size_t f : regions[r]) {
+        for (int j = 0; j < 3; ++j) {
+          const int32_t vertex = triangles_ptr[f * 3 + j];
+          if (remap.map(vertex, count, local)) {
+            const int64_t out = vertex_begin + count;
+            vertex_map_ptr[out] = vertex;
+            for (int d = 0; d < 3; ++d) {
+              submesh_vertices_ptr[out * 3 + d] = vertices_ptr[vertex * 3 + d];
+            }
+            ++count;
+          }
+          *faces_out++ = local;
+        }
+      }
+    }
+  }
+
+  return std::make_tuple(submesh_vertices, submesh_faces, vertex_offsets,
+                         face_offsets, vertex_map);
+}
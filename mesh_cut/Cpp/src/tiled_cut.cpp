@@ -0,0 +1,1115 @@
+#include "tiled_cut.h"
+#include "context_pool.h"
+#include "result_cache.h"
+#include "stats.h"
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fcntl.h>
+#include <filesystem>
+#include <limits>
+#include <mcut/mcut.h>
+#include <memory>
+#include <mio/mio.h>
+#include <stdexcept>
+#include <sys/mman.h>
+#include <unistd.h>
+#include <unordered_map>
+
+namespace {
+
+using Vec3 = std::array<double, 3>;
+
+// MCUT 切割时每个源面片的估计工作内存（hmesh、BVH、kernel 内部副本与输出）
+constexpr size_t kBytesPerTileFace = 2048;
+// 每个分块写出器的缓冲区大小
+constexpr size_t kWriterBufferBytes = 1 << 16;
+// 网格划分阶段同时打开的分块文件上限
+constexpr size_t kMaxOpenTiles = 512;
+// 超出预算的分块最多二分的次数
+constexpr int kMaxSplitDepth = 24;
+
+// 文件的内存映射，页面由操作系统按需换入换出，不计入堆内存
+class MappedFile {
+public:
+  MappedFile(const std::string &path, const size_t &num_bytes,
+             const bool &writable)
+      : size_(num_bytes) {
+    fd_ = open(path.c_str(), writable ? (O_RDWR | O_CREAT) : O_RDONLY, 0644);
+    if (fd_ < 0) {
+      throw std::runtime_error("failed to open " + path);
+    }
+
+    if (writable && ftruncate(fd_, static_cast<off_t>(size_)) != 0) {
+      close(fd_);
+      throw std::runtime_error("failed to resize " + path);
+    }
+
+    if (size_ > 0) {
+      data_ = mmap(nullptr, size_, writable ? (PROT_READ | PROT_WRITE) : PROT_READ,
+                   MAP_SHARED, fd_, 0);
+      if (data_ == MAP_FAILED) {
+        close(fd_);
+        throw std::runtime_error("failed to map " + path);
+      }
+    }
+  }
+
+  ~MappedFile() {
+    if (data_ != nullptr) {
+      munmap(data_, size_);
+    }
+    close(fd_);
+  }
+
+  MappedFile(const MappedFile &) = delete;
+  MappedFile &operator=(const MappedFile &) = delete;
+
+  template <typename T> T *as() const { return static_cast<T *>(data_); }
+
+private:
+  int fd_ = -1;
+  void *data_ = nullptr;
+  size_t size_ = 0;
+};
+
+// 临时文件夹，以 mkdtemp 在给定前缀后追加唯一后缀创建，析构时整体删除。
+// 同一输出目录上并发或残留的调用因此互不影响
+class TempDir {
+public:
+  explicit TempDir(const std::string &prefix) {
+    std::string pattern = prefix + ".XXXXXX";
+    if (mkdtemp(&pattern[0]) == nullptr) {
+      throw std::runtime_error("failed to create temporary folder " + pattern);
+    }
+    path_ = pattern;
+  }
+
+  ~TempDir() {
+    std::error_code ec;
+    std::filesystem::remove_all(path_, ec);
+  }
+
+  std::string file(const std::string &name) const {
+    return (std::filesystem::path(path_) / name).string();
+  }
+
+private:
+  std::string path_;
+};
+
+struct BBox {
+  Vec3 min = {std::numeric_limits<double>::max(),
+              std::numeric_limits<double>::max(),
+              std::numeric_limits<double>::max()};
+  Vec3 max = {-std::numeric_limits<double>::max(),
+              -std::numeric_limits<double>::max(),
+              -std::numeric_limits<double>::max()};
+
+  void expand(const Vec3 &p) {
+    for (int i = 0; i < 3; ++i) {
+      min[i] = std::min(min[i], p[i]);
+      max[i] = std::max(max[i], p[i]);
+    }
+  }
+
+  bool overlaps(const BBox &other) const {
+    for (int i = 0; i < 3; ++i) {
+      if (max[i] < other.min[i] || other.max[i] < min[i]) {
+        return false;
+      }
+    }
+    return true;
+  }
+};
+
+// 逐行流式读取OBJ，只解析顶点坐标与面片顶点编号
+template <typename VertexFn, typename FaceFn>
+void streamOBJ(const std::string &path, VertexFn vertex_fn, FaceFn face_fn) {
+  FILE *file = fopen(path.c_str(), "r");
+  if (file == nullptr) {
+    throw std::runtime_error("failed to open " + path);
+  }
+
+  char *line = nullptr;
+  size_t capacity = 0;
+  int64_t num_vertices = 0;
+  std::vector<uint32_t> face;
+
+  while (getline(&line, &capacity, file) != -1) {
+    if (line[0] == 'v' && std::isspace(static_cast<unsigned char>(line[1]))) {
+      Vec3 p;
+      if (sscanf(line + 2, "%lf %lf %lf", &p[0], &p[1], &p[2]) != 3) {
+        free(line);
+        fclose(file);
+        throw std::runtime_error("invalid vertex in " + path);
+      }
+      vertex_fn(p);
+      ++num_vertices;
+    } else if (line[0] == 'f' &&
+               std::isspace(static_cast<unsigned char>(line[1]))) {
+      face.clear();
+      char *cursor = line + 1;
+      while (true) {
+        char *end = nullptr;
+        const long long idx = strtoll(cursor, &end, 10);
+        if (end == cursor) {
+          break;
+        }
+
+        // 正数编号从1开始，负数编号相对于当前已读顶点数
+        const int64_t vertex_idx = idx > 0 ? idx - 1 : num_vertices + idx;
+        if (idx == 0 || vertex_idx < 0 || vertex_idx >= num_vertices) {
+          free(line);
+          fclose(file);
+          throw std::runtime_error("invalid face index in " + path);
+        }
+        face.push_back(static_cast<uint32_t>(vertex_idx));
+
+        // 跳过纹理与法向编号 "v/vt/vn"
+        cursor = end;
+        while (*cursor != '\0' &&
+               !std::isspace(static_cast<unsigned char>(*cursor))) {
+          ++cursor;
+        }
+      }
+
+      if (face.size() >= 3) {
+        face_fn(face);
+      }
+    }
+  }
+
+  free(line);
+  fclose(file);
+}
+
+// 磁盘上的分块，记录格式为 [n][n 个全局顶点编号]
+struct Tile {
+  std::string path;
+  size_t num_faces = 0;
+  BBox bbox;
+  int depth = 0;
+};
+
+class TileWriter {
+public:
+  TileWriter(const std::string &path, const int &depth)
+      : buffer_(kWriterBufferBytes) {
+    tile_.path = path;
+    tile_.depth = depth;
+    file_ = fopen(path.c_str(), "wb");
+    if (file_ == nullptr) {
+      throw std::runtime_error("failed to create " + path);
+    }
+    setvbuf(file_, buffer_.data(), _IOFBF, buffer_.size());
+  }
+
+  ~TileWriter() { finish(); }
+
+  TileWriter(const TileWriter &) = delete;
+  TileWriter &operator=(const TileWriter &) = delete;
+
+  void write(const std::vector<uint32_t> &face, const Vec3 *vertices) {
+    const uint32_t n = static_cast<uint32_t>(face.size());
+    fwrite(&n, sizeof(uint32_t), 1, file_);
+    fwrite(face.data(), sizeof(uint32_t), n, file_);
+    for (const uint32_t &v : face) {
+      tile_.bbox.expand(vertices[v]);
+    }
+    tile_.num_faces++;
+  }
+
+  Tile finish() {
+    if (file_ != nullptr) {
+      fclose(file_);
+      file_ = nullptr;
+    }
+    return tile_;
+  }
+
+private:
+  FILE *file_ = nullptr;
+  std::vector<char> buffer_;
+  Tile tile_;
+};
+
+template <typename FaceFn> void readTile(const Tile &tile, FaceFn face_fn) {
+  FILE *file = fopen(tile.path.c_str(), "rb");
+  if (file == nullptr) {
+    throw std::runtime_error("failed to open " + tile.path);
+  }
+
+  std::vector<uint32_t> face;
+  uint32_t n = 0;
+  while (fread(&n, sizeof(uint32_t), 1, file) == 1) {
+    face.resize(n);
+    if (fread(face.data(), sizeof(uint32_t), n, file) != n) {
+      fclose(file);
+      throw std::runtime_error("truncated tile " + tile.path);
+    }
+    face_fn(face);
+  }
+
+  fclose(file);
+}
+
+inline Vec3 faceCentroid(const std::vector<uint32_t> &face,
+                         const Vec3 *vertices) {
+  Vec3 c = {0.0, 0.0, 0.0};
+  for (const uint32_t &v : face) {
+    for (int i = 0; i < 3; ++i) {
+      c[i] += vertices[v][i];
+    }
+  }
+  for (int i = 0; i < 3; ++i) {
+    c[i] /= static_cast<double>(face.size());
+  }
+  return c;
+}
+
+// 按均匀网格将面片质心划分到分块，再将超出预算的分块沿最长轴二分
+std::vector<Tile> partitionTiles(const std::string &mesh_file_path,
+                                 const TempDir &temp_dir, const Vec3 *vertices,
+                                 const BBox &bbox, const size_t &num_faces,
+                                 const size_t &max_tile_faces) {
+  const size_t target_tiles =
+      std::max<size_t>(1, (num_faces + max_tile_faces - 1) / max_tile_faces);
+
+  Vec3 extent;
+  for (int i = 0; i < 3; ++i) {
+    extent[i] = std::max(bbox.max[i] - bbox.min[i], 0.0);
+  }
+  const double max_extent =
+      std::max(extent[0], std::max(extent[1], extent[2]));
+
+  double cell_size = max_extent > 0.0 ? max_extent : 1.0;
+  if (max_extent > 0.0) {
+    const double volume = std::max(extent[0], max_extent * 1e-6) *
+                          std::max(extent[1], max_extent * 1e-6) *
+                          std::max(extent[2], max_extent * 1e-6);
+    cell_size = std::cbrt(volume / static_cast<double>(target_tiles));
+  }
+
+  std::array<size_t, 3> dims;
+  while (true) {
+    for (int i = 0; i < 3; ++i) {
+      dims[i] = std::max<size_t>(
+          1, static_cast<size_t>(std::ceil(extent[i] / cell_size)));
+    }
+    if (dims[0] * dims[1] * dims[2] <= kMaxOpenTiles) {
+      break;
+    }
+    cell_size *= 1.25;
+  }
+
+  const size_t num_cells = dims[0] * dims[1] * dims[2];
+  std::vector<std::unique_ptr<TileWriter>> writers(num_cells);
+
+  streamOBJ(
+      mesh_file_path, [](const Vec3 &) {},
+      [&](const std::vector<uint32_t> &face) {
+        const Vec3 c = faceCentroid(face, vertices);
+        size_t cell = 0;
+        for (int i = 2; i >= 0; --i) {
+          const size_t d = std::min(
+              dims[i] - 1, static_cast<size_t>(std::max(
+                               0.0, (c[i] - bbox.min[i]) / cell_size)));
+          cell = cell * dims[i] + d;
+        }
+
+        if (!writers[cell]) {
+          writers[cell].reset(new TileWriter(
+              temp_dir.file("tile_" + std::to_string(cell) + ".bin"), 0));
+        }
+        writers[cell]->write(face, vertices);
+      });
+
+  std::vector<Tile> pending;
+  for (std::unique_ptr<TileWriter> &writer : writers) {
+    if (writer) {
+      pending.push_back(writer->finish());
+    }
+  }
+  writers.clear();
+
+  std::vector<Tile> tiles;
+  size_t split_counter = 0;
+
+  while (!pending.empty()) {
+    Tile tile = pending.back();
+    pending.pop_back();
+
+    if (tile.num_faces <= max_tile_faces || tile.depth >= kMaxSplitDepth) {
+      tiles.push_back(tile);
+      continue;
+    }
+
+    int axis = 0;
+    for (int i = 1; i < 3; ++i) {
+      if (tile.bbox.max[i] - tile.bbox.min[i] >
+          tile.bbox.max[axis] - tile.bbox.min[axis]) {
+        axis = i;
+      }
+    }
+    const double mid = 0.5 * (tile.bbox.min[axis] + tile.bbox.max[axis]);
+
+    TileWriter lower(temp_dir.file("split_" + std::to_string(split_counter++) +
+                                   ".bin"),
+                     tile.depth + 1);
+    TileWriter upper(temp_dir.file("split_" + std::to_string(split_counter++) +
+                                   ".bin"),
+                     tile.depth + 1);
+
+    readTile(tile, [&](const std::vector<uint32_t> &face) {
+      if (faceCentroid(face, vertices)[axis] < mid) {
+        lower.write(face, vertices);
+      } else {
+        upper.write(face, vertices);
+      }
+    });
+
+    const Tile lower_tile = lower.finish();
+    const Tile upper_tile = upper.finish();
+
+    // 所有质心重合时无法再分，保留原分块
+    if (lower_tile.num_faces == 0 || upper_tile.num_faces == 0) {
+      std::remove(lower_tile.path.c_str());
+      std::remove(upper_tile.path.c_str());
+      tile.depth = kMaxSplitDepth;
+      tiles.push_back(tile);
+      continue;
+    }
+
+    std::remove(tile.path.c_str());
+    pending.push_back(lower_tile);
+    pending.push_back(upper_tile);
+  }
+
+  return tiles;
+}
+
+// 切割网格（整体载入内存）
+struct CutMesh {
+  std::vector<double> vertices;
+  std::vector<uint32_t> face_indices;
+  std::vector<uint32_t> face_sizes;
+  std::vector<BBox> face_bboxes;
+  BBox bbox;
+  bool is_closed = false;
+
+  // 面片包围盒的均匀网格索引（CSR），单元 c 内的面片为
+  // grid_faces[grid_offsets[c] .. grid_offsets[c + 1]]
+  std::array<size_t, 3> grid_dims = {1, 1, 1};
+  Vec3 grid_cell_size = {1.0, 1.0, 1.0};
+  std::vector<uint32_t> grid_offsets;
+  std::vector<uint32_t> grid_faces;
+
+  // 包围盒在网格中覆盖的单元范围 [lo, hi]
+  void cellRange(const BBox &box, std::array<size_t, 3> &lo,
+                 std::array<size_t, 3> &hi) const {
+    for (int i = 0; i < 3; ++i) {
+      const auto cell = [&](const double &x) {
+        const double d = std::floor((x - bbox.min[i]) / grid_cell_size[i]);
+        return static_cast<size_t>(std::min(
+            std::max(d, 0.0), static_cast<double>(grid_dims[i] - 1)));
+      };
+      lo[i] = cell(box.min[i]);
+      hi[i] = cell(box.max[i]);
+    }
+  }
+
+  void buildGrid() {
+    const double cells_per_axis =
+        std::max(1.0, std::cbrt(static_cast<double>(face_bboxes.size())));
+    for (int i = 0; i < 3; ++i) {
+      const double extent = bbox.max[i] - bbox.min[i];
+      grid_dims[i] = extent > 0.0 ? static_cast<size_t>(cells_per_axis) : 1;
+      grid_cell_size[i] =
+          extent > 0.0 ? extent / static_cast<double>(grid_dims[i]) : 1.0;
+    }
+
+    // 两遍计数排序：先统计每个单元的面片数，再填入
+    grid_offsets.assign(grid_dims[0] * grid_dims[1] * grid_dims[2] + 1, 0);
+    for (int pass = 0; pass < 2; ++pass) {
+      std::vector<uint32_t> cursor;
+      if (pass == 1) {
+        for (size_t c = 1; c < grid_offsets.size(); ++c) {
+          grid_offsets[c] += grid_offsets[c - 1];
+        }
+        grid_faces.resize(grid_offsets.back());
+        cursor.assign(grid_offsets.begin(), grid_offsets.end() - 1);
+      }
+
+      for (uint32_t f = 0; f < face_bboxes.size(); ++f) {
+        std::array<size_t, 3> lo, hi;
+        cellRange(face_bboxes[f], lo, hi);
+        for (size_t z = lo[2]; z <= hi[2]; ++z) {
+          for (size_t y = lo[1]; y <= hi[1]; ++y) {
+            for (size_t x = lo[0]; x <= hi[0]; ++x) {
+              const size_t c = (z * grid_dims[1] + y) * grid_dims[0] + x;
+              if (pass == 0) {
+                grid_offsets[c + 1]++;
+              } else {
+                grid_faces[cursor[c]++] = f;
+              }
+            }
+          }
+        }
+      }
+    }
+  }
+
+  bool overlaps(const BBox &box) const {
+    if (!bbox.overlaps(box)) {
+      return false;
+    }
+
+    std::array<size_t, 3> lo, hi;
+    cellRange(box, lo, hi);
+    for (size_t z = lo[2]; z <= hi[2]; ++z) {
+      for (size_t y = lo[1]; y <= hi[1]; ++y) {
+        for (size_t x = lo[0]; x <= hi[0]; ++x) {
+          const size_t c = (z * grid_dims[1] + y) * grid_dims[0] + x;
+          for (uint32_t i = grid_offsets[c]; i < grid_offsets[c + 1]; ++i) {
+            if (face_bboxes[grid_faces[i]].overlaps(box)) {
+              return true;
+            }
+          }
+        }
+      }
+    }
+    return false;
+  }
+
+  // 射线奇偶性判断点是否位于闭合切割网格内部
+  bool contains(const Vec3 &p) const {
+    const Vec3 dir = {0.5773502691896258, 0.5773502691896257,
+                      0.5773502691896259};
+    size_t num_hits = 0;
+    size_t offset = 0;
+    for (const uint32_t &face_size : face_sizes) {
+      const double *a = &vertices[3 * face_indices[offset]];
+      for (uint32_t i = 1; i + 1 < face_size; ++i) {
+        const double *b = &vertices[3 * face_indices[offset + i]];
+        const double *c = &vertices[3 * face_indices[offset + i + 1]];
+        const Vec3 e1 = {b[0] - a[0], b[1] - a[1], b[2] - a[2]};
+        const Vec3 e2 = {c[0] - a[0], c[1] - a[1], c[2] - a[2]};
+        const Vec3 q = {dir[1] * e2[2] - dir[2] * e2[1],
+                        dir[2] * e2[0] - dir[0] * e2[2],
+                        dir[0] * e2[1] - dir[1] * e2[0]};
+        const double det = e1[0] * q[0] + e1[1] * q[1] + e1[2] * q[2];
+        if (std::fabs(det) < 1e-300) {
+          continue;
+        }
+        const Vec3 s = {p[0] - a[0], p[1] - a[1], p[2] - a[2]};
+        const double u = (s[0] * q[0] + s[1] * q[1] + s[2] * q[2]) / det;
+        if (u < 0.0 || u > 1.0) {
+          continue;
+        }
+        const Vec3 r = {s[1] * e1[2] - s[2] * e1[1],
+                        s[2] * e1[0] - s[0] * e1[2],
+                        s[0] * e1[1] - s[1] * e1[0]};
+        const double v = (dir[0] * r[0] + dir[1] * r[1] + dir[2] * r[2]) / det;
+        if (v < 0.0 || u + v > 1.0) {
+          continue;
+        }
+        const double t = (e2[0] * r[0] + e2[1] * r[1] + e2[2] * r[2]) / det;
+        if (t > 0.0) {
+          num_hits++;
+        }
+      }
+      offset += face_size;
+    }
+    return (num_hits % 2) == 1;
+  }
+};
+
+CutMesh loadCutMesh(const std::string &cut_mesh_file_path) {
+  MioMesh mio_mesh = {
+      nullptr, // pVertices
+      nullptr, // pNormals
+      nullptr, // pTexCoords
+      nullptr, // pFaceSizes
+      nullptr, // pFaceVertexIndices
+      nullptr, // pFaceVertexTexCoordIndices
+      nullptr, // pFaceVertexNormalIndices
+      0,       // numVertices
+      0,       // numNormals
+      0,       // numTexCoords
+      0,       // numFaces
+  };
+
+  const int status = mioReadOBJ(
+      cut_mesh_file_path.c_str(), &mio_mesh.pVertices, &mio_mesh.pNormals,
+      &mio_mesh.pTexCoords, &mio_mesh.pFaceSizes, &mio_mesh.pFaceVertexIndices,
+      &mio_mesh.pFaceVertexTexCoordIndices, &mio_mesh.pFaceVertexNormalIndices,
+      &mio_mesh.numVertices, &mio_mesh.numNormals, &mio_mesh.numTexCoords,
+      &mio_mesh.numFaces);
+
+  if (status != 0 || mio_mesh.pVertices == nullptr || mio_mesh.numFaces == 0) {
+    mioFreeMesh(&mio_mesh);
+    throw std::runtime_error("failed to read cut mesh " + cut_mesh_file_path);
+  }
+
+  CutMesh mesh;
+  mesh.vertices.assign(mio_mesh.pVertices,
+                       mio_mesh.pVertices + 3 * mio_mesh.numVertices);
+  mesh.face_sizes.assign(mio_mesh.pFaceSizes,
+                         mio_mesh.pFaceSizes + mio_mesh.numFaces);
+
+  size_t num_indices = 0;
+  for (const uint32_t &face_size : mesh.face_sizes) {
+    num_indices += face_size;
+  }
+  mesh.face_indices.assign(mio_mesh.pFaceVertexIndices,
+                           mio_mesh.pFaceVertexIndices + num_indices);
+
+  mioFreeMesh(&mio_mesh);
+
+  // 每条无向边恰好被两个面片使用时视为闭合
+  std::unordered_map<uint64_t, uint32_t> edge_use;
+  size_t offset = 0;
+  for (const uint32_t &face_size : mesh.face_sizes) {
+    BBox face_bbox;
+    for (uint32_t i = 0; i < face_size; ++i) {
+      const uint32_t a = mesh.face_indices[offset + i];
+      const uint32_t b = mesh.face_indices[offset + (i + 1) % face_size];
+      face_bbox.expand({mesh.vertices[3 * a], mesh.vertices[3 * a + 1],
+                        mesh.vertices[3 * a + 2]});
+      edge_use[(static_cast<uint64_t>(std::min(a, b)) << 32) |
+               std::max(a, b)]++;
+    }
+    mesh.face_bboxes.push_back(face_bbox);
+    mesh.bbox.expand(face_bbox.min);
+    mesh.bbox.expand(face_bbox.max);
+    offset += face_size;
+  }
+
+  mesh.is_closed = std::all_of(
+      edge_use.begin(), edge_use.end(),
+      [](const std::pair<const uint64_t, uint32_t> &e) { return e.second == 2; });
+
+  mesh.buildGrid();
+
+  return mesh;
+}
+
+// 按碎片位置流式写出的OBJ，原始顶点按全局编号、新交点按量化坐标去重。
+// 只有落在分量边界边上的交点（跨分块的接缝）才进入去重表，其余交点直接
+// 写出，去重表的大小因此只与切割线穿过分块接缝的长度有关。该表常驻内存，
+// 不计入 memory_budget_bytes
+class StitchedWriter {
+public:
+  StitchedWriter(const std::string &path, const std::string &id_map_path,
+                 const size_t &num_source_vertices, const double &quantum)
+      : path_(path),
+        output_ids_(id_map_path, num_source_vertices * sizeof(uint32_t), true),
+        quantum_(quantum) {
+    file_ = fopen(path.c_str(), "w");
+    if (file_ == nullptr) {
+      throw std::runtime_error("failed to create " + path);
+    }
+  }
+
+  ~StitchedWriter() {
+    if (file_ != nullptr) {
+      fclose(file_);
+    }
+  }
+
+  StitchedWriter(const StitchedWriter &) = delete;
+  StitchedWriter &operator=(const StitchedWriter &) = delete;
+
+  // 返回OBJ中从1开始的顶点编号
+  uint32_t sourceVertex(const uint32_t &global_idx, const Vec3 &p) {
+    uint32_t &id = output_ids_.as<uint32_t>()[global_idx];
+    if (id == 0) {
+      id = writeVertex(p);
+    }
+    return id;
+  }
+
+  // 不在接缝上的交点只属于当前分量，无需去重
+  uint32_t interiorVertex(const Vec3 &p) { return writeVertex(p); }
+
+  // 接缝上的交点：相距不超过一个量化步长的视为同一点。两个分块算出的同一
+  // 交点可能落在相邻的量化格中，因此除所在格外还要检查周围的 26 个格
+  uint32_t seamVertex(const Vec3 &p) {
+    const QuantizedKey key = {std::llround(p[0] / quantum_),
+                              std::llround(p[1] / quantum_),
+                              std::llround(p[2] / quantum_)};
+
+    const auto matches = [&](const NewVertex &vertex) {
+      return std::fabs(vertex.p[0] - p[0]) <= quantum_ &&
+             std::fabs(vertex.p[1] - p[1]) <= quantum_ &&
+             std::fabs(vertex.p[2] - p[2]) <= quantum_;
+    };
+
+    const auto it = new_vertices_.find(key);
+    if (it != new_vertices_.end() && matches(it->second)) {
+      return it->second.id;
+    }
+    for (long long dz = -1; dz <= 1; ++dz) {
+      for (long long dy = -1; dy <= 1; ++dy) {
+        for (long long dx = -1; dx <= 1; ++dx) {
+          const auto neighbour = new_vertices_.find(
+              {key[0] + dx, key[1] + dy, key[2] + dz});
+          if (neighbour != new_vertices_.end() && matches(neighbour->second)) {
+            return neighbour->second.id;
+          }
+        }
+      }
+    }
+
+    const uint32_t id = writeVertex(p);
+    new_vertices_.emplace(key, NewVertex{p, id});
+    return id;
+  }
+
+  void writeFace(const std::vector<uint32_t> &face) {
+    fputc('f', file_);
+    for (const uint32_t &id : face) {
+      fprintf(file_, " %u", id);
+    }
+    fputc('\n', file_);
+    num_faces_++;
+  }
+
+  const std::string &path() const { return path_; }
+  size_t numFaces() const { return num_faces_; }
+  double quantum() const { return quantum_; }
+
+private:
+  using QuantizedKey = std::array<long long, 3>;
+
+  struct NewVertex {
+    Vec3 p;
+    uint32_t id;
+  };
+
+  struct QuantizedKeyHash {
+    size_t operator()(const QuantizedKey &k) const {
+      size_t h = std::hash<long long>()(k[0]);
+      h ^= std::hash<long long>()(k[1]) + 0x9e3779b97f4a7c15ULL + (h << 6) +
+           (h >> 2);
+      h ^= std::hash<long long>()(k[2]) + 0x9e3779b97f4a7c15ULL + (h << 6) +
+           (h >> 2);
+      return h;
+    }
+  };
+
+  uint32_t writeVertex(const Vec3 &p) {
+    fprintf(file_, "v %.17g %.17g %.17g\n", p[0], p[1], p[2]);
+    return ++num_vertices_;
+  }
+
+  std::string path_;
+  FILE *file_ = nullptr;
+  MappedFile output_ids_;
+  double quantum_;
+  uint32_t num_vertices_ = 0;
+  size_t num_faces_ = 0;
+  std::unordered_map<QuantizedKey, NewVertex, QuantizedKeyHash> new_vertices_;
+};
+
+enum FragmentSlot { kAbove = 0, kBelow = 1, kUndefined = 2 };
+
+// 无向边的键
+uint64_t edgeKey(const uint32_t &a, const uint32_t &b) {
+  return (static_cast<uint64_t>(std::min(a, b)) << 32) | std::max(a, b);
+}
+
+void writePassThrough(StitchedWriter &writer, const Vec3 *vertices,
+                      const std::vector<uint32_t> &face_sizes,
+                      const std::vector<uint32_t> &face_indices) {
+  std::vector<uint32_t> face;
+  size_t offset = 0;
+  for (const uint32_t &face_size : face_sizes) {
+    face.clear();
+    for (uint32_t i = 0; i < face_size; ++i) {
+      const uint32_t v = face_indices[offset + i];
+      face.push_back(writer.sourceVertex(v, vertices[v]));
+    }
+    writer.writeFace(face);
+    offset += face_size;
+  }
+}
+
+// 切割一个分块中的一个连通分量（全局编号），结果写入对应位置的输出
+void cutComponent(McContext context, const CutMesh &cut_mesh,
+                  const Vec3 *vertices,
+                  const std::vector<uint32_t> &face_sizes,
+                  const std::vector<uint32_t> &face_indices,
+                  std::array<std::unique_ptr<StitchedWriter>, 3> &writers) {
+  std::unordered_map<uint32_t, uint32_t> global_to_local;
+  std::vector<uint32_t> local_to_global;
+  std::vector<uint32_t> local_indices;
+  local_indices.reserve(face_indices.size());
+
+  for (const uint32_t &v : face_indices) {
+    const auto it = global_to_local.emplace(
+        v, static_cast<uint32_t>(local_to_global.size()));
+    if (it.second) {
+      local_to_global.push_back(v);
+    }
+    local_indices.push_back(it.first->second);
+  }
+
+  // 分量的边界边（只被一个面使用），跨分块共享的交点只会落在这些边上
+  std::vector<size_t> face_offsets(face_sizes.size());
+  std::unordered_map<uint64_t, uint32_t> edge_uses;
+  size_t face_offset = 0;
+  for (size_t f = 0; f < face_sizes.size(); ++f) {
+    face_offsets[f] = face_offset;
+    for (uint32_t i = 0; i < face_sizes[f]; ++i) {
+      edge_uses[edgeKey(face_indices[face_offset + i],
+                        face_indices[face_offset + (i + 1) % face_sizes[f]])]++;
+    }
+    face_offset += face_sizes[f];
+  }
+
+  // 点 p 是否落在源面 f 的某条边界边上
+  const auto on_border_edge = [&](const uint32_t &f, const Vec3 &p,
+                                  const double &tolerance) {
+    for (uint32_t i = 0; i < face_sizes[f]; ++i) {
+      const uint32_t a = face_indices[face_offsets[f] + i];
+      const uint32_t b = face_indices[face_offsets[f] + (i + 1) % face_sizes[f]];
+      if (edge_uses.at(edgeKey(a, b)) != 1) {
+        continue;
+      }
+
+      Vec3 ab, ap;
+      double ab_ab = 0.0, ab_ap = 0.0;
+      for (int j = 0; j < 3; ++j) {
+        ab[j] = vertices[b][j] - vertices[a][j];
+        ap[j] = p[j] - vertices[a][j];
+        ab_ab += ab[j] * ab[j];
+        ab_ap += ab[j] * ap[j];
+      }
+      const double t =
+          ab_ab > 0.0 ? std::min(std::max(ab_ap / ab_ab, 0.0), 1.0) : 0.0;
+      double dist2 = 0.0;
+      for (int j = 0; j < 3; ++j) {
+        const double d = ap[j] - t * ab[j];
+        dist2 += d * d;
+      }
+      if (dist2 <= tolerance * tolerance) {
+        return true;
+      }
+    }
+    return false;
+  };
+
+  std::vector<double> local_vertices;
+  local_vertices.reserve(3 * local_to_global.size());
+  for (const uint32_t &v : local_to_global) {
+    local_vertices.insert(local_vertices.end(), vertices[v].begin(),
+                          vertices[v].end());
+  }
+
+  const std::shared_ptr<const DispatchResult> result = dispatchCached(
+      context,
+      MC_DISPATCH_VERTEX_ARRAY_DOUBLE | MC_DISPATCH_INCLUDE_VERTEX_MAP |
+          MC_DISPATCH_INCLUDE_FACE_MAP |
+          MC_DISPATCH_FILTER_FRAGMENT_SEALING_NONE |
+          MC_DISPATCH_FILTER_FRAGMENT_LOCATION_ABOVE |
+          MC_DISPATCH_FILTER_FRAGMENT_LOCATION_BELOW |
+          MC_DISPATCH_FILTER_FRAGMENT_LOCATION_UNDEFINED |
+          MC_DISPATCH_ENFORCE_GENERAL_POSITION, // perturb if necessary
+      local_vertices.data(), local_indices.data(), face_sizes.data(),
+      static_cast<uint32_t>(local_to_global.size()),
+      static_cast<uint32_t>(face_sizes.size()), cut_mesh.vertices.data(),
+      cut_mesh.face_indices.data(), cut_mesh.face_sizes.data(),
+      static_cast<uint32_t>(cut_mesh.vertices.size() / 3),
+      static_cast<uint32_t>(cut_mesh.face_sizes.size()), false);
+
+  // 分量未被切到：整体位于切割网格一侧
+  if (result->fragments().empty()) {
+    const FragmentSlot slot =
+        !cut_mesh.is_closed ? kUndefined
+        : cut_mesh.contains(vertices[face_indices[0]]) ? kBelow
+                                                       : kAbove;
+    writePassThrough(*writers[slot], vertices, face_sizes, face_indices);
+    return;
+  }
+
+  std::vector<uint32_t> face;
+  std::vector<uint32_t> output_ids;
+  std::vector<char> is_seam;
+
+  for (const DispatchResult::Fragment &cc : result->fragments()) {
+    StitchedWriter &writer =
+        *writers[cc.location == MC_FRAGMENT_LOCATION_ABOVE   ? kAbove
+                 : cc.location == MC_FRAGMENT_LOCATION_BELOW ? kBelow
+                                                             : kUndefined];
+
+    const double *cc_vertices = cc.vertices;
+    const uint32_t *cc_faces = cc.face_indices;
+    const uint32_t *cc_vertex_map = cc.vertex_map;
+    const uint32_t *cc_face_map = cc.face_map;
+
+    // 非有理数构建下MCUT输出坐标未撤销预处理平移，借助一个原始顶点求出该平移
+    Vec3 shift{0.0, 0.0, 0.0};
+    for (size_t i = 0; i < cc.num_vertices; ++i) {
+      const uint32_t local = cc_vertex_map[i];
+      if (local < local_to_global.size()) {
+        const Vec3 &p = vertices[local_to_global[local]];
+        for (int j = 0; j < 3; ++j) {
+          shift[j] = cc_vertices[3 * i + j] - p[j];
+        }
+        break;
+      }
+    }
+
+    const auto point = [&](const size_t &i) -> Vec3 {
+      return {cc_vertices[3 * i] - shift[0], cc_vertices[3 * i + 1] - shift[1],
+              cc_vertices[3 * i + 2] - shift[2]};
+    };
+
+    // 按面映射找到交点所在的源面，判断其是否落在分量的边界边上
+    is_seam.assign(cc.num_vertices, 0);
+    size_t offset = 0;
+    for (size_t f = 0; f < cc.num_faces; ++f) {
+      const uint32_t src_face = cc_face_map[f];
+      for (uint32_t i = 0;
+           src_face < face_sizes.size() && i < cc.face_sizes[f]; ++i) {
+        const uint32_t v = cc_faces[offset + i];
+        if (!is_seam[v] && cc_vertex_map[v] >= local_to_global.size() &&
+            on_border_edge(src_face, point(v), writer.quantum())) {
+          is_seam[v] = 1;
+          recordCount("tile_seam_vertices", 1);
+        }
+      }
+      offset += cc.face_sizes[f];
+    }
+
+    // 碎片顶点 -> 输出编号，原始顶点使用磁盘上的原坐标以保证跨分块一致
+    output_ids.resize(cc.num_vertices);
+    for (size_t i = 0; i < cc.num_vertices; ++i) {
+      const uint32_t local = cc_vertex_map[i];
+      if (local < local_to_global.size()) {
+        const uint32_t global = local_to_global[local];
+        output_ids[i] = writer.sourceVertex(global, vertices[global]);
+      } else if (is_seam[i]) {
+        output_ids[i] = writer.seamVertex(point(i));
+      } else {
+        output_ids[i] = writer.interiorVertex(point(i));
+      }
+    }
+
+    offset = 0;
+    for (size_t f = 0; f < cc.num_faces; ++f) {
+      face.clear();
+      for (uint32_t i = 0; i < cc.face_sizes[f]; ++i) {
+        face.push_back(output_ids[cc_faces[offset + i]]);
+      }
+      writer.writeFace(face);
+      offset += cc.face_sizes[f];
+    }
+  }
+}
+
+// 将分块面片按共享顶点拆分为连通分量
+std::vector<std::vector<uint32_t>>
+splitComponents(const std::vector<uint32_t> &face_sizes,
+                const std::vector<uint32_t> &face_indices) {
+  std::vector<uint32_t> parent(face_sizes.size());
+  for (uint32_t i = 0; i < parent.size(); ++i) {
+    parent[i] = i;
+  }
+
+  auto find_root = [&](uint32_t i) {
+    while (parent[i] != i) {
+      parent[i] = parent[parent[i]];
+      i = parent[i];
+    }
+    return i;
+  };
+
+  std::unordered_map<uint32_t, uint32_t> vertex_owner;
+  size_t offset = 0;
+  for (uint32_t f = 0; f < face_sizes.size(); ++f) {
+    for (uint32_t i = 0; i < face_sizes[f]; ++i) {
+      const auto it = vertex_owner.emplace(face_indices[offset + i], f);
+      if (!it.second) {
+        const uint32_t ra = find_root(f);
+        const uint32_t rb = find_root(it.first->second);
+        if (ra != rb) {
+          parent[std::max(ra, rb)] = std::min(ra, rb);
+        }
+      }
+    }
+    offset += face_sizes[f];
+  }
+
+  std::unordered_map<uint32_t, uint32_t> root_to_component;
+  std::vector<std::vector<uint32_t>> components;
+  for (uint32_t f = 0; f < face_sizes.size(); ++f) {
+    const auto it = root_to_component.emplace(
+        find_root(f), static_cast<uint32_t>(components.size()));
+    if (it.second) {
+      components.emplace_back();
+    }
+    components[it.first->second].push_back(f);
+  }
+  return components;
+}
+
+} // namespace
+
+std::vector<std::string> cutMeshTiled(const std::string &mesh_file_path,
+                                      const std::string &cut_mesh_file_path,
+                                      const std::string &output_folder,
+                                      const size_t &memory_budget_bytes) {
+  StageTimer stage("cutMeshTiled");
+
+  const size_t max_tile_faces =
+      std::max<size_t>(1, memory_budget_bytes / kBytesPerTileFace);
+
+  std::filesystem::create_directories(output_folder);
+  const TempDir temp_dir(
+      (std::filesystem::path(output_folder) / "tiles_tmp").string());
+
+  StageTimer partition_stage("partition");
+
+  // 第一遍：顶点写入磁盘，统计面片数与包围盒
+  const std::string vertex_file_path = temp_dir.file("vertices.bin");
+  size_t num_vertices = 0;
+  size_t num_faces = 0;
+  BBox bbox;
+  {
+    FILE *vertex_file = fopen(vertex_file_path.c_str(), "wb");
+    if (vertex_file == nullptr) {
+      throw std::runtime_error("failed to create " + vertex_file_path);
+    }
+    std::vector<char> buffer(kWriterBufferBytes);
+    setvbuf(vertex_file, buffer.data(), _IOFBF, buffer.size());
+
+    streamOBJ(
+        mesh_file_path,
+        [&](const Vec3 &p) {
+          fwrite(p.data(), sizeof(double), 3, vertex_file);
+          bbox.expand(p);
+          num_vertices++;
+        },
+        [&](const std::vector<uint32_t> &) { num_faces++; });
+
+    fclose(vertex_file);
+  }
+
+  if (num_vertices == 0 || num_faces == 0) {
+    throw std::runtime_error("empty mesh " + mesh_file_path);
+  }
+
+  const MappedFile vertex_map(vertex_file_path, num_vertices * sizeof(Vec3),
+                              false);
+  const Vec3 *vertices = vertex_map.as<const Vec3>();
+
+  // 第二遍：面片按空间划分写入分块
+  const std::vector<Tile> tiles = partitionTiles(
+      mesh_file_path, temp_dir, vertices, bbox, num_faces, max_tile_faces);
+  partition_stage.stop();
+  recordCount("tiles", tiles.size());
+
+  const CutMesh cut_mesh = loadCutMesh(cut_mesh_file_path);
+
+  auto extract_fname = [](const std::string &full_path) {
+    const std::filesystem::path path(full_path);
+    return path.stem().string();
+  };
+
+  const std::string prefix =
+      (std::filesystem::path(output_folder) /
+       (extract_fname(mesh_file_path) + "_" + extract_fname(cut_mesh_file_path)))
+          .string();
+
+  double diagonal = 0.0;
+  for (int i = 0; i < 3; ++i) {
+    diagonal += (bbox.max[i] - bbox.min[i]) * (bbox.max[i] - bbox.min[i]);
+  }
+  const double quantum = std::max(std::sqrt(diagonal), 1.0) * 1e-10;
+
+  const std::array<std::string, 3> slot_names = {"above", "below",
+                                                 "undefined"};
+  std::array<std::unique_ptr<StitchedWriter>, 3> writers;
+  for (size_t i = 0; i < writers.size(); ++i) {
+    writers[i].reset(new StitchedWriter(
+        prefix + "_" + slot_names[i] + ".obj",
+        temp_dir.file("output_ids_" + slot_names[i] + ".bin"), num_vertices,
+        quantum));
+  }
+
+  StageTimer cut_stage("cut");
+
+  ContextLease lease;
+  const McContext context = lease.get();
+
+  std::vector<uint32_t> face_sizes;
+  std::vector<uint32_t> face_indices;
+  std::vector<uint32_t> component_sizes;
+  std::vector<uint32_t> component_indices;
+  std::vector<size_t> face_offsets;
+
+  for (const Tile &tile : tiles) {
+    face_sizes.clear();
+    face_indices.clear();
+    readTile(tile, [&](const std::vector<uint32_t> &face) {
+      face_sizes.push_back(static_cast<uint32_t>(face.size()));
+      face_indices.insert(face_indices.end(), face.begin(), face.end());
+    });
+
+    // 与切割网格不相交的分块不送入MCUT
+    if (!cut_mesh.overlaps(tile.bbox)) {
+      const FragmentSlot slot =
+          !cut_mesh.is_closed ? kUndefined
+          : cut_mesh.contains(vertices[face_indices[0]]) ? kBelow
+                                                         : kAbove;
+      writePassThrough(*writers[slot], vertices, face_sizes, face_indices);
+      recordCount("tiles_passed_through", 1);
+      continue;
+    }
+
+    face_offsets.resize(face_sizes.size());
+    size_t offset = 0;
+    for (size_t f = 0; f < face_sizes.size(); ++f) {
+      face_offsets[f] = offset;
+      offset += face_sizes[f];
+    }
+
+    // MCUT 要求源网格为单一连通分量
+    for (const std::vector<uint32_t> &component :
+         splitComponents(face_sizes, face_indices)) {
+      component_sizes.clear();
+      component_indices.clear();
+      for (const uint32_t &f : component) {
+        component_sizes.push_back(face_sizes[f]);
+        component_indices.insert(
+            component_indices.end(), face_indices.begin() + face_offsets[f],
+            face_indices.begin() + face_offsets[f] + face_sizes[f]);
+      }
+      cutComponent(context, cut_mesh, vertices, component_sizes,
+                   component_indices, writers);
+      recordCount("tile_components", 1);
+    }
+  }
+  cut_stage.stop();
+
+  std::vector<std::string> output_paths;
+  for (std::unique_ptr<StitchedWriter> &writer : writers) {
+    const std::string path = writer->path();
+    const bool is_empty = writer->numFaces() == 0;
+    writer.reset();
+    if (is_empty) {
+      std::remove(path.c_str());
+    } else {
+      output_paths.push_back(path);
+    }
+  }
+
+  return output_paths;
+}
@@ -5,6 +5,7 @@ sys.path.append("../diff-curvature")
 
 import os
 import time
+from mesh_cut.Method.stats import aggregateCutStats, printCutStats
 from mesh_cut.Module.mesh_cutter import MeshCutter
 
 
@@ -34,6 +35,7 @@ def demo():
     mesh_cutter.cutMesh(sub_mesh_num, points_per_submesh)
     end_time = time.time()
     print(f"Mesh cutting completed in {end_time - start_time:.2f} seconds")
+    printCutStats(mesh_cutter.cut_stats)
 
     print("sub mesh sample points.shape:", mesh_cutter.sub_mesh_sample_points.shape)
 
@@ -44,3 +46,41 @@ def demo():
     # mesh_cutter.renderSubMeshSamplePoints()
 
     return True
+
+
+def demo_batch():
+    mesh_folder_path = "/Users/chli/chLi/Dataset/vae-eval/mesh/"
+
+    sub_mesh_num = 400
+    points_per_submesh = 1024
+
+    mesh_cutter = MeshCutter()
+
+    # 汇总所有网格的分阶段统计，并记录最慢的网格
+    stats_list = []
+    slowest_meshes = []
+    for mesh_file_name in sorted(os.listdir(mesh_folder_path)):
+        if not mesh_file_name.endswith(".obj"):
+            continue
+
+        mesh_file_path = mesh_folder_path + mesh_file_name
+        # 首次运行把网格转换为二进制缓存，之后直接内存映射
+        if not mesh_cutter.loadMesh(mesh_file_path, "./output/mesh_cache/"):
+            continue
+        if not mesh_cutter.cutMesh(sub_mesh_num, points_per_submesh):
+            continue
+
+        stats_list.append(mesh_cutter.cut_stats)
+        total_seconds = sum(
+            stage["wall_seconds"]
+            for name, stage in mesh_cutter.cut_stats["stages"].items()
+            if "/" not in name
+        )
+        slowest_meshes.append((total_seconds, mesh_file_name))
+
+    printCutStats(aggregateCutStats(stats_list))
+
+    print("Slowest meshes:")
+    for total_seconds, mesh_file_name in sorted(slowest_meshes, reverse=True)[:10]:
+        print(f"\t {mesh_file_name}: {total_seconds:.2f} seconds")
+    return True
@@ -0,0 +1,570 @@
+/***************************************************************************
+ *  This file is part of the MCUT project, which is comprised of a library
+ *  for surface mesh cutting, example programs and test programs.
+ *
+ *  Copyright (C) 2024 CutDigital Enterprise Ltd
+ *
+ *  MCUT is dual-licensed software that is available under an Open Source
+ *  license as well as a commercial license. The Open Source license is the
+ *  GNU Lesser General Public License v3+ (LGPL). The commercial license
+ *  option is for users that wish to use MCUT in their products for commercial
+ *  purposes but do not wish to release their software under the LGPL.
+ *  Email <contact@cut-digital.com> for further information.
+ *
+ *  You may not use this file except in compliance with the License. A copy of
+ *  the Open Source license can be obtained from
+ *
+ *      https://www.gnu.org/licenses/lgpl-3.0.en.html.
+ *
+ *  For your convenience, a copy of this License has been included in this
+ *  repository.
+ *
+ *  MCUT is distributed in the hope that it will be useful, but THE SOFTWARE IS
+ *  PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ *  INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR
+ *  A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ *  COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ *  WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+ *  OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ **************************************************************************/
+
+/*
+ * mcut_bench: sweeps mcDispatch over source/cut face counts, overlap fraction,
+ * degenerate-input rate and helper thread counts, and writes per-configuration
+ * dispatch times, TIMESTACK stage times, data-query times and peak memory as JSON.
+ *
+ * The source-mesh is a UV sphere whose equator ring lies exactly in the plane z=0.
+ * The cut-mesh is a square grid slightly above that plane; "--degenerate p" snaps
+ * grid quads onto z=0 until a fraction p of the cut-mesh faces lies in that plane,
+ * so that those faces contain the source-mesh equator edges they cross, which
+ * forces MCUT to perturb the input.
+ * "--overlap f" slides the grid so that it spans a fraction f of the sphere's
+ * diameter (f=1 is a complete cut, f<1 a partial cut).
+ *
+ * usage:
+ *   mcut_bench [--source-faces 10000,100000] [--cut-faces 1000,10000]
+ *              [--overlap 0.5,1] [--degenerate 0,0.1] [--helpers 0,1,2,4]
+ *              [--repeat 3] [--output mcut_bench.json]
+ */
+
+#include "mcut/mcut.h"
+#include "mcut/internal/timer.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if defined(__linux__)
+#include <sys/resource.h>
+#endif
+
+namespace {
+
+struct input_mesh_t {
+    std::vector<double> vertices;
+    std::vector<uint32_t> face_indices;
+    std::vector<uint32_t> face_sizes;
+};
+
+struct bench_options_t {
+    std::vector<uint32_t> source_faces = { 10000, 100000 };
+    std::vector<uint32_t> cut_faces = { 1000, 10000 };
+    std::vector<double> overlaps = { 0.5, 1.0 };
+    std::vector<double> degenerate_rates = { 0.0, 0.1 };
+    std::vector<uint32_t> helpers;
+    uint32_t repeat = 3;
+    std::string output = "mcut_bench.json";
+};
+
+struct stage_time_t {
+    double total_seconds = 0.0;
+    unsigned long long calls = 0;
+};
+
+struct bench_result_t {
+    uint32_t source_faces = 0;
+    uint32_t cut_faces = 0;
+    double overlap = 0.0;
+    double degenerate_rate = 0.0;
+    uint32_t degenerate_cut_faces = 0; // cut-mesh faces lying in the plane z=0
+    uint32_t helpers = 0;
+    std::vector<double> dispatch_seconds;
+    std::vector<double> query_seconds;
+    uint32_t connected_components = 0;
+    bool perturbed = false;
+    unsigned long long peak_rss_bytes = 0;
+    bool peak_rss_resettable = true; // false: peak_rss_bytes is the process-wide peak so far
+    std::map<std::string, stage_time_t> stages;
+    std::string error;
+};
+
+// UV sphere of radius 1; "rings" is even so that one vertex ring is the equator at z=0
+input_mesh_t make_source_mesh(uint32_t target_faces)
+{
+    // faces = 2 * segments * (rings - 1) with segments = 2 * rings
+    uint32_t rings = (uint32_t)std::ceil(std::sqrt(target_faces / 4.0));
+    rings = std::max<uint32_t>(4, rings + (rings % 2));
+    const uint32_t segments = 2 * rings;
+
+    input_mesh_t mesh;
+    mesh.vertices.insert(mesh.vertices.end(), { 0.0, 0.0, 1.0 });
+    for (uint32_t i = 1; i < rings; ++i) {
+        const double theta = M_PI * i / rings;
+        // cos(pi/2) is not exactly zero in floating point
+        const double z = (2 * i == rings) ? 0.0 : std::cos(theta);
+        for (uint32_t j = 0; j < segments; ++j) {
+            const double phi = 2.0 * M_PI * j / segments;
+            mesh.vertices.insert(mesh.vertices.end(),
+                { std::sin(theta) * std::cos(phi), std::sin(theta) * std::sin(phi), z });
+        }
+    }
+    mesh.vertices.insert(mesh.vertices.end(), { 0.0, 0.0, -1.0 });
+
+    const uint32_t south = 1 + (rings - 1) * segments;
+    auto ring_vertex = [&](uint32_t ring, uint32_t j) { return 1 + (ring - 1) * segments + (j % segments); };
+    auto add_triangle = [&](uint32_t a, uint32_t b, uint32_t c) {
+        mesh.face_indices.insert(mesh.face_indices.end(), { a, b, c });
+        mesh.face_sizes.push_back(3);
+    };
+
+    for (uint32_t j = 0; j < segments; ++j) {
+        add_triangle(0, ring_vertex(1, j), ring_vertex(1, j + 1));
+        add_triangle(south, ring_vertex(rings - 1, j + 1), ring_vertex(rings - 1, j));
+    }
+    for (uint32_t i = 1; i + 1 < rings; ++i) {
+        for (uint32_t j = 0; j < segments; ++j) {
+            const uint32_t a = ring_vertex(i, j);
+            const uint32_t b = ring_vertex(i + 1, j);
+            const uint32_t c = ring_vertex(i + 1, j + 1);
+            const uint32_t d = ring_vertex(i, j + 1);
+            add_triangle(a, b, c);
+            add_triangle(a, c, d);
+        }
+    }
+    return mesh;
+}
+
+// open n x n grid of triangulated quads near the plane z=0, with a fraction
+// "degenerate_rate" of its faces snapped onto it
+input_mesh_t make_cut_mesh(uint32_t target_faces, double overlap, double degenerate_rate, uint32_t& degenerate_faces)
+{
+    const uint32_t n = std::max<uint32_t>(1, (uint32_t)std::ceil(std::sqrt(target_faces / 2.0)));
+    const double extent = 1.3; // the grid overhangs the unit sphere on every free side
+    // the grid starts inside the sphere at x = 1 - 2 * overlap, or overhangs it when the cut is complete
+    const double x_min = overlap < 1.0 ? 1.0 - 2.0 * overlap : -extent;
+    // keep non-snapped vertices off z=0 and grid lines out of the meridian planes x=0 and y=0
+    const double x_offset = 0.0031;
+    const double y_offset = 0.0071;
+    const double z_offset = 0.0173;
+
+    // snap whole quads (rather than single vertices), so that both of their triangles
+    // lie in the equator plane: snapping vertices independently would make a face
+    // degenerate only with probability degenerate_rate^3. Quads are snapped in random
+    // order until the requested fraction of faces is degenerate, counting the faces
+    // between snapped quads that get snapped along with them.
+    std::vector<uint32_t> quads(n * n);
+    for (uint32_t q = 0; q < n * n; ++q) {
+        quads[q] = q;
+    }
+    std::mt19937 rng(12345u);
+    std::shuffle(quads.begin(), quads.end(), rng);
+
+    const uint64_t target_degenerate_faces = (uint64_t)std::llround(degenerate_rate * 2.0 * n * n);
+    std::vector<bool> snapped((n + 1) * (n + 1), false);
+    std::vector<bool> degenerate(2 * n * n, false);
+    degenerate_faces = 0;
+    for (size_t k = 0; k < quads.size() && degenerate_faces < target_degenerate_faces; ++k) {
+        const uint32_t qi = quads[k] / n;
+        const uint32_t qj = quads[k] % n;
+        const uint32_t qa = qi * (n + 1) + qj;
+        snapped[qa] = snapped[qa + 1] = snapped[qa + n + 1] = snapped[qa + n + 2] = true;
+
+        for (uint32_t i = qi > 0 ? qi - 1 : 0; i <= std::min(qi + 1, n - 1); ++i) {
+            for (uint32_t j = qj > 0 ? qj - 1 : 0; j <= std::min(qj + 1, n - 1); ++j) {
+                const uint32_t a = i * (n + 1) + j;
+                const uint32_t b = (i + 1) * (n + 1) + j;
+                const uint32_t c = b + 1;
+                const uint32_t d = a + 1;
+                const uint32_t f = 2 * (i * n + j);
+                if (!degenerate[f] && snapped[a] && snapped[b] && snapped[c]) {
+                    degenerate[f] = true;
+                    ++degenerate_faces;
+                }
+                if (!degenerate[f + 1] && snapped[a] && snapped[c] && snapped[d]) {
+                    degenerate[f + 1] = true;
+                    ++degenerate_faces;
+                }
+            }
+        }
+    }
+
+    input_mesh_t mesh;
+    for (uint32_t i = 0; i <= n; ++i) {
+        for (uint32_t j = 0; j <= n; ++j) {
+            const double x = x_min + (extent - x_min) * i / n + x_offset;
+            const double y = -extent + 2.0 * extent * j / n + y_offset;
+            mesh.vertices.insert(mesh.vertices.end(), { x, y, snapped[i * (n + 1) + j] ? 0.0 : z_offset });
+        }
+    }
+
+    for (uint32_t i = 0; i < n; ++i) {
+        for (uint32_t j = 0; j < n; ++j) {
+            const uint32_t a = i * (n + 1) + j;
+            const uint32_t b = (i + 1) * (n + 1) + j;
+            const uint32_t c = b + 1;
+            const uint32_t d = a + 1;
+            mesh.face_indices.insert(mesh.face_indices.end(), { a, b, c, a, c, d });
+            mesh.face_sizes.insert(mesh.face_sizes.end(), { 3, 3 });
+        }
+    }
+    return mesh;
+}
+
+void check(McResult err, const char* what)
+{
+    if (err != MC_NO_ERROR) {
+        throw std::runtime_error(std::string(what) + " failed with error " + std::to_string((int)err));
+    }
+}
+
+// Linux lets a process reset its peak RSS (VmHWM) by writing "5" to clear_refs
+bool reset_peak_rss()
+{
+#if defined(__linux__)
+    std::ofstream clear_refs("/proc/self/clear_refs");
+    if (clear_refs) {
+        clear_refs << "5";
+        return (bool)clear_refs.flush();
+    }
+#endif
+    return false;
+}
+
+unsigned long long read_peak_rss_bytes()
+{
+#if defined(__linux__)
+    std::ifstream status("/proc/self/status");
+    std::string line;
+    while (std::getline(status, line)) {
+        if (line.rfind("VmHWM:", 0) == 0) {
+            return std::stoull(line.substr(6)) * 1024ull;
+        }
+    }
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) == 0) {
+        return (unsigned long long)usage.ru_maxrss * 1024ull;
+    }
+#endif
+    return 0;
+}
+
+double seconds_since(const std::chrono::steady_clock::time_point& start)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+// reads the output that a typical client would read back from every connected component
+void query_connected_components(McContext context, bench_result_t& result)
+{
+    uint32_t num_ccs = 0;
+    check(mcGetConnectedComponents(context, MC_CONNECTED_COMPONENT_TYPE_ALL, 0, nullptr, &num_ccs), "mcGetConnectedComponents");
+    std::vector<McConnectedComponent> ccs(num_ccs, MC_NULL_HANDLE);
+    if (num_ccs > 0) {
+        check(mcGetConnectedComponents(context, MC_CONNECTED_COMPONENT_TYPE_ALL, num_ccs, ccs.data(), nullptr), "mcGetConnectedComponents");
+    }
+    result.connected_components = num_ccs;
+
+    const McFlags queries[] = {
+        MC_CONNECTED_COMPONENT_DATA_VERTEX_DOUBLE,
+        MC_CONNECTED_COMPONENT_DATA_FACE,
+        MC_CONNECTED_COMPONENT_DATA_FACE_SIZE,
+        MC_CONNECTED_COMPONENT_DATA_FACE_TRIANGULATION,
+        MC_CONNECTED_COMPONENT_DATA_DISPATCH_PERTURBATION_VECTOR
+    };
+
+    std::vector<char> buffer;
+    for (const McConnectedComponent cc : ccs) {
+        for (const McFlags query : queries) {
+            McSize num_bytes = 0;
+            check(mcGetConnectedComponentData(context, cc, query, 0, nullptr, &num_bytes), "mcGetConnectedComponentData");
+            if (num_bytes == 0) {
+                continue;
+            }
+            buffer.resize(num_bytes);
+            check(mcGetConnectedComponentData(context, cc, query, num_bytes, buffer.data(), nullptr), "mcGetConnectedComponentData");
+
+            if (query == MC_CONNECTED_COMPONENT_DATA_DISPATCH_PERTURBATION_VECTOR) {
+                const double* v = reinterpret_cast<const double*>(buffer.data());
+                result.perturbed = result.perturbed || v[0] != 0.0 || v[1] != 0.0 || v[2] != 0.0;
+            }
+        }
+    }
+
+    if (num_ccs > 0) {
+        check(mcReleaseConnectedComponents(context, num_ccs, ccs.data()), "mcReleaseConnectedComponents");
+    }
+}
+
+void run_configuration(McContext context, const input_mesh_t& src, const input_mesh_t& cut, uint32_t repeat, bench_result_t& result)
+{
+    const McFlags dispatch_flags = MC_DISPATCH_VERTEX_ARRAY_DOUBLE | MC_DISPATCH_ENFORCE_GENERAL_POSITION | MC_DISPATCH_FILTER_ALL;
+
+    timer_registry_take(); // discard anything recorded outside of this configuration
+
+    for (uint32_t r = 0; r < repeat; ++r) {
+        result.peak_rss_resettable = reset_peak_rss() && result.peak_rss_resettable;
+
+        const auto dispatch_start = std::chrono::steady_clock::now();
+        check(mcDispatch(context, dispatch_flags,
+                  src.vertices.data(), src.face_indices.data(), src.face_sizes.data(),
+                  (uint32_t)(src.vertices.size() / 3), (uint32_t)src.face_sizes.size(),
+                  cut.vertices.data(), cut.face_indices.data(), cut.face_sizes.data(),
+                  (uint32_t)(cut.vertices.size() / 3), (uint32_t)cut.face_sizes.size()),
+            "mcDispatch");
+        result.dispatch_seconds.push_back(seconds_since(dispatch_start));
+
+        const auto query_start = std::chrono::steady_clock::now();
+        query_connected_components(context, result);
+        result.query_seconds.push_back(seconds_since(query_start));
+
+        result.peak_rss_bytes = std::max(result.peak_rss_bytes, read_peak_rss_bytes());
+    }
+
+    for (const auto& record : timer_registry_take()) {
+        stage_time_t& stage = result.stages[record.first];
+        stage.total_seconds += record.second.total_ns * 1e-9;
+        stage.calls += record.second.calls;
+    }
+}
+
+template <typename T>
+std::vector<T> parse_list(const std::string& text)
+{
+    std::vector<T> values;
+    std::stringstream stream(text);
+    std::string item;
+    while (std::getline(stream, item, ',')) {
+        if (!item.empty()) {
+            std::stringstream parser(item);
+            T value;
+            parser >> value;
+            if (parser.fail()) {
+                throw std::runtime_error("invalid list value '" + item + "'");
+            }
+            values.push_back(value);
+        }
+    }
+    return values;
+}
+
+bench_options_t parse_options(int argc, char** argv)
+{
+    bench_options_t options;
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if (i + 1 >= argc) {
+            throw std::runtime_error("missing value for " + arg);
+        }
+        const std::string value = argv[++i];
+
+        if (arg == "--source-faces") {
+            options.source_faces = parse_list<uint32_t>(value);
+        } else if (arg == "--cut-faces") {
+            options.cut_faces = parse_list<uint32_t>(value);
+        } else if (arg == "--overlap") {
+            options.overlaps = parse_list<double>(value);
+        } else if (arg == "--degenerate") {
+            options.degenerate_rates = parse_list<double>(value);
+        } else if (arg == "--helpers") {
+            options.helpers = parse_list<uint32_t>(value);
+        } else if (arg == "--repeat") {
+            options.repeat = std::max<uint32_t>(1, (uint32_t)std::stoul(value));
+        } else if (arg == "--output") {
+            options.output = value;
+        } else {
+            throw std::runtime_error("unknown option " + arg);
+        }
+    }
+
+    for (const double overlap : options.overlaps) {
+        if (!(overlap > 0.0 && overlap <= 1.0)) {
+            throw std::runtime_error("overlap fractions must be in (0, 1]");
+        }
+    }
+    for (const double rate : options.degenerate_rates) {
+        if (!(rate >= 0.0 && rate <= 1.0)) {
+            throw std::runtime_error("degenerate rates must be in [0, 1]");
+        }
+    }
+
+    // default: no helpers, then 1, 2, 4, ... up to one less than the hardware threads
+    if (options.helpers.empty()) {
+        const uint32_t hw = std::max(1u, std::thread::hardware_concurrency());
+        options.helpers.push_back(0);
+        for (uint32_t h = 1; h < hw; h *= 2) {
+            options.helpers.push_back(h);
+        }
+        if (hw > 1 && options.helpers.back() != hw - 1) {
+            options.helpers.push_back(hw - 1);
+        }
+    }
+    return options;
+}
+
+std::string json_escape(const std::string& text)
+{
+    std::string escaped;
+    for (const char c : text) {
+        if (c == '"' || c == '\\') {
+            escaped += '\\';
+            escaped += c;
+        } else if ((unsigned char)c < 0x20) {
+            char hex[8];
+            std::snprintf(hex, sizeof(hex), "\\u%04x", c);
+            escaped += hex;
+        } else {
+            escaped += c;
+        }
+    }
+    return escaped;
+}
+
+void write_seconds(std::ostream& out, const char* name, const std::vector<double>& seconds)
+{
+    std::vector<double> sorted = seconds;
+    std::sort(sorted.begin(), sorted.end());
+    double mean = 0.0;
+    for (const double s : sorted) {
+        mean += s;
+    }
+    mean /= std::max<size_t>(1, sorted.size());
+
+    out << "\"" << name << "\": {\"min\": " << (sorted.empty() ? 0.0 : sorted.front())
+        << ", \"median\": " << (sorted.empty() ? 0.0 : sorted[sorted.size() / 2])
+        << ", \"mean\": " << mean << ", \"all\": [";
+    for (size_t i = 0; i < seconds.size(); ++i) {
+        out << (i == 0 ? "" : ", ") << seconds[i];
+    }
+    out << "]}";
+}
+
+void write_json(std::ostream& out, const bench_options_t& options, const std::vector<bench_result_t>& results)
+{
+    out << "{\n";
+    out << "  \"hardware_concurrency\": " << std::thread::hardware_concurrency() << ",\n";
+    out << "  \"repeat\": " << options.repeat << ",\n";
+    out << "  \"results\": [";
+
+    for (size_t i = 0; i < results.size(); ++i) {
+        const bench_result_t& r = results[i];
+        out << (i == 0 ? "\n" : ",\n");
+        out << "    {\"source_faces\": " << r.source_faces
+            << ", \"cut_faces\": " << r.cut_faces
+            << ", \"overlap\": " << r.overlap
+            << ", \"degenerate_rate\": " << r.degenerate_rate
+            << ", \"degenerate_cut_faces\": " << r.degenerate_cut_faces
+            << ", \"helpers\": " << r.helpers;
+
+        if (!r.error.empty()) {
+            out << ", \"error\": \"" << json_escape(r.error) << "\"}";
+            continue;
+        }
+
+        out << ", \"connected_components\": " << r.connected_components
+            << ", \"perturbed\": " << (r.perturbed ? "true" : "false")
+            << ", \"peak_rss_bytes\": " << r.peak_rss_bytes
+            << ", \"peak_rss_resettable\": " << (r.peak_rss_resettable ? "true" : "false") << ",\n      ";
+        write_seconds(out, "dispatch_seconds", r.dispatch_seconds);
+        out << ",\n      ";
+        write_seconds(out, "query_seconds", r.query_seconds);
+        out << ",\n      \"stages\": {";
+
+        // per-dispatch averages; a stage may run several times per dispatch
+        bool first = true;
+        for (const auto& stage : r.stages) {
+            out << (first ? "\n" : ",\n") << "        \"" << json_escape(stage.first) << "\": {\"seconds\": "
+                << stage.second.total_seconds / options.repeat << ", \"calls\": "
+                << (double)stage.second.calls / options.repeat << "}";
+            first = false;
+        }
+        out << (first ? "}}" : "\n      }}");
+    }
+    out << "\n  ]\n}\n";
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    bench_options_t options;
+    try {
+        options = parse_options(argc, argv);
+    } catch (const std::exception& e) {
+        std::cerr << "[mcut_bench] " << e.what() << std::endl;
+        return 1;
+    }
+
+    std::vector<bench_result_t> results;
+
+    for (const uint32_t helpers : options.helpers) {
+        McContext context = MC_NULL_HANDLE;
+        if (mcCreateContextWithHelpers(&context, MC_NULL_HANDLE, helpers) != MC_NO_ERROR) {
+            std::cerr << "[mcut_bench] cannot create a context with " << helpers << " helpers" << std::endl;
+            continue;
+        }
+
+        for (const uint32_t source_faces : options.source_faces) {
+            const input_mesh_t src = make_source_mesh(source_faces);
+
+            for (const uint32_t cut_faces : options.cut_faces) {
+                for (const double overlap : options.overlaps) {
+                    for (const double degenerate_rate : options.degenerate_rates) {
+                        bench_result_t result;
+                        result.overlap = overlap;
+                        result.degenerate_rate = degenerate_rate;
+                        result.helpers = helpers;
+
+                        const input_mesh_t cut = make_cut_mesh(cut_faces, overlap, degenerate_rate, result.degenerate_cut_faces);
+                        result.source_faces = (uint32_t)src.face_sizes.size();
+                        result.cut_faces = (uint32_t)cut.face_sizes.size();
+
+                        try {
+                            run_configuration(context, src, cut, options.repeat, result);
+                        } catch (const std::exception& e) {
+                            result.error = e.what();
+                        }
+
+                        std::cerr << "[mcut_bench] src=" << result.source_faces << " cut=" << result.cut_faces
+                                  << " overlap=" << overlap << " degenerate=" << degenerate_rate
+                                  << " helpers=" << helpers << ": "
+                                  << (result.error.empty() ? std::to_string(result.dispatch_seconds.front()) + " s" : "error: " + result.error)
+                                  << std::endl;
+                        results.push_back(std::move(result));
+                    }
+                }
+            }
+        }
+
+        mcReleaseContext(context);
+    }
+
+    std::ofstream out(options.output);
+    if (!out) {
+        std::cerr << "[mcut_bench] cannot write " << options.output << std::endl;
+        return 1;
+    }
+    write_json(out, options, results);
+    std::cerr << "[mcut_bench] results written to " << options.output << std::endl;
+    return 0;
+}
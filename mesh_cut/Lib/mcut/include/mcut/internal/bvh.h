@@ -125,6 +125,20 @@ extern void build_oibvh(
 	const double& slightEnlargmentEps=0.0, // in native user coordinates
 	const double multiplier=1.);
 
+// Update the bounding boxes of an oi-bvh (built with "build_oibvh") after the vertices of "mesh" have moved
+// but its faces have not changed. The leaf order (morton order of the old positions) is kept, so the boxes
+// stay conservative but the tree may become looser than a rebuilt one as the mesh deforms.
+extern void refit_oibvh(
+#if defined(MCUT_WITH_COMPUTE_HELPER_THREADPOOL)
+    thread_pool& pool,
+#endif
+    const hmesh_t& mesh,
+    std::vector<bounding_box_t<vec3_<double>>>& bvhAABBs,
+    const std::vector<fd_t>& bvhLeafNodeFaces,
+    std::vector<bounding_box_t<vec3_<double>>>& face_bboxes,
+	const double& slightEnlargmentEps=0.0, // in native user coordinates
+	const double multiplier=1.);
+
 extern void intersectOIBVHs(
     std::map<fd_t, std::vector<fd_t>>& ps_face_to_potentially_intersecting_others,
     const std::vector<bounding_box_t<vec3_<double>>>& srcMeshBvhAABBs,
@@ -0,0 +1,89 @@
+/***************************************************************************
+ *  This file is part of the MCUT project, which is comprised of a library 
+ *  for surface mesh cutting, example programs and test programs.
+ * 
+ *  Copyright (C) 2024 CutDigital Enterprise Ltd
+ *  
+ *  MCUT is dual-licensed software that is available under an Open Source 
+ *  license as well as a commercial license. The Open Source license is the 
+ *  GNU Lesser General Public License v3+ (LGPL). The commercial license 
+ *  option is for users that wish to use MCUT in their products for commercial 
+ *  purposes but do not wish to release their software under the LGPL. 
+ *  Email <contact@cut-digital.com> for further information.
+ *
+ *  You may not use this file except in compliance with the License. A copy of 
+ *  the Open Source license can be obtained from
+ *
+ *      https://www.gnu.org/licenses/lgpl-3.0.en.html.
+ *
+ *  For your convenience, a copy of this License has been included in this
+ *  repository.
+ *
+ *  MCUT is distributed in the hope that it will be useful, but THE SOFTWARE IS 
+ *  PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, 
+ *  INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR 
+ *  A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR 
+ *  COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, 
+ *  WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF 
+ *  OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * Author(s):
+ *
+ *    Floyd M. Chitalu    CutDigital Enterprise Ltd.
+ *
+ **************************************************************************/
+
+
+
+/**
+ * @file csg.h
+ *
+ * @brief Evaluation of constructive solid geometry (CSG) operations on solids 
+ * that are kept in their internal (halfedge) representation.
+ *
+ * NOTE: This header file declares the engine behind mcDispatchCSG. The result 
+ * of each operation is passed to the next one as a list of halfedge meshes, 
+ * which avoids converting intermediate solids to and from user arrays.
+ *
+ */
+
+#ifndef _CSG_H_
+#define _CSG_H_
+
+#include "mcut/internal/frontend.h"
+#include "mcut/internal/hmesh.h"
+
+#include <memory>
+#include <vector>
+
+// A closed surface bounding (part of) a solid. A cavity is a shell that bounds
+// an internal void, and which therefore has inward-facing normals.
+struct csg_shell_t {
+    std::shared_ptr<hmesh_t> mesh;
+    bool is_cavity = false;
+};
+
+// Return the signed volume enclosed by a closed mesh, which is positive if its
+// normals face outward.
+double compute_signed_volume(const hmesh_t& mesh);
+
+// Replace the mesh of each shell with a copy that is translated by "offset".
+void translate_csg_shells(std::vector<csg_shell_t>& shells, const vec3& offset);
+
+// Compute "result" = "a" <operation> "b", where "a" and "b" are the shells of
+// two solids. Each pair of shells whose bounding boxes overlap is resolved with
+// one kernel invocation, and shells whose surfaces do not intersect are
+// classified by their winding number with respect to each other.
+//
+// The operand meshes may be modified by polygon partitioning (which does not
+// change their geometry). The shells of "result" reference either operand
+// meshes or new meshes produced by the kernel.
+void evaluate_csg_operation(
+    std::shared_ptr<context_t> context_ptr,
+    McFlags dispatchFlags,
+    const McCSGOperation operation,
+    const std::vector<csg_shell_t>& a,
+    const std::vector<csg_shell_t>& b,
+    std::vector<csg_shell_t>& result);
+
+#endif // #ifndef _CSG_H_
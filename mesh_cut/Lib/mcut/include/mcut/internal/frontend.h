@@ -93,6 +93,14 @@ extern thread_local std::string per_thread_api_log_str; // frontend.cpp
 extern "C" void create_context_impl(
     McContext* pContext, McFlags flags, uint32_t num_helper_threads) noexcept(false);
 
+extern "C" void create_context_with_placement_impl(
+    McContext* pContext,
+    McFlags flags,
+    uint32_t num_helper_threads,
+    McInt32 numaNode,
+    McUint32 numCpus,
+    const McUint32* pCpus) noexcept(false);
+
 extern "C" void debug_message_callback_impl(
     McContext context,
     pfn_mcDebugOutput_CALLBACK cb,
@@ -175,6 +183,36 @@ extern "C" void dispatch_planar_section_impl(
     const McEvent* pEventWaitList,
     McEvent* pEvent) noexcept(false);
 
+extern "C" void dispatch_planar_sections_impl(
+    McContext context,
+    McFlags flags,
+    const McVoid* pSrcMeshVertices,
+    const uint32_t* pSrcMeshFaceIndices,
+    const uint32_t* pSrcMeshFaceSizes,
+    uint32_t numSrcMeshVertices,
+    uint32_t numSrcMeshFaces,
+    const McDouble* pNormalVector,
+    const McDouble* pSectionOffsets,
+    uint32_t numSectionOffsets,
+    uint32_t numEventsInWaitlist,
+    const McEvent* pEventWaitList,
+    McEvent* pEvent) noexcept(false);
+
+extern "C" void dispatch_csg_impl(
+    McContext context,
+    McFlags flags,
+    const McVoid* const* ppMeshVertices,
+    const uint32_t* const* ppMeshFaceIndices,
+    const uint32_t* const* ppMeshFaceSizes,
+    const uint32_t* pMeshVertexCounts,
+    const uint32_t* pMeshFaceCounts,
+    uint32_t numMeshes,
+    const McCSGNode* pNodes,
+    uint32_t numNodes,
+    uint32_t numEventsInWaitlist,
+    const McEvent* pEventWaitList,
+    McEvent* pEvent) noexcept(false);
+
 extern "C" void get_connected_components_impl(
     const McContext context,
     const McConnectedComponentType connectedComponentType,
@@ -323,10 +361,22 @@ struct input_cc_t : public connected_component_t {
     McInputOrigin origin = (McInputOrigin)0;
 };
 
+// struct representing the contour(s) of a planar section
+struct section_cc_t : public connected_component_t {
+    McUint32 sectionIndex = 0; // index into the user's array of section offsets
+};
+
+// struct representing an unsealed fragment between two consecutive planar sections
+struct slab_cc_t : public fragment_cc_t {
+    McUint32 sectionIndex = 0; // index of the slab (ordered by increasing offset)
+};
+
 struct event_t {
-    std::future<void> m_future; // used to wait on event
+    // set once the task associated with this event has finished running (waited on
+    // by mcWaitForEvents and blocking API calls)
+    completion_flag m_finished;
     // used to synchronise access to variables associated with the callback
-    // function.
+    // function, and to the list of continuations.
     // This also also allows us to overcome the edgecase that mcSetEventCallback
     // is called after the task associated with an event has been completed,
     // in which case the new callback will be invoked immediately.
@@ -341,9 +391,10 @@ struct event_t {
         // object has been called
         std::atomic<bool> m_invoked;
     } m_callback_info;
-    // atomic boolean flag indicating whether the task associated with event
-    // object has completed running
-    std::atomic<bool> m_finished;
+    // Functions to run once this event is finished. These are used to submit the API
+    // tasks that depend on this event, so that no API thread has to block while waiting
+    // for an event (see "add_continuation()" below).
+    std::vector<std::function<void()>> m_continuations;
     McEvent m_user_handle; // handle used by client app to reference this event object
     // the Manager thread which was assigned the task of managing the task associated with this event object.
     std::atomic<uint32_t> m_responsible_thread_id;
@@ -354,13 +405,6 @@ struct event_t {
     std::atomic<uint32_t> m_command_exec_status;
     bool m_profiling_enabled;
     McCommandType m_command_type;
-    // A callable object that also holds an std::future. Its purpose is to emulate
-    // the internal representation of an API task, where this time the task is actually
-    // a user command since this pointer is define ONLY for user events.
-    // The std::future object of the packaged task is used to initialize m_future
-    // when this event is a user event. This our internal mechanism allowing for
-    // API command to be able to effectively wait on user events.
-    std::unique_ptr<std::packaged_task<void()>> m_user_API_command_task_emulator;
     McContext m_context;
 
     const char* get_cmd_type_str()
@@ -386,30 +430,39 @@ struct event_t {
             return "UNKNOWN VALUE";
         }
     }
-    explicit event_t(McEvent user_handle, McCommandType command_type)
-        : m_user_handle(user_handle)
-        , m_responsible_thread_id(UINT32_MAX)
-        , m_runtime_exec_status(MC_NO_ERROR)
-        , m_timestamp_submit(0)
-        , m_timestamp_start(0)
-        , m_timestamp_end(0)
-        , m_command_exec_status((McUint32)((int)(MC_RESULT_MAX_ENUM)))
-        , m_profiling_enabled(true)
-        , m_command_type(command_type)
-        , m_user_API_command_task_emulator(nullptr)
-        , m_context(nullptr)
-    {
-        log_msg("[MCUT] Create event (type=" << get_cmd_type_str() <<", handle=" << m_user_handle << ")");
 
+    event_t()
+    {
+        reset(MC_NULL_HANDLE, McCommandType::MC_COMMAND_UKNOWN);
+    }
+
+    // (re-)initialise the event, which may have been recycled by "event_pool_t"
+    void reset(McEvent user_handle, McCommandType command_type)
+    {
+        m_finished.reset();
         m_callback_info.m_fn_ptr = nullptr;
         m_callback_info.m_data_ptr = nullptr;
-        m_finished.store(false);
-        m_callback_info.m_invoked.store(true); // so that we do not call a null pointer/needless invoke the callback in the destructor
+        m_callback_info.m_invoked.store(true); // so that we do not call a null pointer/needless invoke the callback in "retire()"
+        m_continuations.clear();
+        m_user_handle = user_handle;
+        m_responsible_thread_id = UINT32_MAX;
+        m_runtime_exec_status = MC_NO_ERROR;
+        m_timestamp_submit = 0;
+        m_timestamp_start = 0;
+        m_timestamp_end = 0;
+        m_command_exec_status = (McUint32)((int)(MC_RESULT_MAX_ENUM));
+        m_profiling_enabled = true;
+        m_command_type = command_type;
+        m_context = nullptr;
+
+        if (user_handle != MC_NULL_HANDLE) {
+            log_msg("[MCUT] Create event (type=" << get_cmd_type_str() << ", handle=" << m_user_handle << ")");
+        }
     }
 
-    ~event_t()
+    // called when the last reference to the event is dropped, before it is recycled
+    void retire()
     {
-
         if (m_callback_info.m_invoked.load() == false && m_callback_info.m_fn_ptr != nullptr && m_runtime_exec_status.load() == MC_NO_ERROR) {
             MCUT_ASSERT(m_user_handle != MC_NULL_HANDLE);
             (*(m_callback_info.m_fn_ptr))(m_user_handle, m_callback_info.m_data_ptr);
@@ -460,32 +513,108 @@ struct event_t {
         m_callback_info.m_data_ptr = data_ptr;
         m_callback_info.m_invoked.store(false);
 
-        if (m_finished.load() == true) { // see mutex documentation
+        if (m_finished.is_set()) { // see mutex documentation
             // immediately invoke the callback
             (*(m_callback_info.m_fn_ptr))(m_user_handle, m_callback_info.m_data_ptr);
             m_callback_info.m_invoked.store(true);
         }
     }
 
+    // Register "fn" to be called once the event is finished. Returns false (and does
+    // not keep "fn") if the event has already finished.
+    bool add_continuation(std::function<void()> fn)
+    {
+        std::lock_guard<std::mutex> lock(m_callback_mutex);
+
+        if (m_finished.is_set()) {
+            return false;
+        }
+
+        m_continuations.push_back(std::move(fn));
+        return true;
+    }
+
+    // block until the task associated with the event has finished
+    void wait()
+    {
+        m_finished.wait();
+    }
+
     // update the status of the event object to "finished"
     void notify_task_complete(McResult exec_status)
     {
-        m_finished = true;
         m_runtime_exec_status = exec_status;
+        log_end_time();
 
-        std::lock_guard<std::mutex> lock(m_callback_mutex);
-        if (m_callback_info.m_invoked.load() == false && m_callback_info.m_fn_ptr != nullptr) {
-            MCUT_ASSERT(m_user_handle != MC_NULL_HANDLE);
-            (*(m_callback_info.m_fn_ptr))(m_user_handle, m_callback_info.m_data_ptr);
-            m_callback_info.m_invoked.store(true);
+        std::vector<std::function<void()>> continuations;
+
+        {
+            std::lock_guard<std::mutex> lock(m_callback_mutex);
+            if (m_callback_info.m_invoked.load() == false && m_callback_info.m_fn_ptr != nullptr) {
+                MCUT_ASSERT(m_user_handle != MC_NULL_HANDLE);
+                (*(m_callback_info.m_fn_ptr))(m_user_handle, m_callback_info.m_data_ptr);
+                m_callback_info.m_invoked.store(true);
+            }
+            continuations.swap(m_continuations);
+            m_finished.set(); // wake up waiting threads
+        }
+
+        for (std::vector<std::function<void()>>::iterator i = continuations.begin(); i != continuations.end(); ++i) {
+            (*i)();
         }
     }
 };
 
+// Event objects are created for every enqueued command. Instead of allocating (and
+// freeing) one each time, finished events are kept here and recycled.
+class event_pool_t {
+    std::mutex m_mutex;
+    std::vector<event_t*> m_free;
+
+public:
+    event_pool_t() { }
+    event_pool_t(const event_pool_t&) = delete;
+    event_pool_t& operator=(const event_pool_t&) = delete;
+
+    ~event_pool_t()
+    {
+        for (std::vector<event_t*>::iterator i = m_free.begin(); i != m_free.end(); ++i) {
+            delete *i;
+        }
+    }
+
+    std::shared_ptr<event_t> acquire(McEvent user_handle, McCommandType command_type)
+    {
+        event_t* event = nullptr;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (!m_free.empty()) {
+                event = m_free.back();
+                m_free.pop_back();
+            }
+        }
+
+        if (event == nullptr) {
+            event = new event_t;
+        }
+
+        event->reset(user_handle, command_type);
+
+        return std::shared_ptr<event_t>(event, [this](event_t* e) { recycle(e); });
+    }
+
+private:
+    void recycle(event_t* event)
+    {
+        event->retire();
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_free.push_back(event);
+    }
+};
+
 // init in frontened.cpp
-extern threadsafe_list<std::shared_ptr<event_t>> g_events;
-extern std::atomic<std::uintptr_t> g_objects_counter; // a counter that is used to assign a unique value to a McObject handle that will be returned to the user
-extern std::once_flag g_objects_counter_init_flag;
+extern event_pool_t g_event_pool;
+extern threadsafe_handle_table<event_t> g_events;
 
 // our custome deleter function for std::unique_ptr variable of an array type
 template <typename Derived>
@@ -496,7 +625,99 @@ void fn_delete_cc(connected_component_t* p)
 }
 
 // struct defining the state of a context object
-struct context_t {
+// The callable that an API thread runs for an enqueued command: it checks the outcome of the
+// events in the wait-list, runs the API function and completes the event of the command.
+// If the task is dropped without being run (e.g. its context is released first), the event
+// is completed with an error so that nobody waits on it forever.
+template <typename FunctionType>
+struct api_task_t {
+    std::shared_ptr<event_t> m_event;
+    std::vector<std::shared_ptr<event_t>> m_waitlist;
+    FunctionType m_fn;
+
+    api_task_t(std::shared_ptr<event_t>&& event, std::vector<std::shared_ptr<event_t>>&& waitlist, FunctionType&& fn)
+        : m_event(std::move(event))
+        , m_waitlist(std::move(waitlist))
+        , m_fn(std::move(fn))
+    {
+    }
+
+    api_task_t(api_task_t&& other) = default;
+
+    ~api_task_t()
+    {
+        if (m_event != nullptr) {
+            m_event->notify_task_complete(McResult::MC_INVALID_OPERATION);
+        }
+    }
+
+    void operator()()
+    {
+        const std::shared_ptr<event_t> event = std::move(m_event);
+
+        MCUT_ASSERT(event != nullptr);
+
+        // if any previous event failed then we cannot proceed with this task.
+        // i.e. no-Op, and the failure is passed on
+        for (std::vector<std::shared_ptr<event_t>>::const_iterator i = m_waitlist.cbegin(); i != m_waitlist.cend(); ++i) {
+            const McResult status = (McResult)(*i)->m_runtime_exec_status.load();
+            if (status != McResult::MC_NO_ERROR) {
+                event->notify_task_complete(status);
+                return;
+            }
+        }
+
+        m_waitlist.clear();
+
+        McResult return_value = McResult::MC_NO_ERROR;
+        per_thread_api_log_str.clear();
+
+        event->log_start_time();
+
+        try {
+            m_fn(); // execute the API function.
+        }
+        CATCH_POSSIBLE_EXCEPTIONS(per_thread_api_log_str); // exceptions may be thrown due to runtime errors, which must be reported back to user
+
+        if (!per_thread_api_log_str.empty()) {
+
+            std::fprintf(stderr, "%s(...) -> %s (EventID=%p)\n", __FUNCTION__, per_thread_api_log_str.c_str(), event->m_user_handle);
+
+            if (return_value == McResult::MC_NO_ERROR) // i.e. problem with basic local parameter checks
+            {
+                return_value = McResult::MC_INVALID_VALUE;
+            }
+        }
+
+        event->notify_task_complete(return_value); // updated event state to indicate task completion (lock-based)
+    }
+};
+
+// The input meshes of a dispatch call
+enum class dispatch_input_t : int {
+    SOURCE_MESH = 0,
+    CUT_MESH = 1
+};
+
+// What is kept of an input mesh between dispatch calls that only change its vertex positions
+// (see MC_DISPATCH_REUSE_SOURCE_MESH_TOPOLOGY and MC_DISPATCH_REUSE_CUT_MESH_TOPOLOGY).
+// Immutable once stored in the context.
+struct dispatch_input_topology_t {
+    McUint32 num_vertices = 0;
+    McUint32 num_faces = 0;
+    // hash of the face-index and face-size arrays the topology was built from
+    uint64_t faces_hash = 0;
+    // halfedge connectivity (the vertex positions are those of the dispatch that stored it)
+    std::shared_ptr<const hmesh_t> mesh;
+    // result of the watertightness check
+    bool is_watertight = false;
+#if defined(USE_OIBVH)
+    // leaf order of the BVH (which is refitted rather than rebuilt)
+    std::vector<fd_t> bvh_leaf_faces;
+#endif
+};
+
+struct context_t : public std::enable_shared_from_this<context_t> {
 private:
     std::atomic<bool> m_done; // are we finished with the context (i.e. indicate to shutdown threadpool and freeup respective resourses)
     // the work-queues associated with each API (device) thread
@@ -527,6 +748,13 @@ private:
     // The state and flag variable currently used to configure the next dispatch call
     McFlags m_flags = (McFlags)0;
 
+    // The logical CPUs that the API and helper threads are pinned to (empty if placement
+    // is left to the OS), and the NUMA node these CPUs were taken from (-1 if none).
+    // Since the API threads build the per-dispatch meshes, pinning them also places the 
+    // first touch of this memory on the node of the pinned CPUs.
+    const std::vector<uint32_t> m_cpu_set;
+    const McInt32 m_numa_node;
+
     // as it says on the tin: "tiny" number used to enforce general position
     std::atomic<McDouble> m_general_position_enforcement_constant;
     // The maximum number of iterations/attempts over which to try and resolve the input meshes into general position
@@ -540,6 +768,35 @@ private:
     // The type of intersection (between source-mesh and cut-mesh) that was detected during the last/most-recent
     // dispatch call.
     std::atomic<McDispatchIntersectionType> m_most_recent_dispatch_intersection_type;
+    // The input-mesh topologies stored by dispatch calls with the MC_DISPATCH_REUSE_..._TOPOLOGY flags
+    // (indexed by "dispatch_input_t")
+    std::mutex m_input_topology_mutex;
+    std::shared_ptr<const dispatch_input_topology_t> m_input_topology[2];
+
+    // An API task that is waiting for the events in its wait-list. Whoever drops the last reference submits the
+    // task to the context (if the context still exists).
+    struct pending_api_task_t {
+        std::atomic<uint32_t> m_references;
+        function_wrapper m_task;
+        std::weak_ptr<context_t> m_context;
+
+        pending_api_task_t(function_wrapper&& task, const std::shared_ptr<context_t>& context, uint32_t references)
+            : m_references(references)
+            , m_task(std::move(task))
+            , m_context(context)
+        {
+        }
+
+        void release_one()
+        {
+            if (m_references.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                std::shared_ptr<context_t> context = m_context.lock();
+                if (context != nullptr) {
+                    context->m_queue.push(std::move(m_task));
+                }
+            }
+        }
+    };
 
     // This is the "main" function of each device/API/manger thread. When a context is created and 
     // the internal scheduling threadpool is initialised, each (device) thread is launched with this
@@ -584,7 +841,7 @@ private:
     }
 
 public:
-    context_t(McContext handle, McFlags flags
+    context_t(McContext handle, McFlags flags, const std::vector<uint32_t>& cpu_set, McInt32 numa_node
 #if defined(MCUT_WITH_COMPUTE_HELPER_THREADPOOL)
         ,
         uint32_t num_compute_threads
@@ -593,6 +850,8 @@ public:
         : m_done(false)
         // , m_joiner(m_api_threads)
         , m_flags(flags)
+        , m_cpu_set(cpu_set)
+        , m_numa_node(numa_node)
         , m_general_position_enforcement_constant(1e-4) // 0.0001
         , m_max_num_perturbation_attempts(1 << 2), // 4
         // default winding order (as determing from the normals of the input mesh faces)
@@ -623,13 +882,27 @@ public:
 			}
             #endif
 
-
+            for (uint32_t i = 0; i < (uint32_t)m_api_threads.size(); ++i) {
+                if (!set_thread_affinity(m_api_threads[i], m_cpu_set)) {
+                    throw std::invalid_argument("cannot pin API thread to the requested CPUs");
+                }
+            }
             
 #if defined(MCUT_WITH_COMPUTE_HELPER_THREADPOOL)
+            if (!m_cpu_set.empty()) {
+                // avoid over-subscribing the pinned CPUs, which the API threads already use
+                const uint32_t free_cpus = (uint32_t)m_cpu_set.size() > manager_thread_count ? (uint32_t)m_cpu_set.size() - manager_thread_count : 0;
+                num_compute_threads = std::min(num_compute_threads, free_cpus);
+            }
+
             // create the pool of compute threads. These are the worker threads that
             // can be tasked with work from any manager-thread. Thus, manager threads
             // share the available/user-specified compute threads.
             m_compute_threadpool = std::unique_ptr<thread_pool>(new thread_pool(num_compute_threads, manager_thread_count));
+
+            if (!m_compute_threadpool->set_affinity(m_cpu_set)) {
+                throw std::invalid_argument("cannot pin helper threads to the requested CPUs");
+            }
 #endif
         } catch (...) {
             shutdown(); // free up memory shutdown device threads etc.
@@ -675,6 +948,18 @@ public:
         return this->m_flags;
     }
 
+    // returns the logical CPUs that the threads of this context are pinned to (empty if not pinned)
+    const std::vector<uint32_t>& get_cpu_set() const
+    {
+        return this->m_cpu_set;
+    }
+
+    // returns the NUMA node that the threads of this context are pinned to (-1 if none)
+    McInt32 get_numa_node() const
+    {
+        return this->m_numa_node;
+    }
+
     // returns (user controllable) epsilon representing the maximum by which the cut-mesh
     // can be perturbed on any axis
     McDouble get_general_position_enforcement_constant() const
@@ -709,6 +994,18 @@ public:
         this->m_connected_component_winding_order.store(new_value, std::memory_order_release);
     }
 
+    std::shared_ptr<const dispatch_input_topology_t> get_input_topology(dispatch_input_t input)
+    {
+        std::lock_guard<std::mutex> lock(m_input_topology_mutex);
+        return m_input_topology[(int)input];
+    }
+
+    void set_input_topology(dispatch_input_t input, const std::shared_ptr<const dispatch_input_topology_t>& topology)
+    {
+        std::lock_guard<std::mutex> lock(m_input_topology_mutex);
+        m_input_topology[(int)input] = topology;
+    }
+
     McDispatchIntersectionType get_most_recent_dispatch_intersection_type()const
     {
         return this->m_most_recent_dispatch_intersection_type.load(std::memory_order_acquire);
@@ -730,6 +1027,9 @@ public:
     /*
     This function serves the purpose of scheduling an API task (i.e. an async API function call from the user) by submitting this
     task into an internal work-queue that will be checked and popped-from by a device thread.
+
+    A task whose wait-list contains unfinished events is not queued straight away. Instead, it is attached as a continuation
+    to each of those events, and the last of them to finish submits it. Thus, device threads never block on a wait-list.
     */
     template <typename FunctionType>
     McEvent prepare_and_submit_API_task(
@@ -739,29 +1039,36 @@ public:
         FunctionType api_fn // a function (lambda/functor) encapsulating the API task to be executed asynchronously
     )
     {
+        // List of events the enqueued task depends on
+        //
+        // resolved now since the client application is permitted to re-use the memory pointed to by "pEventWaitList" (and
+        // to release the events) after this call
+        std::vector<std::shared_ptr<event_t>> event_waitlist(numEventsInWaitlist);
+
+        for (uint32_t i = 0; i < numEventsInWaitlist; ++i) {
+            event_waitlist[i] = g_events.find(pEventWaitList[i]);
+
+            if (event_waitlist[i] == nullptr) { // not found
+                throw std::invalid_argument("invalid event in waitlist"); // client gave us something we don't recognise
+            }
+        }
+
         //
         // create the event object associated with the enqueued task
         //
 
-        std::shared_ptr<event_t> event_ptr = std::shared_ptr<event_t>(new event_t(
-            reinterpret_cast<McEvent>(g_objects_counter.fetch_add(1, std::memory_order_relaxed)), // the handle is just a lightweight integer counter
-            cmdType));
+        std::shared_ptr<event_t> event_ptr = g_event_pool.acquire(
+            reinterpret_cast<McEvent>(g_events.reserve()), // the handle is a generation-checked slot of "g_events"
+            cmdType);
 
         MCUT_ASSERT(event_ptr != nullptr);
 
-        g_events.push_front(event_ptr);
+        g_events.publish(event_ptr->m_user_handle, event_ptr);
 
-        //event_ptr->m_user_handle = reinterpret_cast<McEvent>(g_objects_counter.fetch_add(1, std::memory_order_relaxed));
         event_ptr->m_profiling_enabled = (this->m_flags & MC_PROFILING_ENABLE) != 0;
-        // event_ptr->m_command_type = cmdType;
 
         event_ptr->log_submit_time();
 
-        // List of events the enqueued task depends on
-        //
-        // local copy that will be captured by-value (client application is permitted to re-use the memory pointed to by "pEventWaitList")
-        const std::vector<McEvent> event_waitlist(pEventWaitList, pEventWaitList + numEventsInWaitlist);
-
 #if 0
         //
         // Determine which manager thread to assign the task to
@@ -774,13 +1081,13 @@ public:
         for (std::vector<McEvent>::const_iterator waitlist_iter = event_waitlist.cbegin(); waitlist_iter != event_waitlist.cend(); ++waitlist_iter) {
             const McEvent& parent_task_event_handle = *waitlist_iter;
             // get actual event object
-            const std::shared_ptr<event_t> parent_task_event_ptr = g_events.find_first_if([=](std::shared_ptr<event_t> e) { return e->m_user_handle == parent_task_event_handle; });
+            const std::shared_ptr<event_t> parent_task_event_ptr = g_events.find(parent_task_event_handle);
 
             if (parent_task_event_ptr == nullptr) { // not found
                 throw std::invalid_argument("invalid event in waitlist"); // client gave us something we don't recognise
             }
 
-            const bool parent_task_is_not_finished = parent_task_event_ptr->m_finished.load() == false;
+            const bool parent_task_is_not_finished = !parent_task_event_ptr->m_finished.is_set();
 
             // task associated with event is still running and the event is a user-event
             if (parent_task_is_not_finished && parent_task_event_ptr->m_command_type != McCommandType::MC_COMMAND_USER) {
@@ -815,79 +1122,51 @@ public:
             }
         }
 #endif
-        //
-        // Package-up the task as a synchronised operation that will wait for
-        // other tasks in the event_waitlist, compute the operation, and finally update
-        // the respective event state with the completion status.
-        //
-
-        std::weak_ptr<event_t> event_weak_ptr(event_ptr);
-
-        std::packaged_task<void()> task(
-            [=]() {
-                McResult runtime_status_from_all_preceding_events = McResult::MC_NO_ERROR;
-
-                if (!event_waitlist.empty()) {
-                    wait_for_events_impl((uint32_t)event_waitlist.size(), &event_waitlist[0], runtime_status_from_all_preceding_events); // block until events are done
-                }
-
-                // if any previous event failed then we cannot proceed with this task.
-                // i.e. no-Op
-                if (runtime_status_from_all_preceding_events != McResult::MC_NO_ERROR) {
-                    return;
-                }
-
-                MCUT_ASSERT(!event_weak_ptr.expired());
-
-                {
-                    std::shared_ptr<event_t> event = event_weak_ptr.lock();
-
-                    MCUT_ASSERT(event != nullptr);
+#	if 0
+        event_ptr->m_responsible_thread_id = responsible_thread_id;
+#	else
+		event_ptr->m_responsible_thread_id = -1u; // unused
+#endif
 
-                    {
-                        McResult return_value = McResult::MC_NO_ERROR;
-                        per_thread_api_log_str.clear();
+        const McEvent event_handle = event_ptr->m_user_handle;
 
-                        event->log_start_time();
+        std::vector<std::shared_ptr<event_t>> unfinished_events;
 
-                        try {
-                            api_fn(); // execute the API function.
-                        }
-                        CATCH_POSSIBLE_EXCEPTIONS(per_thread_api_log_str); // exceptions may be thrown due to runtime errors, which must be reported back to user
+        for (std::vector<std::shared_ptr<event_t>>::const_iterator i = event_waitlist.cbegin(); i != event_waitlist.cend(); ++i) {
+            if (!(*i)->m_finished.is_set()) {
+                unfinished_events.push_back(*i);
+            }
+        }
 
-                        if (!per_thread_api_log_str.empty()) {
+        //
+        // Package-up the task as an operation that will compute the API function and finally update
+        // the respective event state with the completion status.
+        //
 
-                            std::fprintf(stderr, "%s(...) -> %s (EventID=%p)\n", __FUNCTION__, per_thread_api_log_str.c_str(), event == nullptr ? (McEvent)0 : event->m_user_handle);
+        function_wrapper task(api_task_t<FunctionType>(std::move(event_ptr), std::move(event_waitlist), std::move(api_fn)));
 
-                            if (return_value == McResult::MC_NO_ERROR) // i.e. problem with basic local parameter checks
-                            {
-                                return_value = McResult::MC_INVALID_VALUE;
-                            }
-                        }
+        if (unfinished_events.empty()) {
+            m_queue.push(std::move(task)); // enqueue task to be executed when an API thread is free
+        } else {
+            // one reference for each unfinished event, plus one that is dropped below (so that the task is not
+            // submitted while we are still registering it)
+            std::shared_ptr<pending_api_task_t> pending_task(new pending_api_task_t(
+                std::move(task), shared_from_this(), (uint32_t)unfinished_events.size() + 1));
 
-                        event->notify_task_complete(return_value); // updated event state to indicate task completion (lock-based)
-                        event->log_end_time();
-                    }
+            for (std::vector<std::shared_ptr<event_t>>::const_iterator i = unfinished_events.cbegin(); i != unfinished_events.cend(); ++i) {
+                if (!(*i)->add_continuation([pending_task]() { pending_task->release_one(); })) {
+                    pending_task->release_one(); // finished in the meantime
                 }
-            });
+            }
 
-        event_ptr->m_future = task.get_future(); // the future we can later wait on via mcWaitForEVents
-#	if 0
-        event_ptr->m_responsible_thread_id = responsible_thread_id;
-#	else
-		event_ptr->m_responsible_thread_id = -1u; // unused
-#endif
+            pending_task->release_one();
+        }
 
-        #if 0
-        m_queues[responsible_thread_id].push(std::move(task)); // enqueue task to be executed when responsible API thread is free
-        #else
-		m_queue.push(std::move(task)); // enqueue task to be executed when responsible API thread is free
-        #endif
-        return event_ptr->m_user_handle;
+        return event_handle;
     }
 
     // the current set of connected components associated with context
-    threadsafe_list<std::shared_ptr<connected_component_t>> connected_components;
+    threadsafe_handle_table<connected_component_t> connected_components;
 
     // McFlags dispatchFlags = (McFlags)0;
 
@@ -977,6 +1256,6 @@ extern "C" void triangulate_face(
 	const double multiplier);
 
 // list of contexts created by client/user
-extern "C" threadsafe_list<std::shared_ptr<context_t>> g_contexts;
+extern threadsafe_handle_table<context_t> g_contexts;
 
 #endif // #ifndef _FRONTEND_H_
\ No newline at end of file
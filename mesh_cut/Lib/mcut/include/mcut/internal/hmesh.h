@@ -40,6 +40,8 @@
 #include "mcut/internal/utils.h"
 
 #include <algorithm>
+#include <cstddef>
+#include <iterator>
 #include <limits>
 #include <map>
 #include <memory>
@@ -245,6 +247,139 @@ typedef array_iterator_t<vertex_array_t> vertex_array_iterator_t;
 typedef array_iterator_t<edge_array_t> edge_array_iterator_t;
 typedef array_iterator_t<halfedge_array_t> halfedge_array_iterator_t;
 
+/*
+    Allocation-free views of the neighbourhood of a face or vertex
+
+    A face stores its halfedges and a vertex stores its incoming halfedges, so the
+    elements around either can be produced lazily from these arrays (and the
+    halfedge records) instead of being copied into a new std::vector on every query.
+    A view is only valid while the mesh is not modified.
+*/
+
+// maps each halfedge to its target vertex, shifted by "offset" (see "hmesh_t::vertices_around_face")
+struct halfedge_target_map_t {
+    typedef vertex_descriptor_t value_type;
+    const halfedge_data_t* halfedges;
+    uint32_t offset;
+
+    bool accept(const halfedge_descriptor_t) const { return true; }
+    value_type operator()(const halfedge_descriptor_t h) const { return vertex_descriptor_t(offset + halfedges[h].t); }
+};
+
+// maps each (incoming) halfedge to its source vertex
+struct halfedge_source_map_t {
+    typedef vertex_descriptor_t value_type;
+    const halfedge_data_t* halfedges;
+
+    bool accept(const halfedge_descriptor_t) const { return true; }
+    value_type operator()(const halfedge_descriptor_t h) const { return halfedges[halfedges[h].o].t; }
+};
+
+// maps each halfedge to the face on the other side of it, skipping border halfedges
+struct halfedge_opposite_face_map_t {
+    typedef face_descriptor_t value_type;
+    const halfedge_data_t* halfedges;
+
+    bool accept(const halfedge_descriptor_t h) const
+    {
+        const halfedge_descriptor_t o = halfedges[h].o;
+        return o != halfedge_descriptor_t() && halfedges[o].f != face_descriptor_t();
+    }
+    value_type operator()(const halfedge_descriptor_t h) const { return halfedges[halfedges[h].o].f; }
+};
+
+template <typename Map>
+class halfedge_view_t {
+public:
+    typedef typename Map::value_type value_type;
+
+    class const_iterator {
+    public:
+        typedef std::forward_iterator_tag iterator_category;
+        typedef typename Map::value_type value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef const value_type* pointer;
+        typedef value_type reference;
+
+        const_iterator(const halfedge_descriptor_t* it, const halfedge_descriptor_t* end, const Map& map)
+            : m_it(it)
+            , m_end(end)
+            , m_map(map)
+        {
+            skip();
+        }
+
+        value_type operator*() const { return m_map(*m_it); }
+
+        const_iterator& operator++()
+        {
+            ++m_it;
+            skip();
+            return *this;
+        }
+
+        const_iterator operator++(int)
+        {
+            const_iterator tmp = *this;
+            ++(*this);
+            return tmp;
+        }
+
+        bool operator==(const const_iterator& other) const { return m_it == other.m_it; }
+        bool operator!=(const const_iterator& other) const { return m_it != other.m_it; }
+
+    private:
+        void skip()
+        {
+            while (m_it != m_end && !m_map.accept(*m_it)) {
+                ++m_it;
+            }
+        }
+
+        const halfedge_descriptor_t* m_it;
+        const halfedge_descriptor_t* m_end;
+        Map m_map;
+    };
+
+    halfedge_view_t(const std::vector<halfedge_descriptor_t>& halfedges, const Map& map)
+        : m_begin(halfedges.data())
+        , m_end(halfedges.data() + halfedges.size())
+        , m_map(map)
+    {
+    }
+
+    const_iterator begin() const { return const_iterator(m_begin, m_end, m_map); }
+    const_iterator end() const { return const_iterator(m_end, m_end, m_map); }
+    const_iterator cbegin() const { return begin(); }
+    const_iterator cend() const { return end(); }
+
+    bool empty() const { return begin() == end(); }
+
+    // random access, for views whose map does not skip halfedges (all but "faces_around_face")
+    uint32_t size() const { return (uint32_t)(m_end - m_begin); }
+    value_type operator[](const uint32_t i) const { return m_map(m_begin[i]); }
+    value_type front() const { return m_map(*m_begin); }
+    value_type back() const { return m_map(*(m_end - 1)); }
+
+    // materialise the view (e.g. to pass it to a function that expects a std::vector)
+    void copy_to(std::vector<value_type>& out) const
+    {
+        out.clear();
+        for (const_iterator i = begin(); i != end(); ++i) {
+            out.push_back(*i);
+        }
+    }
+
+private:
+    const halfedge_descriptor_t* m_begin;
+    const halfedge_descriptor_t* m_end;
+    Map m_map;
+};
+
+typedef halfedge_view_t<halfedge_target_map_t> vertices_around_face_view_t;
+typedef halfedge_view_t<halfedge_source_map_t> vertices_around_vertex_view_t;
+typedef halfedge_view_t<halfedge_opposite_face_map_t> faces_around_face_view_t;
+
 /*
     Internal mesh data structure used for cutting meshes
 
@@ -310,6 +445,13 @@ public:
     vertex_descriptor_t add_vertex(const vec3& point);
 
     vertex_descriptor_t add_vertex(const scalar_t& x, const scalar_t& y, const scalar_t& z);
+
+    // moves an existing vertex (connectivity is unchanged)
+    void set_vertex(const vertex_descriptor_t v, const vec3& point)
+    {
+        MCUT_ASSERT((size_t)v < m_vertices.size());
+        m_vertices[v].p = point;
+    }
     // adds an edges into the mesh data structure, creating incident halfedges, and returns the
     // halfedge whole target is "v1"
     halfedge_descriptor_t add_edge(const vertex_descriptor_t v0, const vertex_descriptor_t v1);
@@ -412,6 +554,28 @@ public:
     const std::vector<face_descriptor_t> get_faces_around_face(const face_descriptor_t f, const std::vector<halfedge_descriptor_t>* halfedges_around_face_ = nullptr) const;
     void get_faces_around_face( std::vector<face_descriptor_t>& faces_around_face, const face_descriptor_t f, const std::vector<halfedge_descriptor_t>* halfedges_around_face_ = nullptr) const;
     uint32_t get_num_faces_around_face(const face_descriptor_t f, const std::vector<halfedge_descriptor_t>* halfedges_around_face_ = nullptr) const;
+
+    // allocation-free counterparts of the queries above (see "halfedge_view_t")
+    vertices_around_face_view_t vertices_around_face(const face_descriptor_t f, uint32_t prepend_offset = 0) const
+    {
+        MCUT_ASSERT((size_t)f < m_faces.size());
+        const halfedge_target_map_t map = { m_halfedges.data(), prepend_offset };
+        return vertices_around_face_view_t(m_faces[f].m_halfedges, map);
+    }
+
+    vertices_around_vertex_view_t vertices_around_vertex(const vertex_descriptor_t v) const
+    {
+        MCUT_ASSERT((size_t)v < m_vertices.size());
+        const halfedge_source_map_t map = { m_halfedges.data() };
+        return vertices_around_vertex_view_t(m_vertices[v].m_halfedges, map);
+    }
+
+    faces_around_face_view_t faces_around_face(const face_descriptor_t f) const
+    {
+        MCUT_ASSERT((size_t)f < m_faces.size());
+        const halfedge_opposite_face_map_t map = { m_halfedges.data() };
+        return faces_around_face_view_t(m_faces[f].m_halfedges, map);
+    }
     
     // iterators
     // ---------
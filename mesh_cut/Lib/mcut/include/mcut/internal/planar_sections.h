@@ -0,0 +1,95 @@
+/***************************************************************************
+ *  This file is part of the MCUT project, which is comprised of a library 
+ *  for surface mesh cutting, example programs and test programs.
+ * 
+ *  Copyright (C) 2024 CutDigital Enterprise Ltd
+ *  
+ *  MCUT is dual-licensed software that is available under an Open Source 
+ *  license as well as a commercial license. The Open Source license is the 
+ *  GNU Lesser General Public License v3+ (LGPL). The commercial license 
+ *  option is for users that wish to use MCUT in their products for commercial 
+ *  purposes but do not wish to release their software under the LGPL. 
+ *  Email <contact@cut-digital.com> for further information.
+ *
+ *  You may not use this file except in compliance with the License. A copy of 
+ *  the Open Source license can be obtained from
+ *
+ *      https://www.gnu.org/licenses/lgpl-3.0.en.html.
+ *
+ *  For your convenience, a copy of this License has been included in this
+ *  repository.
+ *
+ *  MCUT is distributed in the hope that it will be useful, but THE SOFTWARE IS 
+ *  PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, 
+ *  INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR 
+ *  A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR 
+ *  COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, 
+ *  WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF 
+ *  OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * Author(s):
+ *
+ *    Floyd M. Chitalu    CutDigital Enterprise Ltd.
+ *
+ **************************************************************************/
+
+
+/**
+ * @file planar_sections.h
+ *
+ * @brief Batch slicing of a mesh with a family of parallel planes.
+ *
+ * NOTE: This header file declares the engine behind mcDispatchPlanarSections, 
+ * which computes all sections (and optionally the slabs between them) in a 
+ * single sweep over the source-mesh faces instead of one full dispatch per plane.
+ *
+ */
+
+#ifndef _PLANAR_SECTIONS_H_
+#define _PLANAR_SECTIONS_H_
+
+#include "mcut/internal/hmesh.h"
+#include "mcut/internal/kernel.h"
+
+#include <memory>
+#include <vector>
+
+// A section contour or slab fragment produced by the sweep. "index" is the 
+// position of the respective plane (section) or slab in the sorted order of planes.
+struct planar_slice_t {
+    std::shared_ptr<output_mesh_info_t> mesh_info;
+    uint32_t index;
+};
+
+// Slice "src_mesh" with the planes { x : dot(normal, x) == heights[k] }.
+//
+// "normal" must have unit length and "heights" must be sorted in ascending 
+// order. Side-of-plane tests are done with orient3d against three points on 
+// each plane, and every edge crossing is computed once from the canonical 
+// endpoints of the intersected source-mesh edge, so that neighbouring faces 
+// share identical section vertices.
+//
+// One "sections" entry is produced for each plane that intersects the mesh. 
+// Closed contours are stored as faces that wind counter-clockwise about 
+// "normal" for outer boundaries (clockwise for holes), and open contours are 
+// stored as edges. Vertices lying exactly on a plane are treated as being 
+// below it, and faces that are coplanar with a plane do not contribute to
+// its section.
+//
+// When "compute_slabs" is true, the (unsealed) pieces of the mesh between 
+// consecutive planes are returned in "slabs", with one entry per connected 
+// component. Slab index k is the region below plane k, and index 
+// heights.size() is the region above the last plane. Slab faces are clipped 
+// with a convex-polygon splitter, so non-convex input faces that cross a 
+// plane more than once are not partitioned correctly.
+void compute_planar_sections(
+    const hmesh_t& src_mesh,
+    const vec3& normal,
+    const std::vector<double>& heights,
+    const bool compute_slabs,
+    const bool include_vertex_map,
+    const bool include_face_map,
+    std::vector<planar_slice_t>& sections,
+    std::vector<planar_slice_t>& slabs);
+
+#endif // #ifndef _PLANAR_SECTIONS_H_
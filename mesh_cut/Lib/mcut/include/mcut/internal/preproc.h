@@ -50,6 +50,11 @@
 #define _FRONTEND_INTERSECT_H_
 
 #include "mcut/internal/frontend.h"
+#include "mcut/internal/kernel.h"
+
+#include <map>
+#include <unordered_map>
+#include <vector>
 
 extern "C" void preproc(
     std::shared_ptr<context_t> context_uptr,
@@ -65,4 +70,64 @@ extern "C" void preproc(
     uint32_t numCutMeshVertices,
     uint32_t numCutMeshFaces) noexcept(false);
 
+// this function converts an index array mesh (e.g. as recieved by the dispatch
+// function) into a halfedge mesh representation for the kernel backend.
+bool client_input_arrays_to_hmesh(std::shared_ptr<context_t>& context_ptr,
+    McFlags dispatchFlags,
+    hmesh_t& halfedgeMesh,
+    const void* pVertices,
+    const McUint32* pFaceIndices,
+    const McUint32* pFaceSizes,
+    const McUint32 numVertices,
+    const McUint32 numFaces,
+    const double multiplier,
+    const vec3_<double> srcmesh_cutmesh_com,
+    const vec3_<double> pre_quantization_translation,
+    const vec3_<double>* perturbation = NULL);
+
+// moves the vertices of an hmesh (created by "client_input_arrays_to_hmesh" from arrays with the same
+// faces) to the user-provided coordinates, leaving its connectivity untouched.
+void update_hmesh_vertices_from_client_array(std::shared_ptr<context_t>& context_ptr,
+    McFlags dispatchFlags,
+    hmesh_t& halfedgeMesh,
+    const void* pVertices,
+    const McUint32 numVertices,
+    const double multiplier,
+    const vec3_<double> srcmesh_cutmesh_com,
+    const vec3_<double> pre_quantization_translation,
+    const vec3_<double>* perturbation = NULL);
+
+// check that the halfedge-mesh version of a user-provided mesh is valid (i.e.
+// it is a non-manifold mesh containing a single connected component etc.)
+bool check_input_mesh(std::shared_ptr<context_t>& context_ptr, const hmesh_t& m);
+
+// return true if every halfedge of the mesh is incident to a face
+bool mesh_is_closed(
+#if defined(MCUT_WITH_COMPUTE_HELPER_THREADPOOL)
+    thread_pool& scheduler,
+#endif
+    const hmesh_t& mesh);
+
+// return the generalized winding number of "queryPoint" with respect to "mesh"
+// (one if inside of a closed outward-facing mesh and zero if outside)
+double getWindingNumber(std::shared_ptr<context_t> context_ptr,
+    const vec3& queryPoint,
+    const std::shared_ptr<hmesh_t>& mesh,
+    const double multiplier);
+
+// partition the faces of the input meshes on which the kernel found floating
+// polygons, such that the next kernel invocation severs an edge of each
+void resolve_floating_polygons(
+    bool& source_hmesh_modified,
+    bool& cut_hmesh_modified,
+    const std::map<fd_t, std::vector<floating_polygon_info_t>>& detected_floating_polygons,
+    const int source_hmesh_face_count_prev,
+    hmesh_t& source_hmesh,
+    hmesh_t& cut_hmesh,
+    std::unordered_map<fd_t, fd_t>& source_hmesh_child_to_usermesh_birth_face,
+    std::unordered_map<fd_t, fd_t>& cut_hmesh_child_to_usermesh_birth_face,
+    std::unordered_map<vd_t, vec3>& source_hmesh_new_poly_partition_vertices,
+    std::unordered_map<vd_t, vec3>& cut_hmesh_new_poly_partition_vertices,
+    const double multiplier);
+
 #endif // #ifndef _FRONTEND_INTERSECT_H_
\ No newline at end of file
@@ -47,6 +47,24 @@
 
 //#define PROFILING_BUILD
 
+#if defined(PROFILING_BUILD)
+// Accumulated wall-clock time of one named timer, summed over all threads.
+struct timer_record_t {
+    unsigned long long total_ns = 0;
+    unsigned long long calls = 0;
+};
+
+// Returns "<parent>/<name>" where <parent> is the name of the innermost timer on
+// the calling thread's TIMESTACK (or just <name> if the stack is empty).
+std::string timer_stack_path(const std::string& name);
+
+// Adds one measurement to the process-wide registry (thread-safe).
+void timer_registry_add(const std::string& name, unsigned long long elapsed_ns);
+
+// Returns everything recorded since the previous call and clears the registry.
+std::map<std::string, timer_record_t> timer_registry_take();
+#endif
+
 class mini_timer {
     std::chrono::time_point<std::chrono::steady_clock> m_start;
     const std::string m_name;
@@ -55,25 +73,38 @@ class mini_timer {
 public:
     mini_timer(const std::string& name)
         : m_start(std::chrono::steady_clock::now())
+#if defined(PROFILING_BUILD)
+        , m_name(timer_stack_path(name))
+#else
         , m_name(name)
+#endif
     {
     }
 
     ~mini_timer()
     {
         if (m_valid) {
-#ifdef MCUT_WITH_API_EVENT_LOGGING
             const std::chrono::time_point<std::chrono::steady_clock> now = std::chrono::steady_clock::now();
+#if defined(PROFILING_BUILD)
+            timer_registry_add(m_name, std::chrono::duration_cast<std::chrono::nanoseconds>(now - m_start).count());
+#endif
+#ifdef MCUT_WITH_API_EVENT_LOGGING
             const std::chrono::milliseconds elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(now - m_start);
             unsigned long long elapsed_ = elapsed.count();
             log_msg("[MCUT][PROF:" << std::this_thread::get_id() << "]: \"" << m_name << "\" ("<< elapsed_ << "ms)");
 #endif // #ifdef MCUT_WITH_API_EVENT_LOGGING
+            (void)now;
         }
     }
     void set_invalid()
     {
         m_valid = false;
     }
+
+    const std::string& name() const
+    {
+        return m_name;
+    }
 };
 
 extern thread_local std::stack<std::unique_ptr<mini_timer>> g_thrd_loc_timerstack;
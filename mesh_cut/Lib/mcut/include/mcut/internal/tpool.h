@@ -38,6 +38,7 @@
 
 #include <algorithm>
 #include <atomic>
+#include <cstdint>
 #include <condition_variable>
 #include <future>
 #include <memory>
@@ -45,12 +46,46 @@
 #include <thread>
 #include <vector>
 #include <stack>
+#include <stdexcept>
 #include <functional>
 #include <list>
 #include <utility>
 
+#if defined(__linux__)
+#include <climits>
+#include <linux/futex.h>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
 #include "mcut/internal/utils.h"
 
+// Restrict thread "t" to run only on the logical CPUs listed in "cpu_set". An empty
+// set leaves the OS placement unchanged. Returns false if the platform does not
+// support thread affinity or the OS rejects the set (e.g. an offline CPU).
+inline bool set_thread_affinity(std::thread& t, const std::vector<uint32_t>& cpu_set)
+{
+    if (cpu_set.empty()) {
+        return true;
+    }
+#if defined(__linux__)
+    cpu_set_t mask;
+    CPU_ZERO(&mask);
+    for (const uint32_t cpu : cpu_set) {
+        if (cpu >= CPU_SETSIZE) {
+            return false;
+        }
+        CPU_SET(cpu, &mask);
+    }
+    return pthread_setaffinity_np(t.native_handle(), sizeof(cpu_set_t), &mask) == 0;
+#else
+    (void)t;
+    return false;
+#endif
+}
+
 class function_wrapper {
 private:
     struct impl_base {
@@ -97,6 +132,78 @@ public:
     function_wrapper& operator=(const function_wrapper&) = delete;
 };
 
+// A one-shot flag that threads can block on until it is set (e.g. the completion of an
+// API task). Checking the flag is a single atomic load, and waiting does not need any
+// per-flag heap state: on Linux, blocked threads sleep on a futex of the flag word
+// itself; elsewhere they sleep on a condition variable.
+class completion_flag {
+    // 0 = not set, 1 = not set and some thread may be sleeping, 2 = set
+    std::atomic<uint32_t> m_state;
+#if !defined(__linux__)
+    std::mutex m_mutex;
+    std::condition_variable m_cond;
+#endif
+
+public:
+    completion_flag()
+        : m_state(0)
+    {
+    }
+
+    completion_flag(const completion_flag&) = delete;
+    completion_flag& operator=(const completion_flag&) = delete;
+
+    bool is_set() const
+    {
+        return m_state.load(std::memory_order_acquire) == 2;
+    }
+
+    void set()
+    {
+#if defined(__linux__)
+        if (m_state.exchange(2, std::memory_order_acq_rel) == 1) {
+            syscall(SYS_futex, reinterpret_cast<uint32_t*>(&m_state), FUTEX_WAKE_PRIVATE, INT_MAX, nullptr, nullptr, 0);
+        }
+#else
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_state.store(2, std::memory_order_release);
+        }
+        m_cond.notify_all();
+#endif
+    }
+
+    void wait()
+    {
+        // short tasks often finish while we are getting here, so spin briefly before sleeping
+        for (int i = 0; i < 64; ++i) {
+            if (is_set()) {
+                return;
+            }
+            std::this_thread::yield();
+        }
+
+#if defined(__linux__)
+        uint32_t state = m_state.load(std::memory_order_acquire);
+        while (state != 2) {
+            if (state == 1 || m_state.compare_exchange_weak(state, 1, std::memory_order_acq_rel)) {
+                syscall(SYS_futex, reinterpret_cast<uint32_t*>(&m_state), FUTEX_WAIT_PRIVATE, 1, nullptr, nullptr, 0);
+            }
+            state = m_state.load(std::memory_order_acquire);
+        }
+#else
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_cond.wait(lock, [this] { return is_set(); });
+#endif
+    }
+
+    // make the flag reusable (no thread may be waiting on it)
+    void reset()
+    {
+        m_state.store(0, std::memory_order_release);
+    }
+};
+
 template <typename T>
 class thread_safe_queue {
 private:
@@ -345,6 +452,17 @@ public:
         return threads.size();
     }
 
+    // pin every worker thread to the given set of logical CPUs (see set_thread_affinity)
+    bool set_affinity(const std::vector<uint32_t>& cpu_set)
+    {
+        for (std::thread& t : threads) {
+            if (!set_thread_affinity(t, cpu_set)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
     uint32_t get_num_hardware_threads()
     {
         return machine_thread_count;
@@ -969,6 +1087,275 @@ public:
     }
 };
 
+// Returns a distinct tag for each handle table. The tag is part of every handle of the
+// table, so that e.g. a McEvent is not mistaken for a McContext, or the connected
+// component of one context for that of another, when their slots happen to coincide.
+inline std::uintptr_t next_handle_table_tag()
+{
+    static std::atomic<std::uintptr_t> counter(0);
+    return counter.fetch_add(1, std::memory_order_relaxed);
+}
+
+// A table of shared objects that are referenced through opaque handles (McContext,
+// McEvent etc.). A handle packs a slot index, the tag of the table and the generation
+// of that slot, so a stale handle (whose object was released and whose slot was
+// reused) or a handle of another table is rejected instead of resolving to another
+// object.
+//
+// Slots live in fixed-size chunks that are never moved or freed while the table
+// is alive. Lookups neither walk the table nor take a lock: they pin the slot with
+// a compare-and-swap on its state, copy the object and unpin it, so their cost does
+// not depend on how many objects are alive. Only inserting and removing objects
+// serialise on the table mutex, and removing an object waits for the lookups that
+// pinned its slot to finish copying it.
+template<typename T>
+class threadsafe_handle_table
+{
+    // a handle stores, from the low bits up, "index + 1" (so that it is never null),
+    // the table tag and the low bits of the slot generation
+    static const bool wide_handles = sizeof(std::uintptr_t) >= 8;
+    static const unsigned index_bits = wide_handles ? 24 : 16;
+    static const unsigned tag_bits = wide_handles ? 16 : 6;
+    static const unsigned generation_shift = index_bits + tag_bits;
+    static const std::uintptr_t index_mask = (std::uintptr_t(1) << index_bits) - 1;
+    static const std::uintptr_t tag_mask = (std::uintptr_t(1) << tag_bits) - 1;
+    static const uint32_t generation_mask = (uint32_t(1) << (sizeof(std::uintptr_t) * 8 - generation_shift)) - 1;
+
+    static const uint32_t chunk_size = 1024;
+    static const uint32_t max_chunks = wide_handles ? 1024 : 63;
+
+    // the state of a slot packs its generation (high half), whether an object is
+    // published (bit 31) and the number of lookups that pinned it (low bits). The
+    // generation is odd while the slot is reserved or holds an object.
+    static const uint64_t published_bit = uint64_t(1) << 31;
+    static const uint64_t pins_mask = published_bit - 1;
+
+    struct slot
+    {
+        std::atomic<uint64_t> state;
+        std::shared_ptr<T> data; // only changed (under the table mutex) while unpinned
+        uint64_t sequence; // insertion order (guarded by the table mutex)
+
+        slot() : state(0), sequence(0) {}
+    };
+
+    std::atomic<slot*> chunks[max_chunks];
+    std::mutex m;
+    std::vector<uint32_t> free_slots;
+    uint32_t num_slots;
+    uint64_t num_published;
+    const std::uintptr_t tag;
+
+    static uint32_t generation_of(uint64_t state)
+    {
+        return (uint32_t)(state >> 32);
+    }
+
+    std::uintptr_t make_handle(uint32_t index, uint32_t generation) const
+    {
+        return ((std::uintptr_t)(generation & generation_mask) << generation_shift) | (tag << index_bits) | ((std::uintptr_t)index + 1);
+    }
+
+    static bool generation_matches(uint32_t generation, std::uintptr_t handle)
+    {
+        return (generation & generation_mask) == (handle >> generation_shift);
+    }
+
+    slot* get_slot_at(uint32_t index) const
+    {
+        slot* const chunk = chunks[index / chunk_size].load(std::memory_order_acquire);
+        return chunk == nullptr ? nullptr : &chunk[index % chunk_size];
+    }
+
+    slot* get_slot(std::uintptr_t handle) const
+    {
+        const std::uintptr_t index_plus_one = handle & index_mask;
+        if (index_plus_one == 0 || index_plus_one > (std::uintptr_t)max_chunks * chunk_size || ((handle >> index_bits) & tag_mask) != tag) {
+            return nullptr;
+        }
+        return get_slot_at((uint32_t)(index_plus_one - 1));
+    }
+
+    // returns the slot of "handle" if it is reserved or holds an object (caller holds "m")
+    slot* get_occupied_slot(std::uintptr_t handle) const
+    {
+        slot* const s = get_slot(handle);
+        if (s == nullptr) {
+            return nullptr;
+        }
+        const uint32_t generation = generation_of(s->state.load(std::memory_order_relaxed));
+        return ((generation & 1) && generation_matches(generation, handle)) ? s : nullptr;
+    }
+
+    // Advance the generation of "s" so that no new lookup can pin it, wait for the
+    // lookups that already did and take its object (caller holds "m")
+    std::shared_ptr<T> retire(slot* s)
+    {
+        uint64_t state = s->state.load(std::memory_order_relaxed);
+        while (!s->state.compare_exchange_weak(state, ((uint64_t)(generation_of(state) + 1) << 32) | (state & pins_mask), std::memory_order_relaxed, std::memory_order_relaxed)) {
+        }
+
+        while ((s->state.load(std::memory_order_acquire) & pins_mask) != 0) {
+            std::this_thread::yield();
+        }
+
+        std::shared_ptr<T> value;
+        value.swap(s->data);
+        return value;
+    }
+
+public:
+    threadsafe_handle_table()
+        : num_slots(0)
+        , num_published(0)
+        , tag(next_handle_table_tag() & tag_mask)
+    {
+        for (uint32_t i = 0; i < max_chunks; ++i) {
+            chunks[i].store(nullptr, std::memory_order_relaxed);
+        }
+    }
+
+    ~threadsafe_handle_table()
+    {
+        remove_if([](std::shared_ptr<T> const&) { return true; });
+
+        for (uint32_t i = 0; i < max_chunks; ++i) {
+            delete[] chunks[i].load(std::memory_order_relaxed);
+        }
+    }
+
+    threadsafe_handle_table(threadsafe_handle_table const& other) = delete;
+    threadsafe_handle_table& operator=(threadsafe_handle_table const& other) = delete;
+
+    // Reserve a slot and return its handle. The handle resolves to nothing until an
+    // object is published into it, which lets the object be constructed with (or
+    // record) its own handle.
+    std::uintptr_t reserve()
+    {
+        std::lock_guard<std::mutex> lk(m);
+
+        uint32_t index = 0;
+
+        if (!free_slots.empty()) {
+            index = free_slots.back();
+            free_slots.pop_back();
+        } else {
+            if (num_slots == max_chunks * chunk_size) {
+                throw std::length_error("too many handles");
+            }
+
+            index = num_slots++;
+
+            if (index % chunk_size == 0) {
+                chunks[index / chunk_size].store(new slot[chunk_size], std::memory_order_release);
+            }
+        }
+
+        slot* const s = get_slot_at(index);
+        // a free slot is unpublished and unpinned
+        const uint32_t generation = generation_of(s->state.load(std::memory_order_relaxed)) + 1;
+        s->state.store((uint64_t)generation << 32, std::memory_order_relaxed);
+
+        return make_handle(index, generation);
+    }
+
+    // make "value" visible to lookups through the reserved "handle"
+    template<typename Handle>
+    void publish(Handle handle, std::shared_ptr<T> value)
+    {
+        std::lock_guard<std::mutex> lk(m);
+        slot* const s = get_occupied_slot(reinterpret_cast<std::uintptr_t>(handle));
+        MCUT_ASSERT(s != nullptr);
+        s->sequence = num_published++;
+        s->data = std::move(value);
+        s->state.fetch_or(published_bit, std::memory_order_release);
+    }
+
+    // Return the object referenced by "handle", or nullptr if the handle is unknown,
+    // stale, of another table or only reserved.
+    template<typename Handle>
+    std::shared_ptr<T> find(Handle handle) const
+    {
+        const std::uintptr_t h = reinterpret_cast<std::uintptr_t>(handle);
+        slot* const s = get_slot(h);
+
+        if (s == nullptr) {
+            return std::shared_ptr<T>();
+        }
+
+        // pin the slot, unless it was released (and maybe reused) in the meantime
+        uint64_t state = s->state.load(std::memory_order_acquire);
+        do {
+            if (!(state & published_bit) || !generation_matches(generation_of(state), h)) {
+                return std::shared_ptr<T>();
+            }
+        } while (!s->state.compare_exchange_weak(state, state + 1, std::memory_order_acquire, std::memory_order_acquire));
+
+        std::shared_ptr<T> value = s->data;
+
+        s->state.fetch_sub(1, std::memory_order_release);
+
+        return value;
+    }
+
+    // Remove the object referenced by "handle" (or give back a reserved slot). Returns
+    // the removed object so that the caller decides where it is destroyed.
+    template<typename Handle>
+    std::shared_ptr<T> remove(Handle handle)
+    {
+        std::shared_ptr<T> value;
+        {
+            std::lock_guard<std::mutex> lk(m);
+            slot* const s = get_occupied_slot(reinterpret_cast<std::uintptr_t>(handle));
+            if (s == nullptr) {
+                return value;
+            }
+            value = retire(s);
+            free_slots.push_back((uint32_t)((reinterpret_cast<std::uintptr_t>(handle) & index_mask) - 1));
+        }
+        return value;
+    }
+
+    // Call "f" on each object, most recently published first. The table lock is not
+    // held while "f" runs.
+    template<typename Function>
+    void for_each(Function f)
+    {
+        std::vector<std::pair<uint64_t, std::shared_ptr<T>>> live;
+        {
+            std::lock_guard<std::mutex> lk(m);
+            for (uint32_t i = 0; i < num_slots; ++i) {
+                slot* const s = get_slot_at(i);
+                if (s->data != nullptr) {
+                    live.emplace_back(s->sequence, s->data);
+                }
+            }
+        }
+
+        std::sort(live.begin(), live.end(), [](const std::pair<uint64_t, std::shared_ptr<T>>& a, const std::pair<uint64_t, std::shared_ptr<T>>& b) { return a.first > b.first; });
+
+        for (typename std::vector<std::pair<uint64_t, std::shared_ptr<T>>>::const_iterator i = live.cbegin(); i != live.cend(); ++i) {
+            f(i->second);
+        }
+    }
+
+    template<typename Predicate>
+    void remove_if(Predicate p)
+    {
+        std::vector<std::shared_ptr<T>> removed; // destroyed after the lock is released
+        {
+            std::lock_guard<std::mutex> lk(m);
+            for (uint32_t i = 0; i < num_slots; ++i) {
+                slot* const s = get_slot_at(i);
+                if (s->data != nullptr && p(s->data)) {
+                    removed.push_back(retire(s));
+                    free_slots.push_back(i);
+                }
+            }
+        }
+    }
+};
+
 
 struct empty_stack: std::exception
 {
@@ -218,6 +218,7 @@ typedef enum McConnectedComponentType {
     MC_CONNECTED_COMPONENT_TYPE_PATCH = (1 << 2), /**< A connected component that is originates from the cut-mesh. */
     MC_CONNECTED_COMPONENT_TYPE_SEAM = (1 << 3), /**< A connected component representing an input mesh (source-mesh or cut-mesh), but with additional vertices and edges that are introduced as as a result of the cut (i.e. the intersection contour/curve). */
     MC_CONNECTED_COMPONENT_TYPE_INPUT = (1 << 4), /**< A connected component that is copy of an input mesh (source-mesh or cut-mesh). Such a connected component may contain new faces and vertices, which will happen if MCUT internally performs polygon partitioning. Polygon partitioning occurs when an input mesh intersects the other without severing at least one edge. An example is splitting a tetrahedron (source-mesh) in two parts using one large triangle (cut-mesh): in this case, the large triangle would be partitioned into two faces to ensure that at least one of this cut-mesh are severed by the tetrahedron. This is what allows MCUT to reconnect topology after the cut. */
+    MC_CONNECTED_COMPONENT_TYPE_SECTION = (1 << 5), /**< A connected component representing the contour(s) along which a plane intersects the source-mesh (See also: ::mcEnqueueDispatchPlanarSections). Closed contours are stored as faces, and open contours (which only occur with open meshes) are stored as edges. */
     MC_CONNECTED_COMPONENT_TYPE_ALL = 0xFFFFFFFF /**< Wildcard (match all) . */
 } McConnectedComponentType;
 
@@ -312,6 +313,7 @@ typedef enum McConnectedComponentData {
     MC_CONNECTED_COMPONENT_DATA_FACE_ADJACENT_FACE_SIZE = (1 << 18), /**< List of adjacent-face-list sizes (number of adjacent faces per face).*/
     MC_CONNECTED_COMPONENT_DATA_FACE_TRIANGULATION = (1 << 19), /**< List of 3*N triangulated face indices, where N is the number of triangles that are produced using a [Constrained] Delaunay triangulation. Such a triangulation is similar to a Delaunay triangulation, but each (non-triangulated) face segment is present as a single edge in the triangulation. A constrained Delaunay triangulation is not truly a Delaunay triangulation. Some of its triangles might not be Delaunay, but they are all constrained Delaunay. */
     MC_CONNECTED_COMPONENT_DATA_FACE_TRIANGULATION_MAP = (1 << 20), /**< List of a subset of face indices from one of the input meshes (source-mesh or the cut-mesh). Each value will be the index of an input mesh face. This index-value corresponds to the connected-component face at the accessed index. Example: the value at index 0 of the queried array is the index of the face in the original input mesh. Note that all triangulated-faces are mapped to a defined value. In order to clearly distinguish indices of the cut mesh from those of the source mesh, an input-mesh face index value corresponds to a cut-mesh vertex-index if it is great-than-or-equal-to the number of source-mesh faces. The input connected component (source-mesh or cut-mesh) that is referred to must be one stored internally by MCUT (i.e. a connected component queried from the API via ::McInputOrigin), to ensure consistency with any modification done internally by MCUT. */
+    MC_CONNECTED_COMPONENT_DATA_SECTION_INDEX = (1 << 21), /**< The index of the plane that produced a connected component of type ::MC_CONNECTED_COMPONENT_TYPE_SECTION (i.e. the index into the array of section offsets passed to ::mcEnqueueDispatchPlanarSections), or the index of the slab between two consecutive planes (ordered by increasing offset) for a fragment produced by the same function. */
     
 } McConnectedComponentData;
 
@@ -437,7 +439,12 @@ typedef enum McDispatchFlags {
 
     MC_DISPATCH_ENFORCE_GENERAL_POSITION = (1 << 15), /**< Enforce general position such that the variable "c" (see detailed note above) is computed as the multiplication of the current general position enforcement constant (of current MCUT context) and the diagonal length of the bounding box of the cut-mesh. So this uses a relative perturbation of the cut-mesh based on its scale (see also ::MC_CONTEXT_GENERAL_POSITION_ENFORCEMENT_CONSTANT). */
     MC_DISPATCH_ENFORCE_GENERAL_POSITION_ABSOLUTE= (1 << 16), /**< Enforce general position such that the variable "c" (see detailed note above) is the current general position enforcement constant (of current MCUT context). So this uses an absolute perturbation of the cut-mesh based on the stored constant (see also ::MC_CONTEXT_GENERAL_POSITION_ENFORCEMENT_CONSTANT). */
-    MC_DISPATCH_INCLUDE_INTERSECTION_TYPE = (1<<17)/**< Compute and store the _type_ of intersection that the input meshes where found in. See also: ::McDispatchIntersectionType and ::MC_CONTEXT_DISPATCH_INTERSECTION_TYPE */
+    MC_DISPATCH_INCLUDE_INTERSECTION_TYPE = (1<<17), /**< Compute and store the _type_ of intersection that the input meshes where found in. See also: ::McDispatchIntersectionType and ::MC_CONTEXT_DISPATCH_INTERSECTION_TYPE */
+    MC_DISPATCH_TRUSTED_INPUT = (1 << 18), /**< Skip the connectivity and watertightness checks on the input meshes. The caller guarantees that each input mesh is a single connected component with valid faces (e.g. procedurally generated or already validated in an earlier dispatch). Watertightness is then taken from ::MC_DISPATCH_HINT_SOURCEMESH_WATERTIGHT and ::MC_DISPATCH_HINT_CUTMESH_WATERTIGHT (::mcDispatchCSG inputs are always assumed watertight). Passing invalid meshes with this flag results in undefined behaviour. */
+    MC_DISPATCH_HINT_SOURCEMESH_WATERTIGHT = (1 << 19), /**< With ::MC_DISPATCH_TRUSTED_INPUT, the source-mesh is assumed to be watertight (every edge incident to two faces). Ignored otherwise. */
+    MC_DISPATCH_HINT_CUTMESH_WATERTIGHT = (1 << 20), /**< With ::MC_DISPATCH_TRUSTED_INPUT, the cut-mesh is assumed to be watertight (every edge incident to two faces). Ignored otherwise. */
+    MC_DISPATCH_REUSE_SOURCE_MESH_TOPOLOGY = (1 << 21), /**< The source-mesh has the same faces as in the previous ::mcDispatch on this context that also used this flag, and only its vertex coordinates have changed (e.g. an animated or deforming mesh). Its halfedge connectivity, validation and watertightness results are then reused, and its BVH is refitted to the new coordinates instead of being rebuilt. The first dispatch with this flag (or one whose source-mesh vertex count, face count or face arrays differ from the stored ones) prepares the mesh in full and stores it. The face arrays are compared through a hash computed on each such dispatch. */
+    MC_DISPATCH_REUSE_CUT_MESH_TOPOLOGY = (1 << 22) /**< Like ::MC_DISPATCH_REUSE_SOURCE_MESH_TOPOLOGY, but for the cut-mesh. */
 } McDispatchFlags;
 
 /**
@@ -491,6 +498,30 @@ typedef enum McDispatchIntersectionType {
     MC_DISPATCH_INTERSECTION_TYPE_MAX_ENUM = 0xFFFFFFFF /**< Wildcard (match all) . */
 } McDispatchIntersectionType;
 
+/**
+ * \enum McCSGOperation
+ * @brief The operation performed by a node of a constructive solid geometry (CSG) tree.
+ *
+ * This enum structure defines the possible types of nodes in a CSG tree that is evaluated with ::mcEnqueueDispatchCSG. A leaf node references one of the input meshes, and every other node combines the solids produced by its two child nodes.
+ */
+typedef enum McCSGOperation {
+    MC_CSG_OPERATION_MESH = 0, /**< Leaf node. The solid bounded by the input mesh at index \p operands[0]. */
+    MC_CSG_OPERATION_UNION = 1, /**< The union of the solids of child nodes \p operands[0] and \p operands[1]. */
+    MC_CSG_OPERATION_INTERSECTION = 2, /**< The intersection of the solids of child nodes \p operands[0] and \p operands[1]. */
+    MC_CSG_OPERATION_DIFFERENCE = 3, /**< The solid of child node \p operands[0] minus the solid of child node \p operands[1]. */
+    MC_CSG_OPERATION_MAX_ENUM = 0xFFFFFFFF /**< Wildcard (match all) . */
+} McCSGOperation;
+
+/**
+ * @brief A node of a constructive solid geometry (CSG) tree.
+ *
+ * The nodes of a tree are passed to ::mcEnqueueDispatchCSG as an array in which every node appears after its children (e.g. in post-order), and the last node is the root.
+ */
+typedef struct McCSGNode {
+    McCSGOperation operation; /**< The operation performed by the node. */
+    McUint32 operands[2]; /**< The index of the input mesh (::MC_CSG_OPERATION_MESH, with \p operands[1] unused), or the indices of the two child nodes. */
+} McCSGNode;
+
 /**
  * \enum McQueryFlags
  * @brief Flags for querying fixed API state.
@@ -511,7 +542,9 @@ typedef enum McQueryFlags {
     MC_CONTEXT_GENERAL_POSITION_ENFORCEMENT_CONSTANT = 1 << 10, /**< A constant small real number representing the amount by which to perturb the cut-mesh when two intersecting polygon are found to not be in general position. */
     MC_CONTEXT_GENERAL_POSITION_ENFORCEMENT_ATTEMPTS = 1<<11, /**< The number of times that a dispatch operation will attempt to perturb the cut-mesh if the input meshes are found to not be in general position.*/
     MC_CONTEXT_CONNECTED_COMPONENT_FACE_WINDING_ORDER = 1<<12, /**< The winding order that is used when specifying vertex indices that define the faces of connected components. */
-    MC_CONTEXT_DISPATCH_INTERSECTION_TYPE = 1<<13 /**< The type of intersection found during the most recent dispatch call. Refer to  ::McDispatchIntersectionType.  */
+    MC_CONTEXT_DISPATCH_INTERSECTION_TYPE = 1<<13, /**< The type of intersection found during the most recent dispatch call. Refer to  ::McDispatchIntersectionType.  */
+    MC_CONTEXT_CPU_SET = 1<<14, /**< The logical CPUs (array of McUint32, in ascending order) that the API and helper threads of the context are pinned to. Zero bytes if placement was left to the OS. See also ::mcCreateContextWithPlacement */
+    MC_CONTEXT_NUMA_NODE = 1<<15 /**< The NUMA node (McInt32) whose CPUs the threads of the context are pinned to, or -1 if the context was not created for a NUMA node. See also ::mcCreateContextWithPlacement */
 } McQueryFlags;
 
 /**
@@ -614,6 +647,57 @@ extern MCAPI_ATTR McResult MCAPI_CALL mcCreateContext(
 extern MCAPI_ATTR McResult MCAPI_CALL mcCreateContextWithHelpers(
     McContext* pOutContext, McFlags contextFlags, uint32_t helperThreadCount);
 
+/** @brief Create an MCUT context object whose threads are pinned to a set of CPUs.
+ *
+ * This method behaves like ::mcCreateContextWithHelpers, except that the device (API) threads and the
+ * helper threads of the context are restricted to run on the given logical CPUs. The CPUs are either
+ * listed explicitly in \p pCpus or taken from NUMA node \p numaNode. The number of helper threads is
+ * capped so that, together with the device threads, it does not exceed the number of pinned CPUs.
+ *
+ * The device threads build the internal meshes and buffers of each dispatch call, so with the
+ * first-touch page placement of the OS this memory is allocated on the node of the pinned CPUs.
+ * Creating one context per NUMA node and dispatching to each the data that is local to it avoids
+ * streaming meshes across the interconnect. The placement can be queried with ::MC_CONTEXT_CPU_SET
+ * and ::MC_CONTEXT_NUMA_NODE.
+ *
+ * @param [out] pContext a pointer to the allocated context handle
+ * @param [in] flags bitfield containing the context creation flags
+ * @param [in] helperThreadCount Number of helper-threads to assist device-threads with parallel work.
+ * @param [in] numaNode The NUMA node whose CPUs to pin to, or -1 to use \p pCpus.
+ * @param [in] numCpus Number of entries in \p pCpus.
+ * @param [in] pCpus The logical CPUs to pin to. If NULL and \p numaNode is -1, placement is left to the OS.
+ *
+ * An example of usage:
+ * @code
+ * McContext myContext = MC_NULL_HANDLE;
+ * McResult err = mcCreateContextWithPlacement(&myContext, MC_NULL_HANDLE, 8, 0, 0, NULL); // pin to NUMA node 0
+ * if(err != MC_NO_ERROR)
+ * {
+ *  // deal with error
+ * }
+ * @endcode
+ *
+ * @return Error code.
+ *
+ * <b>Error codes</b>
+ * - MC_NO_ERROR
+ *   -# proper exit
+ * - MC_INVALID_VALUE
+ *   -# \p pContext is NULL
+ *   -# Failure to allocate resources
+ *   -# \p flags defines an invalid bitfield.
+ *   -# \p numCpus is greater than zero and \p pCpus is NULL (and vice versa).
+ *   -# \p numaNode is less than -1, or is not -1 while \p numCpus is greater than zero.
+ *   -# The CPUs of \p numaNode cannot be determined, or the OS does not support pinning threads to the given CPUs.
+ */
+extern MCAPI_ATTR McResult MCAPI_CALL mcCreateContextWithPlacement(
+    McContext* pOutContext,
+    McFlags contextFlags,
+    uint32_t helperThreadCount,
+    McInt32 numaNode,
+    McUint32 numCpus,
+    const McUint32* pCpus);
+
 /** @brief Specify a callback to receive debugging messages from the MCUT library.
  *
  * ::mcDebugMessageCallback sets the current debug output callback function to the function whose address is
@@ -1042,6 +1126,122 @@ extern MCAPI_ATTR McResult MCAPI_CALL mcEnqueueDispatchPlanarSection(
     const McEvent* pEventWaitList,
     McEvent* pEvent);
 
+/**
+ * @brief This function behaves similarly to ::mcEnqueueDispatchPlanarSection except that the mesh is sliced by a 
+ * family of parallel planes in a single dispatch.
+ *
+ * The source-mesh is prepared only once, and its faces are then swept in order of their extent along the normal 
+ * vector, such that each face is only visited for the planes that it actually intersects. The cost is thus roughly 
+ * proportional to the size of the mesh plus the size of the output, rather than the number of planes times the size 
+ * of the mesh.
+ *
+ * One connected component of type ::MC_CONNECTED_COMPONENT_TYPE_SECTION is produced for each plane that intersects 
+ * the mesh. Its closed contours wind counter-clockwise about \p pNormalVector for outer boundaries and clockwise 
+ * for holes. The pieces of the mesh between consecutive planes are also produced as (unsealed) fragments if 
+ * \p dispatchFlags contains ::MC_DISPATCH_FILTER_FRAGMENT_SEALING_NONE. Use ::MC_CONNECTED_COMPONENT_DATA_SECTION_INDEX 
+ * to query the plane or slab that a connected component belongs to.
+ *
+ * @param[in] pNormalVector A non-zero vector the specifies the normal of the slicing planes.
+ * @param[in] pSectionOffsets Array of values between zero and one, which specify the relative position of each plane (see ::mcEnqueueDispatchPlanarSection). The offsets must be distinct, otherwise MC_INVALID_VALUE is returned. The array is copied and need not outlive this call.
+ * @param[in] numSectionOffsets Number of elements in \p pSectionOffsets.
+ *
+ * NOTE: Slab fragments are computed by clipping each face as a convex polygon. Faces that are not convex and that 
+ * cross a plane more than once may therefore yield overlapping slab faces. This function is not available when 
+ * MCUT is built with arbitrary-precision numbers.
+ */
+extern MCAPI_ATTR McResult MCAPI_CALL mcEnqueueDispatchPlanarSections(
+    const McContext context,
+    McFlags dispatchFlags,
+    const McVoid* pSrcMeshVertices,
+    const uint32_t* pSrcMeshFaceIndices,
+    const uint32_t* pSrcMeshFaceSizes,
+    uint32_t numSrcMeshVertices,
+    uint32_t numSrcMeshFaces,
+    const McDouble* pNormalVector,
+    const McDouble* pSectionOffsets,
+    uint32_t numSectionOffsets,
+    uint32_t numEventsInWaitlist,
+    const McEvent* pEventWaitList,
+    McEvent* pEvent);
+
+/**
+ * @brief Blocking version of ::mcEnqueueDispatchPlanarSections.
+ */
+extern MCAPI_ATTR McResult MCAPI_CALL mcDispatchPlanarSections(
+    const McContext context,
+    McFlags dispatchFlags,
+    const McVoid* pSrcMeshVertices,
+    const uint32_t* pSrcMeshFaceIndices,
+    const uint32_t* pSrcMeshFaceSizes,
+    uint32_t numSrcMeshVertices,
+    uint32_t numSrcMeshFaces,
+    const McDouble* pNormalVector,
+    const McDouble* pSectionOffsets,
+    uint32_t numSectionOffsets);
+
+/**
+ * @brief Evaluate a constructive solid geometry (CSG) tree of union, intersection and difference operations over a set of input meshes.
+ *
+ * Each input mesh must be watertight, consist of a single connected component and have outward-facing normals. The 
+ * meshes are converted into their internal representation once, and the solids produced by each operation are passed 
+ * to the next one in that representation, without being triangulated and copied through user arrays in between. 
+ *
+ * Every node of the tree is evaluated as a separate task that waits on the tasks of its children. Independent subtrees 
+ * are therefore evaluated concurrently when \p context was created with ::MC_OUT_OF_ORDER_EXEC_MODE_ENABLE. The 
+ * event returned in \p pEvent completes when the root node has been evaluated.
+ *
+ * The result is stored as connected components of type ::MC_CONNECTED_COMPONENT_TYPE_FRAGMENT, one for each closed 
+ * surface (shell) of the resulting solid, with a fragment location and patch location that are undefined. A shell that 
+ * bounds an internal void (e.g. when subtracting a solid that lies strictly inside another) has inward-facing normals.
+ *
+ * @param[in] context The context handle that was created by a previous call to ::mcCreateContext.
+ * @param[in] dispatchFlags The flags specifying the type of the vertex arrays (::MC_DISPATCH_VERTEX_ARRAY_FLOAT or ::MC_DISPATCH_VERTEX_ARRAY_DOUBLE) and optionally ::MC_DISPATCH_ENFORCE_GENERAL_POSITION. Vertex and face maps are not supported.
+ * @param[in] ppMeshVertices Array of pointers to the vertex arrays of the input meshes.
+ * @param[in] ppMeshFaceIndices Array of pointers to the face-index arrays of the input meshes.
+ * @param[in] ppMeshFaceSizes Array of pointers to the face-size arrays of the input meshes. An element may be NULL if the respective mesh is a triangle mesh, and the array itself may be NULL if all input meshes are triangle meshes.
+ * @param[in] pMeshVertexCounts The number of vertices in each input mesh.
+ * @param[in] pMeshFaceCounts The number of faces in each input mesh.
+ * @param[in] numMeshes The number of input meshes.
+ * @param[in] pNodes The nodes of the tree, where every node appears after its children and the last node is the root. The array is copied and need not outlive this call.
+ * @param[in] numNodes The number of elements in \p pNodes.
+ * @param[in] numEventsInWaitlist Number of events in the waitlist.
+ * @param[in] pEventWaitList Events that need to complete before this particular command can be executed.
+ * @param[out] pEvent Returns an event object that identifies this particular command and can be used to query or queue a wait for this particular command to complete.
+ *
+ * NOTE: The mesh arrays must remain valid until the command has completed, as with ::mcEnqueueDispatch. A solid 
+ * with an internal void cannot be used as an operand of another operation. This function is not available when 
+ * MCUT is built with arbitrary-precision numbers.
+ */
+extern MCAPI_ATTR McResult MCAPI_CALL mcEnqueueDispatchCSG(
+    const McContext context,
+    McFlags dispatchFlags,
+    const McVoid* const* ppMeshVertices,
+    const uint32_t* const* ppMeshFaceIndices,
+    const uint32_t* const* ppMeshFaceSizes,
+    const uint32_t* pMeshVertexCounts,
+    const uint32_t* pMeshFaceCounts,
+    uint32_t numMeshes,
+    const McCSGNode* pNodes,
+    uint32_t numNodes,
+    uint32_t numEventsInWaitlist,
+    const McEvent* pEventWaitList,
+    McEvent* pEvent);
+
+/**
+ * @brief Blocking version of ::mcEnqueueDispatchCSG.
+ */
+extern MCAPI_ATTR McResult MCAPI_CALL mcDispatchCSG(
+    const McContext context,
+    McFlags dispatchFlags,
+    const McVoid* const* ppMeshVertices,
+    const uint32_t* const* ppMeshFaceIndices,
+    const uint32_t* const* ppMeshFaceSizes,
+    const uint32_t* pMeshVertexCounts,
+    const uint32_t* pMeshFaceCounts,
+    uint32_t numMeshes,
+    const McCSGNode* pNodes,
+    uint32_t numNodes);
+
 /**
  * @brief Return the value of a selected parameter.
  *
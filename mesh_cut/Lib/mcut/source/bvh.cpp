@@ -216,6 +216,159 @@ unsigned int morton3D(float x, float y, float z)
     return (xx * 4 + yy * 2 + zz);
 };
 
+// compute the bounding boxes of the internal nodes of an oi-bvh from its leaves (i.e. the face bounding boxes)
+static void compute_oibvh_internal_nodes(
+#if defined(MCUT_WITH_COMPUTE_HELPER_THREADPOOL)
+    thread_pool& pool,
+#endif
+    std::vector<bounding_box_t<vec3_<double>>>& bvhAABBs,
+    const std::vector<fd_t>& bvhLeafNodeFaces,
+    const std::vector<bounding_box_t<vec3_<double>>>& face_bboxes,
+    const int leaf_level_index,
+    const int rightmost_real_leaf)
+{
+
+    // for each level in the oi-bvh tree (starting from the penultimate level)
+    for (int level_index = leaf_level_index - 1; level_index >= 0; --level_index) {
+
+        const int rightmost_real_node_on_level = get_level_rightmost_real_node(rightmost_real_leaf, leaf_level_index, level_index);
+        const int leftmost_real_node_on_level = get_level_leftmost_node(level_index);
+        const int number_of_real_nodes_on_level = (rightmost_real_node_on_level - leftmost_real_node_on_level) + 1;
+
+#if defined(MCUT_WITH_COMPUTE_HELPER_THREADPOOL)
+        {
+            // allows us to pretend that we can use an iterator over the nodes
+            std::vector<uint8_t> level_nodes_placeholder(number_of_real_nodes_on_level);
+            auto fn_compute_bvh_level_nodes = [&](std::vector<uint8_t>::const_iterator block_start_, std::vector<uint8_t>::const_iterator block_end_) {
+                uint32_t base_offset = (uint32_t)std::distance(level_nodes_placeholder.cbegin(), block_start_);
+                uint32_t counter = 0;
+                for (std::vector<uint8_t>::const_iterator it = block_start_; it != block_end_; ++it) {
+                    const int level_node_idx_iter = base_offset + (counter++);
+
+                    const int node_implicit_idx = leftmost_real_node_on_level + level_node_idx_iter;
+                    const int left_child_implicit_idx = (node_implicit_idx * 2) + 1;
+                    const int right_child_implicit_idx = (node_implicit_idx * 2) + 2;
+                    const bool is_penultimate_level = (level_index == (leaf_level_index - 1));
+                    const int rightmost_real_node_on_child_level = get_level_rightmost_real_node(rightmost_real_leaf, leaf_level_index, level_index + 1);
+                    const int leftmost_real_node_on_child_level = get_level_leftmost_node(level_index + 1);
+                    const bool right_child_exists = (right_child_implicit_idx <= rightmost_real_node_on_child_level);
+
+                    bounding_box_t<vec3_<double>> node_bbox;
+
+                    if (is_penultimate_level) { // both children are leaves
+
+                        const int left_child_index_on_level = left_child_implicit_idx - leftmost_real_node_on_child_level;
+                        const fd_t& left_child_face = SAFE_ACCESS(bvhLeafNodeFaces, left_child_index_on_level);
+                        const bounding_box_t<vec3_<double>>& left_child_bbox = SAFE_ACCESS(face_bboxes, left_child_face);
+
+                        node_bbox.expand(left_child_bbox);
+
+                        if (right_child_exists) {
+                            const int right_child_index_on_level = right_child_implicit_idx - leftmost_real_node_on_child_level;
+                            const fd_t& right_child_face = SAFE_ACCESS(bvhLeafNodeFaces, right_child_index_on_level);
+                            const bounding_box_t<vec3_<double>>& right_child_bbox = SAFE_ACCESS(face_bboxes, right_child_face);
+                            node_bbox.expand(right_child_bbox);
+                        }
+                    } else { // remaining internal node levels
+
+                        const int left_child_memory_idx = get_node_mem_index(
+                            left_child_implicit_idx,
+                            leftmost_real_node_on_child_level,
+                            0,
+                            rightmost_real_node_on_child_level);
+                        const bounding_box_t<vec3_<double>>& left_child_bbox = SAFE_ACCESS(bvhAABBs, left_child_memory_idx);
+
+                        node_bbox.expand(left_child_bbox);
+
+                        if (right_child_exists) {
+                            const int right_child_memory_idx = get_node_mem_index(
+                                right_child_implicit_idx,
+                                leftmost_real_node_on_child_level,
+                                0,
+                                rightmost_real_node_on_child_level);
+                            const bounding_box_t<vec3_<double>>& right_child_bbox = SAFE_ACCESS(bvhAABBs, right_child_memory_idx);
+                            node_bbox.expand(right_child_bbox);
+                        }
+                    }
+
+                    const int node_memory_idx = get_node_mem_index(
+                        node_implicit_idx,
+                        leftmost_real_node_on_level,
+                        0,
+                        rightmost_real_node_on_level);
+
+                    SAFE_ACCESS(bvhAABBs, node_memory_idx) = node_bbox;
+                }
+            };
+
+            parallel_for(
+                pool,
+                level_nodes_placeholder.cbegin(),
+                level_nodes_placeholder.cend(),
+                fn_compute_bvh_level_nodes);
+        }
+#else
+        // for each node on the current level
+        for (int level_node_idx_iter = 0; level_node_idx_iter < number_of_real_nodes_on_level; ++level_node_idx_iter) {
+
+            const int node_implicit_idx = leftmost_real_node_on_level + level_node_idx_iter;
+            const int left_child_implicit_idx = (node_implicit_idx * 2) + 1;
+            const int right_child_implicit_idx = (node_implicit_idx * 2) + 2;
+            const bool is_penultimate_level = (level_index == (leaf_level_index - 1));
+            const int rightmost_real_node_on_child_level = get_level_rightmost_real_node(rightmost_real_leaf, leaf_level_index, level_index + 1);
+            const int leftmost_real_node_on_child_level = get_level_leftmost_node(level_index + 1);
+            const bool right_child_exists = (right_child_implicit_idx <= rightmost_real_node_on_child_level);
+
+            bounding_box_t<vec3_<double>> node_bbox;
+
+            if (is_penultimate_level) { // both children are leaves
+
+                const int left_child_index_on_level = left_child_implicit_idx - leftmost_real_node_on_child_level;
+                const fd_t& left_child_face = SAFE_ACCESS(bvhLeafNodeFaces, left_child_index_on_level);
+                const bounding_box_t<vec3_<double>>& left_child_bbox = SAFE_ACCESS(face_bboxes, left_child_face);
+
+                node_bbox.expand(left_child_bbox);
+
+                if (right_child_exists) {
+                    const int right_child_index_on_level = right_child_implicit_idx - leftmost_real_node_on_child_level;
+                    const fd_t& right_child_face = SAFE_ACCESS(bvhLeafNodeFaces, right_child_index_on_level);
+                    const bounding_box_t<vec3_<double>>& right_child_bbox = SAFE_ACCESS(face_bboxes, right_child_face);
+                    node_bbox.expand(right_child_bbox);
+                }
+            } else { // remaining internal node levels
+
+                const int left_child_memory_idx = get_node_mem_index(
+                    left_child_implicit_idx,
+                    leftmost_real_node_on_child_level,
+                    0,
+                    rightmost_real_node_on_child_level);
+                const bounding_box_t<vec3_<double>>& left_child_bbox = SAFE_ACCESS(bvhAABBs, left_child_memory_idx);
+
+                node_bbox.expand(left_child_bbox);
+
+                if (right_child_exists) {
+                    const int right_child_memory_idx = get_node_mem_index(
+                        right_child_implicit_idx,
+                        leftmost_real_node_on_child_level,
+                        0,
+                        rightmost_real_node_on_child_level);
+                    const bounding_box_t<vec3_<double>>& right_child_bbox = SAFE_ACCESS(bvhAABBs, right_child_memory_idx);
+                    node_bbox.expand(right_child_bbox);
+                }
+            }
+
+            const int node_memory_idx = get_node_mem_index(
+                node_implicit_idx,
+                leftmost_real_node_on_level,
+                0,
+                rightmost_real_node_on_level);
+
+            SAFE_ACCESS(bvhAABBs, node_memory_idx) = node_bbox;
+        } // for each real node on level
+#endif
+    } // for each internal level
+}
+
 void build_oibvh(
     #if defined(MCUT_WITH_COMPUTE_HELPER_THREADPOOL)
     thread_pool& pool,
@@ -246,10 +399,10 @@ void build_oibvh(
         auto fn_compute_face_bbox_data = [&](face_array_iterator_t block_start_, face_array_iterator_t block_end_) {
             for (face_array_iterator_t f = block_start_; f != block_end_; ++f) {
                 const int faceIdx = static_cast<int>(*f);
-                std::vector<vd_t> vertices_on_face = mesh.get_vertices_around_face(*f);
+                const vertices_around_face_view_t vertices_on_face = mesh.vertices_around_face(*f);
 
                 // for each vertex on face
-                for (std::vector<vd_t>::const_iterator v = vertices_on_face.cbegin(); v != vertices_on_face.cend(); ++v) {
+                for (vertices_around_face_view_t::const_iterator v = vertices_on_face.cbegin(); v != vertices_on_face.cend(); ++v) {
                     const auto& vv = mesh.vertex(*v);
 #		ifdef MCUT_WITH_ARBITRARY_PRECISION_NUMBERS
                     face_bboxes[faceIdx].expand(
@@ -287,10 +440,10 @@ void build_oibvh(
     // for each face in mesh
     for (face_array_iterator_t f = mesh.faces_begin(); f != mesh.faces_end(); ++f) {
         const int faceIdx = static_cast<int>(*f);
-        const std::vector<vd_t> vertices_on_face = mesh.get_vertices_around_face(*f);
+        const vertices_around_face_view_t vertices_on_face = mesh.vertices_around_face(*f);
 
         // for each vertex on face
-        for (std::vector<vd_t>::const_iterator v = vertices_on_face.cbegin(); v != vertices_on_face.cend(); ++v) {
+        for (vertices_around_face_view_t::const_iterator v = vertices_on_face.cbegin(); v != vertices_on_face.cend(); ++v) {
             const auto& vv = mesh.vertex(*v); // NOTE: lives in positive quadrant
             face_bboxes[faceIdx].expand(
                 vec3_<double>(
@@ -494,145 +647,110 @@ void build_oibvh(
     // construct internal-node bounding boxes
     // ::::::::::::::::::::::::::::::::::::::
 
-    // for each level in the oi-bvh tree (starting from the penultimate level)
-    for (int level_index = leaf_level_index - 1; level_index >= 0; --level_index) {
-
-        const int rightmost_real_node_on_level = get_level_rightmost_real_node(rightmost_real_leaf, leaf_level_index, level_index);
-        const int leftmost_real_node_on_level = get_level_leftmost_node(level_index);
-        const int number_of_real_nodes_on_level = (rightmost_real_node_on_level - leftmost_real_node_on_level) + 1;
-
+    compute_oibvh_internal_nodes(
 #if defined(MCUT_WITH_COMPUTE_HELPER_THREADPOOL)
-        {
-            // allows us to pretend that we can use an iterator over the nodes
-            std::vector<uint8_t> level_nodes_placeholder(number_of_real_nodes_on_level);
-            auto fn_compute_bvh_level_nodes = [&](std::vector<uint8_t>::const_iterator block_start_, std::vector<uint8_t>::const_iterator block_end_) {
-                uint32_t base_offset = (uint32_t)std::distance(level_nodes_placeholder.cbegin(), block_start_);
-                uint32_t counter = 0;
-                for (std::vector<uint8_t>::const_iterator it = block_start_; it != block_end_; ++it) {
-                    const int level_node_idx_iter = base_offset + (counter++);
-
-                    const int node_implicit_idx = leftmost_real_node_on_level + level_node_idx_iter;
-                    const int left_child_implicit_idx = (node_implicit_idx * 2) + 1;
-                    const int right_child_implicit_idx = (node_implicit_idx * 2) + 2;
-                    const bool is_penultimate_level = (level_index == (leaf_level_index - 1));
-                    const int rightmost_real_node_on_child_level = get_level_rightmost_real_node(rightmost_real_leaf, leaf_level_index, level_index + 1);
-                    const int leftmost_real_node_on_child_level = get_level_leftmost_node(level_index + 1);
-                    const bool right_child_exists = (right_child_implicit_idx <= rightmost_real_node_on_child_level);
-
-                    bounding_box_t<vec3_<double>> node_bbox;
-
-                    if (is_penultimate_level) { // both children are leaves
-
-                        const int left_child_index_on_level = left_child_implicit_idx - leftmost_real_node_on_child_level;
-                        const fd_t& left_child_face = SAFE_ACCESS(bvhLeafNodeFaces, left_child_index_on_level);
-                        const bounding_box_t<vec3_<double>>& left_child_bbox = SAFE_ACCESS(face_bboxes, left_child_face);
-
-                        node_bbox.expand(left_child_bbox);
+        pool,
+#endif
+        bvhAABBs,
+        bvhLeafNodeFaces,
+        face_bboxes,
+        leaf_level_index,
+        rightmost_real_leaf);
+}
 
-                        if (right_child_exists) {
-                            const int right_child_index_on_level = right_child_implicit_idx - leftmost_real_node_on_child_level;
-                            const fd_t& right_child_face = SAFE_ACCESS(bvhLeafNodeFaces, right_child_index_on_level);
-                            const bounding_box_t<vec3_<double>>& right_child_bbox = SAFE_ACCESS(face_bboxes, right_child_face);
-                            node_bbox.expand(right_child_bbox);
-                        }
-                    } else { // remaining internal node levels
+void refit_oibvh(
+#if defined(MCUT_WITH_COMPUTE_HELPER_THREADPOOL)
+    thread_pool& pool,
+#endif
+    const hmesh_t& mesh,
+    std::vector<bounding_box_t<vec3_<double>>>& bvhAABBs,
+    const std::vector<fd_t>& bvhLeafNodeFaces,
+    std::vector<bounding_box_t<vec3_<double>>>& face_bboxes,
+    const double& slightEnlargmentEps, // in native user coordinates
+    const double
+#ifdef MCUT_WITH_ARBITRARY_PRECISION_NUMBERS
+    multiplier
+#endif
+)
+{
+    SCOPED_TIMER(__FUNCTION__);
 
-                        const int left_child_memory_idx = get_node_mem_index(
-                            left_child_implicit_idx,
-                            leftmost_real_node_on_child_level,
-                            0,
-                            rightmost_real_node_on_child_level);
-                        const bounding_box_t<vec3_<double>>& left_child_bbox = SAFE_ACCESS(bvhAABBs, left_child_memory_idx);
+    const int meshFaceCount = mesh.number_of_faces();
 
-                        node_bbox.expand(left_child_bbox);
+    MCUT_ASSERT((int)bvhLeafNodeFaces.size() == meshFaceCount);
+    MCUT_ASSERT((int)bvhAABBs.size() == get_ostensibly_implicit_bvh_size(meshFaceCount));
 
-                        if (right_child_exists) {
-                            const int right_child_memory_idx = get_node_mem_index(
-                                right_child_implicit_idx,
-                                leftmost_real_node_on_child_level,
-                                0,
-                                rightmost_real_node_on_child_level);
-                            const bounding_box_t<vec3_<double>>& right_child_bbox = SAFE_ACCESS(bvhAABBs, right_child_memory_idx);
-                            node_bbox.expand(right_child_bbox);
-                        }
-                    }
+    // recompute the face bounding boxes from the current vertex positions
+    // :::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
-                    const int node_memory_idx = get_node_mem_index(
-                        node_implicit_idx,
-                        leftmost_real_node_on_level,
-                        0,
-                        rightmost_real_node_on_level);
+    face_bboxes.resize(meshFaceCount);
 
-                    SAFE_ACCESS(bvhAABBs, node_memory_idx) = node_bbox;
-                }
-            };
+    auto fn_refit_face_bboxes = [&](face_array_iterator_t block_start_, face_array_iterator_t block_end_) {
+        for (face_array_iterator_t f = block_start_; f != block_end_; ++f) {
+            bounding_box_t<vec3_<double>> bbox;
+            const vertices_around_face_view_t vertices_on_face = mesh.vertices_around_face(*f);
 
-            parallel_for(
-                pool,
-                level_nodes_placeholder.cbegin(),
-                level_nodes_placeholder.cend(),
-                fn_compute_bvh_level_nodes);
-        }
+            for (vertices_around_face_view_t::const_iterator v = vertices_on_face.cbegin(); v != vertices_on_face.cend(); ++v) {
+                const auto& vv = mesh.vertex(*v);
+#ifdef MCUT_WITH_ARBITRARY_PRECISION_NUMBERS
+                bbox.expand(
+                    vec3_<double>(
+                        scalar_t::dequantize(vv[0], multiplier),
+                        scalar_t::dequantize(vv[1], multiplier),
+                        scalar_t::dequantize(vv[2], multiplier)));
 #else
-        // for each node on the current level
-        for (int level_node_idx_iter = 0; level_node_idx_iter < number_of_real_nodes_on_level; ++level_node_idx_iter) {
-
-            const int node_implicit_idx = leftmost_real_node_on_level + level_node_idx_iter;
-            const int left_child_implicit_idx = (node_implicit_idx * 2) + 1;
-            const int right_child_implicit_idx = (node_implicit_idx * 2) + 2;
-            const bool is_penultimate_level = (level_index == (leaf_level_index - 1));
-            const int rightmost_real_node_on_child_level = get_level_rightmost_real_node(rightmost_real_leaf, leaf_level_index, level_index + 1);
-            const int leftmost_real_node_on_child_level = get_level_leftmost_node(level_index + 1);
-            const bool right_child_exists = (right_child_implicit_idx <= rightmost_real_node_on_child_level);
+                bbox.expand(vv);
+#endif
+            }
 
-            bounding_box_t<vec3_<double>> node_bbox;
+            if (slightEnlargmentEps > 0.0) {
+                bbox.enlarge(slightEnlargmentEps);
+            }
 
-            if (is_penultimate_level) { // both children are leaves
+            face_bboxes[*f] = bbox;
+        }
+    };
 
-                const int left_child_index_on_level = left_child_implicit_idx - leftmost_real_node_on_child_level;
-                const fd_t& left_child_face = SAFE_ACCESS(bvhLeafNodeFaces, left_child_index_on_level);
-                const bounding_box_t<vec3_<double>>& left_child_bbox = SAFE_ACCESS(face_bboxes, left_child_face);
+#if defined(MCUT_WITH_COMPUTE_HELPER_THREADPOOL)
+    parallel_for(
+        pool,
+        mesh.faces_begin(),
+        mesh.faces_end(),
+        fn_refit_face_bboxes);
+#else
+    fn_refit_face_bboxes(mesh.faces_begin(), mesh.faces_end());
+#endif
 
-                node_bbox.expand(left_child_bbox);
+    // copy them into the leaves (whose order is kept from when the tree was built)
+    // ::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
-                if (right_child_exists) {
-                    const int right_child_index_on_level = right_child_implicit_idx - leftmost_real_node_on_child_level;
-                    const fd_t& right_child_face = SAFE_ACCESS(bvhLeafNodeFaces, right_child_index_on_level);
-                    const bounding_box_t<vec3_<double>>& right_child_bbox = SAFE_ACCESS(face_bboxes, right_child_face);
-                    node_bbox.expand(right_child_bbox);
-                }
-            } else { // remaining internal node levels
-
-                const int left_child_memory_idx = get_node_mem_index(
-                    left_child_implicit_idx,
-                    leftmost_real_node_on_child_level,
-                    0,
-                    rightmost_real_node_on_child_level);
-                const bounding_box_t<vec3_<double>>& left_child_bbox = SAFE_ACCESS(bvhAABBs, left_child_memory_idx);
+    const int leaf_level_index = get_leaf_level_from_real_leaf_count(meshFaceCount);
+    const int leftmost_real_node_on_leaf_level = get_level_leftmost_node(leaf_level_index);
+    const int rightmost_real_leaf = get_rightmost_real_leaf(leaf_level_index, meshFaceCount);
+    const int rightmost_real_node_on_leaf_level = get_level_rightmost_real_node(rightmost_real_leaf, leaf_level_index, leaf_level_index);
 
-                node_bbox.expand(left_child_bbox);
+    for (int index_on_leaf_level = 0; index_on_leaf_level < meshFaceCount; ++index_on_leaf_level) {
+        const int memory_idx = get_node_mem_index(
+            leftmost_real_node_on_leaf_level + index_on_leaf_level,
+            leftmost_real_node_on_leaf_level,
+            0,
+            rightmost_real_node_on_leaf_level);
 
-                if (right_child_exists) {
-                    const int right_child_memory_idx = get_node_mem_index(
-                        right_child_implicit_idx,
-                        leftmost_real_node_on_child_level,
-                        0,
-                        rightmost_real_node_on_child_level);
-                    const bounding_box_t<vec3_<double>>& right_child_bbox = SAFE_ACCESS(bvhAABBs, right_child_memory_idx);
-                    node_bbox.expand(right_child_bbox);
-                }
-            }
+        bvhAABBs[memory_idx] = face_bboxes[bvhLeafNodeFaces[index_on_leaf_level]];
+    }
 
-            const int node_memory_idx = get_node_mem_index(
-                node_implicit_idx,
-                leftmost_real_node_on_level,
-                0,
-                rightmost_real_node_on_level);
+    // then the internal nodes, bottom-up
+    // ::::::::::::::::::::::::::::::::::
 
-            SAFE_ACCESS(bvhAABBs, node_memory_idx) = node_bbox;
-        } // for each real node on level
+    compute_oibvh_internal_nodes(
+#if defined(MCUT_WITH_COMPUTE_HELPER_THREADPOOL)
+        pool,
 #endif
-    } // for each internal level
+        bvhAABBs,
+        bvhLeafNodeFaces,
+        face_bboxes,
+        leaf_level_index,
+        rightmost_real_leaf);
 }
 
 void intersectOIBVHs(
@@ -822,11 +940,11 @@ void BoundingVolumeHierarchy::buildTree(const hmesh_t& mesh_,
         const int i = static_cast<int>(*f);
         primitives[i] = *f;
 
-        const std::vector<vd_t> vertices_on_face = mesh->get_vertices_around_face(*f);
+        const vertices_around_face_view_t vertices_on_face = mesh->vertices_around_face(*f);
 
         bounding_box_t<vec3_<double>> bbox;
         // for each vertex on face
-        for (std::vector<vd_t>::const_iterator v = vertices_on_face.cbegin(); v != vertices_on_face.cend(); ++v) {
+        for (vertices_around_face_view_t::const_iterator v = vertices_on_face.cbegin(); v != vertices_on_face.cend(); ++v) {
             const vec3_<double> coords = mesh->vertex(*v);
             bbox.expand(coords);
         }
@@ -0,0 +1,496 @@
+/***************************************************************************
+ *  This file is part of the MCUT project, which is comprised of a library 
+ *  for surface mesh cutting, example programs and test programs.
+ * 
+ *  Copyright (C) 2024 CutDigital Enterprise Ltd
+ *  
+ *  MCUT is dual-licensed software that is available under an Open Source 
+ *  license as well as a commercial license. The Open Source license is the 
+ *  GNU Lesser General Public License v3+ (LGPL). The commercial license 
+ *  option is for users that wish to use MCUT in their products for commercial 
+ *  purposes but do not wish to release their software under the LGPL. 
+ *  Email <contact@cut-digital.com> for further information.
+ *
+ *  You may not use this file except in compliance with the License. A copy of 
+ *  the Open Source license can be obtained from
+ *
+ *      https://www.gnu.org/licenses/lgpl-3.0.en.html.
+ *
+ *  For your convenience, a copy of this License has been included in this
+ *  repository.
+ *
+ *  MCUT is distributed in the hope that it will be useful, but THE SOFTWARE IS 
+ *  PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, 
+ *  INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR 
+ *  A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR 
+ *  COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, 
+ *  WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF 
+ *  OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * Author(s):
+ *
+ *    Floyd M. Chitalu    CutDigital Enterprise Ltd.
+ *
+ **************************************************************************/
+
+#include "mcut/internal/csg.h"
+#include "mcut/internal/bvh.h"
+#include "mcut/internal/kernel.h"
+#include "mcut/internal/preproc.h"
+#include "mcut/internal/timer.h"
+#include "mcut/internal/utils.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <map>
+#include <random>
+#include <stdexcept>
+#include <unordered_map>
+
+#if !defined(MCUT_WITH_ARBITRARY_PRECISION_NUMBERS)
+
+double compute_signed_volume(const hmesh_t& mesh)
+{
+    double volume = 0.0;
+    std::vector<vertex_descriptor_t> vertices_around_face;
+
+    for (face_array_iterator_t f = mesh.faces_begin(); f != mesh.faces_end(); ++f) {
+        vertices_around_face.clear();
+        mesh.get_vertices_around_face(vertices_around_face, *f);
+
+        const vec3_<double> p0 = mesh.vertex(vertices_around_face[0]);
+
+        // fan triangulation (the volume only depends on the boundary of the face)
+        for (size_t i = 1; i + 1 < vertices_around_face.size(); ++i) {
+            const vec3_<double> p1 = mesh.vertex(vertices_around_face[i]);
+            const vec3_<double> p2 = mesh.vertex(vertices_around_face[i + 1]);
+            volume += dot_product(p0, cross_product(p1, p2));
+        }
+    }
+
+    return volume / 6.0;
+}
+
+namespace {
+
+typedef bounding_box_t<vec3_<double>> aabb_t;
+
+// Copy "mesh" with every vertex translated by "offset" and (optionally) with 
+// the winding order of every face reversed. Removed elements are dropped.
+std::shared_ptr<hmesh_t> copy_mesh(const hmesh_t& mesh, const vec3& offset, const bool reverse_faces)
+{
+    std::shared_ptr<hmesh_t> copy = std::shared_ptr<hmesh_t>(new hmesh_t);
+    copy->reserve_for_additional_elements(mesh.number_of_vertices());
+
+    std::vector<vertex_descriptor_t> vertex_to_copy(mesh.number_of_internal_vertices(), hmesh_t::null_vertex());
+
+    for (vertex_array_iterator_t v = mesh.vertices_begin(); v != mesh.vertices_end(); ++v) {
+        vertex_to_copy[*v] = copy->add_vertex(mesh.vertex(*v) + offset);
+    }
+
+    std::vector<vertex_descriptor_t> vertices_around_face;
+
+    for (face_array_iterator_t f = mesh.faces_begin(); f != mesh.faces_end(); ++f) {
+        vertices_around_face.clear();
+        mesh.get_vertices_around_face(vertices_around_face, *f);
+
+        for (std::vector<vertex_descriptor_t>::iterator v = vertices_around_face.begin(); v != vertices_around_face.end(); ++v) {
+            *v = vertex_to_copy[*v];
+        }
+
+        if (reverse_faces) {
+            std::reverse(vertices_around_face.begin(), vertices_around_face.end());
+        }
+
+        const face_descriptor_t fd = copy->add_face(vertices_around_face);
+
+        if (fd == hmesh_t::null_face()) {
+            throw std::runtime_error("failed to copy csg shell");
+        }
+    }
+
+    return copy;
+}
+
+aabb_t compute_aabb(const hmesh_t& mesh)
+{
+    aabb_t aabb;
+
+    for (vertex_array_iterator_t v = mesh.vertices_begin(); v != mesh.vertices_end(); ++v) {
+        aabb.expand(mesh.vertex(*v));
+    }
+
+    return aabb;
+}
+
+// return true if the first vertex of "query_mesh" lies inside the solid bounded by "mesh"
+bool first_vertex_is_inside(std::shared_ptr<context_t>& context_ptr, const hmesh_t& query_mesh, const std::shared_ptr<hmesh_t>& mesh)
+{
+    const vec3& query_point = query_mesh.vertex(*query_mesh.vertices_begin());
+    // the winding number is (close to) one inside and zero outside
+    return getWindingNumber(context_ptr, query_point, mesh, 1.0) > 0.5;
+}
+
+inline status_t get_status(const output_t& out)
+{
+#if defined(MCUT_WITH_COMPUTE_HELPER_THREADPOOL)
+    return out.status.load();
+#else
+    return out.status;
+#endif
+}
+
+struct oibvh_t {
+    std::vector<aabb_t> aabbs;
+    std::vector<fd_t> leaf_faces;
+    std::vector<aabb_t> face_aabbs;
+
+    void build(std::shared_ptr<context_t>& context_ptr, const hmesh_t& mesh, const double enlargement)
+    {
+        aabbs.clear();
+        leaf_faces.clear();
+        face_aabbs.clear();
+        build_oibvh(
+#if defined(MCUT_WITH_COMPUTE_HELPER_THREADPOOL)
+            context_ptr->get_shared_compute_threadpool(),
+#endif
+            mesh, aabbs, leaf_faces, face_aabbs, enlargement, 1.0);
+    }
+};
+
+// Resolve the intersection of shells "a" and "b" and append the shells of
+// ("a" <operation> "b") to "result". Returns false (leaving "result" unchanged)
+// if the surfaces of the shells do not intersect.
+//
+// This mirrors the perturbation and polygon-partitioning loop in "preproc", but
+// operates directly on internal meshes and keeps only the sealed fragments that
+// make up the requested operation.
+bool resolve_shell_pair(
+    std::shared_ptr<context_t>& context_ptr,
+    const McFlags dispatchFlags,
+    const McCSGOperation operation,
+    const csg_shell_t& a,
+    const csg_shell_t& b,
+    std::vector<csg_shell_t>& result)
+{
+    if (a.is_cavity || b.is_cavity) {
+        throw std::invalid_argument("csg operand has an internal cavity");
+    }
+
+    // fragments of "a" located outside (above) or inside (below) of "b", which are
+    // sealed with the parts of "b" that lie outside or inside of "a" respectively
+    sm_frag_location_t location = sm_frag_location_t::ABOVE;
+    cm_patch_location_t sealing = cm_patch_location_t::OUTSIDE;
+
+    switch (operation) {
+    case MC_CSG_OPERATION_UNION:
+        break;
+    case MC_CSG_OPERATION_INTERSECTION:
+        location = sm_frag_location_t::BELOW;
+        sealing = cm_patch_location_t::INSIDE;
+        break;
+    case MC_CSG_OPERATION_DIFFERENCE:
+        sealing = cm_patch_location_t::INSIDE;
+        break;
+    default:
+        throw std::invalid_argument("invalid csg operation");
+    }
+
+    std::shared_ptr<hmesh_t> source_hmesh = a.mesh;
+    std::shared_ptr<hmesh_t> cut_hmesh = b.mesh;
+
+    input_t kernel_input;
+#if defined(MCUT_WITH_COMPUTE_HELPER_THREADPOOL)
+    kernel_input.scheduler = &context_ptr->get_shared_compute_threadpool();
+#endif
+    kernel_input.multiplier = 1.0;
+    kernel_input.verbose = false;
+    kernel_input.src_mesh_is_watertight = true;
+    kernel_input.cut_mesh_is_watertight = true;
+    kernel_input.keep_fragments_above_cutmesh = location == sm_frag_location_t::ABOVE;
+    kernel_input.keep_fragments_below_cutmesh = location == sm_frag_location_t::BELOW;
+    kernel_input.keep_fragments_sealed_outside = sealing == cm_patch_location_t::OUTSIDE;
+    kernel_input.keep_fragments_sealed_inside = sealing == cm_patch_location_t::INSIDE;
+    kernel_input.enforce_general_position = (0 != (dispatchFlags & MC_DISPATCH_ENFORCE_GENERAL_POSITION)) || (0 != (dispatchFlags & MC_DISPATCH_ENFORCE_GENERAL_POSITION_ABSOLUTE));
+
+    const aabb_t cut_aabb = compute_aabb(*cut_hmesh.get());
+    const double perturbation_scalar = (dispatchFlags & MC_DISPATCH_ENFORCE_GENERAL_POSITION_ABSOLUTE) ? 1.0 : length(cut_aabb.maximum() - cut_aabb.minimum());
+    const double relative_perturbation_constant = perturbation_scalar * context_ptr->get_general_position_enforcement_constant();
+
+    oibvh_t source_bvh;
+    oibvh_t cut_bvh;
+    source_bvh.build(context_ptr, *source_hmesh.get(), 0.0);
+    cut_bvh.build(context_ptr, *cut_hmesh.get(), relative_perturbation_constant);
+
+    std::map<fd_t, std::vector<fd_t>> ps_face_to_potentially_intersecting_others;
+    intersectOIBVHs(ps_face_to_potentially_intersecting_others, source_bvh.aabbs, source_bvh.leaf_faces, cut_bvh.aabbs, cut_bvh.leaf_faces);
+
+    if (ps_face_to_potentially_intersecting_others.empty()) {
+        return false;
+    }
+
+    // unused: csg results do not carry maps back to the user's meshes
+    std::unordered_map<fd_t, fd_t> source_hmesh_child_to_usermesh_birth_face;
+    std::unordered_map<fd_t, fd_t> cut_hmesh_child_to_usermesh_birth_face;
+    std::unordered_map<vd_t, vec3> source_hmesh_new_poly_partition_vertices;
+    std::unordered_map<vd_t, vec3> cut_hmesh_new_poly_partition_vertices;
+
+    int cut_mesh_perturbation_count = 0;
+
+    while (true) {
+        kernel_input.src_mesh = source_hmesh;
+        kernel_input.cut_mesh = cut_hmesh;
+        kernel_input.general_position_enforcement_count = cut_mesh_perturbation_count;
+        kernel_input.ps_face_to_potentially_intersecting_others = &ps_face_to_potentially_intersecting_others;
+        kernel_input.source_hmesh_face_aabb_array_ptr = &source_bvh.face_aabbs;
+        kernel_input.cut_hmesh_face_aabb_array_ptr = &cut_bvh.face_aabbs;
+
+        output_t kernel_output;
+#if defined(MCUT_WITH_COMPUTE_HELPER_THREADPOOL)
+        kernel_output.status.store(status_t::SUCCESS);
+#endif
+
+        dispatch(kernel_output, kernel_input);
+
+        const status_t status = get_status(kernel_output);
+
+        if (status == status_t::SUCCESS) {
+
+            std::map<sm_frag_location_t, std::map<cm_patch_location_t, std::vector<std::shared_ptr<output_mesh_info_t>>>>::const_iterator i = kernel_output.connected_components.find(location);
+
+            if (i == kernel_output.connected_components.cend() || i->second.find(sealing) == i->second.cend() || i->second.at(sealing).empty()) {
+                return false; // surfaces touch (or overlap in their BVHs) without crossing each other
+            }
+
+            const std::vector<std::shared_ptr<output_mesh_info_t>>& fragments = i->second.at(sealing);
+
+            for (std::vector<std::shared_ptr<output_mesh_info_t>>::const_iterator f = fragments.cbegin(); f != fragments.cend(); ++f) {
+                csg_shell_t shell;
+                shell.mesh = (*f)->mesh;
+                shell.is_cavity = compute_signed_volume(*shell.mesh.get()) < 0.0;
+                result.push_back(shell);
+            }
+
+            return true;
+        } else if (status == status_t::GENERAL_POSITION_VIOLATION && kernel_input.enforce_general_position) {
+
+            if (cut_mesh_perturbation_count == (int)context_ptr->get_general_position_enforcement_attempts()) {
+                throw std::runtime_error("max perturbation iteratons reached");
+            }
+
+            static thread_local std::mt19937 mersenne_twister_generator(1);
+            std::uniform_real_distribution<double> uniform_distribution(-1.0, 1.0);
+
+            vec3 perturbation;
+            for (int j = 0; j < 3; ++j) {
+                perturbation[j] = uniform_distribution(mersenne_twister_generator) * relative_perturbation_constant;
+            }
+
+            cut_mesh_perturbation_count++;
+
+            // perturb the original shell (not the previous attempt)
+            cut_hmesh = copy_mesh(*b.mesh.get(), perturbation, false);
+            cut_bvh.build(context_ptr, *cut_hmesh.get(), relative_perturbation_constant);
+
+            ps_face_to_potentially_intersecting_others.clear();
+            intersectOIBVHs(ps_face_to_potentially_intersecting_others, source_bvh.aabbs, source_bvh.leaf_faces, cut_bvh.aabbs, cut_bvh.leaf_faces);
+
+            // an empty set of pairs is handled by the kernel like any other violation
+        } else if (status == status_t::DETECTED_FLOATING_POLYGON) {
+
+            bool source_hmesh_modified = false;
+            bool cut_hmesh_modified = false;
+
+            resolve_floating_polygons(
+                source_hmesh_modified,
+                cut_hmesh_modified,
+                kernel_output.detected_floating_polygons,
+                source_hmesh->number_of_faces(),
+                *source_hmesh.get(),
+                *cut_hmesh.get(),
+                source_hmesh_child_to_usermesh_birth_face,
+                cut_hmesh_child_to_usermesh_birth_face,
+                source_hmesh_new_poly_partition_vertices,
+                cut_hmesh_new_poly_partition_vertices,
+                1.0);
+
+            if (source_hmesh_modified) {
+                source_bvh.build(context_ptr, *source_hmesh.get(), 0.0);
+            }
+
+            if (cut_hmesh_modified) {
+                cut_bvh.build(context_ptr, *cut_hmesh.get(), relative_perturbation_constant);
+            }
+
+            ps_face_to_potentially_intersecting_others.clear();
+            intersectOIBVHs(ps_face_to_potentially_intersecting_others, source_bvh.aabbs, source_bvh.leaf_faces, cut_bvh.aabbs, cut_bvh.leaf_faces);
+        } else {
+            context_ptr->dbg_cb(MC_DEBUG_SOURCE_KERNEL, MC_DEBUG_TYPE_ERROR, 0, MC_DEBUG_SEVERITY_HIGH, to_string(status) + " : " + kernel_output.logger.get_reason_for_failure());
+            throw std::runtime_error("incomplete kernel execution");
+        }
+    }
+}
+
+// Compute "a" <operation> "b" for two shells, including when their surfaces do
+// not intersect. Returns false if the shells are disjoint.
+bool evaluate_shell_pair(
+    std::shared_ptr<context_t>& context_ptr,
+    const McFlags dispatchFlags,
+    const McCSGOperation operation,
+    const csg_shell_t& a,
+    const csg_shell_t& b,
+    std::vector<csg_shell_t>& result)
+{
+    if (intersect_bounding_boxes(compute_aabb(*a.mesh.get()), compute_aabb(*b.mesh.get())) && resolve_shell_pair(context_ptr, dispatchFlags, operation, a, b, result)) {
+        return true;
+    }
+
+    const bool a_in_b = first_vertex_is_inside(context_ptr, *a.mesh.get(), b.mesh);
+    const bool b_in_a = !a_in_b && first_vertex_is_inside(context_ptr, *b.mesh.get(), a.mesh);
+
+    switch (operation) {
+    case MC_CSG_OPERATION_UNION:
+        if (a_in_b) {
+            result.push_back(b);
+        } else if (b_in_a) {
+            result.push_back(a);
+        } else {
+            result.push_back(a);
+            result.push_back(b);
+        }
+        break;
+    case MC_CSG_OPERATION_INTERSECTION:
+        if (a_in_b) {
+            result.push_back(a);
+        } else if (b_in_a) {
+            result.push_back(b);
+        }
+        break;
+    case MC_CSG_OPERATION_DIFFERENCE:
+        if (!a_in_b) {
+            result.push_back(a);
+        }
+
+        if (b_in_a) { // "b" becomes a void inside of "a"
+            csg_shell_t cavity;
+            cavity.mesh = copy_mesh(*b.mesh.get(), vec3(0.0), true);
+            cavity.is_cavity = true;
+            result.push_back(cavity);
+        }
+        break;
+    default:
+        throw std::invalid_argument("invalid csg operation");
+    }
+
+    return a_in_b || b_in_a;
+}
+
+} // namespace
+
+void translate_csg_shells(std::vector<csg_shell_t>& shells, const vec3& offset)
+{
+    for (std::vector<csg_shell_t>::iterator i = shells.begin(); i != shells.end(); ++i) {
+        i->mesh = copy_mesh(*i->mesh.get(), offset, false);
+    }
+}
+
+void evaluate_csg_operation(
+    std::shared_ptr<context_t> context_ptr,
+    McFlags dispatchFlags,
+    const McCSGOperation operation,
+    const std::vector<csg_shell_t>& a,
+    const std::vector<csg_shell_t>& b,
+    std::vector<csg_shell_t>& result)
+{
+    SCOPED_TIMER("evaluate_csg_operation");
+
+    result.clear();
+
+    switch (operation) {
+    case MC_CSG_OPERATION_UNION: {
+        // add the shells of "b" one at a time, merging each with every shell it overlaps
+        std::vector<csg_shell_t> current = a;
+        std::vector<csg_shell_t> cavities;
+
+        for (std::vector<csg_shell_t>::const_iterator j = b.cbegin(); j != b.cend(); ++j) {
+            csg_shell_t merged = *j;
+            std::vector<csg_shell_t> next;
+
+            for (std::vector<csg_shell_t>::const_iterator i = current.cbegin(); i != current.cend(); ++i) {
+                std::vector<csg_shell_t> pair_result;
+
+                if (false == evaluate_shell_pair(context_ptr, dispatchFlags, operation, *i, merged, pair_result)) {
+                    next.push_back(*i); // disjoint
+                    continue;
+                }
+
+                // the union of two connected solids is connected, so it has one outer shell
+                for (std::vector<csg_shell_t>::const_iterator k = pair_result.cbegin(); k != pair_result.cend(); ++k) {
+                    if (k->is_cavity) {
+                        cavities.push_back(*k);
+                    } else {
+                        merged = *k;
+                    }
+                }
+            }
+
+            next.push_back(merged);
+            current.swap(next);
+        }
+
+        result.swap(current);
+        result.insert(result.end(), cavities.cbegin(), cavities.cend());
+    } break;
+    case MC_CSG_OPERATION_INTERSECTION: {
+        for (std::vector<csg_shell_t>::const_iterator i = a.cbegin(); i != a.cend(); ++i) {
+            for (std::vector<csg_shell_t>::const_iterator j = b.cbegin(); j != b.cend(); ++j) {
+                evaluate_shell_pair(context_ptr, dispatchFlags, operation, *i, *j, result);
+            }
+        }
+    } break;
+    case MC_CSG_OPERATION_DIFFERENCE: {
+        // subtract the shells of "b" one at a time
+        std::vector<csg_shell_t> current = a;
+
+        for (std::vector<csg_shell_t>::const_iterator j = b.cbegin(); j != b.cend(); ++j) {
+            std::vector<csg_shell_t> next;
+
+            for (std::vector<csg_shell_t>::const_iterator i = current.cbegin(); i != current.cend(); ++i) {
+                evaluate_shell_pair(context_ptr, dispatchFlags, operation, *i, *j, next);
+            }
+
+            current.swap(next);
+        }
+
+        result.swap(current);
+    } break;
+    default:
+        throw std::invalid_argument("invalid csg operation");
+    }
+}
+
+#else // #if !defined(MCUT_WITH_ARBITRARY_PRECISION_NUMBERS)
+
+double compute_signed_volume(const hmesh_t& /*mesh*/)
+{
+    throw std::runtime_error("csg evaluation is not supported with arbitrary-precision numbers");
+}
+
+void translate_csg_shells(std::vector<csg_shell_t>& /*shells*/, const vec3& /*offset*/)
+{
+    throw std::runtime_error("csg evaluation is not supported with arbitrary-precision numbers");
+}
+
+void evaluate_csg_operation(
+    std::shared_ptr<context_t> /*context_ptr*/,
+    McFlags /*dispatchFlags*/,
+    const McCSGOperation /*operation*/,
+    const std::vector<csg_shell_t>& /*a*/,
+    const std::vector<csg_shell_t>& /*b*/,
+    std::vector<csg_shell_t>& /*result*/)
+{
+    throw std::runtime_error("csg evaluation is not supported with arbitrary-precision numbers");
+}
+
+#endif // #if !defined(MCUT_WITH_ARBITRARY_PRECISION_NUMBERS)
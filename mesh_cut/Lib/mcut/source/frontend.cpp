@@ -38,7 +38,9 @@
 #include <fstream>
 #include <stack>
 
+#include <limits>
 #include <memory>
+#include <mutex>
 
 #include <numeric> // iota
 #include <stdio.h>
@@ -46,6 +48,8 @@
 #include <unordered_map>
 
 #include "mcut/internal/frontend.h"
+#include "mcut/internal/csg.h"
+#include "mcut/internal/planar_sections.h"
 #include "mcut/internal/preproc.h"
 
 #include "mcut/internal/hmesh.h"
@@ -59,6 +63,33 @@
 
 #if defined(PROFILING_BUILD)
 thread_local std::stack<std::unique_ptr<mini_timer>> g_thrd_loc_timerstack;
+
+static std::mutex g_timer_registry_mutex;
+static std::map<std::string, timer_record_t> g_timer_registry;
+
+std::string timer_stack_path(const std::string& name)
+{
+    if (g_thrd_loc_timerstack.empty()) {
+        return name;
+    }
+    return g_thrd_loc_timerstack.top()->name() + "/" + name;
+}
+
+void timer_registry_add(const std::string& name, unsigned long long elapsed_ns)
+{
+    std::lock_guard<std::mutex> lock(g_timer_registry_mutex);
+    timer_record_t& record = g_timer_registry[name];
+    record.total_ns += elapsed_ns;
+    record.calls += 1;
+}
+
+std::map<std::string, timer_record_t> timer_registry_take()
+{
+    std::lock_guard<std::mutex> lock(g_timer_registry_mutex);
+    std::map<std::string, timer_record_t> records;
+    records.swap(g_timer_registry);
+    return records;
+}
 #endif
 
 thread_local std::string per_thread_api_log_str;
@@ -75,12 +106,43 @@ thread_local MultiPool nfgMemoryPool;
 #endif
 
 
-threadsafe_list<std::shared_ptr<context_t>> g_contexts = {};
-threadsafe_list<std::shared_ptr<event_t>> g_events = {};
-std::atomic<std::uintptr_t> g_objects_counter; // a counter that is used to assign a unique value to e.g. a McContext handle that will be returned to the user
-std::once_flag g_objects_counter_init_flag; // flag used to initialise "g_objects_counter" with "std::call_once"
+event_pool_t g_event_pool; // defined first so that it outlives every event (including those held by contexts)
+threadsafe_handle_table<context_t> g_contexts;
+threadsafe_handle_table<event_t> g_events;
+
+// parse the logical CPUs of a NUMA node from sysfs (e.g. "0-15,32-47")
+static std::vector<uint32_t> get_numa_node_cpus(McInt32 numaNode)
+{
+    std::vector<uint32_t> cpus;
+#if defined(__linux__)
+    std::ifstream cpulist("/sys/devices/system/node/node" + std::to_string(numaNode) + "/cpulist");
+    std::string range;
+    while (std::getline(cpulist, range, ',')) {
+        const size_t dash = range.find('-');
+        const uint32_t first = (uint32_t)std::stoul(range.substr(0, dash));
+        const uint32_t last = dash == std::string::npos ? first : (uint32_t)std::stoul(range.substr(dash + 1));
+        for (uint32_t cpu = first; cpu <= last; ++cpu) {
+            cpus.push_back(cpu);
+        }
+    }
+#else
+    UNUSED(numaNode);
+#endif
+    return cpus;
+}
 
 void create_context_impl(McContext* pOutContext, McFlags flags, uint32_t helperThreadCount)
+{
+    create_context_with_placement_impl(pOutContext, flags, helperThreadCount, -1, 0, nullptr);
+}
+
+void create_context_with_placement_impl(
+    McContext* pOutContext,
+    McFlags flags,
+    uint32_t helperThreadCount,
+    McInt32 numaNode,
+    McUint32 numCpus,
+    const McUint32* pCpus)
 {
 #if !defined(MCUT_WITH_COMPUTE_HELPER_THREADPOOL)
     UNUSED(helperThreadCount);
@@ -88,20 +150,39 @@ void create_context_impl(McContext* pOutContext, McFlags flags, uint32_t helperT
 
     MCUT_ASSERT(pOutContext != nullptr);
 
-    std::call_once(g_objects_counter_init_flag, []() { g_objects_counter.store(0xDECAF); /*any non-ero value*/ });
+    std::vector<uint32_t> cpu_set(pCpus, pCpus + numCpus);
+
+    if (numaNode >= 0) {
+        cpu_set = get_numa_node_cpus(numaNode);
+        if (cpu_set.empty()) {
+            throw std::invalid_argument("cannot find the CPUs of NUMA node " + std::to_string(numaNode));
+        }
+    }
 
-    const McContext handle = reinterpret_cast<McContext>(g_objects_counter.fetch_add(1, std::memory_order_relaxed));
-    
-    // Here we actually create the context object (as shared ptr) and stored in a global 
-    // variable g_contexts. Note that g_contexts can be accessed by multiple threads 
-    // simultaneously.
-    g_contexts.push_front(std::shared_ptr<context_t>(
-        new context_t(handle, flags
+    std::sort(cpu_set.begin(), cpu_set.end());
+    cpu_set.erase(std::unique(cpu_set.begin(), cpu_set.end()), cpu_set.end());
+
+    // the handle is reserved first because the context is constructed with it
+    const McContext handle = reinterpret_cast<McContext>(g_contexts.reserve());
+
+    std::shared_ptr<context_t> context_ptr;
+
+    try {
+        context_ptr = std::shared_ptr<context_t>(
+            new context_t(handle, flags, cpu_set, numaNode >= 0 ? numaNode : -1
 #if defined(MCUT_WITH_COMPUTE_HELPER_THREADPOOL)
-            ,
-            helperThreadCount
+                ,
+                helperThreadCount
 #endif
-            )));
+                ));
+    } catch (...) {
+        g_contexts.remove(handle); // give back the reserved slot
+        throw;
+    }
+
+    // Here we make the context object visible in the global variable g_contexts.
+    // Note that g_contexts can be accessed by multiple threads simultaneously.
+    g_contexts.publish(handle, context_ptr);
 
     *pOutContext = handle;
 }
@@ -114,7 +195,7 @@ void debug_message_callback_impl(
     MCUT_ASSERT(contextHandle != nullptr);
     MCUT_ASSERT(cb != nullptr);
 
-    std::shared_ptr<context_t> context_ptr = g_contexts.find_first_if([=](const std::shared_ptr<context_t> cptr) { return cptr->m_user_handle == contextHandle; });
+    std::shared_ptr<context_t> context_ptr = g_contexts.find(contextHandle);
 
     // std::map<McContext, std::unique_ptr<context_t>>::iterator context_entry_iter = g_contexts.find(contextHandle);
 
@@ -136,7 +217,7 @@ void get_debug_message_log_impl(McContext context,
 {
     MCUT_ASSERT(context != nullptr);
 
-    std::shared_ptr<context_t> context_ptr = g_contexts.find_first_if([=](const std::shared_ptr<context_t> cptr) { return cptr->m_user_handle == context; });
+    std::shared_ptr<context_t> context_ptr = g_contexts.find(context);
 
     if (context_ptr == nullptr) {
         throw std::invalid_argument("invalid context");
@@ -235,7 +316,7 @@ void debug_message_control_impl(
     McDebugSeverity severityBitfieldParam,
     bool enabled)
 {
-    std::shared_ptr<context_t> context_ptr = g_contexts.find_first_if([=](const std::shared_ptr<context_t> cptr) { return cptr->m_user_handle == contextHandle; });
+    std::shared_ptr<context_t> context_ptr = g_contexts.find(contextHandle);
 
     if (context_ptr == nullptr) {
         throw std::invalid_argument("invalid context");
@@ -300,7 +381,7 @@ void get_info_impl(
     McVoid* pMem,
     McSize* pNumBytes)
 {
-    std::shared_ptr<context_t> context_ptr = g_contexts.find_first_if([=](const std::shared_ptr<context_t> cptr) { return cptr->m_user_handle == contextHandle; });
+    std::shared_ptr<context_t> context_ptr = g_contexts.find(contextHandle);
 
     if (context_ptr == nullptr) {
         throw std::invalid_argument("invalid context");
@@ -368,6 +449,29 @@ void get_info_impl(
         }
     }
     break;
+    case MC_CONTEXT_CPU_SET: {
+        const std::vector<uint32_t>& cpu_set = context_ptr->get_cpu_set();
+        const McSize cpu_set_bytes = sizeof(McUint32) * cpu_set.size();
+        if (pMem == nullptr) {
+            *pNumBytes = cpu_set_bytes;
+        } else {
+            if (bytes < cpu_set_bytes) {
+                throw std::invalid_argument("invalid bytes");
+            }
+            memcpy(pMem, reinterpret_cast<const McVoid*>(cpu_set.data()), cpu_set_bytes);
+        }
+    } break;
+    case MC_CONTEXT_NUMA_NODE: {
+        if (pMem == nullptr) {
+            *pNumBytes = sizeof(McInt32);
+        } else {
+            if (bytes != sizeof(McInt32)) {
+                throw std::invalid_argument("invalid bytes");
+            }
+            const McInt32 node = context_ptr->get_numa_node();
+            memcpy(pMem, reinterpret_cast<const McVoid*>(&node), sizeof(McInt32));
+        }
+    } break;
 
     default:
         throw std::invalid_argument("unknown info parameter");
@@ -381,7 +485,7 @@ void bind_state_impl(
     McSize bytes,
     const McVoid* pMem)
 {
-    std::shared_ptr<context_t> context_ptr = g_contexts.find_first_if([=](const std::shared_ptr<context_t> cptr) { return cptr->m_user_handle == context; });
+    std::shared_ptr<context_t> context_ptr = g_contexts.find(context);
 
     if (context_ptr == nullptr) {
         throw std::invalid_argument("invalid context");
@@ -427,7 +531,7 @@ void bind_state_impl(
 
 void create_user_event_impl(McEvent* eventHandle, McContext context)
 {
-    std::shared_ptr<context_t> context_ptr = g_contexts.find_first_if([=](const std::shared_ptr<context_t> cptr) { return cptr->m_user_handle == context; });
+    std::shared_ptr<context_t> context_ptr = g_contexts.find(context);
 
     if (context_ptr == nullptr) {
         throw std::invalid_argument("invalid context");
@@ -437,15 +541,14 @@ void create_user_event_impl(McEvent* eventHandle, McContext context)
     // create the event object associated with the enqueued task
     //
 
-    std::shared_ptr<event_t> user_event_ptr = std::shared_ptr<event_t>(new event_t(
-        reinterpret_cast<McEvent>(g_objects_counter.fetch_add(1, std::memory_order_relaxed)),
-        McCommandType::MC_COMMAND_USER));
+    std::shared_ptr<event_t> user_event_ptr = g_event_pool.acquire(
+        reinterpret_cast<McEvent>(g_events.reserve()),
+        McCommandType::MC_COMMAND_USER);
 
     MCUT_ASSERT(user_event_ptr != nullptr);
 
-    g_events.push_front(user_event_ptr);
+    g_events.publish(user_event_ptr->m_user_handle, user_event_ptr);
 
-    // user_event_ptr->m_user_handle = reinterpret_cast<McEvent>(g_objects_counter.fetch_add(1, std::memory_order_relaxed));
     user_event_ptr->m_profiling_enabled = (context_ptr->get_flags() & MC_PROFILING_ENABLE) != 0;
     // user_event_ptr->m_command_type = McCommandType::MC_COMMAND_USER;
     user_event_ptr->m_context = context;
@@ -453,25 +556,6 @@ void create_user_event_impl(McEvent* eventHandle, McContext context)
 
     user_event_ptr->log_submit_time();
 
-    std::weak_ptr<event_t> user_event_weak_ptr(user_event_ptr);
-
-    user_event_ptr->m_user_API_command_task_emulator = std::unique_ptr<std::packaged_task<void()>>(new std::packaged_task<void()>(
-        // will be "called" when user updates the command status to MC_COMPLETE
-        [user_event_weak_ptr]() {
-            if (user_event_weak_ptr.expired()) {
-                throw std::runtime_error("user event expired");
-            }
-
-            std::shared_ptr<event_t> event_ptr = user_event_weak_ptr.lock();
-
-            if (event_ptr == nullptr) {
-                throw std::runtime_error("user event null");
-            }
-
-            event_ptr->log_start_time();
-        }));
-
-    user_event_ptr->m_future = user_event_ptr->m_user_API_command_task_emulator->get_future(); // the future we can later wait on via mcWaitForEVents
     user_event_ptr->m_responsible_thread_id = MC_UNDEFINED_VALUE; // some user thread
 
     *eventHandle = user_event_ptr->m_user_handle;
@@ -484,7 +568,7 @@ void create_user_event_impl(McEvent* eventHandle, McContext context)
  */
 void set_user_event_status_impl(McEvent event, McInt32 execution_status)
 {
-    std::shared_ptr<event_t> event_ptr = g_events.find_first_if([=](const std::shared_ptr<event_t> ptr) { return ptr->m_user_handle == event; });
+    std::shared_ptr<event_t> event_ptr = g_events.find(event);
 
     if (event_ptr == nullptr) {
         throw std::invalid_argument("invalid event");
@@ -492,14 +576,15 @@ void set_user_event_status_impl(McEvent event, McInt32 execution_status)
 
     McResult userEventErrorCode = McResult::MC_NO_ERROR;
 
-    std::unique_ptr<std::packaged_task<void()>>& associated_task_emulator = event_ptr->m_user_API_command_task_emulator;
-    MCUT_ASSERT(associated_task_emulator != nullptr);
-    // simply logs the start time and makes the std::packaged_task future object ready
-    associated_task_emulator->operator()(); // call the internal "task" function to update event status
+    if (event_ptr->m_command_type != McCommandType::MC_COMMAND_USER) {
+        throw std::invalid_argument("not a user event");
+    }
+
+    event_ptr->log_start_time();
 
     switch (execution_status) {
     case McEventCommandExecStatus::MC_COMPLETE: {
-        event_ptr->log_end_time();
+        // end time is logged when the event is completed below
     } break;
     default: {
         MCUT_ASSERT(execution_status < 0); // an error
@@ -527,7 +612,7 @@ void get_event_info_impl(
     McVoid* pMem,
     McSize* pNumBytes)
 {
-    std::shared_ptr<event_t> event_ptr = g_events.find_first_if([=](const std::shared_ptr<event_t> ptr) { return ptr->m_user_handle == event; });
+    std::shared_ptr<event_t> event_ptr = g_events.find(event);
 
     if (event_ptr == nullptr) {
         throw std::invalid_argument("invalid event");
@@ -615,28 +700,21 @@ void wait_for_events_impl(
     for (uint32_t i = 0; i < numEventsInWaitlist; ++i) {
         McEvent eventHandle = pEventWaitList[i];
 
-        std::shared_ptr<event_t> event_ptr = g_events.find_first_if([=](const std::shared_ptr<event_t> eptr) { return eptr->m_user_handle == eventHandle; });
+        std::shared_ptr<event_t> event_ptr = g_events.find(eventHandle);
 
         if (event_ptr == nullptr) {
             // "contextHandle" may not be NULL but that does not mean it maps to
             // a valid object in "g_contexts"
             throw std::invalid_argument("null event object");
         } else {
-            if (event_ptr->m_future.valid()) {
-
-                /*while(event_ptr->m_command_exec_status != McEventCommandExecStatus::MC_COMPLETE)
-					std::this_thread::yield();*/
-
-                // block until event task is finished
-				event_ptr->m_future.wait();
-
-
-                runtimeStatusFromAllPrecedingEvents = (McResult)event_ptr->m_runtime_exec_status.load();
-                if (runtimeStatusFromAllPrecedingEvents != McResult::MC_NO_ERROR) {
-                    // indicate that a task waiting on any one of the event in pEventWaitList
-                    // must not proceed because a runtime error occurred
-                    break;
-                }
+            // block until event task is finished
+            event_ptr->wait();
+
+            runtimeStatusFromAllPrecedingEvents = (McResult)event_ptr->m_runtime_exec_status.load();
+            if (runtimeStatusFromAllPrecedingEvents != McResult::MC_NO_ERROR) {
+                // indicate that a task waiting on any one of the event in pEventWaitList
+                // must not proceed because a runtime error occurred
+                break;
             }
         }
     }
@@ -647,7 +725,7 @@ void set_event_callback_impl(
     pfn_McEvent_CALLBACK eventCallback,
     McVoid* data)
 {
-    std::shared_ptr<event_t> event_ptr = g_events.find_first_if([=](const std::shared_ptr<event_t> eptr) { return eptr->m_user_handle == eventHandle; });
+    std::shared_ptr<event_t> event_ptr = g_events.find(eventHandle);
 
     if (event_ptr == nullptr) {
         // "contextHandle" may not be NULL but that does not mean it maps to
@@ -675,7 +753,7 @@ void dispatch_impl(
     const McEvent* pEventWaitList,
     McEvent* pEvent)
 {
-    std::shared_ptr<context_t> context_ptr = g_contexts.find_first_if([=](const std::shared_ptr<context_t> cptr) { return cptr->m_user_handle == contextHandle; });
+    std::shared_ptr<context_t> context_ptr = g_contexts.find(contextHandle);
 
     if (context_ptr == nullptr) {
         throw std::invalid_argument("invalid context");
@@ -913,7 +991,7 @@ void dispatch_planar_section_impl(
     const McEvent* pEventWaitList,
     McEvent* pEvent) noexcept(false)
 {
-    std::shared_ptr<context_t> context_ptr = g_contexts.find_first_if([=](const std::shared_ptr<context_t> cptr) { return cptr->m_user_handle == context; });
+    std::shared_ptr<context_t> context_ptr = g_contexts.find(context);
 
     if (context_ptr == nullptr) {
         throw std::invalid_argument("invalid context");
@@ -964,6 +1042,377 @@ void dispatch_planar_section_impl(
     *pEvent = event_handle;
 }
 
+void dispatch_planar_sections_impl(
+    McContext context,
+    McFlags flags,
+    const McVoid* pSrcMeshVertices,
+    const uint32_t* pSrcMeshFaceIndices,
+    const uint32_t* pSrcMeshFaceSizes,
+    uint32_t numSrcMeshVertices,
+    uint32_t numSrcMeshFaces,
+    const McDouble* pNormalVector,
+    const McDouble* pSectionOffsets,
+    uint32_t numSectionOffsets,
+    uint32_t numEventsInWaitlist,
+    const McEvent* pEventWaitList,
+    McEvent* pEvent) noexcept(false)
+{
+    std::shared_ptr<context_t> context_ptr = g_contexts.find(context);
+
+    if (context_ptr == nullptr) {
+        throw std::invalid_argument("invalid context");
+    }
+
+    std::weak_ptr<context_t> context_weak_ptr(context_ptr);
+
+    // the offsets are copied because the user's array need not outlive this call
+    const std::vector<McDouble> section_offsets(pSectionOffsets, pSectionOffsets + numSectionOffsets);
+    const vec3 normal_vector(pNormalVector[0], pNormalVector[1], pNormalVector[2]);
+
+    const McEvent event_handle = context_ptr->prepare_and_submit_API_task(
+        MC_COMMAND_DISPATCH, numEventsInWaitlist, pEventWaitList,
+        [=]() {
+            if (!context_weak_ptr.expired()) {
+                std::shared_ptr<context_t> context = context_weak_ptr.lock();
+                if (context) {
+                    // the source-mesh is prepared once and then shared by all planes
+                    std::shared_ptr<hmesh_t> source_hmesh = std::shared_ptr<hmesh_t>(new hmesh_t);
+
+                    if (false == client_input_arrays_to_hmesh(context, flags, *source_hmesh.get(), pSrcMeshVertices, pSrcMeshFaceIndices, pSrcMeshFaceSizes, numSrcMeshVertices, numSrcMeshFaces, 1.0, vec3_<double>(0.0), vec3_<double>(0.0))) {
+                        throw std::invalid_argument("invalid source-mesh arrays");
+                    }
+
+                    if ((flags & MC_DISPATCH_TRUSTED_INPUT) == 0 && false == check_input_mesh(context, *source_hmesh.get())) {
+                        throw std::invalid_argument("invalid source-mesh connectivity");
+                    }
+
+                    const vec3 n = normalize(normal_vector);
+
+                    double proj_min = std::numeric_limits<double>::max();
+                    double proj_max = -std::numeric_limits<double>::max();
+
+                    for (vertex_array_iterator_t v = source_hmesh->vertices_begin(); v != source_hmesh->vertices_end(); ++v) {
+                        const double proj = dot_product(n, source_hmesh->vertex(*v));
+                        proj_min = std::min(proj_min, proj);
+                        proj_max = std::max(proj_max, proj);
+                    }
+
+                    // same offset convention as "generate_supertriangle_from_mesh_vertices"
+                    const double eps = 1e-6;
+                    std::vector<uint32_t> plane_to_offset_idx(section_offsets.size());
+                    std::iota(plane_to_offset_idx.begin(), plane_to_offset_idx.end(), 0);
+                    std::stable_sort(plane_to_offset_idx.begin(), plane_to_offset_idx.end(), [&](const uint32_t a, const uint32_t b) {
+                        return section_offsets[a] < section_offsets[b];
+                    });
+
+                    std::vector<double> heights(section_offsets.size());
+
+                    for (uint32_t k = 0; k < (uint32_t)heights.size(); ++k) {
+                        const double offset = std::min(std::max(section_offsets[plane_to_offset_idx[k]], eps), 1.0 - eps);
+                        heights[k] = proj_min + offset * (proj_max - proj_min);
+                    }
+
+                    std::vector<planar_slice_t> sections;
+                    std::vector<planar_slice_t> slabs;
+
+                    compute_planar_sections(
+                        *source_hmesh.get(),
+                        n,
+                        heights,
+                        (flags & MC_DISPATCH_FILTER_FRAGMENT_SEALING_NONE) != 0,
+                        (flags & MC_DISPATCH_INCLUDE_VERTEX_MAP) != 0,
+                        (flags & MC_DISPATCH_INCLUDE_FACE_MAP) != 0,
+                        sections,
+                        slabs);
+
+                    // no polygon partitioning is done, so internal and user indices coincide
+                    std::shared_ptr<std::unordered_map<fd_t, fd_t>> child_to_birth_face = std::shared_ptr<std::unordered_map<fd_t, fd_t>>(new std::unordered_map<fd_t, fd_t>);
+                    std::shared_ptr<std::unordered_map<vd_t, vec3>> partition_vertices = std::shared_ptr<std::unordered_map<vd_t, vec3>>(new std::unordered_map<vd_t, vec3>);
+
+                    auto init_cc = [&](connected_component_t* cc, const planar_slice_t& slice, const McConnectedComponentType type) {
+                        cc->m_user_handle = reinterpret_cast<McConnectedComponent>(context->connected_components.reserve());
+                        cc->type = type;
+                        cc->kernel_hmesh_data = slice.mesh_info;
+                        cc->source_hmesh_child_to_usermesh_birth_face = child_to_birth_face;
+                        cc->cut_hmesh_child_to_usermesh_birth_face = child_to_birth_face;
+                        cc->source_hmesh_new_poly_partition_vertices = partition_vertices;
+                        cc->cut_hmesh_new_poly_partition_vertices = partition_vertices;
+                        cc->internal_sourcemesh_vertex_count = source_hmesh->number_of_vertices();
+                        cc->client_sourcemesh_vertex_count = numSrcMeshVertices;
+                        cc->internal_sourcemesh_face_count = source_hmesh->number_of_faces();
+                        cc->client_sourcemesh_face_count = numSrcMeshFaces;
+                    };
+
+                    for (std::vector<planar_slice_t>::const_iterator i = sections.cbegin(); i != sections.cend(); ++i) {
+                        std::shared_ptr<connected_component_t> cc_ptr = std::shared_ptr<connected_component_t>(new section_cc_t, fn_delete_cc<section_cc_t>);
+                        std::shared_ptr<section_cc_t> asSectionPtr = std::dynamic_pointer_cast<section_cc_t>(cc_ptr);
+                        MCUT_ASSERT(asSectionPtr != nullptr);
+                        init_cc(asSectionPtr.get(), *i, MC_CONNECTED_COMPONENT_TYPE_SECTION);
+                        asSectionPtr->sectionIndex = plane_to_offset_idx[i->index];
+                        context->connected_components.publish(cc_ptr->m_user_handle, cc_ptr);
+                    }
+
+                    for (std::vector<planar_slice_t>::const_iterator i = slabs.cbegin(); i != slabs.cend(); ++i) {
+                        std::shared_ptr<connected_component_t> cc_ptr = std::shared_ptr<connected_component_t>(new slab_cc_t, fn_delete_cc<slab_cc_t>);
+                        std::shared_ptr<slab_cc_t> asSlabPtr = std::dynamic_pointer_cast<slab_cc_t>(cc_ptr);
+                        MCUT_ASSERT(asSlabPtr != nullptr);
+                        init_cc(asSlabPtr.get(), *i, MC_CONNECTED_COMPONENT_TYPE_FRAGMENT);
+                        asSlabPtr->fragmentLocation = MC_FRAGMENT_LOCATION_UNDEFINED;
+                        asSlabPtr->patchLocation = MC_PATCH_LOCATION_UNDEFINED;
+                        asSlabPtr->srcMeshSealType = MC_FRAGMENT_SEAL_TYPE_NONE;
+                        asSlabPtr->sectionIndex = i->index;
+                        context->connected_components.publish(cc_ptr->m_user_handle, cc_ptr);
+                    }
+                }
+            }
+        });
+
+    MCUT_ASSERT(pEvent != nullptr);
+
+    *pEvent = event_handle;
+}
+
+void dispatch_csg_impl(
+    McContext context,
+    McFlags flags,
+    const McVoid* const* ppMeshVertices,
+    const uint32_t* const* ppMeshFaceIndices,
+    const uint32_t* const* ppMeshFaceSizes,
+    const uint32_t* pMeshVertexCounts,
+    const uint32_t* pMeshFaceCounts,
+    uint32_t numMeshes,
+    const McCSGNode* pNodes,
+    uint32_t numNodes,
+    uint32_t numEventsInWaitlist,
+    const McEvent* pEventWaitList,
+    McEvent* pEvent) noexcept(false)
+{
+    std::shared_ptr<context_t> context_ptr = g_contexts.find(context);
+
+    if (context_ptr == nullptr) {
+        throw std::invalid_argument("invalid context");
+    }
+
+    std::weak_ptr<context_t> context_weak_ptr(context_ptr);
+
+    // the solid produced by each node, which is handed to the task of its parent
+    struct node_state_t {
+        std::vector<csg_shell_t> shells;
+        bool evaluated = false;
+        std::string error; // set if the node (or one of its descendants) failed
+    };
+
+    // State shared by the tasks of all nodes (one copy per dispatch, not per task).
+    // The arrays of pointers and the nodes are copied because the user's arrays need
+    // not outlive this call.
+    struct csg_dispatch_t {
+        std::vector<const McVoid*> mesh_vertices;
+        std::vector<const uint32_t*> mesh_face_indices;
+        std::vector<const uint32_t*> mesh_face_sizes;
+        std::vector<uint32_t> mesh_vertex_counts;
+        std::vector<uint32_t> mesh_face_counts;
+        std::vector<McCSGNode> nodes;
+        std::vector<node_state_t> states;
+
+        // All meshes are moved into a common frame that keeps every vertex away from
+        // the origin (as in "calculate_vertex_parameters"), which floating-polygon
+        // partitioning relies on. The frame is computed by the first leaf task, once
+        // the user's waitlist has completed and the vertex arrays are ready.
+        std::once_flag frame_once;
+        vec3_<double> com;
+        vec3_<double> translation;
+    };
+
+    std::shared_ptr<csg_dispatch_t> dispatch = std::shared_ptr<csg_dispatch_t>(new csg_dispatch_t);
+    dispatch->mesh_vertices.assign(ppMeshVertices, ppMeshVertices + numMeshes);
+    dispatch->mesh_face_indices.assign(ppMeshFaceIndices, ppMeshFaceIndices + numMeshes);
+    if (ppMeshFaceSizes != nullptr) {
+        dispatch->mesh_face_sizes.assign(ppMeshFaceSizes, ppMeshFaceSizes + numMeshes);
+    } else {
+        dispatch->mesh_face_sizes.assign(numMeshes, nullptr);
+    }
+    dispatch->mesh_vertex_counts.assign(pMeshVertexCounts, pMeshVertexCounts + numMeshes);
+    dispatch->mesh_face_counts.assign(pMeshFaceCounts, pMeshFaceCounts + numMeshes);
+    dispatch->nodes.assign(pNodes, pNodes + numNodes);
+    dispatch->states.resize(numNodes);
+
+    std::shared_ptr<std::vector<McEvent>> node_events = std::shared_ptr<std::vector<McEvent>>(new std::vector<McEvent>(numNodes, MC_NULL_HANDLE));
+
+    auto init_frame = [dispatch, flags]() {
+        std::call_once(dispatch->frame_once, [&]() {
+            vec3_<double> bboxmin(std::numeric_limits<double>::max());
+            vec3_<double> com(0.0);
+            double count = 0.0;
+
+            for (uint32_t m = 0; m < (uint32_t)dispatch->mesh_vertices.size(); ++m) {
+                for (uint32_t v = 0; v < dispatch->mesh_vertex_counts[m] * 3; ++v) {
+                    const double x = (flags & MC_DISPATCH_VERTEX_ARRAY_FLOAT) ? (double)reinterpret_cast<const float*>(dispatch->mesh_vertices[m])[v] : reinterpret_cast<const double*>(dispatch->mesh_vertices[m])[v];
+                    bboxmin[v % 3] = std::min(bboxmin[v % 3], x);
+                    com[v % 3] += x;
+                }
+                count += dispatch->mesh_vertex_counts[m];
+            }
+
+            dispatch->com = com / count;
+            const vec3_<double> to_positive_quadrant = dispatch->com - bboxmin;
+            dispatch->translation = to_positive_quadrant + normalize(to_positive_quadrant);
+        });
+    };
+
+    // evaluate node "i" once its children (if any) have been evaluated
+    auto evaluate_node = [dispatch, flags, init_frame](std::shared_ptr<context_t>& ctx, const uint32_t i) {
+        const McCSGNode& node = dispatch->nodes[i];
+        node_state_t& state = dispatch->states[i];
+
+        if (node.operation == MC_CSG_OPERATION_MESH) {
+            const uint32_t m = node.operands[0];
+            std::shared_ptr<hmesh_t> hmesh = std::shared_ptr<hmesh_t>(new hmesh_t);
+
+            init_frame();
+
+            if (false == client_input_arrays_to_hmesh(ctx, flags, *hmesh.get(), dispatch->mesh_vertices[m], dispatch->mesh_face_indices[m], dispatch->mesh_face_sizes[m], dispatch->mesh_vertex_counts[m], dispatch->mesh_face_counts[m], 1.0, dispatch->com, dispatch->translation)) {
+                throw std::invalid_argument("invalid csg input-mesh arrays");
+            }
+
+            if ((flags & MC_DISPATCH_TRUSTED_INPUT) == 0) {
+                if (false == check_input_mesh(ctx, *hmesh.get())) {
+                    throw std::invalid_argument("invalid csg input-mesh connectivity");
+                }
+
+                if (false == mesh_is_closed(
+#if defined(MCUT_WITH_COMPUTE_HELPER_THREADPOOL)
+                        ctx->get_shared_compute_threadpool(),
+#endif
+                        *hmesh.get())) {
+                    throw std::invalid_argument("csg input-mesh is not watertight");
+                }
+            }
+
+            if (compute_signed_volume(*hmesh.get()) <= 0.0) {
+                throw std::invalid_argument("csg input-mesh has inward-facing normals");
+            }
+
+            csg_shell_t shell;
+            shell.mesh = hmesh;
+            state.shells.push_back(shell);
+        } else {
+            node_state_t& lhs = dispatch->states[node.operands[0]];
+            node_state_t& rhs = dispatch->states[node.operands[1]];
+
+            if (!lhs.error.empty() || !rhs.error.empty()) {
+                throw std::runtime_error(!lhs.error.empty() ? lhs.error : rhs.error);
+            }
+
+            evaluate_csg_operation(ctx, flags, node.operation, lhs.shells, rhs.shells, state.shells);
+
+            // the operands are no longer needed
+            lhs.shells.clear();
+            rhs.shells.clear();
+        }
+
+        state.evaluated = true;
+    };
+
+    const uint32_t root = numNodes - 1;
+
+    // Nodes are submitted in the given order, so that children are always queued
+    // before their parent. A non-root task records its error instead of failing
+    // its event, so that the root task can report it.
+    for (uint32_t i = 0; i < root; ++i) {
+        const McCSGNode& node = dispatch->nodes[i];
+        const bool is_leaf = node.operation == MC_CSG_OPERATION_MESH;
+        const McEvent child_events[2] = { is_leaf ? MC_NULL_HANDLE : node_events->at(node.operands[0]), is_leaf ? MC_NULL_HANDLE : node_events->at(node.operands[1]) };
+
+        node_events->at(i) = context_ptr->prepare_and_submit_API_task(
+            MC_COMMAND_DISPATCH, is_leaf ? numEventsInWaitlist : 2, is_leaf ? pEventWaitList : child_events,
+            [context_weak_ptr, evaluate_node, dispatch, i]() {
+                if (!context_weak_ptr.expired()) {
+                    std::shared_ptr<context_t> ctx = context_weak_ptr.lock();
+                    if (ctx) {
+                        try {
+                            evaluate_node(ctx, i);
+                        } catch (const std::exception& e) {
+                            dispatch->states[i].error = e.what();
+                        }
+                    }
+                }
+            });
+    }
+
+    const bool root_is_leaf = dispatch->nodes[root].operation == MC_CSG_OPERATION_MESH;
+    const McEvent root_child_events[2] = { root_is_leaf ? MC_NULL_HANDLE : node_events->at(dispatch->nodes[root].operands[0]), root_is_leaf ? MC_NULL_HANDLE : node_events->at(dispatch->nodes[root].operands[1]) };
+
+    const McEvent event_handle = context_ptr->prepare_and_submit_API_task(
+        MC_COMMAND_DISPATCH, root_is_leaf ? numEventsInWaitlist : 2, root_is_leaf ? pEventWaitList : root_child_events,
+        [context_weak_ptr, evaluate_node, dispatch, root]() {
+            if (!context_weak_ptr.expired()) {
+                std::shared_ptr<context_t> context = context_weak_ptr.lock();
+                if (context) {
+                    evaluate_node(context, root);
+
+                    if (!dispatch->states[root].evaluated) {
+                        throw std::runtime_error("csg operand was not evaluated");
+                    }
+
+                    // csg results do not map back to the user's meshes
+                    std::shared_ptr<std::unordered_map<fd_t, fd_t>> child_to_birth_face = std::shared_ptr<std::unordered_map<fd_t, fd_t>>(new std::unordered_map<fd_t, fd_t>);
+                    std::shared_ptr<std::unordered_map<vd_t, vec3>> partition_vertices = std::shared_ptr<std::unordered_map<vd_t, vec3>>(new std::unordered_map<vd_t, vec3>);
+
+                    std::vector<csg_shell_t>& shells = dispatch->states[root].shells;
+
+                    // back to user coordinates
+                    translate_csg_shells(shells, dispatch->com - dispatch->translation);
+
+                    for (std::vector<csg_shell_t>::const_iterator i = shells.cbegin(); i != shells.cend(); ++i) {
+                        std::shared_ptr<connected_component_t> cc_ptr = std::shared_ptr<connected_component_t>(new fragment_cc_t, fn_delete_cc<fragment_cc_t>);
+                        std::shared_ptr<fragment_cc_t> asFragPtr = std::dynamic_pointer_cast<fragment_cc_t>(cc_ptr);
+                        MCUT_ASSERT(asFragPtr != nullptr);
+
+                        std::shared_ptr<output_mesh_info_t> omi = std::shared_ptr<output_mesh_info_t>(new output_mesh_info_t);
+                        omi->mesh = i->mesh;
+
+                        asFragPtr->m_user_handle = reinterpret_cast<McConnectedComponent>(context->connected_components.reserve());
+                        asFragPtr->type = MC_CONNECTED_COMPONENT_TYPE_FRAGMENT;
+                        asFragPtr->fragmentLocation = MC_FRAGMENT_LOCATION_UNDEFINED;
+                        asFragPtr->patchLocation = MC_PATCH_LOCATION_UNDEFINED;
+                        asFragPtr->srcMeshSealType = MC_FRAGMENT_SEAL_TYPE_COMPLETE;
+                        asFragPtr->kernel_hmesh_data = omi;
+                        asFragPtr->source_hmesh_child_to_usermesh_birth_face = child_to_birth_face;
+                        asFragPtr->cut_hmesh_child_to_usermesh_birth_face = child_to_birth_face;
+                        asFragPtr->source_hmesh_new_poly_partition_vertices = partition_vertices;
+                        asFragPtr->cut_hmesh_new_poly_partition_vertices = partition_vertices;
+                        asFragPtr->internal_sourcemesh_vertex_count = 0;
+                        asFragPtr->client_sourcemesh_vertex_count = 0;
+                        asFragPtr->internal_sourcemesh_face_count = 0;
+                        asFragPtr->client_sourcemesh_face_count = 0;
+                        asFragPtr->perturbation_vector = vec3(0.0);
+
+                        context->connected_components.publish(cc_ptr->m_user_handle, cc_ptr);
+                    }
+                }
+            }
+        });
+
+    // The internal events are released once the root event completes, which also
+    // happens without the root task running (a failed wait-list event, or the task
+    // being dropped). Every node is a descendant of the root, so their tasks have
+    // completed (or will not run) by then.
+    if (root > 0) {
+        const std::shared_ptr<event_t> root_event_ptr = g_events.find(event_handle);
+        const auto release_node_events = [node_events, root]() {
+            release_events_impl(root, node_events->data());
+        };
+
+        if (root_event_ptr == nullptr || !root_event_ptr->add_continuation(release_node_events)) {
+            release_node_events(); // finished in the meantime
+        }
+    }
+
+    MCUT_ASSERT(pEvent != nullptr);
+
+    *pEvent = event_handle;
+}
+
 void get_connected_components_impl(
     const McContext contextHandle,
     const McConnectedComponentType connectedComponentType,
@@ -974,7 +1423,7 @@ void get_connected_components_impl(
     const McEvent* pEventWaitList,
     McEvent* pEvent)
 {
-    std::shared_ptr<context_t> context_ptr = g_contexts.find_first_if([=](const std::shared_ptr<context_t> cptr) { return cptr->m_user_handle == contextHandle; });
+    std::shared_ptr<context_t> context_ptr = g_contexts.find(contextHandle);
 
     if (context_ptr == nullptr) {
         throw std::invalid_argument("invalid context");
@@ -1222,13 +1671,13 @@ void triangulate_face(
             // with the correct orientation.
             //
 
-            const std::vector<vertex_descriptor_t>& vertices_around_neighbour = cc.get_vertices_around_face(neigh);
+            const vertices_around_face_view_t vertices_around_neighbour = cc.vertices_around_face(neigh);
 
             // face vertices (their descriptors for indexing into the WOT)
             std::vector<vertex_descriptor_t> remapped_descrs; // from CC to WOT
 
             // for each vertex around neighbour
-            for (std::vector<vertex_descriptor_t>::const_iterator neigh_viter = vertices_around_neighbour.cbegin();
+            for (vertices_around_face_view_t::const_iterator neigh_viter = vertices_around_neighbour.cbegin();
                  neigh_viter != vertices_around_neighbour.cend(); ++neigh_viter) {
 
                 // Check if vertex is already added into the WOT
@@ -2029,7 +2478,7 @@ void get_connected_component_data_impl_detail(
     std::shared_ptr<connected_component_t>& cc_uptr = cc_entry_iter->second;
 #endif
 
-    std::shared_ptr<connected_component_t> cc_uptr = context_ptr->connected_components.find_first_if([=](const std::shared_ptr<connected_component_t> ccptr) { return ccptr->m_user_handle == connCompId; });
+    std::shared_ptr<connected_component_t> cc_uptr = context_ptr->connected_components.find(connCompId);
     if (!cc_uptr) {
         throw std::invalid_argument("invalid connected component");
     }
@@ -2908,6 +3357,32 @@ void get_connected_component_data_impl_detail(
             fragment_cc_t* fragPtr = dynamic_cast<fragment_cc_t*>(cc_uptr.get());
             memcpy(pMem, reinterpret_cast<McVoid*>(&fragPtr->srcMeshSealType), bytes);
         }
+    } break;
+    case MC_CONNECTED_COMPONENT_DATA_SECTION_INDEX: {
+
+        McUint32* src = nullptr;
+
+        if (cc_uptr->type == MC_CONNECTED_COMPONENT_TYPE_SECTION) {
+            src = &dynamic_cast<section_cc_t*>(cc_uptr.get())->sectionIndex;
+        } else if (cc_uptr->type == MC_CONNECTED_COMPONENT_TYPE_FRAGMENT && dynamic_cast<slab_cc_t*>(cc_uptr.get()) != nullptr) {
+            src = &dynamic_cast<slab_cc_t*>(cc_uptr.get())->sectionIndex;
+        } else {
+            throw std::invalid_argument("connected component was not produced by a planar-sections dispatch");
+        }
+
+        if (pMem == nullptr) {
+            *pNumBytes = sizeof(McUint32);
+        } else {
+            if (bytes > sizeof(McUint32)) {
+                throw std::invalid_argument("out of bounds memory access");
+            }
+
+            if (bytes % sizeof(McUint32) != 0) {
+                throw std::invalid_argument("invalid number of bytes");
+            }
+
+            memcpy(pMem, reinterpret_cast<McVoid*>(src), bytes);
+        }
     } break;
         //
     case MC_CONNECTED_COMPONENT_DATA_ORIGIN: {
@@ -3866,7 +4341,7 @@ void get_connected_component_data_impl(
     const McEvent* pEventWaitList,
     McEvent* pEvent)
 {
-    std::shared_ptr<context_t> context_ptr = g_contexts.find_first_if([=](const std::shared_ptr<context_t> cptr) { return cptr->m_user_handle == contextHandle; });
+    std::shared_ptr<context_t> context_ptr = g_contexts.find(contextHandle);
 
     if (context_ptr == nullptr) {
         throw std::invalid_argument("invalid context");
@@ -3898,14 +4373,14 @@ void get_connected_component_data_impl(
 void release_event_impl(
     McEvent eventHandle)
 {
-    std::shared_ptr<event_t> event_ptr = g_events.find_first_if([=](const std::shared_ptr<event_t> eptr) { return eptr->m_user_handle == eventHandle; });
+    std::shared_ptr<event_t> event_ptr = g_events.find(eventHandle);
 
     if (event_ptr == nullptr) {
         throw std::invalid_argument("invalid event handle");
     }
 
     {
-        g_events.remove_if([=](const std::shared_ptr<event_t> eptr) { return eptr->m_user_handle == eventHandle; });
+        g_events.remove(eventHandle);
     }
 }
 
@@ -3922,7 +4397,7 @@ void release_connected_components_impl(
     uint32_t numConnComps,
     const McConnectedComponent* pConnComps)
 {
-    std::shared_ptr<context_t> context_ptr = g_contexts.find_first_if([=](const std::shared_ptr<context_t> cptr) { return cptr->m_user_handle == contextHandle; });
+    std::shared_ptr<context_t> context_ptr = g_contexts.find(contextHandle);
 
     if (context_ptr == nullptr) {
         throw std::invalid_argument("invalid context");
@@ -3937,13 +4412,13 @@ void release_connected_components_impl(
             McConnectedComponent connCompId = pConnComps[i];
 
             // report error if cc is not valid
-            std::shared_ptr<connected_component_t> cc_ptr = context_ptr->connected_components.find_first_if([=](const std::shared_ptr<connected_component_t> ccptr) { return ccptr->m_user_handle == connCompId; });
+            std::shared_ptr<connected_component_t> cc_ptr = context_ptr->connected_components.find(connCompId);
 
             if (cc_ptr == nullptr) {
                 throw std::invalid_argument("invalid connected component handle");
             }
 
-            context_ptr->connected_components.remove_if([=](const std::shared_ptr<connected_component_t> ccptr) { return ccptr->m_user_handle == connCompId; });
+            context_ptr->connected_components.remove(connCompId);
         }
     }
 }
@@ -3951,11 +4426,11 @@ void release_connected_components_impl(
 void release_context_impl(
     McContext contextHandle)
 {
-    std::shared_ptr<context_t> context_ptr = g_contexts.find_first_if([=](const std::shared_ptr<context_t> cptr) { return cptr->m_user_handle == contextHandle; });
+    std::shared_ptr<context_t> context_ptr = g_contexts.find(contextHandle);
 
     if (context_ptr == nullptr) {
         throw std::invalid_argument("invalid context handle");
     }
 
-    g_contexts.remove_if([=](const std::shared_ptr<context_t> cptr) { return cptr->m_user_handle == contextHandle; });
+    g_contexts.remove(contextHandle);
 }
\ No newline at end of file
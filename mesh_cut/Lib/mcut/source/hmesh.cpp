@@ -706,58 +706,32 @@ std::vector<vertex_descriptor_t> hmesh_t::get_vertices_around_face(const face_de
 {
     MCUT_ASSERT(f != null_face());
 
-    const std::vector<halfedge_descriptor_t>& halfedges_on_face = get_halfedges_around_face(f);
-
-    std::vector<vertex_descriptor_t> vertex_descriptors(halfedges_on_face.size());
-
-    for (int i = 0; i < (int)halfedges_on_face.size(); ++i) {
-        const halfedge_descriptor_t h = halfedges_on_face[i];
-        // MCUT_ASSERT((size_t)h < m_halfedges.size() /*m_halfedges.count(h) == 1*/);
-        // const halfedge_data_t& hd = m_halfedges[h];
-        vertex_descriptors[i] = vertex_descriptor_t(prepend_offset + target(h) /*hd.t*/);
-    }
-    return vertex_descriptors;
+    const vertices_around_face_view_t view = vertices_around_face(f, prepend_offset);
+    return std::vector<vertex_descriptor_t>(view.begin(), view.end());
 }
 
 void hmesh_t::get_vertices_around_face(std::vector<vertex_descriptor_t>& vertex_descriptors, const face_descriptor_t f, uint32_t prepend_offset) const
 {
     MCUT_ASSERT(f != null_face());
 
-    const std::vector<halfedge_descriptor_t>& halfedges_on_face = get_halfedges_around_face(f);
-    vertex_descriptors.resize(halfedges_on_face.size());
-
-    for (int i = 0; i < (int)halfedges_on_face.size(); ++i) {
-        const halfedge_descriptor_t h = halfedges_on_face[i];
-        vertex_descriptors[i] = vertex_descriptor_t(prepend_offset + target(h) /*hd.t*/);
-    }
+    vertices_around_face(f, prepend_offset).copy_to(vertex_descriptors);
 }
 
 std::vector<vertex_descriptor_t> hmesh_t::get_vertices_around_vertex(const vertex_descriptor_t v) const
 {
     MCUT_ASSERT(v != null_vertex());
-    // halfedges whoe target is 'v'
-    const std::vector<halfedge_descriptor_t>& halfedges = get_halfedges_around_vertex(v);
-    std::vector<vertex_descriptor_t> out(halfedges.size());
-    //out.resize(halfedges.size());
-    uint32_t counter = 0;
-    for (std::vector<halfedge_descriptor_t>::const_iterator h = halfedges.cbegin(); h != halfedges.cend(); ++h) {
-        vertex_descriptor_t src = source(*h);
-        out[counter++] = src;
-    }
-    return out;
+
+    const vertices_around_vertex_view_t view = vertices_around_vertex(v);
+    return std::vector<vertex_descriptor_t>(view.begin(), view.end());
 }
 
-void hmesh_t::get_vertices_around_vertex(std::vector<vertex_descriptor_t>& vertices_around_vertex, const vertex_descriptor_t v) const
+void hmesh_t::get_vertices_around_vertex(std::vector<vertex_descriptor_t>& vertices_around_vertex_, const vertex_descriptor_t v) const
 {
     MCUT_ASSERT(v != null_vertex());
-    // halfedges whoe target is 'v'
-    const std::vector<halfedge_descriptor_t>& halfedges = get_halfedges_around_vertex(v);
-    
-    vertices_around_vertex.reserve(halfedges.size());
-    for (std::vector<halfedge_descriptor_t>::const_iterator h = halfedges.cbegin(); h != halfedges.cend(); ++h) {
-        vertex_descriptor_t src = source(*h);
-        vertices_around_vertex.emplace_back(src);
-    }
+
+    // NOTE: appends to the output (existing callers clear it themselves)
+    const vertices_around_vertex_view_t view = vertices_around_vertex(v);
+    vertices_around_vertex_.insert(vertices_around_vertex_.end(), view.begin(), view.end());
 }
 
 const std::vector<halfedge_descriptor_t>& hmesh_t::get_halfedges_around_face(const face_descriptor_t f) const
@@ -769,53 +743,18 @@ const std::vector<halfedge_descriptor_t>& hmesh_t::get_halfedges_around_face(con
 
 const std::vector<face_descriptor_t> hmesh_t::get_faces_around_face(const face_descriptor_t f, const std::vector<halfedge_descriptor_t>* halfedges_around_face_) const
 {
-    MCUT_ASSERT(f != null_face());
-
     std::vector<face_descriptor_t> faces_around_face;
-
-    const std::vector<halfedge_descriptor_t>& halfedges_on_face = (halfedges_around_face_ != nullptr) ? *halfedges_around_face_ : get_halfedges_around_face(f);
-
-    for (int i = 0; i < (int)halfedges_on_face.size(); ++i) {
-
-        const halfedge_descriptor_t h = halfedges_on_face[i];
-        MCUT_ASSERT((size_t)h < m_halfedges.size() /*m_halfedges.count(h) == 1*/);
-        const halfedge_data_t& hd = m_halfedges[h];
-
-        if (hd.o != null_halfedge()) {
-            MCUT_ASSERT((size_t)hd.o < m_halfedges.size() /*m_halfedges.count(hd.o) == 1*/);
-            const halfedge_data_t& ohd = m_halfedges[hd.o];
-
-            if (ohd.f != null_face()) {
-                faces_around_face.emplace_back(ohd.f);
-            }
-        }
-    }
+    get_faces_around_face(faces_around_face, f, halfedges_around_face_);
     return faces_around_face;
 }
-// NOTE: we have a lot of dupication here
-void hmesh_t::get_faces_around_face(std::vector<face_descriptor_t>& faces_around_face, const face_descriptor_t f, const std::vector<halfedge_descriptor_t>* halfedges_around_face_) const
+
+void hmesh_t::get_faces_around_face(std::vector<face_descriptor_t>& faces_around_face_, const face_descriptor_t f, const std::vector<halfedge_descriptor_t>* halfedges_around_face_) const
 {
     MCUT_ASSERT(f != null_face());
 
-    faces_around_face.clear();
-
-    const std::vector<halfedge_descriptor_t>& halfedges_on_face = (halfedges_around_face_ != nullptr) ? *halfedges_around_face_ : get_halfedges_around_face(f);
-
-    for (int i = 0; i < (int)halfedges_on_face.size(); ++i) {
-
-        const halfedge_descriptor_t h = halfedges_on_face[i];
-        MCUT_ASSERT((size_t)h < m_halfedges.size() /*m_halfedges.count(h) == 1*/);
-        const halfedge_data_t& hd = m_halfedges[h];
-
-        if (hd.o != null_halfedge()) {
-            MCUT_ASSERT((size_t)hd.o < m_halfedges.size() /*m_halfedges.count(hd.o) == 1*/);
-            const halfedge_data_t& ohd = m_halfedges[hd.o];
-
-            if (ohd.f != null_face()) {
-                faces_around_face.emplace_back(ohd.f);
-            }
-        }
-    }
+    const halfedge_opposite_face_map_t map = { m_halfedges.data() };
+    const faces_around_face_view_t view((halfedges_around_face_ != nullptr) ? *halfedges_around_face_ : get_halfedges_around_face(f), map);
+    view.copy_to(faces_around_face_);
 }
 
 uint32_t hmesh_t::get_num_faces_around_face(const face_descriptor_t f, const std::vector<halfedge_descriptor_t>* halfedges_around_face_) const
@@ -1325,13 +1264,13 @@ void write_off(const char* fpath, const hmesh_t& mesh, const double
     //
     for (face_array_iterator_t iter = mesh.faces_begin(); iter != mesh.faces_end(); ++iter) {
         // const typename hmesh_t::face_descriptor_t& fd = iter.first;
-        const std::vector<vertex_descriptor_t> vertices_around_face = mesh.get_vertices_around_face(*iter);
+        const vertices_around_face_view_t vertices_around_face = mesh.vertices_around_face(*iter);
 
         MCUT_ASSERT(!vertices_around_face.empty());
 
         outfile << vertices_around_face.size() << " ";
 
-        for (std::vector<vertex_descriptor_t>::const_iterator i = vertices_around_face.cbegin(); i != vertices_around_face.cend(); ++i) {
+        for (vertices_around_face_view_t::const_iterator i = vertices_around_face.cbegin(); i != vertices_around_face.cend(); ++i) {
             outfile << (*i) << " ";
         }
         outfile << " \n";
@@ -223,8 +223,8 @@ bool point_on_face_plane(const hmesh_t& m, const fd_t& f, const vec3& p, int& fv
 */
 void dfs_cc(vd_t u, const hmesh_t& mesh, std::vector<int>& visited, int connected_component_id)
 {
-    std::vector<vd_t> verts = mesh.get_vertices_around_vertex(u);
-    for (std::vector<vd_t>::const_iterator v = verts.cbegin(); v != verts.cend(); ++v) {
+    const vertices_around_vertex_view_t verts = mesh.vertices_around_vertex(u);
+    for (vertices_around_vertex_view_t::const_iterator v = verts.cbegin(); v != verts.cend(); ++v) {
         if (SAFE_ACCESS(visited, *v) == -1) {
             visited[*v] = connected_component_id;
             dfs_cc(*v, mesh, visited, connected_component_id);
@@ -257,9 +257,6 @@ int find_connected_components(
     std::vector<bool> queued(mesh.number_of_vertices(), false);
     std::queue<vd_t> queue; // .. to discover all vertices of current connected component
 
-    std::vector<vd_t> vertices_of_v;
-    std::vector<vd_t> vertices_of_u;
-
     for (vertex_array_iterator_t u = mesh.vertices_begin(); u != mesh.vertices_end(); ++u) {
         if (visited[*u] == -1) {
             connected_component_id += 1;
@@ -268,11 +265,10 @@ int find_connected_components(
 
             cc_to_vertex_count.push_back(1); // each discovered cc has at least one vertex
 
-            vertices_of_u.clear();
-            mesh.get_vertices_around_vertex(vertices_of_u, *u);
+            const vertices_around_vertex_view_t vertices_of_u = mesh.vertices_around_vertex(*u);
 
-            for (int i = 0; i < (int)vertices_of_u.size(); ++i) {
-                vd_t vou = vertices_of_u[i];
+            for (vertices_around_vertex_view_t::const_iterator i = vertices_of_u.cbegin(); i != vertices_of_u.cend(); ++i) {
+                vd_t vou = *i;
                 queue.push(vou);
                 queued[vou] = true;
             }
@@ -286,13 +282,12 @@ int find_connected_components(
                     visited[v] = connected_component_id;
                     cc_to_vertex_count[connected_component_id] += 1;
 
-                    vertices_of_v.clear();
-                    mesh.get_vertices_around_vertex(vertices_of_v, v);
+                    const vertices_around_vertex_view_t vertices_of_v = mesh.vertices_around_vertex(v);
 
-                    for (int i = 0; i < (int)vertices_of_v.size(); ++i) {
-                        vd_t vov = vertices_of_v[i];
+                    for (vertices_around_vertex_view_t::const_iterator i = vertices_of_v.cbegin(); i != vertices_of_v.cend(); ++i) {
+                        vd_t vov = *i;
                         if (visited[vov] == -1 || queued[vov] == false) {
-                            queue.push(vertices_of_v[i]);
+                            queue.push(vov);
                             queued[vov] = true;
                         }
                     }
@@ -330,9 +325,7 @@ int find_connected_components(
 #if defined(MCUT_WITH_COMPUTE_HELPER_THREADPOOL)
     auto fn_map_faces = [&](face_array_iterator_t block_start_, face_array_iterator_t block_end_) {
         for (face_array_iterator_t f = block_start_; f != block_end_; ++f) {
-            const std::vector<vertex_descriptor_t> vertices = mesh.get_vertices_around_face(*f);
-
-            int face_cc_id = SAFE_ACCESS(visited, vertices.front());
+            int face_cc_id = SAFE_ACCESS(visited, mesh.vertices_around_face(*f).front());
 
             // all vertices belong to the same conn comp
             fccmap[*f] = face_cc_id;
@@ -349,9 +342,7 @@ int find_connected_components(
 #else
     // map each face to a connected component
     for (face_array_iterator_t f = mesh.faces_begin(); f != mesh.faces_end(); ++f) {
-        const std::vector<vertex_descriptor_t> vertices = mesh.get_vertices_around_face(*f);
-
-        int face_cc_id = SAFE_ACCESS(visited, vertices.front());
+        int face_cc_id = SAFE_ACCESS(visited, mesh.vertices_around_face(*f).front());
 
         // all vertices belong to the same conn comp
         fccmap[*f] = face_cc_id;
@@ -672,9 +663,9 @@ hmesh_t extract_connected_components(
         bool prev_vertex_belonged_to_seam = false; // previous in face
         #endif
         // for each vertex around the current face
-        const std::vector<vertex_descriptor_t> vertices_around_face = mesh.get_vertices_around_face(fd); // order according to "halfedges_on_face" (targets)
+        const vertices_around_face_view_t vertices_around_face = mesh.vertices_around_face(fd); // order according to "halfedges_on_face" (targets)
 
-        for (std::vector<vertex_descriptor_t>::const_iterator face_vertex_iter = vertices_around_face.cbegin();
+        for (vertices_around_face_view_t::const_iterator face_vertex_iter = vertices_around_face.cbegin();
              face_vertex_iter != vertices_around_face.cend();
              ++face_vertex_iter) {
 
@@ -709,7 +700,7 @@ hmesh_t extract_connected_components(
                     bool have_seam_halfedge = prev_vertex_belonged_to_seam;
 
                     if (is_first_face_vertex) {
-                        vd_t last_vtx_descr = (*(vertices_around_face.end() - 1));
+                        vd_t last_vtx_descr = vertices_around_face.back();
                         bool last_vertex_is_seam_vertex = (size_t)(last_vtx_descr) < mesh_vertex_to_seam_flag.size() && SAFE_ACCESS(mesh_vertex_to_seam_flag, last_vtx_descr); //(size_t)(*face_vertex_iter) < mesh_vertex_to_seam_flag.size(); //fiter != mesh_vertex_to_seam_flag.cend() && fiter->second == true;
                         have_seam_halfedge = (last_vertex_is_seam_vertex);
                     }
@@ -807,9 +798,9 @@ hmesh_t extract_connected_components(
                 std::unordered_map<vd_t, vd_t>& mX_to_cc_vertex = SAFE_ACCESS(ccID_to_mX_to_cc_vertex, cc_id);
 
                 // for each vertex around face
-                const std::vector<vertex_descriptor_t> vertices_around_face = mesh.get_vertices_around_face(fd);
+                const vertices_around_face_view_t vertices_around_face = mesh.vertices_around_face(fd);
 
-                for (std::vector<vertex_descriptor_t>::const_iterator face_vertex_iter = vertices_around_face.cbegin();
+                for (vertices_around_face_view_t::const_iterator face_vertex_iter = vertices_around_face.cbegin();
                      face_vertex_iter != vertices_around_face.cend();
                      ++face_vertex_iter) {
                     MCUT_ASSERT(ccID_to_mX_to_cc_vertex.find(cc_id) != ccID_to_mX_to_cc_vertex.cend());
@@ -924,10 +915,10 @@ hmesh_t extract_connected_components(
         std::unordered_map<vd_t, vd_t>& mX_to_cc_vertex = SAFE_ACCESS(ccID_to_mX_to_cc_vertex, cc_id);
 
         // for each vertex around face
-        /*const*/ std::vector<vertex_descriptor_t> vertices_around_face = mesh.get_vertices_around_face(fd);
+        const vertices_around_face_view_t vertices_around_face = mesh.vertices_around_face(fd);
 
-        for (std::vector<vertex_descriptor_t>::/*const_*/ iterator face_vertex_iter = vertices_around_face.begin();
-             face_vertex_iter != vertices_around_face.end();
+        for (vertices_around_face_view_t::const_iterator face_vertex_iter = vertices_around_face.cbegin();
+             face_vertex_iter != vertices_around_face.cend();
              ++face_vertex_iter) {
             MCUT_ASSERT(ccID_to_mX_to_cc_vertex.find(cc_id) != ccID_to_mX_to_cc_vertex.cend());
 
@@ -1436,7 +1427,7 @@ void update_neighouring_ps_iface_m0_edge_list(
 
     std::vector<fd_t> neighbouring_ifaces;
     for (auto neigh_face : { sm_face, cs_face }) {
-        const std::vector<face_descriptor_t> faces_around_face = ps.get_faces_around_face(neigh_face);
+        const faces_around_face_view_t faces_around_face = ps.faces_around_face(neigh_face);
         neighbouring_ifaces.insert(neighbouring_ifaces.end(), faces_around_face.cbegin(), faces_around_face.cend());
     }
 
@@ -1876,6 +1867,10 @@ void dispatch(output_t& output, const input_t& input)
         // an element of this queue is an iterator/ptr to an element of "input.ps_face_to_potentially_intersecting_others"
         std::queue<std::map<fd_t, std::vector<fd_t>>::const_iterator> adj_ps_face_queue;
 
+        // reused across faces to avoid allocating per face
+        std::vector<fd_t> cur_ps_face_neigh_faces;
+        std::vector<fd_t> cur_ps_face_neigh_ifaces;
+
         do { // each iteration will find a set of edges that belong to a connected-component patch of intersectng faces (of sm or cm) in ps
             cur_ps_cc_face = next_ps_cc_face;
             next_ps_cc_face = input.ps_face_to_potentially_intersecting_others->cend(); // set null
@@ -1907,10 +1902,9 @@ void dispatch(output_t& output, const input_t& input)
 
                 const std::vector<hd_t>& cur_ps_face_halfedges = ps.get_halfedges_around_face(cc_iface->first);
                 // all neighbours
-                const std::vector<fd_t> cur_ps_face_neigh_faces = ps.get_faces_around_face(cc_iface->first, &cur_ps_face_halfedges);
+                ps.get_faces_around_face(cur_ps_face_neigh_faces, cc_iface->first, &cur_ps_face_halfedges);
                 // neighbours [which are intersecting faces]
-                std::vector<fd_t> cur_ps_face_neigh_ifaces;
-                cur_ps_face_neigh_ifaces.reserve(cur_ps_face_neigh_faces.size());
+                cur_ps_face_neigh_ifaces.clear();
 
                 for (std::vector<fd_t>::const_iterator face_iter = cur_ps_face_neigh_faces.cbegin();
                      face_iter != cur_ps_face_neigh_faces.cend();
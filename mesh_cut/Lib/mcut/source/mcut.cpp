@@ -39,8 +39,11 @@
 #include "mcut/internal/timer.h"
 #include "mcut/internal/utils.h"
 
+#include <algorithm>
 #include <exception>
 #include <stdexcept>
+#include <string>
+#include <vector>
 
 #if defined(MCUT_BUILD_WINDOWS)
 #pragma warning(disable : 26812)
@@ -107,6 +110,43 @@ MCAPI_ATTR McResult MCAPI_CALL mcCreateContextWithHelpers(McContext* pOutContext
     return return_value;
 }
 
+MCAPI_ATTR McResult MCAPI_CALL mcCreateContextWithPlacement(
+    McContext* pOutContext,
+    McFlags contextFlags,
+    uint32_t helperThreadCount,
+    McInt32 numaNode,
+    McUint32 numCpus,
+    const McUint32* pCpus)
+{
+    McResult return_value = McResult::MC_NO_ERROR;
+    per_thread_api_log_str.clear();
+
+    if (pOutContext == nullptr) {
+        per_thread_api_log_str = "context ptr undef (NULL)";
+        return_value = McResult::MC_INVALID_VALUE;
+    } else if ((numCpus > 0) != (pCpus != nullptr)) {
+        per_thread_api_log_str = "invalid cpu set specification (param4 & param5)";
+        return_value = McResult::MC_INVALID_VALUE;
+    } else if (numaNode < -1) {
+        per_thread_api_log_str = "invalid numa node (param3)";
+        return_value = McResult::MC_INVALID_VALUE;
+    } else if (numaNode >= 0 && numCpus > 0) {
+        per_thread_api_log_str = "numa node and cpu set are mutually exclusive";
+        return_value = McResult::MC_INVALID_VALUE;
+    } else {
+        try {
+            create_context_with_placement_impl(pOutContext, contextFlags, helperThreadCount, numaNode, numCpus, pCpus);
+        }
+        CATCH_POSSIBLE_EXCEPTIONS(per_thread_api_log_str);
+    }
+
+    if (return_value != McResult::MC_NO_ERROR) {
+        std::fprintf(stderr, "%s(...) -> %s\n", __FUNCTION__, per_thread_api_log_str.c_str());
+    }
+
+    return return_value;
+}
+
 MCAPI_ATTR McResult MCAPI_CALL mcDebugMessageCallback(McContext pContext, pfn_mcDebugOutput_CALLBACK cb, const McVoid* userParam)
 {
     McResult return_value = McResult::MC_NO_ERROR;
@@ -231,11 +271,16 @@ MCAPI_ATTR McResult MCAPI_CALL mcGetInfo(const McContext context, McFlags info,
             info & MC_CONTEXT_MAX_DEBUG_MESSAGE_LENGTH || //
             info & MC_CONTEXT_GENERAL_POSITION_ENFORCEMENT_CONSTANT || //
             info & MC_CONTEXT_GENERAL_POSITION_ENFORCEMENT_ATTEMPTS || //
-            info & MC_CONTEXT_DISPATCH_INTERSECTION_TYPE)) // check all possible values
+            info & MC_CONTEXT_CONNECTED_COMPONENT_FACE_WINDING_ORDER || //
+            info & MC_CONTEXT_DISPATCH_INTERSECTION_TYPE || //
+            info & MC_CONTEXT_CPU_SET || //
+            info & MC_CONTEXT_NUMA_NODE)) // check all possible values
     {
         per_thread_api_log_str = "invalid info flag val (param1)";
     } else if ((info & MC_CONTEXT_FLAGS) && (pMem != nullptr && bytes != sizeof(McFlags))) {
         per_thread_api_log_str = "invalid byte size (param2)"; // leads to e.g. "out of bounds" memory access during memcpy
+    } else if ((info & MC_CONTEXT_NUMA_NODE) && (pMem != nullptr && bytes != sizeof(McInt32))) {
+        per_thread_api_log_str = "invalid byte size (param2)";
     } else {
         try {
             get_info_impl(context, info, bytes, pMem, pNumBytes);
@@ -685,6 +730,309 @@ MCAPI_ATTR McResult MCAPI_CALL mcEnqueueDispatchPlanarSection(
     return return_value;
     }
 
+// Return true if two planes of a planar-sections dispatch coincide, which
+// would leave an empty slab between them.
+static bool has_duplicate_section_offsets(const McDouble* pSectionOffsets, uint32_t numSectionOffsets)
+{
+    std::vector<McDouble> offsets(pSectionOffsets, pSectionOffsets + numSectionOffsets);
+    std::sort(offsets.begin(), offsets.end());
+    return std::adjacent_find(offsets.begin(), offsets.end()) != offsets.end();
+}
+
+MCAPI_ATTR McResult MCAPI_CALL mcEnqueueDispatchPlanarSections(
+    const McContext context,
+    McFlags dispatchFlags,
+    const McVoid* pSrcMeshVertices,
+    const uint32_t* pSrcMeshFaceIndices,
+    const uint32_t* pSrcMeshFaceSizes,
+    uint32_t numSrcMeshVertices,
+    uint32_t numSrcMeshFaces,
+    const McDouble* pNormalVector,
+    const McDouble* pSectionOffsets,
+    uint32_t numSectionOffsets,
+    uint32_t numEventsInWaitlist,
+    const McEvent* pEventWaitList,
+    McEvent* pEvent)
+{
+    McResult return_value = McResult::MC_NO_ERROR;
+    per_thread_api_log_str.clear();
+
+    if (context == nullptr) {
+        per_thread_api_log_str = "context ptr (param0) undef (NULL)";
+    } else if (dispatchFlags == 0) {
+        per_thread_api_log_str = "dispatch flags unspecified";
+    } else if ((dispatchFlags & MC_DISPATCH_VERTEX_ARRAY_FLOAT) == 0 && (dispatchFlags & MC_DISPATCH_VERTEX_ARRAY_DOUBLE) == 0) {
+        per_thread_api_log_str = "dispatch vertex aray type unspecified";
+    } else if (pSrcMeshVertices == nullptr) {
+        per_thread_api_log_str = "source-mesh vertex-position array ptr undef (NULL)";
+    } else if (numSrcMeshVertices < 3) {
+        per_thread_api_log_str = "invalid source-mesh vertex count";
+    } else if (pSrcMeshFaceIndices == nullptr) {
+        per_thread_api_log_str = "source-mesh face-index array ptr undef (NULL)";
+    } else if (numSrcMeshFaces < 1) {
+        per_thread_api_log_str = "invalid source-mesh face count";
+    } else if (pNormalVector == nullptr) {
+        per_thread_api_log_str = "normal vector ptr undef (NULL)";
+    } else if (pNormalVector[0] == 0.0 && pNormalVector[1] == 0.0 && pNormalVector[2] == 0.0) {
+        per_thread_api_log_str = "invalid normal vector (zero vector)";
+    } else if (pSectionOffsets == nullptr) {
+        per_thread_api_log_str = "section offset array ptr undef (NULL)";
+    } else if (numSectionOffsets == 0) {
+        per_thread_api_log_str = "invalid section offset count (zero)";
+    } else if (std::any_of(pSectionOffsets, pSectionOffsets + numSectionOffsets, [](const McDouble o) { return !(o >= 0.0 && o <= 1.0); })) {
+        per_thread_api_log_str = "invalid section offset parameter";
+    } else if (has_duplicate_section_offsets(pSectionOffsets, numSectionOffsets)) {
+        per_thread_api_log_str = "duplicate section offset parameter";
+    } else if (pEventWaitList == nullptr && numEventsInWaitlist > 0) {
+        per_thread_api_log_str = "invalid event waitlist ptr (NULL)";
+    } else if (pEventWaitList != nullptr && numEventsInWaitlist == 0) {
+        per_thread_api_log_str = "invalid event waitlist size (zero)";
+    } else if (pEventWaitList == nullptr && numEventsInWaitlist == 0 && pEvent == nullptr) {
+        per_thread_api_log_str = "invalid event ptr (zero)";
+    } else {
+        try {
+            dispatch_planar_sections_impl(
+                context,
+                dispatchFlags,
+                pSrcMeshVertices,
+                pSrcMeshFaceIndices,
+                pSrcMeshFaceSizes,
+                numSrcMeshVertices,
+                numSrcMeshFaces,
+                pNormalVector,
+                pSectionOffsets,
+                numSectionOffsets,
+                numEventsInWaitlist,
+                pEventWaitList,
+                pEvent);
+        }
+        CATCH_POSSIBLE_EXCEPTIONS(per_thread_api_log_str);
+    }
+
+    if (!per_thread_api_log_str.empty()) {
+
+        std::fprintf(stderr, "%s(...) -> %s\n", __FUNCTION__, per_thread_api_log_str.c_str());
+
+        if (return_value == McResult::MC_NO_ERROR) // i.e. problem with basic local parameter checks
+        {
+            return_value = McResult::MC_INVALID_VALUE;
+        }
+    }
+
+    return return_value;
+}
+
+MCAPI_ATTR McResult MCAPI_CALL mcDispatchPlanarSections(
+    const McContext context,
+    McFlags dispatchFlags,
+    const McVoid* pSrcMeshVertices,
+    const uint32_t* pSrcMeshFaceIndices,
+    const uint32_t* pSrcMeshFaceSizes,
+    uint32_t numSrcMeshVertices,
+    uint32_t numSrcMeshFaces,
+    const McDouble* pNormalVector,
+    const McDouble* pSectionOffsets,
+    uint32_t numSectionOffsets)
+{
+    McEvent event = MC_NULL_HANDLE;
+
+    McResult return_value = mcEnqueueDispatchPlanarSections(
+        context,
+        dispatchFlags,
+        pSrcMeshVertices,
+        pSrcMeshFaceIndices,
+        pSrcMeshFaceSizes,
+        numSrcMeshVertices,
+        numSrcMeshFaces,
+        pNormalVector,
+        pSectionOffsets,
+        numSectionOffsets,
+        0,
+        nullptr,
+        &event);
+
+    if (return_value == MC_NO_ERROR) { // API parameter checks are fine
+        if (event != MC_NULL_HANDLE) // event must exist to wait on and query
+        {
+            McResult waitliststatus = MC_NO_ERROR;
+
+            wait_for_events_impl(1, &event, waitliststatus); // block until event of mcEnqueueDispatchPlanarSections is completed!
+
+            if (waitliststatus != McResult::MC_NO_ERROR) {
+                return_value = waitliststatus;
+            }
+
+            release_events_impl(1, &event); // destroy
+        }
+    }
+
+    return return_value;
+}
+
+// Return an empty string if "pNodes" describes a tree over "numMeshes" meshes
+// in which every node appears after its children and the last node is the root.
+static std::string check_csg_tree(const McCSGNode* pNodes, uint32_t numNodes, uint32_t numMeshes)
+{
+    std::vector<uint32_t> parent_count(numNodes, 0);
+
+    for (uint32_t i = 0; i < numNodes; ++i) {
+        const McCSGNode& node = pNodes[i];
+
+        if (node.operation == MC_CSG_OPERATION_MESH) {
+            if (node.operands[0] >= numMeshes) {
+                return "invalid csg node mesh index (node " + std::to_string(i) + ")";
+            }
+        } else if (node.operation == MC_CSG_OPERATION_UNION || node.operation == MC_CSG_OPERATION_INTERSECTION || node.operation == MC_CSG_OPERATION_DIFFERENCE) {
+            for (int j = 0; j < 2; ++j) {
+                if (node.operands[j] >= i) {
+                    return "invalid csg node operand (node " + std::to_string(i) + " must appear after its children)";
+                }
+                parent_count[node.operands[j]] += 1;
+            }
+        } else {
+            return "invalid csg node operation (node " + std::to_string(i) + ")";
+        }
+    }
+
+    for (uint32_t i = 0; i + 1 < numNodes; ++i) {
+        if (parent_count[i] != 1) {
+            return "invalid csg tree (node " + std::to_string(i) + " must be the operand of exactly one node)";
+        }
+    }
+
+    return std::string();
+}
+
+MCAPI_ATTR McResult MCAPI_CALL mcEnqueueDispatchCSG(
+    const McContext context,
+    McFlags dispatchFlags,
+    const McVoid* const* ppMeshVertices,
+    const uint32_t* const* ppMeshFaceIndices,
+    const uint32_t* const* ppMeshFaceSizes,
+    const uint32_t* pMeshVertexCounts,
+    const uint32_t* pMeshFaceCounts,
+    uint32_t numMeshes,
+    const McCSGNode* pNodes,
+    uint32_t numNodes,
+    uint32_t numEventsInWaitlist,
+    const McEvent* pEventWaitList,
+    McEvent* pEvent)
+{
+    McResult return_value = McResult::MC_NO_ERROR;
+    per_thread_api_log_str.clear();
+
+    if (context == nullptr) {
+        per_thread_api_log_str = "context ptr (param0) undef (NULL)";
+    } else if (dispatchFlags == 0) {
+        per_thread_api_log_str = "dispatch flags unspecified";
+    } else if ((dispatchFlags & MC_DISPATCH_VERTEX_ARRAY_FLOAT) == 0 && (dispatchFlags & MC_DISPATCH_VERTEX_ARRAY_DOUBLE) == 0) {
+        per_thread_api_log_str = "dispatch vertex aray type unspecified";
+    } else if ((dispatchFlags & MC_DISPATCH_INCLUDE_VERTEX_MAP) || (dispatchFlags & MC_DISPATCH_INCLUDE_FACE_MAP)) {
+        per_thread_api_log_str = "vertex and face maps are not supported by csg dispatch";
+    } else if (numMeshes == 0) {
+        per_thread_api_log_str = "invalid mesh count (zero)";
+    } else if (ppMeshVertices == nullptr || std::any_of(ppMeshVertices, ppMeshVertices + numMeshes, [](const McVoid* p) { return p == nullptr; })) {
+        per_thread_api_log_str = "mesh vertex-position array ptr undef (NULL)";
+    } else if (ppMeshFaceIndices == nullptr || std::any_of(ppMeshFaceIndices, ppMeshFaceIndices + numMeshes, [](const uint32_t* p) { return p == nullptr; })) {
+        per_thread_api_log_str = "mesh face-index array ptr undef (NULL)";
+    } else if (pMeshVertexCounts == nullptr || std::any_of(pMeshVertexCounts, pMeshVertexCounts + numMeshes, [](const uint32_t n) { return n < 3; })) {
+        per_thread_api_log_str = "invalid mesh vertex count";
+    } else if (pMeshFaceCounts == nullptr || std::any_of(pMeshFaceCounts, pMeshFaceCounts + numMeshes, [](const uint32_t n) { return n < 1; })) {
+        per_thread_api_log_str = "invalid mesh face count";
+    } else if (pNodes == nullptr) {
+        per_thread_api_log_str = "csg node array ptr undef (NULL)";
+    } else if (numNodes == 0) {
+        per_thread_api_log_str = "invalid csg node count (zero)";
+    } else if (pEventWaitList == nullptr && numEventsInWaitlist > 0) {
+        per_thread_api_log_str = "invalid event waitlist ptr (NULL)";
+    } else if (pEventWaitList != nullptr && numEventsInWaitlist == 0) {
+        per_thread_api_log_str = "invalid event waitlist size (zero)";
+    } else if (pEventWaitList == nullptr && numEventsInWaitlist == 0 && pEvent == nullptr) {
+        per_thread_api_log_str = "invalid event ptr (zero)";
+    } else {
+        per_thread_api_log_str = check_csg_tree(pNodes, numNodes, numMeshes);
+
+        if (per_thread_api_log_str.empty()) {
+            try {
+                dispatch_csg_impl(
+                    context,
+                    dispatchFlags,
+                    ppMeshVertices,
+                    ppMeshFaceIndices,
+                    ppMeshFaceSizes,
+                    pMeshVertexCounts,
+                    pMeshFaceCounts,
+                    numMeshes,
+                    pNodes,
+                    numNodes,
+                    numEventsInWaitlist,
+                    pEventWaitList,
+                    pEvent);
+            }
+            CATCH_POSSIBLE_EXCEPTIONS(per_thread_api_log_str);
+        }
+    }
+
+    if (!per_thread_api_log_str.empty()) {
+
+        std::fprintf(stderr, "%s(...) -> %s\n", __FUNCTION__, per_thread_api_log_str.c_str());
+
+        if (return_value == McResult::MC_NO_ERROR) // i.e. problem with basic local parameter checks
+        {
+            return_value = McResult::MC_INVALID_VALUE;
+        }
+    }
+
+    return return_value;
+}
+
+MCAPI_ATTR McResult MCAPI_CALL mcDispatchCSG(
+    const McContext context,
+    McFlags dispatchFlags,
+    const McVoid* const* ppMeshVertices,
+    const uint32_t* const* ppMeshFaceIndices,
+    const uint32_t* const* ppMeshFaceSizes,
+    const uint32_t* pMeshVertexCounts,
+    const uint32_t* pMeshFaceCounts,
+    uint32_t numMeshes,
+    const McCSGNode* pNodes,
+    uint32_t numNodes)
+{
+    McEvent event = MC_NULL_HANDLE;
+
+    McResult return_value = mcEnqueueDispatchCSG(
+        context,
+        dispatchFlags,
+        ppMeshVertices,
+        ppMeshFaceIndices,
+        ppMeshFaceSizes,
+        pMeshVertexCounts,
+        pMeshFaceCounts,
+        numMeshes,
+        pNodes,
+        numNodes,
+        0,
+        nullptr,
+        &event);
+
+    if (return_value == MC_NO_ERROR) { // API parameter checks are fine
+        if (event != MC_NULL_HANDLE) // event must exist to wait on and query
+        {
+            McResult waitliststatus = MC_NO_ERROR;
+
+            wait_for_events_impl(1, &event, waitliststatus); // block until event of mcEnqueueDispatchCSG is completed!
+
+            if (waitliststatus != McResult::MC_NO_ERROR) {
+                return_value = waitliststatus;
+            }
+
+            release_events_impl(1, &event); // destroy
+        }
+    }
+
+    return return_value;
+}
+
 MCAPI_ATTR McResult MCAPI_CALL mcEnqueueGetConnectedComponents(
     const McContext context,
     const McConnectedComponentType connectedComponentType,
@@ -0,0 +1,678 @@
+/***************************************************************************
+ *  This file is part of the MCUT project, which is comprised of a library 
+ *  for surface mesh cutting, example programs and test programs.
+ * 
+ *  Copyright (C) 2024 CutDigital Enterprise Ltd
+ *  
+ *  MCUT is dual-licensed software that is available under an Open Source 
+ *  license as well as a commercial license. The Open Source license is the 
+ *  GNU Lesser General Public License v3+ (LGPL). The commercial license 
+ *  option is for users that wish to use MCUT in their products for commercial 
+ *  purposes but do not wish to release their software under the LGPL. 
+ *  Email <contact@cut-digital.com> for further information.
+ *
+ *  You may not use this file except in compliance with the License. A copy of 
+ *  the Open Source license can be obtained from
+ *
+ *      https://www.gnu.org/licenses/lgpl-3.0.en.html.
+ *
+ *  For your convenience, a copy of this License has been included in this
+ *  repository.
+ *
+ *  MCUT is distributed in the hope that it will be useful, but THE SOFTWARE IS 
+ *  PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, 
+ *  INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR 
+ *  A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR 
+ *  COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, 
+ *  WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF 
+ *  OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * Author(s):
+ *
+ *    Floyd M. Chitalu    CutDigital Enterprise Ltd.
+ *
+ **************************************************************************/
+
+
+#include "mcut/internal/planar_sections.h"
+#include "mcut/internal/timer.h"
+#include "mcut/internal/utils.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <unordered_map>
+
+#if !defined(MCUT_WITH_ARBITRARY_PRECISION_NUMBERS)
+
+namespace {
+
+// Points of a (partially clipped) face are identified by a 64-bit key. The key
+// of a source-mesh vertex is its descriptor, and the key of a point that is
+// created where edge "e" crosses plane "k" is ((k + 1) << 32) | e. Both faces
+// incident to "e" therefore refer to the same point.
+inline uint64_t crossing_key(const uint32_t plane_idx, const ed_t& e)
+{
+    return (((uint64_t)plane_idx + 1) << 32) | (uint64_t)(uint32_t)e;
+}
+
+inline bool is_source_vertex_key(const uint64_t key)
+{
+    return key < ((uint64_t)1 << 32);
+}
+
+// The part of a source-mesh face that has not yet been assigned to a slab.
+// "tags[i]" is the source-mesh edge that the polygon edge from "keys[i]" to
+// "keys[i+1]" lies on, or null_edge() if it lies on a previous section.
+struct active_polygon_t {
+    fd_t face;
+    std::vector<uint64_t> keys;
+    std::vector<vec3> positions;
+    std::vector<ed_t> tags;
+};
+
+struct slab_piece_t {
+    fd_t face;
+    std::vector<uint64_t> keys;
+    std::vector<vec3> positions;
+};
+
+struct section_segment_t {
+    uint64_t keys[2];
+    vec3 positions[2];
+};
+
+// plane "k" is represented by three points so that side-of-plane tests can use
+// the exact orient3d predicate.
+struct plane_t {
+    vec3 p0, p1, p2;
+    double height;
+    double above_sign; // sign of orient3d(p0, p1, p2, x) for points above the plane
+};
+
+// remove consecutive duplicates (including the wrap-around pair) produced when a
+// polygon vertex lies exactly on the plane. The later copy is kept because its
+// tag describes the outgoing edge.
+void remove_repeated_points(std::vector<uint64_t>& keys, std::vector<vec3>& positions, std::vector<ed_t>& tags)
+{
+    uint32_t n = 0;
+    for (uint32_t i = 0; i < (uint32_t)keys.size(); ++i) {
+        if (n > 0 && keys[n - 1] == keys[i]) {
+            n--;
+        }
+        keys[n] = keys[i];
+        positions[n] = positions[i];
+        tags[n] = tags[i];
+        n++;
+    }
+
+    while (n > 1 && keys[n - 1] == keys[0]) {
+        n--;
+    }
+
+    keys.resize(n);
+    positions.resize(n);
+    tags.resize(n);
+}
+
+// build the output mesh of one slab connected component from its pieces
+std::shared_ptr<output_mesh_info_t> build_slab_mesh(
+    const std::vector<slab_piece_t>& pieces,
+    const std::vector<uint32_t>& piece_indices,
+    const std::vector<char>& vertex_on_section,
+    const bool include_vertex_map,
+    const bool include_face_map)
+{
+    std::shared_ptr<output_mesh_info_t> info = std::shared_ptr<output_mesh_info_t>(new output_mesh_info_t);
+    info->mesh = std::shared_ptr<hmesh_t>(new hmesh_t);
+    hmesh_t& mesh = *info->mesh;
+
+    std::unordered_map<uint64_t, vd_t> key_to_vertex;
+    std::vector<vd_t> face_vertices;
+
+    for (std::vector<uint32_t>::const_iterator i = piece_indices.cbegin(); i != piece_indices.cend(); ++i) {
+        const slab_piece_t& piece = pieces[*i];
+
+        face_vertices.clear();
+
+        for (uint32_t j = 0; j < (uint32_t)piece.keys.size(); ++j) {
+            const uint64_t key = piece.keys[j];
+            std::unordered_map<uint64_t, vd_t>::const_iterator fiter = key_to_vertex.find(key);
+
+            if (fiter == key_to_vertex.cend()) {
+                const vd_t v = mesh.add_vertex(piece.positions[j]);
+                key_to_vertex[key] = v;
+                face_vertices.push_back(v);
+
+                const bool is_source_vertex = is_source_vertex_key(key);
+
+                if (!is_source_vertex || vertex_on_section[(size_t)key]) {
+                    info->seam_vertices.push_back(v);
+                }
+
+                if (include_vertex_map) {
+                    info->data_maps.vertex_map.push_back(is_source_vertex ? vd_t((uint32_t)key) : hmesh_t::null_vertex());
+                }
+            } else {
+                face_vertices.push_back(fiter->second);
+            }
+        }
+
+        const fd_t f = mesh.add_face(face_vertices);
+
+        if (f == hmesh_t::null_face()) {
+            throw std::runtime_error("invalid slab face");
+        }
+
+        if (include_face_map) {
+            info->data_maps.face_map.push_back(piece.face);
+        }
+    }
+
+    return info;
+}
+
+// build the output mesh of one section from its (oriented) segments
+std::shared_ptr<output_mesh_info_t> build_section_mesh(
+    const std::vector<section_segment_t>& segments,
+    const bool include_vertex_map)
+{
+    // discard repeated segments and cancel pairs with opposite orientation, which
+    // arise where the mesh touches the plane along an edge from one side only.
+    std::vector<std::pair<uint64_t, uint64_t>> directed;
+    std::unordered_map<uint64_t, vec3> key_positions;
+    {
+        std::vector<std::pair<uint64_t, uint64_t>> sorted_all;
+        sorted_all.reserve(segments.size());
+
+        for (std::vector<section_segment_t>::const_iterator s = segments.cbegin(); s != segments.cend(); ++s) {
+            sorted_all.push_back(std::make_pair(s->keys[0], s->keys[1]));
+            key_positions[s->keys[0]] = s->positions[0];
+            key_positions[s->keys[1]] = s->positions[1];
+        }
+
+        std::sort(sorted_all.begin(), sorted_all.end());
+        sorted_all.erase(std::unique(sorted_all.begin(), sorted_all.end()), sorted_all.end());
+
+        for (std::vector<std::pair<uint64_t, uint64_t>>::const_iterator s = sorted_all.cbegin(); s != sorted_all.cend(); ++s) {
+            const std::pair<uint64_t, uint64_t> opposite(s->second, s->first);
+            if (!std::binary_search(sorted_all.cbegin(), sorted_all.cend(), opposite)) {
+                directed.push_back(*s);
+            }
+        }
+    }
+
+    std::shared_ptr<output_mesh_info_t> info = std::shared_ptr<output_mesh_info_t>(new output_mesh_info_t);
+    info->mesh = std::shared_ptr<hmesh_t>(new hmesh_t);
+    hmesh_t& mesh = *info->mesh;
+
+    if (directed.empty()) {
+        return info;
+    }
+
+    // "directed" is sorted by source key, which lets us find outgoing segments
+    std::unordered_map<uint64_t, vd_t> key_to_vertex;
+    std::unordered_map<uint64_t, uint32_t> in_degree;
+
+    for (std::vector<std::pair<uint64_t, uint64_t>>::const_iterator s = directed.cbegin(); s != directed.cend(); ++s) {
+        for (int i = 0; i < 2; ++i) {
+            const uint64_t key = (i == 0 ? s->first : s->second);
+            if (key_to_vertex.find(key) == key_to_vertex.cend()) {
+                const vd_t v = mesh.add_vertex(key_positions[key]);
+                key_to_vertex[key] = v;
+                info->seam_vertices.push_back(v);
+                if (include_vertex_map) {
+                    info->data_maps.vertex_map.push_back(is_source_vertex_key(key) ? vd_t((uint32_t)key) : hmesh_t::null_vertex());
+                }
+            }
+        }
+        in_degree[s->second]++;
+    }
+
+    std::vector<bool> used(directed.size(), false);
+
+    // returns the index of an unused segment starting at "key", or -1
+    auto find_outgoing = [&](const uint64_t key) -> int64_t {
+        std::vector<std::pair<uint64_t, uint64_t>>::const_iterator it = std::lower_bound(
+            directed.cbegin(), directed.cend(), std::make_pair(key, (uint64_t)0));
+        for (; it != directed.cend() && it->first == key; ++it) {
+            const int64_t idx = (int64_t)std::distance(directed.cbegin(), it);
+            if (!used[(size_t)idx]) {
+                return idx;
+            }
+        }
+        return -1;
+    };
+
+    auto add_chain_as_edges = [&](const std::vector<uint64_t>& chain) {
+        for (uint32_t i = 0; i + 1 < (uint32_t)chain.size(); ++i) {
+            mesh.add_edge(key_to_vertex[chain[i]], key_to_vertex[chain[i + 1]]);
+        }
+    };
+
+    std::vector<uint64_t> chain;
+
+    // open contours first: they start at vertices without incoming segments
+    for (uint32_t pass = 0; pass < 2; ++pass) {
+        for (uint32_t s = 0; s < (uint32_t)directed.size(); ++s) {
+            if (used[s] || (pass == 0 && in_degree[directed[s].first] != 0)) {
+                continue;
+            }
+
+            chain.clear();
+            chain.push_back(directed[s].first);
+            int64_t cur = s;
+
+            while (cur >= 0) {
+                used[(size_t)cur] = true;
+                const uint64_t next_key = directed[(size_t)cur].second;
+                chain.push_back(next_key);
+                if (next_key == chain.front()) {
+                    break;
+                }
+                cur = find_outgoing(next_key);
+            }
+
+            const bool is_loop = chain.size() > 1 && chain.back() == chain.front();
+
+            if (is_loop && chain.size() > 3) {
+                std::vector<vd_t> face_vertices;
+                for (uint32_t i = 0; i + 1 < (uint32_t)chain.size(); ++i) {
+                    face_vertices.push_back(key_to_vertex[chain[i]]);
+                }
+
+                if (mesh.add_face(face_vertices) == hmesh_t::null_face()) {
+                    add_chain_as_edges(chain); // e.g. contours touching at a vertex
+                }
+            } else {
+                add_chain_as_edges(chain);
+            }
+        }
+    }
+
+    return info;
+}
+
+} // namespace
+
+void compute_planar_sections(
+    const hmesh_t& src_mesh,
+    const vec3& normal,
+    const std::vector<double>& heights,
+    const bool compute_slabs,
+    const bool include_vertex_map,
+    const bool include_face_map,
+    std::vector<planar_slice_t>& sections,
+    std::vector<planar_slice_t>& slabs)
+{
+    SCOPED_TIMER(__FUNCTION__);
+
+    const uint32_t num_planes = (uint32_t)heights.size();
+    const uint32_t num_vertices = (uint32_t)src_mesh.number_of_vertices();
+    const uint32_t num_faces = (uint32_t)src_mesh.number_of_faces();
+
+    // orthonormal basis of the planes
+    const int largest_component = (std::fabs(normal[0]) > std::fabs(normal[1]) ? (std::fabs(normal[0]) > std::fabs(normal[2]) ? 0 : 2) : (std::fabs(normal[1]) > std::fabs(normal[2]) ? 1 : 2));
+    vec3 helper(0.0);
+    helper[(largest_component + 1) % 3] = 1.0;
+    const vec3 u = normalize(cross_product(normal, helper));
+    const vec3 v = cross_product(normal, u);
+
+    double proj_min = std::numeric_limits<double>::max();
+    double proj_max = -std::numeric_limits<double>::max();
+    double extent = 0.0;
+
+    for (uint32_t i = 0; i < num_vertices; ++i) {
+        const vec3& p = src_mesh.vertex(vd_t(i));
+        const double proj = dot_product(normal, p);
+        proj_min = std::min(proj_min, proj);
+        proj_max = std::max(proj_max, proj);
+        extent = std::max(extent, std::max(std::fabs(p[0]), std::max(std::fabs(p[1]), std::fabs(p[2]))));
+    }
+
+    extent = std::max(extent, 1.0);
+
+    // tolerance for the (inexact) projections that are only used to schedule
+    // the faces. All side-of-plane decisions are exact.
+    const double margin = extent * 1e-9;
+
+    std::vector<plane_t> planes(num_planes);
+
+    for (uint32_t k = 0; k < num_planes; ++k) {
+        plane_t& plane = planes[k];
+        plane.height = heights[k];
+        plane.p0 = normal * heights[k];
+        plane.p1 = plane.p0 + u * extent;
+        plane.p2 = plane.p0 + v * extent;
+        const double ref = orient3d(plane.p0, plane.p1, plane.p2, plane.p0 + normal * extent);
+        MCUT_ASSERT(ref != 0.0);
+        plane.above_sign = (ref > 0.0 ? 1.0 : -1.0);
+    }
+
+    // faces sorted by their lowest projection onto the normal
+    std::vector<double> face_min_proj(num_faces);
+    std::vector<uint32_t> face_order(num_faces);
+
+    for (uint32_t i = 0; i < num_faces; ++i) {
+        double fmin = std::numeric_limits<double>::max();
+        const std::vector<hd_t>& halfedges = src_mesh.get_halfedges_around_face(fd_t(i));
+        for (std::vector<hd_t>::const_iterator h = halfedges.cbegin(); h != halfedges.cend(); ++h) {
+            fmin = std::min(fmin, dot_product(normal, src_mesh.vertex(src_mesh.source(*h))));
+        }
+        face_min_proj[i] = fmin;
+        face_order[i] = i;
+    }
+
+    std::stable_sort(face_order.begin(), face_order.end(), [&](const uint32_t a, const uint32_t b) {
+        return face_min_proj[a] < face_min_proj[b];
+    });
+
+    // per-vertex side cache, valid when "vertex_side_stamp[v] == k"
+    std::vector<int8_t> vertex_side(num_vertices, 0);
+    std::vector<uint32_t> vertex_side_stamp(num_vertices, UINT32_MAX);
+    std::vector<char> vertex_on_section(num_vertices, 0);
+
+    // -1 = below, 0 = on, +1 = above. Points created on previous planes are below.
+    auto classify = [&](const uint64_t key, const vec3& pos, const uint32_t k) -> int {
+        if (!is_source_vertex_key(key)) {
+            return -1;
+        }
+
+        const uint32_t vidx = (uint32_t)key;
+
+        if (vertex_side_stamp[vidx] != k) {
+            const plane_t& plane = planes[k];
+            const double o = orient3d(plane.p0, plane.p1, plane.p2, pos) * plane.above_sign;
+            vertex_side[vidx] = (int8_t)(o > 0.0 ? 1 : (o < 0.0 ? -1 : 0));
+            vertex_side_stamp[vidx] = k;
+        }
+
+        return vertex_side[vidx];
+    };
+
+    // point where source-mesh edge "e" crosses plane "k", computed from the
+    // canonical endpoints of the edge so that it does not depend on the face
+    auto edge_crossing = [&](const ed_t& e, const uint32_t k) -> vec3 {
+        const hd_t h0 = src_mesh.halfedge(e, 0);
+        const vec3& a = src_mesh.vertex(src_mesh.source(h0));
+        const vec3& b = src_mesh.vertex(src_mesh.target(h0));
+        const double da = dot_product(normal, a) - planes[k].height;
+        const double db = dot_product(normal, b) - planes[k].height;
+        double t = (da != db) ? (da / (da - db)) : 0.5;
+        t = std::min(std::max(t, 0.0), 1.0);
+        return a + (b - a) * t;
+    };
+
+    std::vector<std::vector<slab_piece_t>> slab_pieces(compute_slabs ? (num_planes + 1) : 0);
+    std::vector<active_polygon_t> active;
+    std::vector<active_polygon_t> still_active;
+    std::vector<section_segment_t> segments;
+
+    struct crossing_t {
+        uint64_t key;
+        vec3 position;
+        bool enters_above; // polygon goes from below to above at this point
+    };
+    std::vector<crossing_t> crossings;
+    std::vector<int> sides;
+    active_polygon_t below;
+    active_polygon_t above;
+
+    uint32_t next_face = 0;
+
+    for (uint32_t k = 0; k < num_planes; ++k) {
+
+        const plane_t& plane = planes[k];
+
+        // activate the faces that may reach below this plane
+        while (next_face < num_faces && face_min_proj[face_order[next_face]] <= plane.height + margin) {
+            const fd_t f((uint32_t)face_order[next_face++]);
+            active_polygon_t poly;
+            poly.face = f;
+            const std::vector<hd_t>& halfedges = src_mesh.get_halfedges_around_face(f);
+            for (std::vector<hd_t>::const_iterator h = halfedges.cbegin(); h != halfedges.cend(); ++h) {
+                const vd_t s = src_mesh.source(*h);
+                poly.keys.push_back((uint64_t)(uint32_t)s);
+                poly.positions.push_back(src_mesh.vertex(s));
+                poly.tags.push_back(src_mesh.edge(*h));
+            }
+            active.push_back(std::move(poly));
+        }
+
+        segments.clear();
+        still_active.clear();
+
+        for (std::vector<active_polygon_t>::iterator p = active.begin(); p != active.end(); ++p) {
+            active_polygon_t& poly = *p;
+            const uint32_t n = (uint32_t)poly.keys.size();
+
+            sides.resize(n);
+            bool has_above = false;
+            bool has_below = false;
+
+            for (uint32_t i = 0; i < n; ++i) {
+                sides[i] = classify(poly.keys[i], poly.positions[i], k);
+                has_above = has_above || (sides[i] > 0);
+                has_below = has_below || (sides[i] <= 0);
+            }
+
+            if (!has_above) { // retire: the whole polygon is below this plane
+                if (compute_slabs) {
+                    slab_pieces[k].push_back(slab_piece_t { poly.face, std::move(poly.keys), std::move(poly.positions) });
+                }
+                continue;
+            }
+
+            if (!has_below) { // nothing to clip yet
+                still_active.push_back(std::move(poly));
+                continue;
+            }
+
+            below.face = above.face = poly.face;
+            below.keys.clear();
+            below.positions.clear();
+            below.tags.clear();
+            above.keys.clear();
+            above.positions.clear();
+            above.tags.clear();
+            crossings.clear();
+
+            for (uint32_t i = 0; i < n; ++i) {
+                const uint32_t j = (i + 1) % n;
+                const bool a_above = sides[i] > 0;
+                const bool b_above = sides[j] > 0;
+                const ed_t& e = poly.tags[i];
+
+                active_polygon_t& a_side = a_above ? above : below;
+                a_side.keys.push_back(poly.keys[i]);
+                a_side.positions.push_back(poly.positions[i]);
+                a_side.tags.push_back(e);
+
+                if (a_above == b_above) {
+                    continue;
+                }
+
+                // edges on previous sections have both endpoints below
+                MCUT_ASSERT(e != hmesh_t::null_edge());
+
+                uint64_t x_key;
+                vec3 x_pos;
+
+                if (!a_above && sides[i] == 0) {
+                    x_key = poly.keys[i];
+                    x_pos = poly.positions[i];
+                } else if (!b_above && sides[j] == 0) {
+                    x_key = poly.keys[j];
+                    x_pos = poly.positions[j];
+                } else {
+                    x_key = crossing_key(k, e);
+                    x_pos = edge_crossing(e, k);
+                }
+
+                if (is_source_vertex_key(x_key)) {
+                    vertex_on_section[(size_t)x_key] = 1;
+                }
+
+                // the polygon edge leaving the crossing towards the other side
+                // lies on the section, and the other one still lies on "e"
+                below.keys.push_back(x_key);
+                below.positions.push_back(x_pos);
+                below.tags.push_back(a_above ? e : hmesh_t::null_edge());
+                above.keys.push_back(x_key);
+                above.positions.push_back(x_pos);
+                above.tags.push_back(a_above ? hmesh_t::null_edge() : e);
+
+                crossings.push_back(crossing_t { x_key, x_pos, !a_above });
+            }
+
+            // section segments of this face. For a convex polygon the segment
+            // runs from the point where the boundary goes below to the point
+            // where it comes back above, which orients it along cross(normal, face normal).
+            if (crossings.size() == 2) {
+                const crossing_t& from = crossings[0].enters_above ? crossings[1] : crossings[0];
+                const crossing_t& to = crossings[0].enters_above ? crossings[0] : crossings[1];
+                if (from.key != to.key) {
+                    segments.push_back(section_segment_t { { from.key, to.key }, { from.position, to.position } });
+                }
+            } else if (crossings.size() > 2) {
+                vec3 face_normal(0.0); // Newell's method
+                for (uint32_t i = 0; i < n; ++i) {
+                    const vec3& c = poly.positions[i];
+                    const vec3& d = poly.positions[(i + 1) % n];
+                    face_normal[0] += (c[1] - d[1]) * (c[2] + d[2]);
+                    face_normal[1] += (c[2] - d[2]) * (c[0] + d[0]);
+                    face_normal[2] += (c[0] - d[0]) * (c[1] + d[1]);
+                }
+                const vec3 dir = cross_product(normal, face_normal);
+                std::sort(crossings.begin(), crossings.end(), [&](const crossing_t& a, const crossing_t& b) {
+                    return dot_product(dir, a.position) < dot_product(dir, b.position);
+                });
+                for (uint32_t i = 0; i + 1 < (uint32_t)crossings.size(); i += 2) {
+                    if (crossings[i].key != crossings[i + 1].key) {
+                        segments.push_back(section_segment_t { { crossings[i].key, crossings[i + 1].key }, { crossings[i].position, crossings[i + 1].position } });
+                    }
+                }
+            }
+
+            remove_repeated_points(below.keys, below.positions, below.tags);
+            remove_repeated_points(above.keys, above.positions, above.tags);
+
+            if (compute_slabs && below.keys.size() >= 3) {
+                slab_pieces[k].push_back(slab_piece_t { poly.face, below.keys, below.positions });
+            }
+
+            if (above.keys.size() >= 3) {
+                still_active.push_back(above);
+            }
+        }
+
+        std::swap(active, still_active);
+
+        if (!segments.empty()) {
+            planar_slice_t section;
+            section.mesh_info = build_section_mesh(segments, include_vertex_map);
+            section.index = k;
+            if (section.mesh_info->mesh->number_of_vertices() > 0) {
+                sections.push_back(section);
+            }
+        }
+    }
+
+    if (!compute_slabs) {
+        return;
+    }
+
+    // everything that remains is above the last plane
+    for (std::vector<active_polygon_t>::iterator p = active.begin(); p != active.end(); ++p) {
+        slab_pieces[num_planes].push_back(slab_piece_t { p->face, std::move(p->keys), std::move(p->positions) });
+    }
+
+    for (; next_face < num_faces; ++next_face) {
+        const fd_t f((uint32_t)face_order[next_face]);
+        slab_piece_t piece;
+        piece.face = f;
+        const std::vector<hd_t>& halfedges = src_mesh.get_halfedges_around_face(f);
+        for (std::vector<hd_t>::const_iterator h = halfedges.cbegin(); h != halfedges.cend(); ++h) {
+            const vd_t s = src_mesh.source(*h);
+            piece.keys.push_back((uint64_t)(uint32_t)s);
+            piece.positions.push_back(src_mesh.vertex(s));
+        }
+        slab_pieces[num_planes].push_back(std::move(piece));
+    }
+
+    // split each slab into connected components (union-find over point keys)
+    for (uint32_t s = 0; s <= num_planes; ++s) {
+        const std::vector<slab_piece_t>& pieces = slab_pieces[s];
+
+        if (pieces.empty()) {
+            continue;
+        }
+
+        std::vector<uint32_t> parent(pieces.size());
+        for (uint32_t i = 0; i < (uint32_t)pieces.size(); ++i) {
+            parent[i] = i;
+        }
+
+        auto find_root = [&](uint32_t i) {
+            while (parent[i] != i) {
+                parent[i] = parent[parent[i]];
+                i = parent[i];
+            }
+            return i;
+        };
+
+        std::unordered_map<uint64_t, uint32_t> key_owner;
+
+        for (uint32_t i = 0; i < (uint32_t)pieces.size(); ++i) {
+            for (std::vector<uint64_t>::const_iterator key = pieces[i].keys.cbegin(); key != pieces[i].keys.cend(); ++key) {
+                std::unordered_map<uint64_t, uint32_t>::const_iterator fiter = key_owner.find(*key);
+                if (fiter == key_owner.cend()) {
+                    key_owner[*key] = i;
+                } else {
+                    const uint32_t ra = find_root(i);
+                    const uint32_t rb = find_root(fiter->second);
+                    if (ra != rb) {
+                        parent[std::max(ra, rb)] = std::min(ra, rb);
+                    }
+                }
+            }
+        }
+
+        std::unordered_map<uint32_t, std::vector<uint32_t>> components;
+        std::vector<uint32_t> component_roots;
+
+        for (uint32_t i = 0; i < (uint32_t)pieces.size(); ++i) {
+            const uint32_t root = find_root(i);
+            std::vector<uint32_t>& members = components[root];
+            if (members.empty()) {
+                component_roots.push_back(root);
+            }
+            members.push_back(i);
+        }
+
+        for (std::vector<uint32_t>::const_iterator r = component_roots.cbegin(); r != component_roots.cend(); ++r) {
+            planar_slice_t slab;
+            slab.mesh_info = build_slab_mesh(pieces, components[*r], vertex_on_section, include_vertex_map, include_face_map);
+            slab.index = s;
+            slabs.push_back(slab);
+        }
+    }
+}
+
+#else // #if !defined(MCUT_WITH_ARBITRARY_PRECISION_NUMBERS)
+
+void compute_planar_sections(
+    const hmesh_t& /*src_mesh*/,
+    const vec3& /*normal*/,
+    const std::vector<double>& /*heights*/,
+    const bool /*compute_slabs*/,
+    const bool /*include_vertex_map*/,
+    const bool /*include_face_map*/,
+    std::vector<planar_slice_t>& /*sections*/,
+    std::vector<planar_slice_t>& /*slabs*/)
+{
+    throw std::runtime_error("planar sections are not supported with arbitrary-precision numbers");
+}
+
+#endif // #if !defined(MCUT_WITH_ARBITRARY_PRECISION_NUMBERS)
@@ -36,7 +36,7 @@
 #include <queue>
 #include <random> // for numerical perturbation
 
-#include "mcut/internal/frontend.h"
+#include "mcut/internal/preproc.h"
 
 #include "mcut/internal/bvh.h"
 #include "mcut/internal/hmesh.h"
@@ -52,6 +52,71 @@
 // const double GENERAL_POSITION_ENFORCMENT_CONSTANT = 1e-4;
 // const int MAX_PERTUBATION_ATTEMPTS = 1 << 3;
 
+// returns the coordinates of the i-th user-provided vertex as they are stored in an input hmesh
+// (i.e. recentred, shifted into the positive quadrant, quantized and perturbed as requested)
+static vec3 client_vertex_to_hmesh_point(McFlags dispatchFlags,
+										 const void* pVertices,
+										 const McUint32 i,
+										 const double
+#ifdef MCUT_WITH_ARBITRARY_PRECISION_NUMBERS
+											 multiplier
+#endif
+										 ,
+										 const vec3_<double>& srcmesh_cutmesh_com,
+										 const vec3_<double>& pre_quantization_translation,
+										 const vec3_<double>* perturbation)
+{
+	double x;
+	double y;
+	double z;
+
+	// did the user provide vertex arrays of 32-bit floats...?
+	if(dispatchFlags & MC_DISPATCH_VERTEX_ARRAY_FLOAT)
+	{
+		const float* vptr = reinterpret_cast<const float*>(pVertices);
+#ifdef MCUT_WITH_ARBITRARY_PRECISION_NUMBERS
+		x = (float)((vptr[(i * 3) + 0] - srcmesh_cutmesh_com[0]) + pre_quantization_translation[0]);
+		y = (float)((vptr[(i * 3) + 1] - srcmesh_cutmesh_com[1]) + pre_quantization_translation[1]);
+		z = (float)((vptr[(i * 3) + 2] - srcmesh_cutmesh_com[2]) + pre_quantization_translation[2]);
+#else
+		x = (vptr[(i * 3) + 0] - (float)srcmesh_cutmesh_com[0]) + (float)pre_quantization_translation[0];
+		y = (vptr[(i * 3) + 1] - (float)srcmesh_cutmesh_com[1]) + (float)pre_quantization_translation[1];
+		z = (vptr[(i * 3) + 2] - (float)srcmesh_cutmesh_com[2]) + (float)pre_quantization_translation[2];
+#endif
+	}
+	else // ... 64-bit doubles
+	{
+		MCUT_ASSERT(dispatchFlags & MC_DISPATCH_VERTEX_ARRAY_DOUBLE);
+		const double* vptr = reinterpret_cast<const double*>(pVertices);
+		x = (vptr[(i * 3) + 0] - srcmesh_cutmesh_com[0]) + pre_quantization_translation[0];
+		y = (vptr[(i * 3) + 1] - srcmesh_cutmesh_com[1]) + pre_quantization_translation[1];
+		z = (vptr[(i * 3) + 2] - srcmesh_cutmesh_com[2]) + pre_quantization_translation[2];
+	}
+
+#ifdef MCUT_WITH_ARBITRARY_PRECISION_NUMBERS
+	vec3 quantized_vertex(scalar_t::quantize(x, multiplier),
+						  scalar_t::quantize(y, multiplier),
+						  scalar_t::quantize(z, multiplier));
+
+	if(perturbation != NULL && squared_length(*perturbation) > 0)
+	{
+		for(int j = 0; j < 3; ++j)
+		{
+			if((*perturbation)[j] != 0)
+			{
+				quantized_vertex[j] += scalar_t::quantize((*perturbation)[j], multiplier); // perturb
+			}
+		}
+	}
+
+	return quantized_vertex;
+#else
+	return vec3(x + (perturbation != NULL ? (*perturbation).x() : double(0.)),
+				y + (perturbation != NULL ? (*perturbation).y() : double(0.)),
+				z + (perturbation != NULL ? (*perturbation).z() : double(0.)));
+#endif
+}
+
 // this function converts an index array mesh (e.g. as recieved by the dispatch
 // function) into a halfedge mesh representation for the kernel backend.
 bool client_input_arrays_to_hmesh(std::shared_ptr<context_t>& context_ptr,
@@ -65,14 +130,10 @@ bool client_input_arrays_to_hmesh(std::shared_ptr<context_t>& context_ptr,
 								  const McUint32* pFaceSizes,
 								  const McUint32 numVertices,
 								  const McUint32 numFaces,
-								  const double 
-	#ifdef MCUT_WITH_ARBITRARY_PRECISION_NUMBERS
-	multiplier
-	#endif
-								  ,
+								  const double multiplier,
 								  const vec3_<double> srcmesh_cutmesh_com,
 								  const vec3_<double> pre_quantization_translation,
-								  const vec3_<double>* perturbation = NULL)
+								  const vec3_<double>* perturbation)
 {
 	SCOPED_TIMER(__FUNCTION__);
 
@@ -87,101 +148,19 @@ bool client_input_arrays_to_hmesh(std::shared_ptr<context_t>& context_ptr,
 
 	TIMESTACK_PUSH("add vertices");
 
-	// did the user provide vertex arrays of 32-bit floats...?
-	if(dispatchFlags & MC_DISPATCH_VERTEX_ARRAY_FLOAT)
+	// for each input mesh-vertex
+	for(McUint32 i = 0; i < numVertices; ++i)
 	{
-		const float* vptr = reinterpret_cast<const float*>(pVertices);
-
-		// for each input mesh-vertex
-		for(McUint32 i = 0; i < numVertices; ++i)
-		{
-			
-#ifdef MCUT_WITH_ARBITRARY_PRECISION_NUMBERS
-			const float x = (vptr[(i * 3) + 0] - srcmesh_cutmesh_com[0]) + pre_quantization_translation[0];
-			const float y = (vptr[(i * 3) + 1] - srcmesh_cutmesh_com[1]) + pre_quantization_translation[1];
-			const float z = (vptr[(i * 3) + 2] - srcmesh_cutmesh_com[2]) + pre_quantization_translation[2];
-			vec3 quantized_vertex(scalar_t::quantize(x, multiplier),
-								  scalar_t::quantize(y, multiplier),
-								  scalar_t::quantize(z, multiplier));
-
-			
-			if(perturbation != NULL && squared_length(*perturbation) > 0)
-			{
-				for(int j = 0; j < 3; ++j)
-				{
-					if((*perturbation)[j] != 0)
-					{
-						quantized_vertex[j] +=
-							scalar_t::quantize((*perturbation)[j], multiplier); // perturb
-					}
-
-					//quantized_vertex[j] -= scalar_t::quantize(srcmesh_cutmesh_com[i].get_d(), multiplier); // recentre to origin
-				}
-			}
-
-			vd_t vd = halfedgeMesh.add_vertex(quantized_vertex);
-#else
-			const float x = (vptr[(i * 3) + 0] - (float)srcmesh_cutmesh_com[0]) +
-							(float)pre_quantization_translation[0];
-			const float y = (vptr[(i * 3) + 1] - (float)srcmesh_cutmesh_com[1]) +
-							(float)pre_quantization_translation[1];
-			const float z = (vptr[(i * 3) + 2] - (float)srcmesh_cutmesh_com[2]) +
-							(float)pre_quantization_translation[2];
-			// insert our vertex into halfedge mesh
-			vd_t vd = halfedgeMesh.add_vertex(
-				double(x) + (perturbation != NULL ? (*perturbation).x() : double(0.)),
-				double(y) + (perturbation != NULL ? (*perturbation).y() : double(0.)),
-				double(z) + (perturbation != NULL ? (*perturbation).z() : double(0.)));
-#endif
-			MCUT_ASSERT(vd != hmesh_t::null_vertex() && (McUint32)vd < numVertices);
-		}
-	}
-	// did the user provide vertex arrays of 64-bit double...?
-	else if(dispatchFlags & MC_DISPATCH_VERTEX_ARRAY_DOUBLE)
-	{
-		const double* vptr = reinterpret_cast<const double*>(pVertices);
-
-		// for each input mesh-vertex
-		for(McUint32 i = 0; i < numVertices; ++i)
-		{
-			const double x_ =
-				vptr[(i * 3) + 0];
-			const double y_ =
-				vptr[(i * 3) + 1];
-			const double z_ = vptr[(i * 3) + 2];
-
-			const double x = (x_ - srcmesh_cutmesh_com[0]) + pre_quantization_translation[0];
-			const double y = (y_ - srcmesh_cutmesh_com[1]) + pre_quantization_translation[1];
-			const double z = (z_ - srcmesh_cutmesh_com[2]) + pre_quantization_translation[2];
-
-#ifdef MCUT_WITH_ARBITRARY_PRECISION_NUMBERS
-			vec3 quantized_vertex;
-			quantized_vertex[0] = scalar_t::quantize(x, multiplier);
-			quantized_vertex[1] = scalar_t::quantize(y, multiplier),
-			quantized_vertex[2] = scalar_t::quantize(z, multiplier);
-
-			if(perturbation != NULL && squared_length(*perturbation) > 0)
-			{
-				for(int j = 0; j < 3; ++j)
-				{
-					if((*perturbation)[j] != 0)
-					{
-						quantized_vertex[j] +=
-							scalar_t::quantize((*perturbation)[j], multiplier);
-					}
-				}
-			}
-
-			vd_t vd = halfedgeMesh.add_vertex(quantized_vertex);
-#else
-			// insert our vertex into halfedge mesh
-			vd_t vd = halfedgeMesh.add_vertex(
-				double(x) + (perturbation != NULL ? (*perturbation).x() : double(0.)),
-				double(y) + (perturbation != NULL ? (*perturbation).y() : double(0.)),
-				double(z) + (perturbation != NULL ? (*perturbation).z() : double(0.)));
-#endif
-			MCUT_ASSERT(vd != hmesh_t::null_vertex() && (McUint32)vd < numVertices);
-		}
+		// insert our vertex into halfedge mesh
+		vd_t vd = halfedgeMesh.add_vertex(client_vertex_to_hmesh_point(dispatchFlags,
+																	   pVertices,
+																	   i,
+																	   multiplier,
+																	   srcmesh_cutmesh_com,
+																	   pre_quantization_translation,
+																	   perturbation));
+		MCUT_ASSERT(vd != hmesh_t::null_vertex() && (McUint32)vd < numVertices);
+		(void)vd;
 	}
 
 	TIMESTACK_POP(); // TIMESTACK_PUSH("add vertices");
@@ -467,22 +446,98 @@ bool client_input_arrays_to_hmesh(std::shared_ptr<context_t>& context_ptr,
 	return true;
 }
 
+// FNV-1a style hash of the face arrays of an input mesh (one step per 32-bit word). A stored
+// topology is only reused when this matches, so that different faces with the same element counts
+// are never mistaken for the stored ones.
+uint64_t hash_client_face_arrays(const McUint32* pFaceIndices, const McUint32* pFaceSizes, const McUint32 numFaces)
+{
+	SCOPED_TIMER(__FUNCTION__);
+
+	uint64_t hash = 14695981039346656037ull;
+	auto mix = [&](McUint32 word) {
+		hash ^= word;
+		hash *= 1099511628211ull;
+	};
+
+	mix(pFaceSizes != nullptr); // a triangle mesh given without face sizes is a different input
+	uint64_t num_face_indices = 0;
+	for(McUint32 i = 0; i < numFaces; ++i)
+	{
+		const McUint32 face_size = (pFaceSizes != nullptr) ? pFaceSizes[i] : 3;
+		if(pFaceSizes != nullptr)
+		{
+			mix(face_size);
+		}
+		num_face_indices += face_size;
+	}
+
+	for(uint64_t i = 0; i < num_face_indices; ++i)
+	{
+		mix(pFaceIndices[i]);
+	}
+
+	return hash;
+}
+
+// moves the vertices of an hmesh (created by "client_input_arrays_to_hmesh" from arrays with the same
+// faces) to the user-provided coordinates, leaving its connectivity untouched.
+void update_hmesh_vertices_from_client_array(std::shared_ptr<context_t>& context_ptr,
+											  McFlags dispatchFlags,
+											  hmesh_t& halfedgeMesh,
+											  const void* pVertices,
+											  const McUint32 numVertices,
+											  const double multiplier,
+											  const vec3_<double> srcmesh_cutmesh_com,
+											  const vec3_<double> pre_quantization_translation,
+											  const vec3_<double>* perturbation)
+{
+	SCOPED_TIMER(__FUNCTION__);
+
+	MCUT_ASSERT((McUint32)halfedgeMesh.number_of_vertices() == numVertices);
+	(void)numVertices;
+
+	auto fn_update_vertices = [&](vertex_array_iterator_t block_start_,
+								  vertex_array_iterator_t block_end_) {
+		for(vertex_array_iterator_t v = block_start_; v != block_end_; ++v)
+		{
+			halfedgeMesh.set_vertex(*v,
+									client_vertex_to_hmesh_point(dispatchFlags,
+																 pVertices,
+																 (McUint32)*v,
+																 multiplier,
+																 srcmesh_cutmesh_com,
+																 pre_quantization_translation,
+																 perturbation));
+		}
+	};
+
+#if defined(MCUT_WITH_COMPUTE_HELPER_THREADPOOL)
+	parallel_for(context_ptr->get_shared_compute_threadpool(),
+				 halfedgeMesh.vertices_begin(),
+				 halfedgeMesh.vertices_end(),
+				 fn_update_vertices);
+#else
+	(void)context_ptr;
+	fn_update_vertices(halfedgeMesh.vertices_begin(), halfedgeMesh.vertices_end());
+#endif
+}
+
 bool is_coplanar(const hmesh_t& m, const fd_t& f, int& fv_count)
 {
-	const std::vector<vd_t> vertices = m.get_vertices_around_face(f);
-	fv_count = (int)vertices.size();
+	fv_count = (int)m.get_num_vertices_around_face(f);
 	if(fv_count > 3) // non-triangle
 	{
+		const vertices_around_face_view_t vertices = m.vertices_around_face(f);
 		for(int i = 0; i < (fv_count - 3); ++i)
 		{
 			const int j = (i + 1) % fv_count;
 			const int k = (i + 2) % fv_count;
 			const int l = (i + 3) % fv_count;
 
-			const vd_t& vi = vertices[i];
-			const vd_t& vj = vertices[j];
-			const vd_t& vk = vertices[k];
-			const vd_t& vl = vertices[l];
+			const vd_t vi = vertices[i];
+			const vd_t vj = vertices[j];
+			const vd_t vk = vertices[k];
+			const vd_t vl = vertices[l];
 
 			const vec3& vi_coords = m.vertex(vi);
 			const vec3& vj_coords = m.vertex(vj);
@@ -548,30 +603,69 @@ bool check_input_mesh(std::shared_ptr<context_t>& context_ptr, const hmesh_t& m)
 		return false;
 	}
 
-	// check that the vertices of each face are co-planar
-	for(face_array_iterator_t f = m.faces_begin(); f != m.faces_end(); ++f)
+	// check that the vertices of each face are co-planar. The blocks only collect
+	// the offending faces (with their vertex counts), which are reported on this
+	// thread, since the debug callback (and the internal debug log) must not be
+	// invoked from helper threads
+	typedef std::vector<std::pair<fd_t, int>> noncoplanar_faces_t;
+
+	auto fn_check_coplanarity = [&](face_array_iterator_t block_start_,
+									face_array_iterator_t block_end_) {
+		noncoplanar_faces_t noncoplanar_faces;
+		for(face_array_iterator_t f = block_start_; f != block_end_; ++f)
+		{
+			int fv_count = 0;
+			const bool face_is_coplanar = is_coplanar(m, *f, fv_count);
+			if(!face_is_coplanar)
+			{
+				noncoplanar_faces.emplace_back(*f, fv_count);
+			}
+		}
+		return noncoplanar_faces;
+	};
+
+	noncoplanar_faces_t noncoplanar_faces;
+
+#if defined(MCUT_WITH_COMPUTE_HELPER_THREADPOOL)
 	{
-		int fv_count = 0;
-		const bool face_is_coplanar = is_coplanar(m, *f, fv_count);
-		if(!face_is_coplanar)
+		std::vector<std::future<noncoplanar_faces_t>> futures;
+		noncoplanar_faces_t partial_res;
+
+		parallel_for(context_ptr->get_shared_compute_threadpool(),
+					 m.faces_begin(),
+					 m.faces_end(),
+					 fn_check_coplanarity,
+					 partial_res, // output computed by master thread
+					 futures);
+
+		for(int i = 0; i < (int)futures.size(); ++i)
 		{
-			context_ptr->dbg_cb(MC_DEBUG_SOURCE_API,
-								MC_DEBUG_TYPE_OTHER,
-								0,
-								MC_DEBUG_SEVERITY_NOTIFICATION,
-								"Vertices (" + std::to_string(fv_count) + ") on face f" +
-									std::to_string(*f) + " are not coplanar");
-			// No need to return false, simply warn. It is difficult to
-			// know whether the non-coplanarity is severe enough to cause
-			// confusion when computing intersection points between two
-			// polygons (min=2 but sometimes can get 1 due to non-coplanarity
-			// of face vertices).
-			// In general, the more vertices on a face, the less likely
-			// they are to be co-planar. Faces with a low number of polygons
-			// are ideal (3 vertices being the best)
-			// result = false;
-			// break;
+			const noncoplanar_faces_t block_res = futures[i].get();
+			noncoplanar_faces.insert(noncoplanar_faces.end(), block_res.cbegin(), block_res.cend());
 		}
+
+		noncoplanar_faces.insert(noncoplanar_faces.end(), partial_res.cbegin(), partial_res.cend());
+	}
+#else
+	noncoplanar_faces = fn_check_coplanarity(m.faces_begin(), m.faces_end());
+#endif
+
+	for(noncoplanar_faces_t::const_iterator i = noncoplanar_faces.cbegin(); i != noncoplanar_faces.cend(); ++i)
+	{
+		context_ptr->dbg_cb(MC_DEBUG_SOURCE_API,
+							MC_DEBUG_TYPE_OTHER,
+							0,
+							MC_DEBUG_SEVERITY_NOTIFICATION,
+							"Vertices (" + std::to_string(i->second) + ") on face f" +
+								std::to_string(i->first) + " are not coplanar");
+		// No need to return false, simply warn. It is difficult to
+		// know whether the non-coplanarity is severe enough to cause
+		// confusion when computing intersection points between two
+		// polygons (min=2 but sometimes can get 1 due to non-coplanarity
+		// of face vertices).
+		// In general, the more vertices on a face, the less likely
+		// they are to be co-planar. Faces with a low number of polygons
+		// are ideal (3 vertices being the best)
 	}
 
 	return true;
@@ -811,16 +905,13 @@ void resolve_floating_polygons(
 
 					// ::::::::::::::::::::::
 					// get face vertex coords
-					const std::vector<vd_t> face_vertex_descriptors =
-						parent_face_hmesh_ptr->get_vertices_around_face(face);
+					const vertices_around_face_view_t face_vertex_descriptors =
+						parent_face_hmesh_ptr->vertices_around_face(face);
 					std::vector<vec3> face_vertex_coords_3d(face_vertex_descriptors.size());
 
-					for(std::vector<vd_t>::const_iterator i = face_vertex_descriptors.cbegin();
-						i != face_vertex_descriptors.cend();
-						++i)
+					for(uint32_t idx = 0; idx < face_vertex_descriptors.size(); ++idx)
 					{
-						const size_t idx = std::distance(face_vertex_descriptors.cbegin(), i);
-						const vec3& coords = parent_face_hmesh_ptr->vertex(*i);
+						const vec3& coords = parent_face_hmesh_ptr->vertex(face_vertex_descriptors[idx]);
 						face_vertex_coords_3d[idx] = coords;
 					}
 
@@ -1955,25 +2046,36 @@ double getWindingNumber(std::shared_ptr<context_t> context_ptr,
 }
 
 bool mesh_is_closed(
-#if 0 //defined(MCUT_WITH_COMPUTE_HELPER_THREADPOOL)
-    thread_pool& scheduler,
+#if defined(MCUT_WITH_COMPUTE_HELPER_THREADPOOL)
+	thread_pool& scheduler,
 #endif
 	const hmesh_t& mesh)
 {
-	bool all_halfedges_incident_to_face = true;
-#if 0 // defined(MCUT_WITH_COMPUTE_HELPER_THREADPOOL)
-    {
-        printf("mesh=%d\n", (int)mesh.number_of_halfedges());
-        all_halfedges_incident_to_face = parallel_find_if(
-            scheduler,
-            mesh.halfedges_begin(),
-            mesh.halfedges_end(),
-            [&](hd_t h) {
-                const fd_t f = mesh.face(h);
-                return (f == hmesh_t::null_face());
-            })
-            == mesh.halfedges_end();
-    }
+#if defined(MCUT_WITH_COMPUTE_HELPER_THREADPOOL)
+	// set by the first thread to find a border halfedge so that the others stop early
+	std::atomic<bool> found_border_halfedge(false);
+
+	auto fn_find_border_halfedge = [&](halfedge_array_iterator_t block_start_,
+									   halfedge_array_iterator_t block_end_) {
+		for(halfedge_array_iterator_t iter = block_start_;
+			iter != block_end_ && !found_border_halfedge.load(std::memory_order_relaxed);
+			++iter)
+		{
+			if(mesh.face(*iter) == hmesh_t::null_face())
+			{
+				found_border_halfedge.store(true, std::memory_order_relaxed);
+			}
+		}
+	};
+
+	parallel_for(scheduler,
+				 mesh.halfedges_begin(),
+				 mesh.halfedges_end(),
+				 fn_find_border_halfedge,
+				 1 << 14 // the per-halfedge test is cheap
+	);
+
+	return !found_border_halfedge.load();
 #else
 	for(halfedge_array_iterator_t iter = mesh.halfedges_begin(); iter != mesh.halfedges_end();
 		++iter)
@@ -1981,12 +2083,11 @@ bool mesh_is_closed(
 		const fd_t f = mesh.face(*iter);
 		if(f == hmesh_t::null_face())
 		{
-			all_halfedges_incident_to_face = false;
-			break;
+			return false;
 		}
 	}
+	return true;
 #endif
-	return all_halfedges_incident_to_face;
 }
 
 // If either mesh is not watertight, then we return [no intersection]!
@@ -2332,25 +2433,81 @@ extern "C" void preproc(std::shared_ptr<context_t> context_ptr,
 
 	///
 
-	std::shared_ptr<hmesh_t> source_hmesh = std::shared_ptr<hmesh_t>(new hmesh_t);
+	// Topologies stored by an earlier dispatch whose input mesh had the same faces. Only the vertex
+	// positions are then updated (no re-validation) and the BVH is refitted rather than rebuilt.
+	// A stored topology whose element counts or face arrays do not match is replaced below.
+	const bool reuse_source_topology = (dispatchFlags & MC_DISPATCH_REUSE_SOURCE_MESH_TOPOLOGY) != 0;
+	const bool reuse_cut_topology = (dispatchFlags & MC_DISPATCH_REUSE_CUT_MESH_TOPOLOGY) != 0;
+
+	std::shared_ptr<const dispatch_input_topology_t> source_topology;
+	uint64_t source_faces_hash = 0;
+	if(reuse_source_topology)
+	{
+		source_faces_hash = hash_client_face_arrays(pSrcMeshFaceIndices, pSrcMeshFaceSizes, numSrcMeshFaces);
+		source_topology = context_ptr->get_input_topology(dispatch_input_t::SOURCE_MESH);
+		if(source_topology &&
+		   (source_topology->num_vertices != numSrcMeshVertices || source_topology->num_faces != numSrcMeshFaces ||
+			source_topology->faces_hash != source_faces_hash))
+		{
+			source_topology.reset();
+		}
+	}
+
+	std::shared_ptr<const dispatch_input_topology_t> cut_topology;
+	uint64_t cut_faces_hash = 0;
+	if(reuse_cut_topology)
+	{
+		cut_faces_hash = hash_client_face_arrays(pCutMeshFaceIndices, pCutMeshFaceSizes, numCutMeshFaces);
+		cut_topology = context_ptr->get_input_topology(dispatch_input_t::CUT_MESH);
+		if(cut_topology &&
+		   (cut_topology->num_vertices != numCutMeshVertices || cut_topology->num_faces != numCutMeshFaces ||
+			cut_topology->faces_hash != cut_faces_hash))
+		{
+			cut_topology.reset();
+		}
+	}
+
+	std::shared_ptr<hmesh_t> source_hmesh;
 	//double source_hmesh_aabb_diag = length(srcmesh_bboxmax - srcmesh_bboxmin, 1);
 
-	if(false == client_input_arrays_to_hmesh(context_ptr,
-											 dispatchFlags,
-											 *source_hmesh.get(),
-											 pSrcMeshVertices,
-											 pSrcMeshFaceIndices,
-											 pSrcMeshFaceSizes,
-											 numSrcMeshVertices,
-											 numSrcMeshFaces,
-											 multiplier,
+	if(source_topology)
+	{
+		TIMESTACK_PUSH("update source-mesh vertices");
+		source_hmesh = std::shared_ptr<hmesh_t>(new hmesh_t(*source_topology->mesh));
+		update_hmesh_vertices_from_client_array(context_ptr,
+												dispatchFlags,
+												*source_hmesh.get(),
+												pSrcMeshVertices,
+												numSrcMeshVertices,
+												multiplier,
 												srcmesh_cutmesh_com,
-											  pre_quantization_translation))
+												pre_quantization_translation);
+		TIMESTACK_POP();
+	}
+	else
 	{
-		throw std::invalid_argument("invalid source-mesh arrays");
+		source_hmesh = std::shared_ptr<hmesh_t>(new hmesh_t);
+
+		if(false == client_input_arrays_to_hmesh(context_ptr,
+												 dispatchFlags,
+												 *source_hmesh.get(),
+												 pSrcMeshVertices,
+												 pSrcMeshFaceIndices,
+												 pSrcMeshFaceSizes,
+												 numSrcMeshVertices,
+												 numSrcMeshFaces,
+												 multiplier,
+												 srcmesh_cutmesh_com,
+												 pre_quantization_translation))
+		{
+			throw std::invalid_argument("invalid source-mesh arrays");
+		}
 	}
 
-	if(false == check_input_mesh(context_ptr, *source_hmesh.get()))
+	// the caller vouches for the connectivity of the inputs, and their watertightness is given as a hint
+	const bool trusted_input = (dispatchFlags & MC_DISPATCH_TRUSTED_INPUT) != 0;
+
+	if(!trusted_input && !source_topology && false == check_input_mesh(context_ptr, *source_hmesh.get()))
 	{
 		throw std::invalid_argument("invalid source-mesh connectivity");
 	}
@@ -2453,14 +2610,30 @@ extern "C" void preproc(std::shared_ptr<context_t> context_ptr,
 	std::vector<bounding_box_t<vec3_<double>>> source_hmesh_BVH_aabb_array;
 	std::vector<fd_t> source_hmesh_BVH_leafdata_array;
 	std::vector<bounding_box_t<vec3_<double>>> source_hmesh_face_aabb_array;
-	build_oibvh(
+	if(source_topology)
+	{
+		source_hmesh_BVH_leafdata_array = source_topology->bvh_leaf_faces;
+		source_hmesh_BVH_aabb_array.resize(get_ostensibly_implicit_bvh_size((int)numSrcMeshFaces));
+		refit_oibvh(
 #	if defined(MCUT_WITH_COMPUTE_HELPER_THREADPOOL)
-		context_ptr->get_shared_compute_threadpool(),
+			context_ptr->get_shared_compute_threadpool(),
 #	endif
-		*source_hmesh.get(),
-		source_hmesh_BVH_aabb_array,
-		source_hmesh_BVH_leafdata_array,
-		source_hmesh_face_aabb_array, 0.0, multiplier);
+			*source_hmesh.get(),
+			source_hmesh_BVH_aabb_array,
+			source_hmesh_BVH_leafdata_array,
+			source_hmesh_face_aabb_array, 0.0, multiplier);
+	}
+	else
+	{
+		build_oibvh(
+#	if defined(MCUT_WITH_COMPUTE_HELPER_THREADPOOL)
+			context_ptr->get_shared_compute_threadpool(),
+#	endif
+			*source_hmesh.get(),
+			source_hmesh_BVH_aabb_array,
+			source_hmesh_BVH_leafdata_array,
+			source_hmesh_face_aabb_array, 0.0, multiplier);
+	}
 #else
 	BoundingVolumeHierarchy source_hmesh_BVH;
 	source_hmesh_BVH.buildTree(source_hmesh);
@@ -2545,6 +2718,11 @@ extern "C" void preproc(std::shared_ptr<context_t> context_ptr,
 	// the (translation) vector to hold the values with which we will
 	// carry out numerical perturbation of the cutting surface
 	vec3_<double> perturbation(0.0, 0.0, 0.0); // in native user coordinates
+	// seeded for each dispatch, so that the perturbations (and thus the output) only depend on the
+	// input meshes, and not on the thread running the dispatch or on the dispatches that ran before
+	std::default_random_engine random_engine(1);
+	std::mt19937 mersenne_twister_generator(random_engine());
+	std::uniform_real_distribution<double> uniform_distribution(-1.0, 1.0);
 
 	// RESOLVE mesh intersections
 	// ::::::::::::::::::::::::::
@@ -2618,11 +2796,6 @@ extern "C" void preproc(std::shared_ptr<context_t> context_ptr,
 
 			MCUT_ASSERT(relative_perturbation_constant !=  (0.0));
 
-			static thread_local std::default_random_engine random_engine(1);
-			static thread_local std::mt19937 mersenne_twister_generator(random_engine());
-			static thread_local std::uniform_real_distribution<double> uniform_distribution(-1.0,
-																							1.0);
-
 			for(int i = 0; i < 3; ++i)
 			{
 				perturbation[i] =  (uniform_distribution(mersenne_twister_generator)) *
@@ -2637,31 +2810,50 @@ extern "C" void preproc(std::shared_ptr<context_t> context_ptr,
 		   floating_polygon_was_detected == false)
 		{
 
-			// TODO: assume that re-adding elements (vertices and faces) is going to change the order
-			// from the user-provided order. So we still need to fix the mapping, which may no longer
-			// be one-to-one as in the case when things do not change.
-			cut_hmesh->reset();
-
-			// TODO: the number of cut-mesh faces and vertices may increase due to polygon partitioning
-			// Therefore: we need to perturb [the updated cut-mesh] i.e. the one containing partitioned polygons
-			// "pCutMeshFaces" are simply the user provided faces
-			// We must also use the newly added vertices (coords) due to polygon partitioning as "unperturbed" values
-			// This will require some intricate mapping
-			if(false == client_input_arrays_to_hmesh(
-							context_ptr,
-							dispatchFlags,
-							*cut_hmesh.get(),
-							pCutMeshVertices,
-							pCutMeshFaceIndices,
-							pCutMeshFaceSizes,
-							numCutMeshVertices,
-							numCutMeshFaces,
-							multiplier,
-							 srcmesh_cutmesh_com,
-							 pre_quantization_translation,
-							((cut_mesh_perturbation_count == 0) ? NULL : &perturbation)))
+			if(cut_topology)
+			{
+				TIMESTACK_PUSH("update cut-mesh vertices");
+				*cut_hmesh = *cut_topology->mesh;
+				update_hmesh_vertices_from_client_array(
+					context_ptr,
+					dispatchFlags,
+					*cut_hmesh.get(),
+					pCutMeshVertices,
+					numCutMeshVertices,
+					multiplier,
+					srcmesh_cutmesh_com,
+					pre_quantization_translation,
+					((cut_mesh_perturbation_count == 0) ? NULL : &perturbation));
+				TIMESTACK_POP();
+			}
+			else
 			{
-				throw std::invalid_argument("invalid cut-mesh arrays");
+				// TODO: assume that re-adding elements (vertices and faces) is going to change the order
+				// from the user-provided order. So we still need to fix the mapping, which may no longer
+				// be one-to-one as in the case when things do not change.
+				cut_hmesh->reset();
+
+				// TODO: the number of cut-mesh faces and vertices may increase due to polygon partitioning
+				// Therefore: we need to perturb [the updated cut-mesh] i.e. the one containing partitioned polygons
+				// "pCutMeshFaces" are simply the user provided faces
+				// We must also use the newly added vertices (coords) due to polygon partitioning as "unperturbed" values
+				// This will require some intricate mapping
+				if(false == client_input_arrays_to_hmesh(
+								context_ptr,
+								dispatchFlags,
+								*cut_hmesh.get(),
+								pCutMeshVertices,
+								pCutMeshFaceIndices,
+								pCutMeshFaceSizes,
+								numCutMeshVertices,
+								numCutMeshFaces,
+								multiplier,
+								srcmesh_cutmesh_com,
+								pre_quantization_translation,
+								((cut_mesh_perturbation_count == 0) ? NULL : &perturbation)))
+				{
+					throw std::invalid_argument("invalid cut-mesh arrays");
+				}
 			}
 
 			/*const*/ double perturbation_scalar =
@@ -2680,17 +2872,34 @@ extern "C" void preproc(std::shared_ptr<context_t> context_ptr,
 			if(cut_mesh_perturbation_count == 0)
 			{ // i.e. first time we are invoking kernel intersect function
 #if defined(USE_OIBVH)
-				cut_hmesh_BVH_aabb_array.clear();
-				cut_hmesh_BVH_leafdata_array.clear();
-				build_oibvh(
+				if(cut_topology)
+				{
+					cut_hmesh_BVH_leafdata_array = cut_topology->bvh_leaf_faces;
+					cut_hmesh_BVH_aabb_array.resize(get_ostensibly_implicit_bvh_size((int)numCutMeshFaces));
+					refit_oibvh(
 #	if defined(MCUT_WITH_COMPUTE_HELPER_THREADPOOL)
-					context_ptr->get_shared_compute_threadpool(),
+						context_ptr->get_shared_compute_threadpool(),
 #	endif
-					*cut_hmesh.get(),
-					cut_hmesh_BVH_aabb_array,
-					cut_hmesh_BVH_leafdata_array,
-					cut_hmesh_face_face_aabb_array,
-					relative_perturbation_constant, multiplier);
+						*cut_hmesh.get(),
+						cut_hmesh_BVH_aabb_array,
+						cut_hmesh_BVH_leafdata_array,
+						cut_hmesh_face_face_aabb_array,
+						relative_perturbation_constant, multiplier);
+				}
+				else
+				{
+					cut_hmesh_BVH_aabb_array.clear();
+					cut_hmesh_BVH_leafdata_array.clear();
+					build_oibvh(
+#	if defined(MCUT_WITH_COMPUTE_HELPER_THREADPOOL)
+						context_ptr->get_shared_compute_threadpool(),
+#	endif
+						*cut_hmesh.get(),
+						cut_hmesh_BVH_aabb_array,
+						cut_hmesh_BVH_leafdata_array,
+						cut_hmesh_face_face_aabb_array,
+						relative_perturbation_constant, multiplier);
+				}
 #else
 				cut_hmesh_BVH.buildTree(cut_hmesh, relative_perturbation_constant);
 #endif
@@ -2783,7 +2992,9 @@ extern "C" void preproc(std::shared_ptr<context_t> context_ptr,
 							MC_DEBUG_SEVERITY_NOTIFICATION,
 							"Check source-mesh for defects");
 
-		if(false == check_input_mesh(context_ptr, *source_hmesh.get()))
+		// the source-mesh was already checked before the loop and is unmodified on the first iteration
+		if(!trusted_input && kernel_invocation_counter > 0 &&
+		   false == check_input_mesh(context_ptr, *source_hmesh.get()))
 		{
 			throw std::invalid_argument("invalid source-mesh connectivity");
 		}
@@ -2794,7 +3005,9 @@ extern "C" void preproc(std::shared_ptr<context_t> context_ptr,
 							MC_DEBUG_SEVERITY_NOTIFICATION,
 							"Check cut-mesh for defects");
 
-		if(false == check_input_mesh(context_ptr, *cut_hmesh.get()))
+		// a reused cut-mesh topology was already checked (until it is modified by polygon partitioning)
+		if(!trusted_input && !(cut_topology && kernel_invocation_counter == 0) &&
+		   false == check_input_mesh(context_ptr, *cut_hmesh.get()))
 		{
 			throw std::invalid_argument("invalid cut-mesh connectivity");
 		}
@@ -2802,25 +3015,73 @@ extern "C" void preproc(std::shared_ptr<context_t> context_ptr,
 		if(kernel_invocation_counter == 0) // first iteration
 		{
 			TIMESTACK_PUSH("Check source mesh is closed");
-			sm_is_watertight = mesh_is_closed(
-#if 0 //defined(MCUT_WITH_COMPUTE_HELPER_THREADPOOL)
-                * input.scheduler,
+			if(source_topology)
+			{
+				sm_is_watertight = source_topology->is_watertight;
+			}
+			else
+			{
+				sm_is_watertight = trusted_input
+					? (dispatchFlags & MC_DISPATCH_HINT_SOURCEMESH_WATERTIGHT) != 0
+					: mesh_is_closed(
+#if defined(MCUT_WITH_COMPUTE_HELPER_THREADPOOL)
+						  *kernel_input.scheduler,
 #endif
-				*source_hmesh.get());
+						  *source_hmesh.get());
+			}
 
 			TIMESTACK_POP();
 
 			TIMESTACK_PUSH("Check cut mesh is closed");
-			cm_is_watertight = mesh_is_closed(
-#if 0 // defined(MCUT_WITH_COMPUTE_HELPER_THREADPOOL)
-                * input.scheduler,
+			if(cut_topology)
+			{
+				cm_is_watertight = cut_topology->is_watertight;
+			}
+			else
+			{
+				cm_is_watertight = trusted_input
+					? (dispatchFlags & MC_DISPATCH_HINT_CUTMESH_WATERTIGHT) != 0
+					: mesh_is_closed(
+#if defined(MCUT_WITH_COMPUTE_HELPER_THREADPOOL)
+						  *kernel_input.scheduler,
 #endif
-				*cut_hmesh.get());
+						  *cut_hmesh.get());
+			}
 
 			kernel_input.src_mesh_is_watertight = sm_is_watertight;
 			kernel_input.cut_mesh_is_watertight = cm_is_watertight;
 
 			TIMESTACK_POP();
+
+			// Both input meshes are validated and still unmodified at this point, so this is where
+			// their topologies are stored for later dispatches (see MC_DISPATCH_REUSE_..._TOPOLOGY)
+			if(reuse_source_topology && !source_topology)
+			{
+				std::shared_ptr<dispatch_input_topology_t> topology(new dispatch_input_topology_t);
+				topology->num_vertices = numSrcMeshVertices;
+				topology->num_faces = numSrcMeshFaces;
+				topology->faces_hash = source_faces_hash;
+				topology->mesh = std::shared_ptr<const hmesh_t>(new hmesh_t(*source_hmesh.get()));
+				topology->is_watertight = sm_is_watertight;
+#if defined(USE_OIBVH)
+				topology->bvh_leaf_faces = source_hmesh_BVH_leafdata_array;
+#endif
+				context_ptr->set_input_topology(dispatch_input_t::SOURCE_MESH, topology);
+			}
+
+			if(reuse_cut_topology && !cut_topology)
+			{
+				std::shared_ptr<dispatch_input_topology_t> topology(new dispatch_input_topology_t);
+				topology->num_vertices = numCutMeshVertices;
+				topology->num_faces = numCutMeshFaces;
+				topology->faces_hash = cut_faces_hash;
+				topology->mesh = std::shared_ptr<const hmesh_t>(new hmesh_t(*cut_hmesh.get()));
+				topology->is_watertight = cm_is_watertight;
+#if defined(USE_OIBVH)
+				topology->bvh_leaf_faces = cut_hmesh_BVH_leafdata_array;
+#endif
+				context_ptr->set_input_topology(dispatch_input_t::CUT_MESH, topology);
+			}
 		}
 
 		if(source_or_cut_hmesh_BVH_rebuilt)
@@ -3039,7 +3300,7 @@ extern "C" void preproc(std::shared_ptr<context_t> context_ptr,
 				MCUT_ASSERT(asFragPtr != nullptr);
 
 				asFragPtr->m_user_handle = reinterpret_cast<McConnectedComponent>(
-					g_objects_counter.fetch_add(1, std::memory_order_relaxed));
+					context_ptr->connected_components.reserve());
 				asFragPtr->type = MC_CONNECTED_COMPONENT_TYPE_FRAGMENT;
 				asFragPtr->fragmentLocation = convert(i->first);
 				asFragPtr->patchLocation = convert(j->first);
@@ -3073,8 +3334,8 @@ extern "C" void preproc(std::shared_ptr<context_t> context_ptr,
 				asFragPtr->pre_quantization_translation = pre_quantization_translation;
 #endif
 
-				context_ptr->connected_components.push_front(
-					cc_ptr); // copy the connected component ptr into the context object
+				context_ptr->connected_components.publish(
+					cc_ptr->m_user_handle, cc_ptr); // copy the connected component ptr into the context object
 
 				numConnectedComponentsCreated += 1;
 			}
@@ -3109,7 +3370,7 @@ extern "C" void preproc(std::shared_ptr<context_t> context_ptr,
 			MCUT_ASSERT(asFragPtr != nullptr);
 
 			asFragPtr->m_user_handle = reinterpret_cast<McConnectedComponent>(
-				g_objects_counter.fetch_add(1, std::memory_order_relaxed));
+				context_ptr->connected_components.reserve());
 
 			asFragPtr->type = MC_CONNECTED_COMPONENT_TYPE_FRAGMENT;
 			asFragPtr->fragmentLocation = convert(i->first);
@@ -3140,8 +3401,8 @@ extern "C" void preproc(std::shared_ptr<context_t> context_ptr,
 			asFragPtr->pre_quantization_translation = pre_quantization_translation;
 #endif
 
-			context_ptr->connected_components.push_front(
-				cc_ptr); // copy the connected component ptr into the context object
+			context_ptr->connected_components.publish(
+				cc_ptr->m_user_handle, cc_ptr); // copy the connected component ptr into the context object
 
 			numConnectedComponentsCreated += 1;
 		}
@@ -3169,7 +3430,7 @@ extern "C" void preproc(std::shared_ptr<context_t> context_ptr,
 		MCUT_ASSERT(asPatchPtr != nullptr);
 
 		asPatchPtr->m_user_handle = reinterpret_cast<McConnectedComponent>(
-			g_objects_counter.fetch_add(1, std::memory_order_relaxed));
+			context_ptr->connected_components.reserve());
 #if 0
         // std::shared_ptr<connected_component_t> patchConnComp = std::unique_ptr<patch_cc_t, void (*)(connected_component_t*)>(new patch_cc_t, fn_delete_cc<patch_cc_t>);
         // McConnectedComponent clientHandle = reinterpret_cast<McConnectedComponent>(patchConnComp.get());
@@ -3210,8 +3471,8 @@ extern "C" void preproc(std::shared_ptr<context_t> context_ptr,
 		asPatchPtr->srcmesh_cutmesh_com = srcmesh_cutmesh_com;
 		asPatchPtr->pre_quantization_translation = pre_quantization_translation;
 #endif
-		context_ptr->connected_components.push_front(
-			cc_ptr); // copy the connected component ptr into the context object
+		context_ptr->connected_components.publish(
+			cc_ptr->m_user_handle, cc_ptr); // copy the connected component ptr into the context object
 
 		numConnectedComponentsCreated += 1;
 	}
@@ -3237,7 +3498,7 @@ extern "C" void preproc(std::shared_ptr<context_t> context_ptr,
 		MCUT_ASSERT(asPatchPtr != nullptr);
 
 		asPatchPtr->m_user_handle = reinterpret_cast<McConnectedComponent>(
-			g_objects_counter.fetch_add(1, std::memory_order_relaxed));
+			context_ptr->connected_components.reserve());
 #if 0
         /// std::shared_ptr<connected_component_t> patchConnComp = std::unique_ptr<patch_cc_t, void (*)(connected_component_t*)>(new patch_cc_t, fn_delete_cc<patch_cc_t>);
         // McConnectedComponent clientHandle = reinterpret_cast<McConnectedComponent>(patchConnComp.get());
@@ -3278,8 +3539,8 @@ extern "C" void preproc(std::shared_ptr<context_t> context_ptr,
 		asPatchPtr->pre_quantization_translation = pre_quantization_translation;
 #endif
 
-		context_ptr->connected_components.push_front(
-			cc_ptr); // copy the connected component ptr into the context object
+		context_ptr->connected_components.publish(
+			cc_ptr->m_user_handle, cc_ptr); // copy the connected component ptr into the context object
 
 		numConnectedComponentsCreated += 1;
 	}
@@ -3307,7 +3568,7 @@ extern "C" void preproc(std::shared_ptr<context_t> context_ptr,
 		MCUT_ASSERT(asSrcMeshSeamPtr != nullptr);
 
 		asSrcMeshSeamPtr->m_user_handle = reinterpret_cast<McConnectedComponent>(
-			g_objects_counter.fetch_add(1, std::memory_order_relaxed));
+			context_ptr->connected_components.reserve());
 #if 0
         // std::shared_ptr<connected_component_t> srcMeshSeam = std::unique_ptr<seam_cc_t, void (*)(connected_component_t*)>(new seam_cc_t, fn_delete_cc<seam_cc_t>);
         // McConnectedComponent clientHandle = reinterpret_cast<McConnectedComponent>(srcMeshSeam.get());
@@ -3351,8 +3612,8 @@ extern "C" void preproc(std::shared_ptr<context_t> context_ptr,
 		asSrcMeshSeamPtr->pre_quantization_translation = pre_quantization_translation;
 #endif
 
-		context_ptr->connected_components.push_front(
-			cc_ptr); // copy the connected component ptr into the context object
+		context_ptr->connected_components.publish(
+			cc_ptr->m_user_handle, cc_ptr); // copy the connected component ptr into the context object
 
 		numConnectedComponentsCreated += 1;
 
@@ -3376,7 +3637,7 @@ extern "C" void preproc(std::shared_ptr<context_t> context_ptr,
 		MCUT_ASSERT(asCutMeshSeamPtr != nullptr);
 
 		asCutMeshSeamPtr->m_user_handle = reinterpret_cast<McConnectedComponent>(
-			g_objects_counter.fetch_add(1, std::memory_order_relaxed));
+			context_ptr->connected_components.reserve());
 #if 0
         // std::shared_ptr<connected_component_t> cutMeshSeam = std::unique_ptr<seam_cc_t, void (*)(connected_component_t*)>(new seam_cc_t, fn_delete_cc<seam_cc_t>);
         // McConnectedComponent clientHandle = reinterpret_cast<McConnectedComponent>(cutMeshSeam.get());
@@ -3418,8 +3679,8 @@ extern "C" void preproc(std::shared_ptr<context_t> context_ptr,
 		asCutMeshSeamPtr->pre_quantization_translation = pre_quantization_translation;
 #endif
 
-		context_ptr->connected_components.push_front(
-			cc_ptr); // copy the connected component ptr into the context object
+		context_ptr->connected_components.publish(
+			cc_ptr->m_user_handle, cc_ptr); // copy the connected component ptr into the context object
 
 		numConnectedComponentsCreated += 1;
 
@@ -3444,7 +3705,7 @@ extern "C" void preproc(std::shared_ptr<context_t> context_ptr,
 		MCUT_ASSERT(asCutMeshInputPtr != nullptr);
 
 		asCutMeshInputPtr->m_user_handle = reinterpret_cast<McConnectedComponent>(
-			g_objects_counter.fetch_add(1, std::memory_order_relaxed));
+			context_ptr->connected_components.reserve());
 
 #if 0
         // std::shared_ptr<connected_component_t> internalCutMesh = std::unique_ptr<input_cc_t, void (*)(connected_component_t*)>(new input_cc_t, fn_delete_cc<input_cc_t>);
@@ -3553,8 +3814,8 @@ extern "C" void preproc(std::shared_ptr<context_t> context_ptr,
 		asCutMeshInputPtr->pre_quantization_translation = pre_quantization_translation;
 #endif
 
-		context_ptr->connected_components.push_front(
-			cc_ptr); // copy the connected component ptr into the context object
+		context_ptr->connected_components.publish(
+			cc_ptr->m_user_handle, cc_ptr); // copy the connected component ptr into the context object
 
 		numConnectedComponentsCreated += 1;
 
@@ -3577,7 +3838,7 @@ extern "C" void preproc(std::shared_ptr<context_t> context_ptr,
 		MCUT_ASSERT(asSrcMeshInputPtr != nullptr);
 
 		asSrcMeshInputPtr->m_user_handle = reinterpret_cast<McConnectedComponent>(
-			g_objects_counter.fetch_add(1, std::memory_order_relaxed));
+			context_ptr->connected_components.reserve());
 
 #if 0
         // std::shared_ptr<connected_component_t> internalSrcMesh = std::unique_ptr<input_cc_t, void (*)(connected_component_t*)>(new input_cc_t, fn_delete_cc<input_cc_t>);
@@ -3679,8 +3940,8 @@ extern "C" void preproc(std::shared_ptr<context_t> context_ptr,
 		asSrcMeshInputPtr->pre_quantization_translation = pre_quantization_translation;
 #endif
 
-		context_ptr->connected_components.push_front(
-			cc_ptr); // copy the connected component ptr into the context object
+		context_ptr->connected_components.publish(
+			cc_ptr->m_user_handle, cc_ptr); // copy the connected component ptr into the context object
 
 		numConnectedComponentsCreated += 1;
 
@@ -0,0 +1,57 @@
+/***************************************************************************
+ *
+ *  Copyright (C) 2024 CutDigital Enterprise Ltd
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  For your convenience, a copy of the License has been included in this
+ *  repository.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.WE
+ *
+ **************************************************************************/
+
+
+#ifndef __MIO_GLB_H__
+#define __MIO_GLB_H__  1
+
+#ifdef __cplusplus
+extern "C" {
+#endif // #ifdef __cplusplus
+
+/*
+    Funcion to read in a binary glTF 2.0 (.glb) file. The triangle primitives of
+    every mesh instanced by the default scene are merged into one mesh, with the
+    node transforms applied. Only the embedded binary buffer is supported: files
+    that need external buffers or compression extensions (Draco, meshopt) are
+    rejected. The file is memory-mapped and the accessors are converted in
+    parallel.
+    The pointer parameters will be allocated inside this function and must be
+    freed by caller. Returns 0 on success and a non-zero value on failure.
+*/
+int mioReadGLB(
+    // absolute path to file
+    const char* fpath,
+    // pointer to list of vertex coordinates stored as [xyz,xyz,xyz,...]
+    double** pVertices,
+    // pointer to list of face-vertex indices stored as [ijk,ijk,ijk,...]
+    unsigned int** pFaceVertexIndices,
+    // pointer to list of face sizes (all 3)
+    unsigned int** pFaceSizes,
+    // number of vertices in "pVertices"
+    unsigned int* numVertices,
+    // number of faces (number of elements in "pFaceSizes")
+    unsigned int* numFaces);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif // #ifdef __cplusplus
+
+#endif // #ifndef __MIO_GLB_H__
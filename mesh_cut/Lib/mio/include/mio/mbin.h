@@ -0,0 +1,119 @@
+/***************************************************************************
+ *
+ *  Copyright (C) 2024 CutDigital Enterprise Ltd
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  For your convenience, a copy of the License has been included in this
+ *  repository.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.WE
+ *
+ **************************************************************************/
+
+#ifndef __MIO_MBIN_H__
+#define __MIO_MBIN_H__  1
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif // #ifdef __cplusplus
+
+/*
+    Version of the .mbin container. Files with another version (or written on a
+    machine with a different byte order) are rejected by "mioMapMBIN", so callers
+    can simply regenerate them.
+
+    Layout: a 64-byte header, a table of sections and the section payloads, each
+    payload starting at a 64-byte aligned offset so that it can be used in-place
+    once the file is memory-mapped.
+*/
+#define MIO_MBIN_VERSION 1
+
+// a mesh stored in a memory-mapped .mbin file
+// NOTE: the pointers reference the mapping and become invalid after "mioUnmapMBIN"
+typedef struct MioMappedMesh
+{
+	// vertex coordinates stored as [xyz,xyz,xyz,...]
+	double* pVertices;
+	// per-vertex normals stored as [xyz,xyz,xyz,...] (NULL if not stored)
+	double* pNormals;
+	// face sizes stored as [a,b,c,...] (NULL if every face is a triangle)
+	unsigned int* pFaceSizes;
+	// face-vertex indices stored as [ijkl,ijk,ijkl,ijklmn,ijk,...]
+	unsigned int* pFaceVertexIndices;
+	// faces incident to each vertex in CSR form: the faces of vertex v are
+	// pVertexFaces[pVertexFaceOffsets[v] .. pVertexFaceOffsets[v + 1]] (NULL if not stored)
+	unsigned int* pVertexFaceOffsets;
+	unsigned int* pVertexFaces;
+
+	unsigned int numVertices;
+	unsigned int numFaces;
+	// number of elements in "pFaceVertexIndices"
+	unsigned int numFaceVertexIndices;
+
+	// opaque values given to "mioWriteMBIN", e.g. the size and modification
+	// time of the file the cache was converted from
+	unsigned long long sourceStamp[2];
+
+	// the mapping itself
+	void* pMapping;
+	size_t mappingSize;
+} MioMappedMesh;
+
+/*
+    Function to write out a .mbin file. Pass NULL to omit the optional sections
+    (normals, face sizes of an all-triangle mesh and the vertex-face map).
+    Returns 0 on success and a non-zero value if the file could not be written.
+*/
+int mioWriteMBIN(
+    // absolute path to file
+    const char* fpath,
+    // pointer to list of vertex coordinates stored as [xyz,xyz,xyz,...]
+    const double* pVertices,
+    // pointer to list of per-vertex normals stored as [xyz,xyz,xyz,...] (optional)
+    const double* pNormals,
+    // pointer to list of face sizes stored as [a,b,c,d,e,f,g,...] (optional, NULL for triangles)
+    const unsigned int* pFaceSizes,
+    // pointer to list of face-vertex indices stored as [ijkl,ijk,ijkl,ijklmn,ijk,...]
+    const unsigned int* pFaceVertexIndices,
+    // pointer to the numVertices + 1 offsets of the vertex-face map (optional)
+    const unsigned int* pVertexFaceOffsets,
+    // pointer to the faces of the vertex-face map (optional)
+    const unsigned int* pVertexFaces,
+    // number of vertices in "pVertices"
+    unsigned int numVertices,
+    // number of faces
+    unsigned int numFaces,
+    // two values stored as-is in the header
+    const unsigned long long sourceStamp[2]);
+
+/*
+    Function to memory-map a .mbin file. The pages are mapped copy-on-write, so
+    the arrays may be modified without touching the file. Nothing is read
+    until the arrays are accessed.
+    Returns 0 on success, and a non-zero value (leaving "pMesh" zeroed) if the
+    file is missing, truncated or of another version.
+*/
+int mioMapMBIN(
+    // absolute path to file
+    const char* fpath,
+    // mesh that receives the mapped arrays
+    MioMappedMesh* pMesh);
+
+// Unmaps a mesh mapped by "mioMapMBIN" and zeroes it
+void mioUnmapMBIN(MioMappedMesh* pMesh);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif // #ifdef __cplusplus
+
+#endif // #ifndef __MIO_MBIN_H__
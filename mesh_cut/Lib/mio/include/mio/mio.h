@@ -25,8 +25,11 @@
 extern "C" {
 #endif // #ifdef __cplusplus
     
+#include "mio/glb.h"
+#include "mio/mbin.h"
 #include "mio/obj.h"
 #include "mio/off.h"
+#include "mio/ply.h"
 #include "mio/stl.h"
 
 #if defined(_WIN32)
@@ -60,9 +63,14 @@ typedef struct MioMesh
 }MioMesh;
 
 /*
-    Function to read in a mesh file. Supported file formats are .obj and .off
+    Function to read in a mesh file, choosing the reader from the (case-insensitive)
+    file extension. Supported file formats are .obj, .off, .ply (binary
+    little-endian) and .glb. The pointer parameters will be allocated inside this
+    function and must be freed by caller.
+    Returns 0 on success and a non-zero value if the file could not be read or
+    has an unsupported extension.
 */
-void mioRead(
+int mioRead(
     // absolute path to file
     const char* fpath,
     // pointer to list of vertex coordinates stored as [xyz,xyz,xyz,...]
@@ -31,9 +31,10 @@ extern "C" {
     be freed by caller. The function only handles polygonal faces, so commands like
     "vp" command (which is used to specify control points of the surface or curve)
     are ignored if encountered in file.
-
+    Returns 0 on success, and a non-zero value (leaving the pointers NULL) if the
+    file cannot be opened or is malformed.
 */
-void mioReadOBJ(
+int mioReadOBJ(
     // absolute path to file
     const char* fpath,
     // pointer to list of vertex coordinates stored as [xyz,xyz,xyz,...]
@@ -29,8 +29,10 @@ extern "C" {
     Funcion to read in an .off file that stores a single 3D mesh object (in ASCII
     format). The pointer parameters will be allocated inside this function and must
     be freed by caller.
+    Returns 0 on success, and a non-zero value (leaving the pointers NULL) if the
+    file cannot be opened or is malformed.
 */
-void mioReadOFF(
+int mioReadOFF(
     // absolute path to file
     const char* fpath,
     // pointer to list of vertex coordinates stored as [xyz,xyz,xyz,...]
@@ -0,0 +1,56 @@
+/***************************************************************************
+ *
+ *  Copyright (C) 2024 CutDigital Enterprise Ltd
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  For your convenience, a copy of the License has been included in this
+ *  repository.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.WE
+ *
+ **************************************************************************/
+
+
+#ifndef __MIO_PLY_H__
+#define __MIO_PLY_H__  1
+
+#ifdef __cplusplus
+extern "C" {
+#endif // #ifdef __cplusplus
+
+/*
+    Funcion to read in a binary little-endian .ply file that stores a single 3D
+    mesh object. Only the x/y/z properties of the "vertex" element and the
+    "vertex_indices" (or "vertex_index") list of the "face" element are read,
+    every other element and property is skipped. The file is memory-mapped and
+    the attributes are converted in parallel.
+    The pointer parameters will be allocated inside this function and must be
+    freed by caller. Returns 0 on success and a non-zero value on failure.
+*/
+int mioReadPLY(
+    // absolute path to file
+    const char* fpath,
+    // pointer to list of vertex coordinates stored as [xyz,xyz,xyz,...]
+    double** pVertices,
+    // pointer to list of face-vertex indices stored as [ijkl,ijk,ijkl,ijklmn,ijk,...]
+    unsigned int** pFaceVertexIndices,
+    // pointer to list of face sizes (number of vertices in each face) stored as [a,b,c,d,e,f,g,...]
+    unsigned int** pFaceSizes,
+    // number of vertices in "pVertices"
+    unsigned int* numVertices,
+    // number of faces (number of elements in "pFaceSizes")
+    unsigned int* numFaces);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif // #ifdef __cplusplus
+
+#endif // #ifndef __MIO_PLY_H__
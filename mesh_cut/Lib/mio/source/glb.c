@@ -0,0 +1,907 @@
+/***************************************************************************
+ *
+ *  Copyright (C) 2024 CutDigital Enterprise Ltd
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  For your convenience, a copy of the License has been included in this
+ *  repository.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.WE
+ *
+ **************************************************************************/
+
+
+#include "mio/glb.h"
+#include "mapping.h"
+
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define GLB_MAGIC 0x46546C67u // "glTF"
+#define GLB_CHUNK_JSON 0x4E4F534Au
+#define GLB_CHUNK_BIN 0x004E4942u
+#define GLTF_MODE_TRIANGLES 4
+#define GLTF_FLOAT 5126
+#define GLTF_UNSIGNED_BYTE 5121
+#define GLTF_UNSIGNED_SHORT 5123
+#define GLTF_UNSIGNED_INT 5125
+#define GLTF_MAX_DEPTH 64
+
+// ---------------------------------------------------------------------------
+// minimal JSON DOM, nodes refer to each other by index and strings point into
+// the (unescaped) source text, which is enough for the ASCII keys of glTF
+// ---------------------------------------------------------------------------
+
+typedef enum JsonType
+{
+	JSON_NULL = 0,
+	JSON_BOOL,
+	JSON_NUMBER,
+	JSON_STRING,
+	JSON_ARRAY,
+	JSON_OBJECT
+} JsonType;
+
+typedef struct JsonNode
+{
+	JsonType type;
+	double number;
+	const char* str;
+	size_t strLength;
+	const char* key;
+	size_t keyLength;
+	int firstChild;
+	int nextSibling;
+	int numChildren;
+} JsonNode;
+
+typedef struct JsonDoc
+{
+	JsonNode* nodes;
+	int numNodes;
+	int capacity;
+	const char* text;
+	size_t length;
+	size_t pos;
+} JsonDoc;
+
+static void jsonSkipSpace(JsonDoc* doc)
+{
+	while(doc->pos < doc->length && (doc->text[doc->pos] == ' ' || doc->text[doc->pos] == '\t' || doc->text[doc->pos] == '\n' || doc->text[doc->pos] == '\r'))
+	{
+		doc->pos++;
+	}
+}
+
+static int jsonNewNode(JsonDoc* doc, JsonType type)
+{
+	if(doc->numNodes == doc->capacity)
+	{
+		const int capacity = doc->capacity > 0 ? doc->capacity * 2 : 256;
+		JsonNode* nodes = (JsonNode*)realloc(doc->nodes, sizeof(JsonNode) * capacity);
+		if(nodes == NULL)
+		{
+			return -1;
+		}
+		doc->nodes = nodes;
+		doc->capacity = capacity;
+	}
+	JsonNode* pNode = &doc->nodes[doc->numNodes];
+	memset(pNode, 0, sizeof(*pNode));
+	pNode->type = type;
+	pNode->firstChild = -1;
+	pNode->nextSibling = -1;
+	return doc->numNodes++;
+}
+
+// scans a string starting at the opening quote, returns 0 if it is unterminated
+static int jsonScanString(JsonDoc* doc, const char** pStr, size_t* pLength)
+{
+	const size_t start = ++doc->pos;
+	while(doc->pos < doc->length && doc->text[doc->pos] != '"')
+	{
+		doc->pos += doc->text[doc->pos] == '\\' ? 2 : 1;
+	}
+	if(doc->pos >= doc->length)
+	{
+		return 0;
+	}
+	*pStr = doc->text + start;
+	*pLength = doc->pos - start;
+	doc->pos++; // closing quote
+	return 1;
+}
+
+static int jsonParseValue(JsonDoc* doc, int depth);
+
+static int jsonParseContainer(JsonDoc* doc, int depth, JsonType type)
+{
+	const char close = type == JSON_ARRAY ? ']' : '}';
+	const int node = jsonNewNode(doc, type);
+	int lastChild = -1;
+
+	if(node < 0)
+	{
+		return -1;
+	}
+	doc->pos++; // opening bracket
+	jsonSkipSpace(doc);
+	if(doc->pos < doc->length && doc->text[doc->pos] == close)
+	{
+		doc->pos++;
+		return node;
+	}
+
+	while(doc->pos < doc->length)
+	{
+		const char* key = NULL;
+		size_t keyLength = 0;
+		if(type == JSON_OBJECT)
+		{
+			jsonSkipSpace(doc);
+			if(doc->pos >= doc->length || doc->text[doc->pos] != '"' || !jsonScanString(doc, &key, &keyLength))
+			{
+				return -1;
+			}
+			jsonSkipSpace(doc);
+			if(doc->pos >= doc->length || doc->text[doc->pos] != ':')
+			{
+				return -1;
+			}
+			doc->pos++;
+		}
+
+		const int child = jsonParseValue(doc, depth + 1);
+		if(child < 0)
+		{
+			return -1;
+		}
+		doc->nodes[child].key = key;
+		doc->nodes[child].keyLength = keyLength;
+		if(lastChild < 0)
+		{
+			doc->nodes[node].firstChild = child;
+		}
+		else
+		{
+			doc->nodes[lastChild].nextSibling = child;
+		}
+		lastChild = child;
+		doc->nodes[node].numChildren++;
+
+		jsonSkipSpace(doc);
+		if(doc->pos >= doc->length)
+		{
+			return -1;
+		}
+		if(doc->text[doc->pos] == ',')
+		{
+			doc->pos++;
+			continue;
+		}
+		if(doc->text[doc->pos] == close)
+		{
+			doc->pos++;
+			return node;
+		}
+		return -1;
+	}
+	return -1;
+}
+
+static int jsonParseValue(JsonDoc* doc, int depth)
+{
+	if(depth > GLTF_MAX_DEPTH)
+	{
+		return -1;
+	}
+	jsonSkipSpace(doc);
+	if(doc->pos >= doc->length)
+	{
+		return -1;
+	}
+
+	const char c = doc->text[doc->pos];
+	if(c == '{')
+	{
+		return jsonParseContainer(doc, depth, JSON_OBJECT);
+	}
+	if(c == '[')
+	{
+		return jsonParseContainer(doc, depth, JSON_ARRAY);
+	}
+	if(c == '"')
+	{
+		const int node = jsonNewNode(doc, JSON_STRING);
+		if(node < 0 || !jsonScanString(doc, &doc->nodes[node].str, &doc->nodes[node].strLength))
+		{
+			return -1;
+		}
+		return node;
+	}
+	if(c == 't' || c == 'f' || c == 'n')
+	{
+		const char* word = c == 't' ? "true" : (c == 'f' ? "false" : "null");
+		const size_t wordLength = strlen(word);
+		if(doc->length - doc->pos < wordLength || strncmp(doc->text + doc->pos, word, wordLength) != 0)
+		{
+			return -1;
+		}
+		doc->pos += wordLength;
+		const int node = jsonNewNode(doc, c == 'n' ? JSON_NULL : JSON_BOOL);
+		if(node >= 0)
+		{
+			doc->nodes[node].number = c == 't' ? 1.0 : 0.0;
+		}
+		return node;
+	}
+
+	// the text is not null-terminated, copy the number before converting it
+	char buffer[64];
+	size_t length = 0;
+	while(doc->pos + length < doc->length && length + 1 < sizeof(buffer) && strchr("+-0123456789.eE", doc->text[doc->pos + length]) != NULL)
+	{
+		buffer[length] = doc->text[doc->pos + length];
+		length++;
+	}
+	buffer[length] = '\0';
+	char* end = NULL;
+	const double number = strtod(buffer, &end);
+	if(length == 0 || end != buffer + length)
+	{
+		return -1;
+	}
+	doc->pos += length;
+	const int node = jsonNewNode(doc, JSON_NUMBER);
+	if(node >= 0)
+	{
+		doc->nodes[node].number = number;
+	}
+	return node;
+}
+
+static int jsonMember(const JsonDoc* doc, int node, const char* key)
+{
+	if(node < 0 || doc->nodes[node].type != JSON_OBJECT)
+	{
+		return -1;
+	}
+	const size_t keyLength = strlen(key);
+	int child = 0;
+	for(child = doc->nodes[node].firstChild; child >= 0; child = doc->nodes[child].nextSibling)
+	{
+		if(doc->nodes[child].keyLength == keyLength && strncmp(doc->nodes[child].key, key, keyLength) == 0)
+		{
+			return child;
+		}
+	}
+	return -1;
+}
+
+static double jsonNumber(const JsonDoc* doc, int node, double defaultValue)
+{
+	return node >= 0 && doc->nodes[node].type == JSON_NUMBER ? doc->nodes[node].number : defaultValue;
+}
+
+static int jsonStringEquals(const JsonDoc* doc, int node, const char* str)
+{
+	return node >= 0 && doc->nodes[node].type == JSON_STRING && doc->nodes[node].strLength == strlen(str) &&
+		   strncmp(doc->nodes[node].str, str, doc->nodes[node].strLength) == 0;
+}
+
+// table of the children of an array, for indexed access; NULL if "node" is
+// not an array (or empty)
+static int* jsonArrayTable(const JsonDoc* doc, int node, int* pCount)
+{
+	*pCount = 0;
+	if(node < 0 || doc->nodes[node].type != JSON_ARRAY || doc->nodes[node].numChildren == 0)
+	{
+		return NULL;
+	}
+	int* table = (int*)malloc(sizeof(int) * doc->nodes[node].numChildren);
+	if(table == NULL)
+	{
+		return NULL;
+	}
+	int child = 0;
+	for(child = doc->nodes[node].firstChild; child >= 0; child = doc->nodes[child].nextSibling)
+	{
+		table[(*pCount)++] = child;
+	}
+	return table;
+}
+
+// ---------------------------------------------------------------------------
+// glTF
+// ---------------------------------------------------------------------------
+
+typedef struct GltfArray
+{
+	int* items;
+	int count;
+} GltfArray;
+
+typedef struct GltfDoc
+{
+	JsonDoc json;
+	int root;
+	GltfArray accessors;
+	GltfArray bufferViews;
+	GltfArray buffers;
+	GltfArray meshes;
+	GltfArray nodes;
+	const unsigned char* bin;
+	size_t binSize;
+	const char* fpath;
+} GltfDoc;
+
+typedef struct GltfAccessor
+{
+	const unsigned char* data;
+	size_t stride;
+	uint64_t count;
+	int componentType;
+} GltfAccessor;
+
+// one triangle primitive of one mesh instance
+typedef struct GltfPiece
+{
+	GltfAccessor positions;
+	GltfAccessor indices;
+	int indexed;
+	double matrix[16];
+	int flipWinding;
+	uint64_t vertexOffset;
+	uint64_t indexOffset;
+} GltfPiece;
+
+typedef struct GltfPieceList
+{
+	GltfPiece* items;
+	size_t count;
+	size_t capacity;
+} GltfPieceList;
+
+static int gltfItem(const GltfArray* array, double index)
+{
+	if(index < 0 || index >= array->count || index != floor(index))
+	{
+		return -1;
+	}
+	return array->items[(int)index];
+}
+
+static size_t componentSize(int componentType)
+{
+	switch(componentType)
+	{
+	case GLTF_UNSIGNED_BYTE:
+		return 1;
+	case GLTF_UNSIGNED_SHORT:
+		return 2;
+	case GLTF_UNSIGNED_INT:
+	case GLTF_FLOAT:
+		return 4;
+	default:
+		return 0;
+	}
+}
+
+// resolves an accessor to a strided view into the binary chunk
+static int gltfAccessor(const GltfDoc* doc, double accessorIndex, const char* expectedType, GltfAccessor* pAccessor)
+{
+	const JsonDoc* json = &doc->json;
+	const int accessor = gltfItem(&doc->accessors, accessorIndex);
+	if(accessor < 0 || !jsonStringEquals(json, jsonMember(json, accessor, "type"), expectedType))
+	{
+		fprintf(stderr, "error: invalid glTF accessor in `%s`\n", doc->fpath);
+		return 1;
+	}
+	if(jsonMember(json, accessor, "sparse") >= 0)
+	{
+		fprintf(stderr, "error: sparse glTF accessors are not supported in `%s`\n", doc->fpath);
+		return 1;
+	}
+
+	const int view = gltfItem(&doc->bufferViews, jsonNumber(json, jsonMember(json, accessor, "bufferView"), -1));
+	const int buffer = view < 0 ? -1 : gltfItem(&doc->buffers, jsonNumber(json, jsonMember(json, view, "buffer"), -1));
+	if(buffer < 0 || jsonMember(json, buffer, "uri") >= 0 || doc->bin == NULL)
+	{
+		fprintf(stderr, "error: glTF accessor outside the embedded buffer in `%s`\n", doc->fpath);
+		return 1;
+	}
+
+	const size_t numComponents = strcmp(expectedType, "VEC3") == 0 ? 3 : 1;
+	pAccessor->componentType = (int)jsonNumber(json, jsonMember(json, accessor, "componentType"), 0);
+	pAccessor->count = (uint64_t)jsonNumber(json, jsonMember(json, accessor, "count"), 0);
+
+	const size_t elementSize = numComponents * componentSize(pAccessor->componentType);
+	const double viewOffset = jsonNumber(json, jsonMember(json, view, "byteOffset"), 0);
+	const double viewLength = jsonNumber(json, jsonMember(json, view, "byteLength"), 0);
+	const double accessorOffset = jsonNumber(json, jsonMember(json, accessor, "byteOffset"), 0);
+	const double stride = jsonNumber(json, jsonMember(json, view, "byteStride"), (double)elementSize);
+
+	// the extent of the last element must lie inside both the view and the chunk
+	const double extent = accessorOffset + (pAccessor->count > 0 ? (double)(pAccessor->count - 1) * stride + elementSize : 0.0);
+	if(elementSize == 0 || stride < elementSize || viewOffset < 0 || accessorOffset < 0 || extent > viewLength ||
+	   viewOffset + viewLength > (double)doc->binSize)
+	{
+		fprintf(stderr, "error: glTF accessor out of bounds in `%s`\n", doc->fpath);
+		return 1;
+	}
+
+	pAccessor->data = doc->bin + (size_t)viewOffset + (size_t)accessorOffset;
+	pAccessor->stride = (size_t)stride;
+	return 0;
+}
+
+static void multiplyMatrix(const double* a, const double* b, double* result)
+{
+	// column-major, result = a * b
+	int r = 0;
+	int c = 0;
+	int k = 0;
+	for(c = 0; c < 4; ++c)
+	{
+		for(r = 0; r < 4; ++r)
+		{
+			double sum = 0.0;
+			for(k = 0; k < 4; ++k)
+			{
+				sum += a[k * 4 + r] * b[c * 4 + k];
+			}
+			result[c * 4 + r] = sum;
+		}
+	}
+}
+
+static void nodeMatrix(const JsonDoc* json, int node, double* matrix)
+{
+	int i = 0;
+	const int matrixNode = jsonMember(json, node, "matrix");
+	if(matrixNode >= 0 && json->nodes[matrixNode].numChildren == 16)
+	{
+		int child = json->nodes[matrixNode].firstChild;
+		for(i = 0; i < 16; ++i, child = json->nodes[child].nextSibling)
+		{
+			matrix[i] = jsonNumber(json, child, 0.0);
+		}
+		return;
+	}
+
+	double t[3] = {0.0, 0.0, 0.0};
+	double q[4] = {0.0, 0.0, 0.0, 1.0};
+	double s[3] = {1.0, 1.0, 1.0};
+	const char* keys[3] = {"translation", "rotation", "scale"};
+	double* values[3] = {t, q, s};
+	const int sizes[3] = {3, 4, 3};
+	int j = 0;
+	for(j = 0; j < 3; ++j)
+	{
+		const int array = jsonMember(json, node, keys[j]);
+		if(array >= 0 && json->nodes[array].numChildren == sizes[j])
+		{
+			int child = json->nodes[array].firstChild;
+			for(i = 0; i < sizes[j]; ++i, child = json->nodes[child].nextSibling)
+			{
+				values[j][i] = jsonNumber(json, child, values[j][i]);
+			}
+		}
+	}
+
+	// T * R * S, with R from the unit quaternion (x, y, z, w)
+	const double x = q[0], y = q[1], z = q[2], w = q[3];
+	const double rotation[9] = {
+		1 - 2 * (y * y + z * z), 2 * (x * y + z * w), 2 * (x * z - y * w),
+		2 * (x * y - z * w), 1 - 2 * (x * x + z * z), 2 * (y * z + x * w),
+		2 * (x * z + y * w), 2 * (y * z - x * w), 1 - 2 * (x * x + y * y)};
+	int c = 0;
+	int r = 0;
+	for(c = 0; c < 3; ++c)
+	{
+		for(r = 0; r < 3; ++r)
+		{
+			matrix[c * 4 + r] = rotation[c * 3 + r] * s[c];
+		}
+		matrix[c * 4 + 3] = 0.0;
+	}
+	matrix[12] = t[0];
+	matrix[13] = t[1];
+	matrix[14] = t[2];
+	matrix[15] = 1.0;
+}
+
+static int appendPiece(GltfPieceList* list, const GltfPiece* pPiece)
+{
+	if(list->count == list->capacity)
+	{
+		const size_t capacity = list->capacity > 0 ? list->capacity * 2 : 16;
+		GltfPiece* items = (GltfPiece*)realloc(list->items, sizeof(GltfPiece) * capacity);
+		if(items == NULL)
+		{
+			return 1;
+		}
+		list->items = items;
+		list->capacity = capacity;
+	}
+	list->items[list->count++] = *pPiece;
+	return 0;
+}
+
+static int collectMesh(const GltfDoc* doc, int mesh, const double* matrix, GltfPieceList* list)
+{
+	const JsonDoc* json = &doc->json;
+	const int primitives = jsonMember(json, mesh, "primitives");
+	int primitive = 0;
+
+	const double det = matrix[0] * (matrix[5] * matrix[10] - matrix[9] * matrix[6]) -
+					   matrix[4] * (matrix[1] * matrix[10] - matrix[9] * matrix[2]) +
+					   matrix[8] * (matrix[1] * matrix[6] - matrix[5] * matrix[2]);
+
+	for(primitive = primitives >= 0 ? json->nodes[primitives].firstChild : -1; primitive >= 0; primitive = json->nodes[primitive].nextSibling)
+	{
+		// points, lines and strips are not surfaces (strips are rare in practice)
+		if(jsonNumber(json, jsonMember(json, primitive, "mode"), GLTF_MODE_TRIANGLES) != GLTF_MODE_TRIANGLES)
+		{
+			continue;
+		}
+
+		GltfPiece piece;
+		memset(&piece, 0, sizeof(piece));
+		memcpy(piece.matrix, matrix, sizeof(piece.matrix));
+		// a mirroring transform reverses the winding, see the glTF spec on node transforms
+		piece.flipWinding = det < 0.0;
+
+		const int position = jsonMember(json, jsonMember(json, primitive, "attributes"), "POSITION");
+		if(position < 0)
+		{
+			continue;
+		}
+		if(gltfAccessor(doc, jsonNumber(json, position, -1), "VEC3", &piece.positions) != 0)
+		{
+			return 1;
+		}
+		if(piece.positions.componentType != GLTF_FLOAT)
+		{
+			fprintf(stderr, "error: quantized glTF positions are not supported in `%s`\n", doc->fpath);
+			return 1;
+		}
+
+		const int indices = jsonMember(json, primitive, "indices");
+		if(indices >= 0)
+		{
+			if(gltfAccessor(doc, jsonNumber(json, indices, -1), "SCALAR", &piece.indices) != 0)
+			{
+				return 1;
+			}
+			if(piece.indices.componentType == GLTF_FLOAT)
+			{
+				fprintf(stderr, "error: invalid glTF index type in `%s`\n", doc->fpath);
+				return 1;
+			}
+			piece.indexed = 1;
+		}
+
+		if(appendPiece(list, &piece) != 0)
+		{
+			return 1;
+		}
+	}
+	return 0;
+}
+
+static int collectNode(const GltfDoc* doc, int node, const double* parentMatrix, int depth, GltfPieceList* list)
+{
+	const JsonDoc* json = &doc->json;
+	if(node < 0 || depth > GLTF_MAX_DEPTH)
+	{
+		fprintf(stderr, "error: invalid glTF node hierarchy in `%s`\n", doc->fpath);
+		return 1;
+	}
+
+	double local[16];
+	double matrix[16];
+	nodeMatrix(json, node, local);
+	multiplyMatrix(parentMatrix, local, matrix);
+
+	const int meshIndex = jsonMember(json, node, "mesh");
+	if(meshIndex >= 0)
+	{
+		const int mesh = gltfItem(&doc->meshes, jsonNumber(json, meshIndex, -1));
+		if(mesh < 0 || collectMesh(doc, mesh, matrix, list) != 0)
+		{
+			return 1;
+		}
+	}
+
+	const int children = jsonMember(json, node, "children");
+	int child = 0;
+	for(child = children >= 0 ? json->nodes[children].firstChild : -1; child >= 0; child = json->nodes[child].nextSibling)
+	{
+		if(collectNode(doc, gltfItem(&doc->nodes, jsonNumber(json, child, -1)), matrix, depth + 1, list) != 0)
+		{
+			return 1;
+		}
+	}
+	return 0;
+}
+
+// collects the primitives of the default scene; without scenes every mesh is
+// taken once, untransformed
+static int collectPieces(const GltfDoc* doc, GltfPieceList* list)
+{
+	const JsonDoc* json = &doc->json;
+	static const double identity[16] = {1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1};
+	int i = 0;
+
+	GltfArray scenes;
+	scenes.items = jsonArrayTable(json, jsonMember(json, doc->root, "scenes"), &scenes.count);
+	const int scene = gltfItem(&scenes, jsonNumber(json, jsonMember(json, doc->root, "scene"), 0));
+	free(scenes.items);
+
+	if(scene < 0)
+	{
+		for(i = 0; i < doc->meshes.count; ++i)
+		{
+			if(collectMesh(doc, doc->meshes.items[i], identity, list) != 0)
+			{
+				return 1;
+			}
+		}
+		return 0;
+	}
+
+	const int roots = jsonMember(json, scene, "nodes");
+	int root = 0;
+	for(root = roots >= 0 ? json->nodes[roots].firstChild : -1; root >= 0; root = json->nodes[root].nextSibling)
+	{
+		if(collectNode(doc, gltfItem(&doc->nodes, jsonNumber(json, root, -1)), identity, 0, list) != 0)
+		{
+			return 1;
+		}
+	}
+	return 0;
+}
+
+static uint32_t readIndex(const GltfAccessor* pAccessor, uint64_t i)
+{
+	const unsigned char* p = pAccessor->data + i * pAccessor->stride;
+	switch(pAccessor->componentType)
+	{
+	case GLTF_UNSIGNED_BYTE:
+		return *p;
+	case GLTF_UNSIGNED_SHORT: {
+		uint16_t v;
+		memcpy(&v, p, sizeof(v));
+		return v;
+	}
+	default: {
+		uint32_t v;
+		memcpy(&v, p, sizeof(v));
+		return v;
+	}
+	}
+}
+
+// converts one piece into the merged arrays; returns 0 if an index is out of range
+static int convertPiece(const GltfPiece* pPiece, double* pVertices, unsigned int* pIndices)
+{
+	const double* m = pPiece->matrix;
+	const int64_t numVertices = (int64_t)pPiece->positions.count;
+	const int64_t numIndices = (int64_t)(pPiece->indexed ? pPiece->indices.count : pPiece->positions.count);
+	int64_t i = 0;
+	int invalid = 0;
+
+#pragma omp parallel for
+	for(i = 0; i < numVertices; ++i)
+	{
+		float p[3];
+		memcpy(p, pPiece->positions.data + (size_t)i * pPiece->positions.stride, sizeof(p));
+		double* out = pVertices + 3 * (pPiece->vertexOffset + (uint64_t)i);
+		out[0] = m[0] * p[0] + m[4] * p[1] + m[8] * p[2] + m[12];
+		out[1] = m[1] * p[0] + m[5] * p[1] + m[9] * p[2] + m[13];
+		out[2] = m[2] * p[0] + m[6] * p[1] + m[10] * p[2] + m[14];
+	}
+
+	// the last incomplete triangle, if any, is dropped
+	const int64_t numTriangles = numIndices / 3;
+#pragma omp parallel for reduction(| : invalid)
+	for(i = 0; i < numTriangles; ++i)
+	{
+		unsigned int* out = pIndices + pPiece->indexOffset + 3 * (uint64_t)i;
+		int k = 0;
+		for(k = 0; k < 3; ++k)
+		{
+			const uint64_t corner = 3 * (uint64_t)i + (uint64_t)(pPiece->flipWinding ? 2 - k : k);
+			const uint32_t index = pPiece->indexed ? readIndex(&pPiece->indices, corner) : (uint32_t)corner;
+			invalid |= index >= (uint64_t)numVertices;
+			out[k] = (unsigned int)(pPiece->vertexOffset + index);
+		}
+	}
+	return !invalid;
+}
+
+static int parseGLB(const unsigned char* pData, size_t size, GltfDoc* doc)
+{
+	uint32_t header[3];
+	if(size < 20)
+	{
+		fprintf(stderr, "error: `%s` is not a .glb file\n", doc->fpath);
+		return 1;
+	}
+	memcpy(header, pData, sizeof(header));
+	if(header[0] != GLB_MAGIC || header[1] != 2 || header[2] > size)
+	{
+		fprintf(stderr, "error: `%s` is not a glTF 2.0 binary file\n", doc->fpath);
+		return 1;
+	}
+	size = header[2];
+
+	size_t pos = 12;
+	while(pos + 8 <= size)
+	{
+		uint32_t chunk[2];
+		memcpy(chunk, pData + pos, sizeof(chunk));
+		pos += 8;
+		if(chunk[0] > size - pos)
+		{
+			fprintf(stderr, "error: truncated .glb chunk in `%s`\n", doc->fpath);
+			return 1;
+		}
+		if(chunk[1] == GLB_CHUNK_JSON && doc->json.text == NULL)
+		{
+			doc->json.text = (const char*)pData + pos;
+			doc->json.length = chunk[0];
+		}
+		else if(chunk[1] == GLB_CHUNK_BIN && doc->bin == NULL)
+		{
+			doc->bin = pData + pos;
+			doc->binSize = chunk[0];
+		}
+		pos += (chunk[0] + 3) & ~(size_t)3;
+	}
+
+	if(doc->json.text == NULL || (doc->root = jsonParseValue(&doc->json, 0)) < 0 || doc->json.nodes[doc->root].type != JSON_OBJECT)
+	{
+		fprintf(stderr, "error: invalid .glb JSON chunk in `%s`\n", doc->fpath);
+		return 1;
+	}
+
+	const JsonDoc* json = &doc->json;
+	const int required = jsonMember(json, doc->root, "extensionsRequired");
+	int extension = 0;
+	for(extension = required >= 0 ? json->nodes[required].firstChild : -1; extension >= 0; extension = json->nodes[extension].nextSibling)
+	{
+		if(jsonStringEquals(json, extension, "KHR_draco_mesh_compression") || jsonStringEquals(json, extension, "EXT_meshopt_compression"))
+		{
+			fprintf(stderr, "error: compressed glTF meshes are not supported in `%s`\n", doc->fpath);
+			return 1;
+		}
+	}
+
+	doc->accessors.items = jsonArrayTable(json, jsonMember(json, doc->root, "accessors"), &doc->accessors.count);
+	doc->bufferViews.items = jsonArrayTable(json, jsonMember(json, doc->root, "bufferViews"), &doc->bufferViews.count);
+	doc->buffers.items = jsonArrayTable(json, jsonMember(json, doc->root, "buffers"), &doc->buffers.count);
+	doc->meshes.items = jsonArrayTable(json, jsonMember(json, doc->root, "meshes"), &doc->meshes.count);
+	doc->nodes.items = jsonArrayTable(json, jsonMember(json, doc->root, "nodes"), &doc->nodes.count);
+	return 0;
+}
+
+int mioReadGLB(const char* fpath,
+			   double** pVertices,
+			   unsigned int** pFaceVertexIndices,
+			   unsigned int** pFaceSizes,
+			   unsigned int* numVertices,
+			   unsigned int* numFaces)
+{
+	*pVertices = NULL;
+	*pFaceVertexIndices = NULL;
+	*pFaceSizes = NULL;
+	*numVertices = 0;
+	*numFaces = 0;
+
+	size_t size = 0;
+	const unsigned char* pData = (const unsigned char*)mioMapFile(fpath, &size, 0);
+
+	if(pData == NULL)
+	{
+		fprintf(stderr, "error: failed to open `%s`\n", fpath);
+		return 1;
+	}
+
+	GltfDoc doc;
+	memset(&doc, 0, sizeof(doc));
+	doc.fpath = fpath;
+
+	GltfPieceList pieces;
+	memset(&pieces, 0, sizeof(pieces));
+
+	int status = parseGLB(pData, size, &doc);
+	if(status == 0)
+	{
+		status = collectPieces(&doc, &pieces);
+	}
+
+	uint64_t totalVertices = 0;
+	uint64_t totalIndices = 0;
+	size_t i = 0;
+	for(i = 0; i < pieces.count && status == 0; ++i)
+	{
+		GltfPiece* pPiece = &pieces.items[i];
+		pPiece->vertexOffset = totalVertices;
+		pPiece->indexOffset = totalIndices;
+		totalVertices += pPiece->positions.count;
+		totalIndices += (pPiece->indexed ? pPiece->indices.count : pPiece->positions.count) / 3 * 3;
+	}
+
+	if(status == 0 && (totalVertices > UINT32_MAX || totalIndices / 3 > UINT32_MAX))
+	{
+		fprintf(stderr, "error: too many vertices or faces in `%s`\n", fpath);
+		status = 1;
+	}
+
+	if(status == 0)
+	{
+		*pVertices = (double*)malloc(sizeof(double) * 3 * (totalVertices > 0 ? totalVertices : 1));
+		*pFaceVertexIndices = (unsigned int*)malloc(sizeof(unsigned int) * (totalIndices > 0 ? totalIndices : 1));
+		*pFaceSizes = (unsigned int*)malloc(sizeof(unsigned int) * (totalIndices > 0 ? totalIndices / 3 : 1));
+		if(*pVertices == NULL || *pFaceVertexIndices == NULL || *pFaceSizes == NULL)
+		{
+			fprintf(stderr, "error: out of memory reading `%s`\n", fpath);
+			status = 1;
+		}
+	}
+
+	for(i = 0; i < pieces.count && status == 0; ++i)
+	{
+		if(!convertPiece(&pieces.items[i], *pVertices, *pFaceVertexIndices))
+		{
+			fprintf(stderr, "error: glTF vertex index out of range in `%s`\n", fpath);
+			status = 1;
+		}
+	}
+
+	if(status == 0)
+	{
+		const int64_t count = (int64_t)(totalIndices / 3);
+		int64_t f = 0;
+#pragma omp parallel for
+		for(f = 0; f < count; ++f)
+		{
+			(*pFaceSizes)[f] = 3;
+		}
+		*numVertices = (unsigned int)totalVertices;
+		*numFaces = (unsigned int)count;
+	}
+
+	free(pieces.items);
+	free(doc.accessors.items);
+	free(doc.bufferViews.items);
+	free(doc.buffers.items);
+	free(doc.meshes.items);
+	free(doc.nodes.items);
+	free(doc.json.nodes);
+	mioUnmapFile((void*)pData, size);
+
+	if(status != 0)
+	{
+		free(*pVertices);
+		free(*pFaceVertexIndices);
+		free(*pFaceSizes);
+		*pVertices = NULL;
+		*pFaceVertexIndices = NULL;
+		*pFaceSizes = NULL;
+	}
+	return status;
+}
@@ -0,0 +1,90 @@
+/***************************************************************************
+ *
+ *  Copyright (C) 2024 CutDigital Enterprise Ltd
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  For your convenience, a copy of the License has been included in this
+ *  repository.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.WE
+ *
+ **************************************************************************/
+
+#include "mapping.h"
+
+#if defined(_WIN32)
+#	define WIN32_LEAN_AND_MEAN
+#	include <windows.h>
+#else
+#	include <fcntl.h>
+#	include <sys/mman.h>
+#	include <sys/stat.h>
+#	include <unistd.h>
+#endif
+
+void* mioMapFile(const char* fpath, size_t* pSize, int copyOnWrite)
+{
+	*pSize = 0;
+#if defined(_WIN32)
+	HANDLE file = CreateFileA(fpath, GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_DELETE, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+	if(file == INVALID_HANDLE_VALUE)
+	{
+		return NULL;
+	}
+
+	LARGE_INTEGER size;
+	void* pData = NULL;
+	if(GetFileSizeEx(file, &size) && size.QuadPart > 0)
+	{
+		// the view keeps the mapping alive after both handles are closed
+		HANDLE mapping = CreateFileMappingA(file, NULL, copyOnWrite ? PAGE_WRITECOPY : PAGE_READONLY, 0, 0, NULL);
+		if(mapping != NULL)
+		{
+			pData = MapViewOfFile(mapping, copyOnWrite ? FILE_MAP_COPY : FILE_MAP_READ, 0, 0, 0);
+			CloseHandle(mapping);
+		}
+		*pSize = (size_t)size.QuadPart;
+	}
+	CloseHandle(file);
+	return pData;
+#else
+	const int fd = open(fpath, O_RDONLY);
+	if(fd < 0)
+	{
+		return NULL;
+	}
+
+	struct stat info;
+	void* pData = NULL;
+	if(fstat(fd, &info) == 0 && info.st_size > 0)
+	{
+		const int protection = copyOnWrite ? PROT_READ | PROT_WRITE : PROT_READ;
+		pData = mmap(NULL, (size_t)info.st_size, protection, MAP_PRIVATE, fd, 0);
+		if(pData == MAP_FAILED)
+		{
+			pData = NULL;
+		}
+		*pSize = (size_t)info.st_size;
+	}
+	close(fd);
+	return pData;
+#endif
+}
+
+void mioUnmapFile(void* pData, size_t size)
+{
+#if defined(_WIN32)
+	(void)size;
+	UnmapViewOfFile(pData);
+#else
+	munmap(pData, size);
+#endif
+}
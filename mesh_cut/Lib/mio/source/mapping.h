@@ -0,0 +1,38 @@
+/***************************************************************************
+ *
+ *  Copyright (C) 2024 CutDigital Enterprise Ltd
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  For your convenience, a copy of the License has been included in this
+ *  repository.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.WE
+ *
+ **************************************************************************/
+
+// Internal helpers shared by the binary readers (not part of the public API)
+
+#ifndef __MIO_MAPPING_H__
+#define __MIO_MAPPING_H__  1
+
+#include <stddef.h>
+
+/*
+    Memory-maps a whole file. With "copyOnWrite" set the pages may be modified
+    without touching the file, otherwise they are read-only.
+    Returns NULL if the file is missing, empty or cannot be mapped.
+*/
+void* mioMapFile(const char* fpath, size_t* pSize, int copyOnWrite);
+
+// Unmaps a file mapped by "mioMapFile"
+void mioUnmapFile(void* pData, size_t size);
+
+#endif // #ifndef __MIO_MAPPING_H__
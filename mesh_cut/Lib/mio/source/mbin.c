@@ -0,0 +1,318 @@
+/***************************************************************************
+ *
+ *  Copyright (C) 2024 CutDigital Enterprise Ltd
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  For your convenience, a copy of the License has been included in this
+ *  repository.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.WE
+ *
+ **************************************************************************/
+
+#include "mio/mbin.h"
+#include "mapping.h"
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#define MBIN_ALIGNMENT 64
+#define MBIN_MAX_SECTIONS 8
+// written in native byte order, reads back differently on a foreign machine
+#define MBIN_BYTE_ORDER 0x01020304u
+
+static const char kMagic[8] = {'M', 'I', 'O', 'M', 'B', 'I', 'N', '\0'};
+
+enum
+{
+	MBIN_SECTION_VERTICES = 1,
+	MBIN_SECTION_NORMALS = 2,
+	MBIN_SECTION_FACE_SIZES = 3,
+	MBIN_SECTION_FACE_VERTEX_INDICES = 4,
+	MBIN_SECTION_VERTEX_FACE_OFFSETS = 5,
+	MBIN_SECTION_VERTEX_FACES = 6
+};
+
+typedef struct MbinHeader
+{
+	char magic[8];
+	uint32_t version;
+	uint32_t byteOrder;
+	uint32_t numVertices;
+	uint32_t numFaces;
+	uint32_t numFaceVertexIndices;
+	uint32_t numSections;
+	uint64_t sourceStamp[2];
+	uint8_t reserved[16];
+} MbinHeader;
+
+typedef struct MbinSection
+{
+	uint32_t type;
+	uint32_t reserved;
+	uint64_t offset;
+	uint64_t numBytes;
+} MbinSection;
+
+typedef struct MbinPayload
+{
+	uint32_t type;
+	const void* pData;
+	uint64_t numBytes;
+} MbinPayload;
+
+static uint64_t alignUp(uint64_t value)
+{
+	return (value + MBIN_ALIGNMENT - 1) / MBIN_ALIGNMENT * MBIN_ALIGNMENT;
+}
+
+static int writePadding(FILE* file, uint64_t from, uint64_t to)
+{
+	static const char zeros[MBIN_ALIGNMENT] = {0};
+	return to > from && fwrite(zeros, 1, (size_t)(to - from), file) != (size_t)(to - from);
+}
+
+int mioWriteMBIN(const char* fpath,
+				 const double* pVertices,
+				 const double* pNormals,
+				 const unsigned int* pFaceSizes,
+				 const unsigned int* pFaceVertexIndices,
+				 const unsigned int* pVertexFaceOffsets,
+				 const unsigned int* pVertexFaces,
+				 unsigned int numVertices,
+				 unsigned int numFaces,
+				 const unsigned long long sourceStamp[2])
+{
+	uint64_t numFaceVertexIndices = (uint64_t)numFaces * 3;
+	unsigned int i = 0;
+
+	if(pFaceSizes != NULL)
+	{
+		numFaceVertexIndices = 0;
+		for(i = 0; i < numFaces; ++i)
+		{
+			numFaceVertexIndices += pFaceSizes[i];
+		}
+	}
+
+	if(numFaceVertexIndices > UINT32_MAX || (pVertexFaceOffsets == NULL) != (pVertexFaces == NULL))
+	{
+		fprintf(stderr, "error: invalid mesh for `%s`\n", fpath);
+		return 1;
+	}
+
+	MbinPayload payloads[MBIN_MAX_SECTIONS];
+	uint32_t numSections = 0;
+
+	payloads[numSections].type = MBIN_SECTION_VERTICES;
+	payloads[numSections].pData = pVertices;
+	payloads[numSections++].numBytes = (uint64_t)numVertices * 3 * sizeof(double);
+
+	if(pNormals != NULL)
+	{
+		payloads[numSections].type = MBIN_SECTION_NORMALS;
+		payloads[numSections].pData = pNormals;
+		payloads[numSections++].numBytes = (uint64_t)numVertices * 3 * sizeof(double);
+	}
+
+	if(pFaceSizes != NULL)
+	{
+		payloads[numSections].type = MBIN_SECTION_FACE_SIZES;
+		payloads[numSections].pData = pFaceSizes;
+		payloads[numSections++].numBytes = (uint64_t)numFaces * sizeof(uint32_t);
+	}
+
+	payloads[numSections].type = MBIN_SECTION_FACE_VERTEX_INDICES;
+	payloads[numSections].pData = pFaceVertexIndices;
+	payloads[numSections++].numBytes = numFaceVertexIndices * sizeof(uint32_t);
+
+	if(pVertexFaceOffsets != NULL)
+	{
+		payloads[numSections].type = MBIN_SECTION_VERTEX_FACE_OFFSETS;
+		payloads[numSections].pData = pVertexFaceOffsets;
+		payloads[numSections++].numBytes = ((uint64_t)numVertices + 1) * sizeof(uint32_t);
+
+		payloads[numSections].type = MBIN_SECTION_VERTEX_FACES;
+		payloads[numSections].pData = pVertexFaces;
+		payloads[numSections++].numBytes = (uint64_t)pVertexFaceOffsets[numVertices] * sizeof(uint32_t);
+	}
+
+	MbinHeader header;
+	memset(&header, 0, sizeof(header));
+	memcpy(header.magic, kMagic, sizeof(kMagic));
+	header.version = MIO_MBIN_VERSION;
+	header.byteOrder = MBIN_BYTE_ORDER;
+	header.numVertices = numVertices;
+	header.numFaces = numFaces;
+	header.numFaceVertexIndices = (uint32_t)numFaceVertexIndices;
+	header.numSections = numSections;
+	header.sourceStamp[0] = sourceStamp[0];
+	header.sourceStamp[1] = sourceStamp[1];
+
+	MbinSection sections[MBIN_MAX_SECTIONS];
+	memset(sections, 0, sizeof(sections));
+	uint64_t offset = alignUp(sizeof(MbinHeader) + numSections * sizeof(MbinSection));
+	for(i = 0; i < numSections; ++i)
+	{
+		sections[i].type = payloads[i].type;
+		sections[i].offset = offset;
+		sections[i].numBytes = payloads[i].numBytes;
+		offset = alignUp(offset + payloads[i].numBytes);
+	}
+
+	FILE* file = fopen(fpath, "wb");
+
+	if(file == NULL)
+	{
+		fprintf(stderr, "error: failed to open `%s`\n", fpath);
+		return 1;
+	}
+
+	int failed = fwrite(&header, sizeof(header), 1, file) != 1 ||
+				 fwrite(sections, sizeof(MbinSection), numSections, file) != numSections;
+	uint64_t position = sizeof(header) + numSections * sizeof(MbinSection);
+
+	for(i = 0; i < numSections && !failed; ++i)
+	{
+		failed = writePadding(file, position, sections[i].offset);
+		position = sections[i].offset;
+
+		if(!failed && payloads[i].numBytes > 0)
+		{
+			failed = fwrite(payloads[i].pData, 1, (size_t)payloads[i].numBytes, file) != payloads[i].numBytes;
+		}
+		position += payloads[i].numBytes;
+	}
+
+	if(fclose(file) != 0 || failed)
+	{
+		fprintf(stderr, "error: failed to write `%s`\n", fpath);
+		return 1;
+	}
+	return 0;
+}
+
+// checks the header and the section table, then points the arrays into the
+// mapping; the payloads themselves are not touched, so no page is read yet
+static int bindSections(MioMappedMesh* pMesh)
+{
+	const char* pBytes = (const char*)pMesh->pMapping;
+	const uint64_t size = pMesh->mappingSize;
+	const MbinHeader* pHeader = (const MbinHeader*)pBytes;
+
+	if(size < sizeof(MbinHeader) || memcmp(pHeader->magic, kMagic, sizeof(kMagic)) != 0 || pHeader->version != MIO_MBIN_VERSION ||
+	   pHeader->byteOrder != MBIN_BYTE_ORDER || pHeader->numSections > MBIN_MAX_SECTIONS ||
+	   size < sizeof(MbinHeader) + pHeader->numSections * sizeof(MbinSection))
+	{
+		return 1;
+	}
+
+	const uint64_t numVertices = pHeader->numVertices;
+	const uint64_t numFaces = pHeader->numFaces;
+	const uint64_t numFaceVertexIndices = pHeader->numFaceVertexIndices;
+	const MbinSection* sections = (const MbinSection*)(pBytes + sizeof(MbinHeader));
+	uint64_t numVertexFaces = 0;
+	uint32_t i = 0;
+
+	for(i = 0; i < pHeader->numSections; ++i)
+	{
+		const MbinSection* pSection = &sections[i];
+		if(pSection->offset % MBIN_ALIGNMENT != 0 || pSection->offset > size || pSection->numBytes > size - pSection->offset)
+		{
+			return 1;
+		}
+
+		char* pData = (char*)pMesh->pMapping + pSection->offset;
+		uint64_t expectedBytes = 0;
+		switch(pSection->type)
+		{
+		case MBIN_SECTION_VERTICES:
+			pMesh->pVertices = (double*)pData;
+			expectedBytes = numVertices * 3 * sizeof(double);
+			break;
+		case MBIN_SECTION_NORMALS:
+			pMesh->pNormals = (double*)pData;
+			expectedBytes = numVertices * 3 * sizeof(double);
+			break;
+		case MBIN_SECTION_FACE_SIZES:
+			pMesh->pFaceSizes = (unsigned int*)pData;
+			expectedBytes = numFaces * sizeof(uint32_t);
+			break;
+		case MBIN_SECTION_FACE_VERTEX_INDICES:
+			pMesh->pFaceVertexIndices = (unsigned int*)pData;
+			expectedBytes = numFaceVertexIndices * sizeof(uint32_t);
+			break;
+		case MBIN_SECTION_VERTEX_FACE_OFFSETS:
+			pMesh->pVertexFaceOffsets = (unsigned int*)pData;
+			expectedBytes = (numVertices + 1) * sizeof(uint32_t);
+			break;
+		case MBIN_SECTION_VERTEX_FACES:
+			pMesh->pVertexFaces = (unsigned int*)pData;
+			numVertexFaces = pSection->numBytes / sizeof(uint32_t);
+			expectedBytes = numVertexFaces * sizeof(uint32_t);
+			break;
+		default: // sections unknown to this reader are skipped
+			expectedBytes = pSection->numBytes;
+			break;
+		}
+
+		if(pSection->numBytes != expectedBytes)
+		{
+			return 1;
+		}
+	}
+
+	if(pMesh->pVertices == NULL || pMesh->pFaceVertexIndices == NULL ||
+	   (pMesh->pFaceSizes == NULL && numFaceVertexIndices != numFaces * 3) ||
+	   (pMesh->pVertexFaceOffsets == NULL) != (pMesh->pVertexFaces == NULL) ||
+	   (pMesh->pVertexFaceOffsets != NULL && pMesh->pVertexFaceOffsets[numVertices] != numVertexFaces))
+	{
+		return 1;
+	}
+
+	pMesh->numVertices = pHeader->numVertices;
+	pMesh->numFaces = pHeader->numFaces;
+	pMesh->numFaceVertexIndices = pHeader->numFaceVertexIndices;
+	pMesh->sourceStamp[0] = pHeader->sourceStamp[0];
+	pMesh->sourceStamp[1] = pHeader->sourceStamp[1];
+	return 0;
+}
+
+int mioMapMBIN(const char* fpath, MioMappedMesh* pMesh)
+{
+	memset(pMesh, 0, sizeof(*pMesh));
+
+	size_t size = 0;
+	void* pData = mioMapFile(fpath, &size, 1);
+	if(pData == NULL)
+	{
+		return 1;
+	}
+
+	pMesh->pMapping = pData;
+	pMesh->mappingSize = size;
+	if(bindSections(pMesh) != 0)
+	{
+		mioUnmapMBIN(pMesh);
+		return 1;
+	}
+	return 0;
+}
+
+void mioUnmapMBIN(MioMappedMesh* pMesh)
+{
+	if(pMesh->pMapping != NULL)
+	{
+		mioUnmapFile(pMesh->pMapping, pMesh->mappingSize);
+	}
+	memset(pMesh, 0, sizeof(*pMesh));
+}
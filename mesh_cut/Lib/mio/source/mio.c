@@ -21,7 +21,10 @@
 #include "mio/mio.h"
 
 #include <assert.h>
+#include <ctype.h>
+#include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
 #if defined(_WIN32)
 #	include <stdlib.h> // https://stackoverflow.com/questions/44504429/c-write-access-violation
@@ -83,10 +86,7 @@ ssize_t getline(char** lineptr, size_t* n, FILE* stream)
 	return pos;
 }
 
-/*
-    Function to read in a mesh file. Supported file formats are .obj and .off
-*/
-void mioRead(
+void mioWrite(
 	// absolute path to file
 	const char* fpath,
 	// pointer to list of vertex coordinates stored as [xyz,xyz,xyz,...]
@@ -103,7 +103,29 @@ void mioRead(
 	// TODO
 }
 
-void mioWrite(
+#endif // #if defined (_WIN32)
+
+// compares the extension of "fpath" with "extension" (lower case, with the dot)
+static int hasExtension(const char* fpath, const char* extension)
+{
+	const char* dot = strrchr(fpath, '.');
+	size_t i = 0;
+
+	if(dot == NULL || strlen(dot) != strlen(extension))
+	{
+		return 0;
+	}
+	for(i = 0; extension[i] != '\0'; ++i)
+	{
+		if(tolower((unsigned char)dot[i]) != extension[i])
+		{
+			return 0;
+		}
+	}
+	return 1;
+}
+
+int mioRead(
 	// absolute path to file
 	const char* fpath,
 	// pointer to list of vertex coordinates stored as [xyz,xyz,xyz,...]
@@ -117,10 +139,45 @@ void mioWrite(
 	// number of faces
 	unsigned int* numFaces)
 {
-	// TODO
-}
+	if(hasExtension(fpath, ".obj"))
+	{
+		double* pNormals = NULL;
+		double* pTexCoords = NULL;
+		unsigned int* pFaceVertexTexCoordIndices = NULL;
+		unsigned int* pFaceVertexNormalIndices = NULL;
+		unsigned int numNormals = 0;
+		unsigned int numTexCoords = 0;
+		int status = 0;
+
+		status = mioReadOBJ(fpath, pVertices, &pNormals, &pTexCoords, pFaceSizes, pFaceVertexIndices,
+				   &pFaceVertexTexCoordIndices, &pFaceVertexNormalIndices, numVertices, &numNormals,
+				   &numTexCoords, numFaces);
+
+		mioFree(pNormals);
+		mioFree(pTexCoords);
+		mioFree(pFaceVertexTexCoordIndices);
+		mioFree(pFaceVertexNormalIndices);
+		return status;
+	}
 
-#endif // #if defined (_WIN32)
+	if(hasExtension(fpath, ".off"))
+	{
+		return mioReadOFF(fpath, pVertices, pFaceVertexIndices, pFaceSizes, numVertices, numFaces);
+	}
+
+	if(hasExtension(fpath, ".ply"))
+	{
+		return mioReadPLY(fpath, pVertices, pFaceVertexIndices, pFaceSizes, numVertices, numFaces);
+	}
+
+	if(hasExtension(fpath, ".glb"))
+	{
+		return mioReadGLB(fpath, pVertices, pFaceVertexIndices, pFaceSizes, numVertices, numFaces);
+	}
+
+	fprintf(stderr, "error: unsupported mesh file `%s`\n", fpath);
+	return 1;
+}
 
 void mioFree(void* pMemPtr)
 {
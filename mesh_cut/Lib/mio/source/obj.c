@@ -27,6 +27,13 @@
 #include <string.h>
 #include <stddef.h> // ptrdiff_t
 
+// re-entrant tokenizer so that several files can be parsed concurrently
+#if defined(_WIN32)
+#define MIO_STRTOK_R strtok_s
+#else
+#define MIO_STRTOK_R strtok_r
+#endif
+
 enum ObjFileCmdType
 {
 	/*
@@ -82,7 +89,7 @@ enum ObjFileCmdType
 // be freed by caller. The function only handles polygonal faces, so commands like
 // "vp" command (which is used to specify control points of the surface or curve)
 // are ignored if encountered in file.
-void mioReadOBJ(
+int mioReadOBJ(
 	// absolute path to file
 	const char* fpath,
 	// pointer to list of vertex coordinates stored as [xyz,xyz,xyz,...]
@@ -115,8 +122,8 @@ void mioReadOBJ(
 
 	if(file == NULL)
 	{
-		fprintf(stderr, "error: failed to open file '%s'", fpath);
-		exit(1);
+		fprintf(stderr, "error: failed to open file '%s'\n", fpath);
+		return 1;
 	}
 
 	fpos_t startOfFile;
@@ -125,9 +132,18 @@ void mioReadOBJ(
 	{
 		perror("fgetpos()");
 		fprintf(stderr, "error fgetpos() failed in file %s at line # %d\n", __FILE__, __LINE__ - 3);
-		exit(EXIT_FAILURE);
+		fclose(file);
+		return 1;
 	}
 
+	*pVertices = NULL;
+	*pNormals = NULL;
+	*pTexCoords = NULL;
+	*pFaceSizes = NULL;
+	*pFaceVertexIndices = NULL;
+	*pFaceVertexTexCoordIndices = NULL;
+	*pFaceVertexNormalIndices = NULL;
+
 	// buffer used to store the contents of a line read from the file.
 	char* lineBuf = NULL;
 	// current length of the line buffer (in characters read)
@@ -242,7 +258,7 @@ void mioReadOBJ(
 					if(nread != 3)
 					{
 						fprintf(stderr, "error: have %zu components for v%d\n", nread, vertexId);
-						abort();
+						goto failed;
 					}
 				}
 			}
@@ -266,7 +282,7 @@ void mioReadOBJ(
 					if(nread != 3)
 					{
 						fprintf(stderr, "error: have %zu components for vn%d\n", nread, normalId);
-						abort();
+						goto failed;
 					}
 				}
 			}
@@ -287,7 +303,7 @@ void mioReadOBJ(
 					if(nread != 2)
 					{
 						fprintf(stderr, "error: have %zu components for vt%d\n", nread, texCoordId);
-						abort();
+						goto failed;
 					}
 				}
 			}
@@ -300,13 +316,14 @@ void mioReadOBJ(
 					//
 					// count the number of vertices in face
 					//
-					char* pch = strtok(lineBuf + 2, " ");
+					char* savePtr = NULL;
+					char* pch = MIO_STRTOK_R(lineBuf + 2, " ", &savePtr);
 					unsigned int faceVertexCount = 0;
 
 					while(pch != NULL)
 					{
 						faceVertexCount++; // track number of vertices found in face
-						pch = strtok(NULL, " ");
+						pch = MIO_STRTOK_R(NULL, " ", &savePtr);
 					}
 
 					assert(pFaceSizes != NULL);
@@ -331,10 +348,11 @@ void mioReadOBJ(
 					char* token = NULL;
 					char* tokenElem = NULL;
 					char* buf = NULL; // char buf[512];
+					char* savePtr = NULL;
 
 					// for each vertex in face
-					for(token = strtok(lineBuf, " "); token != NULL;
-						token = strtok(token + strlen(token) + 1, " "))
+					for(token = MIO_STRTOK_R(lineBuf, " ", &savePtr); token != NULL;
+						token = MIO_STRTOK_R(token + strlen(token) + 1, " ", &savePtr))
 					{
 
 						token[strcspn(token, "\r\n")] =
@@ -369,9 +387,9 @@ void mioReadOBJ(
 
 						// for each data element of a face-vertex
 						for(
-							tokenElem = strtok(buf, "/"); 
+							tokenElem = MIO_STRTOK_R(buf, "/", &savePtr); 
 							tokenElem != NULL;
-							tokenElem = strtok(tokenElem + strlen(tokenElem), "/"))
+							tokenElem = MIO_STRTOK_R(tokenElem + strlen(tokenElem), "/", &savePtr))
 						{
 
 							// distance from the beginning of "buf", where "buf" contains a small string
@@ -398,6 +416,14 @@ void mioReadOBJ(
 							int sscanfRet =
 								sscanf(tokenElem, "%d", &val); // extract face vertex data index
 
+							// vertex indices are 1-based, relative (negative) indices are not supported
+							if(faceVertexDataIt == 0 && (sscanfRet != 1 || val < 1 || (unsigned int)val > *numVertices))
+							{
+								fprintf(stderr, "error: invalid index '%s' in face f%d\n", tokenElem, faceId);
+								free(buf);
+								goto failed;
+							}
+
 							switch(faceVertexDataIt)
 							{
 							case 0: // vertex id
@@ -432,7 +458,7 @@ void mioReadOBJ(
 								"error: have %d vertices when there should be =%d\n",
 								iter,
 								faceVertexCount);
-						abort();
+						goto failed;
 					}
 				}
 			}
@@ -489,7 +515,7 @@ void mioReadOBJ(
 			if(nFaceIndices == 0)
 			{
 				fprintf(stderr, "error: invalid face index count %d\n", nFaceIndices);
-				abort();
+				goto failed;
 			}
 
 			*pFaceVertexIndices = (unsigned int*)malloc(nFaceIndices * sizeof(unsigned int));
@@ -523,7 +549,7 @@ void mioReadOBJ(
 						"fsetpos() failed in file %s at lineBuf # %d\n",
 						__FILE__,
 						__LINE__ - 5);
-				exit(EXIT_FAILURE);
+				goto failed;
 			}
 		}
 	} while(++passIterator < 3);
@@ -539,6 +565,35 @@ void mioReadOBJ(
 	fclose(file);
 
 	printf("done.\n");
+	return 0;
+
+failed:
+	if(lineBuf != NULL)
+	{
+		free(lineBuf);
+	}
+
+	fclose(file);
+
+	free(*pVertices);
+	free(*pNormals);
+	free(*pTexCoords);
+	free(*pFaceSizes);
+	free(*pFaceVertexIndices);
+	free(*pFaceVertexTexCoordIndices);
+	free(*pFaceVertexNormalIndices);
+	*pVertices = NULL;
+	*pNormals = NULL;
+	*pTexCoords = NULL;
+	*pFaceSizes = NULL;
+	*pFaceVertexIndices = NULL;
+	*pFaceVertexTexCoordIndices = NULL;
+	*pFaceVertexNormalIndices = NULL;
+	*numVertices = 0;
+	*numNormals = 0;
+	*numTexcoords = 0;
+	*numFaces = 0;
+	return 1;
 }
 
 void mioWriteOBJ(
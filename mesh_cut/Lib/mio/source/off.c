@@ -28,7 +28,7 @@
 
 bool readLine(FILE* file, char** line, size_t* len)
 {
-	while(getline(line, len, file))
+	while(getline(line, len, file) != -1)
 	{
 		if(strlen(*line) > 1 && (*line)[0] != '#')
 		{
@@ -38,12 +38,12 @@ bool readLine(FILE* file, char** line, size_t* len)
 	return false;
 }
 
-void mioReadOFF(const char* fpath,
-				double** pVertices,
-				unsigned int** pFaceVertexIndices,
-				unsigned int** pFaceSizes,
-				unsigned int* numVertices,
-				unsigned int* numFaces)
+int mioReadOFF(const char* fpath,
+			   double** pVertices,
+			   unsigned int** pFaceVertexIndices,
+			   unsigned int** pFaceSizes,
+			   unsigned int* numVertices,
+			   unsigned int* numFaces)
 {
 	printf("read OFF file %s: \n", fpath);
 
@@ -54,14 +54,26 @@ void mioReadOFF(const char* fpath,
 
 	if(file == NULL)
 	{
-		fprintf(stderr, "error: failed to open `%s`", fpath);
-		exit(1);
+		fprintf(stderr, "error: failed to open `%s`\n", fpath);
+		return 1;
 	}
 
 	char* line = NULL;
 	size_t lineBufLen = 0;
 	bool lineOk = true;
 	int i = 0;
+	int nedges = 0;
+	int numFaceIndices = 0;
+	int indexOffset = 0;
+#if _WIN64
+	__int64 facesStartOffset = 0;
+#else
+	long int facesStartOffset = 0;
+#endif
+
+	*pVertices = NULL;
+	*pFaceVertexIndices = NULL;
+	*pFaceSizes = NULL;
 
 	// file header
 	lineOk = readLine(file, &line, &lineBufLen);
@@ -69,13 +81,13 @@ void mioReadOFF(const char* fpath,
 	if(!lineOk)
 	{
 		fprintf(stderr, "error: .off file header not found\n");
-		exit(1);
+		goto failed;
 	}
 
 	if(strstr(line, "OFF") == NULL)
 	{
 		fprintf(stderr, "error: unrecognised .off file header\n");
-		exit(1);
+		goto failed;
 	}
 
 	// #vertices, #faces, #edges
@@ -84,11 +96,14 @@ void mioReadOFF(const char* fpath,
 	if(!lineOk)
 	{
 		fprintf(stderr, "error: .off element count not found\n");
-		exit(1);
+		goto failed;
 	}
 
-	int nedges = 0;
-	sscanf(line, "%d %d %d", numVertices, numFaces, &nedges);
+	if(sscanf(line, "%u %u %d", numVertices, numFaces, &nedges) < 2)
+	{
+		fprintf(stderr, "error: invalid .off element count\n");
+		goto failed;
+	}
 	*pVertices = (double*)malloc(sizeof(double) * (*numVertices) * 3);
 	*pFaceSizes = (unsigned int*)malloc(sizeof(unsigned int) * (*numFaces));
 
@@ -100,22 +115,25 @@ void mioReadOFF(const char* fpath,
 		if(!lineOk)
 		{
 			fprintf(stderr, "error: .off vertex not found\n");
-			exit(1);
+			goto failed;
 		}
 
 		double x, y, z;
-		sscanf(line, "%lf %lf %lf", &x, &y, &z);
+		if(sscanf(line, "%lf %lf %lf", &x, &y, &z) != 3)
+		{
+			fprintf(stderr, "error: invalid .off vertex %d\n", i);
+			goto failed;
+		}
 
 		(*pVertices)[(i * 3) + 0] = x;
 		(*pVertices)[(i * 3) + 1] = y;
 		(*pVertices)[(i * 3) + 2] = z;
 	}
 #if _WIN64
-	__int64 facesStartOffset = _ftelli64(file);
+	facesStartOffset = _ftelli64(file);
 #else
-	long int facesStartOffset = ftell(file);
+	facesStartOffset = ftell(file);
 #endif
-	int numFaceIndices = 0;
 
 	// faces
 	for(i = 0; i < (int)(*numFaces); ++i)
@@ -125,16 +143,14 @@ void mioReadOFF(const char* fpath,
 		if(!lineOk)
 		{
 			fprintf(stderr, "error: .off file face not found\n");
-			exit(1);
+			goto failed;
 		}
 
-		int n; // number of vertices in face
-		sscanf(line, "%d", &n);
-
-		if(n < 3)
+		int n = 0; // number of vertices in face
+		if(sscanf(line, "%d", &n) != 1 || n < 3)
 		{
 			fprintf(stderr, "error: invalid vertex count in file %d\n", n);
-			exit(1);
+			goto failed;
 		}
 
 		(*pFaceSizes)[i] = n;
@@ -144,17 +160,15 @@ void mioReadOFF(const char* fpath,
 	(*pFaceVertexIndices) = (unsigned int*)malloc(sizeof(unsigned int) * numFaceIndices);
 
 #if _WIN64
-	int api_err = _fseeki64(file, facesStartOffset, SEEK_SET);
+	if(_fseeki64(file, facesStartOffset, SEEK_SET) != 0)
 #else
-	int api_err = fseek(file, facesStartOffset, SEEK_SET);
+	if(fseek(file, facesStartOffset, SEEK_SET) != 0)
 #endif
-	if(api_err != 0)
 	{
 		fprintf(stderr, "error: fseek failed\n");
-		exit(1);
+		goto failed;
 	}
 
-	int indexOffset = 0;
 	for(i = 0; i < (int)(*numFaces); ++i)
 	{
 
@@ -163,21 +177,25 @@ void mioReadOFF(const char* fpath,
 		if(!lineOk)
 		{
 			fprintf(stderr, "error: .off file face not found\n");
-			exit(1);
+			goto failed;
 		}
 
-		int n; // number of vertices in face
-		sscanf(line, "%d", &n);
+		int n = (int)(*pFaceSizes)[i]; // number of vertices in face
 
 		char* lineBufShifted = line;
 		int j = 0;
 
 		while(j < n)
 		{ // parse remaining numbers on line
-			lineBufShifted = strstr(lineBufShifted, " ") + 1; // start of next number
+			lineBufShifted = strchr(lineBufShifted, ' ');
 
-			int val;
-			sscanf(lineBufShifted, "%d", &val);
+			int val = -1;
+			if(lineBufShifted == NULL || sscanf(++lineBufShifted, "%d", &val) != 1 || val < 0 ||
+			   (unsigned int)val >= *numVertices)
+			{
+				fprintf(stderr, "error: invalid vertex index in .off face %d\n", i);
+				goto failed;
+			}
 
 			(*pFaceVertexIndices)[indexOffset + j] = val;
 			j++;
@@ -189,6 +207,21 @@ void mioReadOFF(const char* fpath,
 	free(line);
 
 	fclose(file);
+	return 0;
+
+failed:
+	free(line);
+	fclose(file);
+
+	free(*pVertices);
+	free(*pFaceVertexIndices);
+	free(*pFaceSizes);
+	*pVertices = NULL;
+	*pFaceVertexIndices = NULL;
+	*pFaceSizes = NULL;
+	*numVertices = 0;
+	*numFaces = 0;
+	return 1;
 }
 
 // To ignore edges when writing the output just pass pEdgeVertexIndices = NULL and set numEdges = 0
@@ -0,0 +1,617 @@
+/***************************************************************************
+ *
+ *  Copyright (C) 2024 CutDigital Enterprise Ltd
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  For your convenience, a copy of the License has been included in this
+ *  repository.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.WE
+ *
+ **************************************************************************/
+
+
+#include "mio/ply.h"
+#include "mapping.h"
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define PLY_MAX_ELEMENTS 16
+#define PLY_MAX_PROPERTIES 32
+#define PLY_MAX_NAME 64
+
+typedef enum PlyType
+{
+	PLY_TYPE_INVALID = 0,
+	PLY_TYPE_INT8,
+	PLY_TYPE_UINT8,
+	PLY_TYPE_INT16,
+	PLY_TYPE_UINT16,
+	PLY_TYPE_INT32,
+	PLY_TYPE_UINT32,
+	PLY_TYPE_FLOAT32,
+	PLY_TYPE_FLOAT64
+} PlyType;
+
+typedef struct PlyProperty
+{
+	char name[PLY_MAX_NAME];
+	PlyType type;
+	// for list properties "type" is the type of the items
+	int isList;
+	PlyType countType;
+} PlyProperty;
+
+typedef struct PlyElement
+{
+	char name[PLY_MAX_NAME];
+	uint64_t count;
+	PlyProperty properties[PLY_MAX_PROPERTIES];
+	int numProperties;
+} PlyElement;
+
+static PlyType parseType(const char* name)
+{
+	if(strcmp(name, "char") == 0 || strcmp(name, "int8") == 0)
+	{
+		return PLY_TYPE_INT8;
+	}
+	if(strcmp(name, "uchar") == 0 || strcmp(name, "uint8") == 0)
+	{
+		return PLY_TYPE_UINT8;
+	}
+	if(strcmp(name, "short") == 0 || strcmp(name, "int16") == 0)
+	{
+		return PLY_TYPE_INT16;
+	}
+	if(strcmp(name, "ushort") == 0 || strcmp(name, "uint16") == 0)
+	{
+		return PLY_TYPE_UINT16;
+	}
+	if(strcmp(name, "int") == 0 || strcmp(name, "int32") == 0)
+	{
+		return PLY_TYPE_INT32;
+	}
+	if(strcmp(name, "uint") == 0 || strcmp(name, "uint32") == 0)
+	{
+		return PLY_TYPE_UINT32;
+	}
+	if(strcmp(name, "float") == 0 || strcmp(name, "float32") == 0)
+	{
+		return PLY_TYPE_FLOAT32;
+	}
+	if(strcmp(name, "double") == 0 || strcmp(name, "float64") == 0)
+	{
+		return PLY_TYPE_FLOAT64;
+	}
+	return PLY_TYPE_INVALID;
+}
+
+static size_t typeSize(PlyType type)
+{
+	switch(type)
+	{
+	case PLY_TYPE_INT8:
+	case PLY_TYPE_UINT8:
+		return 1;
+	case PLY_TYPE_INT16:
+	case PLY_TYPE_UINT16:
+		return 2;
+	case PLY_TYPE_INT32:
+	case PLY_TYPE_UINT32:
+	case PLY_TYPE_FLOAT32:
+		return 4;
+	case PLY_TYPE_FLOAT64:
+		return 8;
+	default:
+		return 0;
+	}
+}
+
+// the file is little-endian, so are all the platforms mio is built for; the
+// values may be unaligned and are read with memcpy
+static double readDouble(const unsigned char* p, PlyType type)
+{
+	switch(type)
+	{
+	case PLY_TYPE_INT8: { int8_t v; memcpy(&v, p, sizeof(v)); return v; }
+	case PLY_TYPE_UINT8: { uint8_t v; memcpy(&v, p, sizeof(v)); return v; }
+	case PLY_TYPE_INT16: { int16_t v; memcpy(&v, p, sizeof(v)); return v; }
+	case PLY_TYPE_UINT16: { uint16_t v; memcpy(&v, p, sizeof(v)); return v; }
+	case PLY_TYPE_INT32: { int32_t v; memcpy(&v, p, sizeof(v)); return v; }
+	case PLY_TYPE_UINT32: { uint32_t v; memcpy(&v, p, sizeof(v)); return v; }
+	case PLY_TYPE_FLOAT32: { float v; memcpy(&v, p, sizeof(v)); return v; }
+	case PLY_TYPE_FLOAT64: { double v; memcpy(&v, p, sizeof(v)); return v; }
+	default: return 0.0;
+	}
+}
+
+// integer value of a list count or index, negative values become -1
+static int64_t readInteger(const unsigned char* p, PlyType type)
+{
+	switch(type)
+	{
+	case PLY_TYPE_INT8: { int8_t v; memcpy(&v, p, sizeof(v)); return v < 0 ? -1 : v; }
+	case PLY_TYPE_UINT8: { uint8_t v; memcpy(&v, p, sizeof(v)); return v; }
+	case PLY_TYPE_INT16: { int16_t v; memcpy(&v, p, sizeof(v)); return v < 0 ? -1 : v; }
+	case PLY_TYPE_UINT16: { uint16_t v; memcpy(&v, p, sizeof(v)); return v; }
+	case PLY_TYPE_INT32: { int32_t v; memcpy(&v, p, sizeof(v)); return v < 0 ? -1 : v; }
+	case PLY_TYPE_UINT32: { uint32_t v; memcpy(&v, p, sizeof(v)); return v; }
+	default: return -1;
+	}
+}
+
+static int isIntegerType(PlyType type)
+{
+	return type != PLY_TYPE_INVALID && type != PLY_TYPE_FLOAT32 && type != PLY_TYPE_FLOAT64;
+}
+
+// reads one header line into "line" and advances "pPos"; returns 0 at the end
+// of the data or if the line is too long
+static int readHeaderLine(const char* pData, size_t size, size_t* pPos, char* line, size_t lineCapacity)
+{
+	size_t length = 0;
+	while(*pPos < size && pData[*pPos] != '\n')
+	{
+		if(length + 1 >= lineCapacity)
+		{
+			return 0;
+		}
+		line[length++] = pData[(*pPos)++];
+	}
+	if(*pPos >= size)
+	{
+		return 0;
+	}
+	(*pPos)++; // '\n'
+	if(length > 0 && line[length - 1] == '\r')
+	{
+		length--;
+	}
+	line[length] = '\0';
+	return 1;
+}
+
+static int parseHeader(const char* pData, size_t size, PlyElement* elements, int* pNumElements, size_t* pDataOffset, const char* fpath)
+{
+	char line[256];
+	size_t pos = 0;
+	int haveFormat = 0;
+
+	*pNumElements = 0;
+	if(!readHeaderLine(pData, size, &pos, line, sizeof(line)) || strcmp(line, "ply") != 0)
+	{
+		fprintf(stderr, "error: `%s` is not a .ply file\n", fpath);
+		return 1;
+	}
+
+	while(readHeaderLine(pData, size, &pos, line, sizeof(line)))
+	{
+		char keyword[PLY_MAX_NAME] = {0};
+		char a[PLY_MAX_NAME] = {0};
+		char b[PLY_MAX_NAME] = {0};
+		char c[PLY_MAX_NAME] = {0};
+		char d[PLY_MAX_NAME] = {0};
+		const int numTokens = sscanf(line, "%63s %63s %63s %63s %63s", keyword, a, b, c, d);
+
+		if(numTokens <= 0 || strcmp(keyword, "comment") == 0 || strcmp(keyword, "obj_info") == 0)
+		{
+			continue;
+		}
+
+		if(strcmp(keyword, "end_header") == 0)
+		{
+			if(!haveFormat)
+			{
+				fprintf(stderr, "error: .ply format not found in `%s`\n", fpath);
+				return 1;
+			}
+			*pDataOffset = pos;
+			return 0;
+		}
+
+		if(strcmp(keyword, "format") == 0)
+		{
+			if(numTokens < 2 || strcmp(a, "binary_little_endian") != 0)
+			{
+				fprintf(stderr, "error: unsupported .ply format `%s` in `%s` (only binary_little_endian)\n", a, fpath);
+				return 1;
+			}
+			haveFormat = 1;
+		}
+		else if(strcmp(keyword, "element") == 0)
+		{
+			if(numTokens < 3 || *pNumElements >= PLY_MAX_ELEMENTS)
+			{
+				fprintf(stderr, "error: invalid .ply element `%s` in `%s`\n", line, fpath);
+				return 1;
+			}
+			PlyElement* pElement = &elements[(*pNumElements)++];
+			memset(pElement, 0, sizeof(*pElement));
+			strcpy(pElement->name, a);
+			pElement->count = strtoull(b, NULL, 10);
+		}
+		else if(strcmp(keyword, "property") == 0)
+		{
+			if(*pNumElements == 0 || elements[*pNumElements - 1].numProperties >= PLY_MAX_PROPERTIES)
+			{
+				fprintf(stderr, "error: invalid .ply property `%s` in `%s`\n", line, fpath);
+				return 1;
+			}
+			PlyElement* pElement = &elements[*pNumElements - 1];
+			PlyProperty* pProperty = &pElement->properties[pElement->numProperties++];
+			memset(pProperty, 0, sizeof(*pProperty));
+
+			if(strcmp(a, "list") == 0 && numTokens == 5)
+			{
+				pProperty->isList = 1;
+				pProperty->countType = parseType(b);
+				pProperty->type = parseType(c);
+				strcpy(pProperty->name, d);
+				if(!isIntegerType(pProperty->countType))
+				{
+					pProperty->type = PLY_TYPE_INVALID;
+				}
+			}
+			else if(numTokens == 3)
+			{
+				pProperty->type = parseType(a);
+				strcpy(pProperty->name, b);
+			}
+
+			if(pProperty->type == PLY_TYPE_INVALID)
+			{
+				fprintf(stderr, "error: unsupported .ply property `%s` in `%s`\n", line, fpath);
+				return 1;
+			}
+		}
+	}
+
+	fprintf(stderr, "error: .ply end_header not found in `%s`\n", fpath);
+	return 1;
+}
+
+// size of one record, or 0 if the element contains lists
+static size_t fixedRecordSize(const PlyElement* pElement)
+{
+	size_t size = 0;
+	int i = 0;
+	for(i = 0; i < pElement->numProperties; ++i)
+	{
+		if(pElement->properties[i].isList)
+		{
+			return 0;
+		}
+		size += typeSize(pElement->properties[i].type);
+	}
+	return size;
+}
+
+// walks the records of an element that contains lists; returns 0 if the data
+// ends before the last record
+static int skipRecords(const unsigned char* pData, size_t size, size_t* pPos, const PlyElement* pElement)
+{
+	uint64_t r = 0;
+	int i = 0;
+	for(r = 0; r < pElement->count; ++r)
+	{
+		for(i = 0; i < pElement->numProperties; ++i)
+		{
+			const PlyProperty* pProperty = &pElement->properties[i];
+			size_t bytes = typeSize(pProperty->type);
+			if(pProperty->isList)
+			{
+				const size_t countSize = typeSize(pProperty->countType);
+				if(countSize > size - *pPos)
+				{
+					return 0;
+				}
+				const int64_t count = readInteger(pData + *pPos, pProperty->countType);
+				if(count < 0)
+				{
+					return 0;
+				}
+				*pPos += countSize;
+				bytes *= (size_t)count;
+			}
+			if(bytes > size - *pPos)
+			{
+				return 0;
+			}
+			*pPos += bytes;
+		}
+	}
+	return 1;
+}
+
+int mioReadPLY(const char* fpath,
+			   double** pVertices,
+			   unsigned int** pFaceVertexIndices,
+			   unsigned int** pFaceSizes,
+			   unsigned int* numVertices,
+			   unsigned int* numFaces)
+{
+	*pVertices = NULL;
+	*pFaceVertexIndices = NULL;
+	*pFaceSizes = NULL;
+	*numVertices = 0;
+	*numFaces = 0;
+
+	size_t size = 0;
+	const unsigned char* pData = (const unsigned char*)mioMapFile(fpath, &size, 0);
+
+	if(pData == NULL)
+	{
+		fprintf(stderr, "error: failed to open `%s`\n", fpath);
+		return 1;
+	}
+
+	PlyElement elements[PLY_MAX_ELEMENTS];
+	int numElements = 0;
+	size_t pos = 0;
+	int status = parseHeader((const char*)pData, size, elements, &numElements, &pos, fpath);
+
+	const PlyElement* pVertexElement = NULL;
+	size_t vertexStart = 0;
+	size_t vertexStride = 0;
+	size_t coordOffsets[3] = {0, 0, 0};
+	PlyType coordTypes[3] = {PLY_TYPE_INVALID, PLY_TYPE_INVALID, PLY_TYPE_INVALID};
+
+	const PlyElement* pFaceElement = NULL;
+	size_t faceStart = 0;
+	// a face record is [fixed properties][count][indices][fixed properties]
+	size_t faceBytesBefore = 0;
+	size_t faceBytesAfter = 0;
+	PlyType countType = PLY_TYPE_INVALID;
+	PlyType indexType = PLY_TYPE_INVALID;
+	uint64_t numIndices = 0;
+	uint64_t* indexOffsets = NULL;
+
+	int e = 0;
+	int i = 0;
+	for(e = 0; e < numElements && status == 0; ++e)
+	{
+		const PlyElement* pElement = &elements[e];
+		const size_t recordSize = fixedRecordSize(pElement);
+
+		if(strcmp(pElement->name, "vertex") == 0 && pVertexElement == NULL)
+		{
+			if(recordSize == 0)
+			{
+				fprintf(stderr, "error: .ply vertex element with lists in `%s`\n", fpath);
+				status = 1;
+				break;
+			}
+
+			size_t offset = 0;
+			for(i = 0; i < pElement->numProperties; ++i)
+			{
+				const PlyProperty* pProperty = &pElement->properties[i];
+				const char* name = pProperty->name;
+				if(name[0] >= 'x' && name[0] <= 'z' && name[1] == '\0')
+				{
+					coordOffsets[name[0] - 'x'] = offset;
+					coordTypes[name[0] - 'x'] = pProperty->type;
+				}
+				offset += typeSize(pProperty->type);
+			}
+
+			if(coordTypes[0] == PLY_TYPE_INVALID || coordTypes[1] == PLY_TYPE_INVALID || coordTypes[2] == PLY_TYPE_INVALID)
+			{
+				fprintf(stderr, "error: .ply vertex x/y/z not found in `%s`\n", fpath);
+				status = 1;
+				break;
+			}
+
+			pVertexElement = pElement;
+			vertexStart = pos;
+			vertexStride = recordSize;
+		}
+		else if(strcmp(pElement->name, "face") == 0 && pFaceElement == NULL)
+		{
+			int listIndex = -1;
+			for(i = 0; i < pElement->numProperties; ++i)
+			{
+				const PlyProperty* pProperty = &pElement->properties[i];
+				if(pProperty->isList && (strcmp(pProperty->name, "vertex_indices") == 0 || strcmp(pProperty->name, "vertex_index") == 0))
+				{
+					listIndex = i;
+				}
+				else if(pProperty->isList)
+				{
+					listIndex = -2;
+					break;
+				}
+			}
+
+			if(listIndex < 0 || !isIntegerType(pElement->properties[listIndex].type))
+			{
+				fprintf(stderr, "error: unsupported .ply face element in `%s`\n", fpath);
+				status = 1;
+				break;
+			}
+
+			for(i = 0; i < pElement->numProperties; ++i)
+			{
+				if(i < listIndex)
+				{
+					faceBytesBefore += typeSize(pElement->properties[i].type);
+				}
+				else if(i > listIndex)
+				{
+					faceBytesAfter += typeSize(pElement->properties[i].type);
+				}
+			}
+			countType = pElement->properties[listIndex].countType;
+			indexType = pElement->properties[listIndex].type;
+
+			if(pElement->count > UINT32_MAX)
+			{
+				fprintf(stderr, "error: too many .ply faces in `%s`\n", fpath);
+				status = 1;
+				break;
+			}
+
+			// the face sizes locate the records, so this pass is sequential
+			*pFaceSizes = (unsigned int*)malloc(sizeof(unsigned int) * (pElement->count + 1));
+			indexOffsets = (uint64_t*)malloc(sizeof(uint64_t) * (pElement->count + 1));
+			if(*pFaceSizes == NULL || indexOffsets == NULL)
+			{
+				fprintf(stderr, "error: out of memory reading `%s`\n", fpath);
+				status = 1;
+				break;
+			}
+
+			const size_t countSize = typeSize(countType);
+			const size_t indexSize = typeSize(indexType);
+			const size_t fixedBytes = faceBytesBefore + countSize + faceBytesAfter;
+			faceStart = pos;
+			uint64_t f = 0;
+			for(f = 0; f < pElement->count; ++f)
+			{
+				if(fixedBytes > size - pos)
+				{
+					break;
+				}
+				const int64_t count = readInteger(pData + pos + faceBytesBefore, countType);
+				if(count < 0 || (uint64_t)count * indexSize > size - pos - fixedBytes)
+				{
+					break;
+				}
+				(*pFaceSizes)[f] = (unsigned int)count;
+				indexOffsets[f] = numIndices;
+				numIndices += (uint64_t)count;
+				pos += fixedBytes + (size_t)count * indexSize;
+			}
+			indexOffsets[pElement->count] = numIndices;
+
+			if(f < pElement->count || numIndices > UINT32_MAX)
+			{
+				fprintf(stderr, "error: invalid .ply face data in `%s`\n", fpath);
+				status = 1;
+				break;
+			}
+			pFaceElement = pElement;
+			continue;
+		}
+
+		if(recordSize > 0)
+		{
+			if(pElement->count > (size - pos) / recordSize)
+			{
+				fprintf(stderr, "error: .ply element `%s` truncated in `%s`\n", pElement->name, fpath);
+				status = 1;
+				break;
+			}
+			pos += pElement->count * recordSize;
+		}
+		else if(!skipRecords(pData, size, &pos, pElement))
+		{
+			fprintf(stderr, "error: .ply element `%s` truncated in `%s`\n", pElement->name, fpath);
+			status = 1;
+			break;
+		}
+	}
+
+	if(status == 0 && (pVertexElement == NULL || pVertexElement->count > UINT32_MAX))
+	{
+		fprintf(stderr, "error: .ply vertex element not found in `%s`\n", fpath);
+		status = 1;
+	}
+
+	if(status == 0)
+	{
+		const int64_t count = (int64_t)pVertexElement->count;
+		*pVertices = (double*)malloc(sizeof(double) * 3 * (count > 0 ? count : 1));
+		*numVertices = (unsigned int)count;
+
+		if(*pVertices == NULL)
+		{
+			fprintf(stderr, "error: out of memory reading `%s`\n", fpath);
+			status = 1;
+		}
+		else
+		{
+			const unsigned char* pBase = pData + vertexStart;
+			int64_t v = 0;
+#pragma omp parallel for
+			for(v = 0; v < count; ++v)
+			{
+				const unsigned char* pRecord = pBase + (size_t)v * vertexStride;
+				(*pVertices)[3 * v + 0] = readDouble(pRecord + coordOffsets[0], coordTypes[0]);
+				(*pVertices)[3 * v + 1] = readDouble(pRecord + coordOffsets[1], coordTypes[1]);
+				(*pVertices)[3 * v + 2] = readDouble(pRecord + coordOffsets[2], coordTypes[2]);
+			}
+		}
+	}
+
+	if(status == 0 && pFaceElement != NULL)
+	{
+		const int64_t count = (int64_t)pFaceElement->count;
+		const size_t countSize = typeSize(countType);
+		const size_t indexSize = typeSize(indexType);
+		const size_t fixedBytes = faceBytesBefore + countSize + faceBytesAfter;
+		const int64_t maxIndex = (int64_t)*numVertices;
+		int invalid = 0;
+
+		*pFaceVertexIndices = (unsigned int*)malloc(sizeof(unsigned int) * (numIndices > 0 ? numIndices : 1));
+		*numFaces = (unsigned int)count;
+
+		if(*pFaceVertexIndices == NULL)
+		{
+			fprintf(stderr, "error: out of memory reading `%s`\n", fpath);
+			status = 1;
+		}
+		else
+		{
+			int64_t f = 0;
+			// the record of face f starts after f fixed parts and the indices of the previous faces
+#pragma omp parallel for reduction(| : invalid)
+			for(f = 0; f < count; ++f)
+			{
+				const unsigned char* pIndices = pData + faceStart + (size_t)f * fixedBytes + indexOffsets[f] * indexSize + faceBytesBefore + countSize;
+				const unsigned int faceSize = (*pFaceSizes)[f];
+				unsigned int k = 0;
+				for(k = 0; k < faceSize; ++k)
+				{
+					const int64_t index = readInteger(pIndices + k * indexSize, indexType);
+					invalid |= index < 0 || index >= maxIndex;
+					(*pFaceVertexIndices)[indexOffsets[f] + k] = (unsigned int)index;
+				}
+			}
+
+			if(invalid)
+			{
+				fprintf(stderr, "error: .ply vertex index out of range in `%s`\n", fpath);
+				status = 1;
+			}
+		}
+	}
+
+	free(indexOffsets);
+	mioUnmapFile((void*)pData, size);
+
+	if(status != 0)
+	{
+		free(*pVertices);
+		free(*pFaceVertexIndices);
+		free(*pFaceSizes);
+		*pVertices = NULL;
+		*pFaceVertexIndices = NULL;
+		*pFaceSizes = NULL;
+		*numVertices = 0;
+		*numFaces = 0;
+	}
+	return status;
+}
@@ -0,0 +1,92 @@
+import time
+from contextlib import contextmanager
+
+
+@contextmanager
+def timeStage(stats, stage_name: str):
+    # record a python-side stage into a cut_cpp.CutStats
+    wall_start = time.perf_counter()
+    cpu_start = time.process_time()
+    try:
+        yield
+    finally:
+        stats.add_stage(
+            stage_name,
+            time.perf_counter() - wall_start,
+            time.process_time() - cpu_start,
+        )
+
+
+def aggregateCutStats(stats_list: list) -> dict:
+    # merge the CutStats.to_dict() results of several meshes, counts ending
+    # with _max / _min keep the extreme value, the others are summed
+    stages = {}
+    counts = {}
+    peak_rss_bytes = 0
+    for stats in stats_list:
+        if stats is None:
+            continue
+
+        for name, stage in stats["stages"].items():
+            if name not in stages:
+                stages[name] = {
+                    "wall_seconds": 0.0,
+                    "cpu_seconds": 0.0,
+                    "calls": 0,
+                    "threads": 0,
+                    "peak_rss_bytes": 0,
+                }
+            merged = stages[name]
+            merged["wall_seconds"] += stage["wall_seconds"]
+            merged["cpu_seconds"] += stage["cpu_seconds"]
+            merged["calls"] += stage["calls"]
+            merged["threads"] = max(merged["threads"], stage["threads"])
+            merged["peak_rss_bytes"] = max(
+                merged["peak_rss_bytes"], stage["peak_rss_bytes"]
+            )
+
+        for name, value in stats["counts"].items():
+            if name not in counts:
+                counts[name] = value
+            elif name.endswith("_max"):
+                counts[name] = max(counts[name], value)
+            elif name.endswith("_min"):
+                counts[name] = min(counts[name], value)
+            else:
+                counts[name] += value
+
+        peak_rss_bytes = max(peak_rss_bytes, stats["peak_rss_bytes"])
+
+    for stage in stages.values():
+        capacity = stage["wall_seconds"] * stage["threads"]
+        stage["utilization"] = stage["cpu_seconds"] / capacity if capacity > 0 else 0.0
+
+    return {
+        "stages": stages,
+        "counts": counts,
+        "peak_rss_bytes": peak_rss_bytes,
+    }
+
+
+def printCutStats(stats: dict, top_stage_num: int = 10) -> bool:
+    if stats is None:
+        print("[WARN][stats::printCutStats]")
+        print("\t stats not found!")
+        return False
+
+    stages = sorted(
+        stats["stages"].items(), key=lambda item: item[1]["wall_seconds"], reverse=True
+    )
+
+    print("[INFO][stats::printCutStats]")
+    print("\t peak rss:", f"{stats['peak_rss_bytes'] / 2**20:.1f} MiB")
+    for name, stage in stages[:top_stage_num]:
+        print(
+            f"\t {name}: {stage['wall_seconds']:.3f}s wall,",
+            f"{stage['cpu_seconds']:.3f}s cpu,",
+            f"{100.0 * stage['utilization']:.0f}% of {stage['threads']} threads,",
+            f"{stage['calls']} calls",
+        )
+    for name, value in sorted(stats["counts"].items()):
+        print(f"\t {name}: {value}")
+    return True
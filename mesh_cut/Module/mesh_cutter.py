@@ -5,8 +5,16 @@ import open3d as o3d
 from typing import Union
 
 from cut_cpp import (
-    farthest_point_sampling,
-    run_parallel_region_growing,
+    CutStats,
+    RegionMembershipIndex,
+    decimate_to_proxy,
+    extract_submeshes,
+    farthest_surface_point_sampling,
+    loadMeshCached,
+    project_proxy_face_groups,
+    run_cvt_region_growing,
+    run_multi_level_region_growing,
+    run_parallel_region_growing_from_surface_seeds,
     toSubMeshSamplePoints,
 )
 
@@ -14,10 +22,15 @@ from diff_curvature.Module.mesh_curvature import MeshCurvature
 
 from mesh_cut.Method.curvature import toVisiableVertexCurvature
 from mesh_cut.Method.render import renderFaceLabels, renderSubMeshSamplePoints
+from mesh_cut.Method.stats import timeStage
 
 
 class MeshCutter(object):
-    def __init__(self, mesh_file_path: Union[str, None] = None):
+    def __init__(
+        self,
+        mesh_file_path: Union[str, None] = None,
+        cache_dir: Union[str, None] = None,
+    ):
         self.mesh_curvature = MeshCurvature()
 
         self.vertices = None
@@ -29,11 +42,27 @@ class MeshCutter(object):
         self.face_curvatures = None
 
         # cut mesh results
-        self.fps_vertex_idxs = None
+        self.proxy_mesh = None
+        self.multi_level_face_labels = None
+        self.multi_level_sample_points = None
+        self.fps_seed_faces = None
+        self.fps_seed_barycentrics = None
+        self.face_labels = None
+        self.region_index = None
         self.sub_mesh_sample_points = None
 
+        # per-stage times and counts of the last cut, see CutStats.to_dict
+        self.cut_stats = None
+
+        # compacted sub meshes, ragged with offsets
+        self.sub_mesh_vertices = None
+        self.sub_mesh_faces = None
+        self.sub_mesh_vertex_offsets = None
+        self.sub_mesh_face_offsets = None
+        self.sub_mesh_vertex_map = None
+
         if mesh_file_path is not None:
-            self.loadMesh(mesh_file_path)
+            self.loadMesh(mesh_file_path, cache_dir)
         return
 
     def isValid(self) -> bool:
@@ -52,13 +81,27 @@ class MeshCutter(object):
 
         return True
 
-    def loadMesh(self, mesh_file_path: str) -> bool:
+    def loadMesh(
+        self, mesh_file_path: str, cache_dir: Union[str, None] = None
+    ) -> bool:
         if not os.path.exists(mesh_file_path):
             print("[ERROR][MeshCutter::loadMesh]")
             print("\t mesh file not exist!")
             print("\t mesh_file_path: ", mesh_file_path)
             return False
 
+        # the first load converts the mesh into a binary cache, later loads
+        # memory-map it and the arrays below are views into the mapping
+        if cache_dir is not None and mesh_file_path.lower().endswith(
+            (".obj", ".off", ".ply", ".glb")
+        ):
+            mapped_mesh = loadMeshCached(mesh_file_path, cache_dir, False)
+
+            self.vertices = mapped_mesh.vertices
+            self.triangles = mapped_mesh.triangles
+            self.vertex_normals = mapped_mesh.normals
+            return True
+
         mesh = o3d.io.read_triangle_mesh(mesh_file_path)
 
         self.vertices = np.asarray(mesh.vertices, dtype=np.float64)
@@ -98,37 +141,209 @@ class MeshCutter(object):
         self.face_curvatures = self.mesh_curvature.toMeanF()
         return True
 
+    def toSegmentMesh(self, proxy_face_num: int = -1) -> tuple:
+        # segment on a QEM-decimated proxy mesh and project the labels back, so
+        # the segmentation cost does not grow with the input resolution
+        self.proxy_mesh = None
+        if 0 < proxy_face_num < self.triangles.shape[0]:
+            self.proxy_mesh = decimate_to_proxy(
+                self.vertices, self.triangles, proxy_face_num
+            )
+            return (
+                np.asarray(self.proxy_mesh.vertices, dtype=np.float64),
+                np.asarray(self.proxy_mesh.faces, dtype=np.int32),
+            )
+
+        return self.vertices, self.triangles
+
     def cutMesh(
-        self, sub_mesh_num: int = 400, points_per_submesh: int = 8192
+        self,
+        sub_mesh_num: int = 400,
+        points_per_submesh: int = 8192,
+        fps_candidate_num: int = -1,
+        proxy_face_num: int = -1,
+        cvt_iterations: int = 0,
+        cvt_balance_tolerance: float = 1e-3,
     ) -> Union[list, bool]:
-        self.subdivMesh(10 * sub_mesh_num)
+        self.cut_stats = None
+
+        # every cut_cpp call below records its stages into stats
+        stats = CutStats()
+        with stats:
+            with timeStage(stats, "estimateCurvatures"):
+                self.estimateCurvatures()
+
+            if not self.isValid():
+                print("[ERROR][MeshCutter::cutMesh]")
+                print("\t mesh is not valid!")
+                return False
+
+            # seeds are farthest points among area-weighted surface samples, so the
+            # mesh does not need to be subdivided to have enough vertices to choose from
+            if fps_candidate_num <= 0:
+                fps_candidate_num = 32 * sub_mesh_num
+
+            segment_vertices, segment_triangles = self.toSegmentMesh(proxy_face_num)
+
+            self.fps_seed_faces, self.fps_seed_barycentrics = (
+                farthest_surface_point_sampling(
+                    torch.from_numpy(segment_vertices).to(torch.float32),
+                    torch.from_numpy(segment_triangles).to(torch.int),
+                    sub_mesh_num,
+                    fps_candidate_num,
+                )
+            )
+
+            if cvt_iterations > 0:
+                # balance the regions with native Lloyd iterations
+                self.face_labels = run_cvt_region_growing(
+                    segment_vertices,
+                    segment_triangles,
+                    self.fps_seed_faces.numpy(),
+                    self.fps_seed_barycentrics.numpy(),
+                    cvt_iterations,
+                    cvt_balance_tolerance,
+                )
+            else:
+                self.face_labels = run_parallel_region_growing_from_surface_seeds(
+                    segment_vertices,
+                    segment_triangles,
+                    self.fps_seed_faces.numpy(),
+                    self.fps_seed_barycentrics.numpy(),
+                )
+
+            if self.proxy_mesh is not None:
+                self.face_labels = project_proxy_face_groups(
+                    self.proxy_mesh, self.face_labels
+                )
+
+            self.sub_mesh_sample_points = toSubMeshSamplePoints(
+                torch.from_numpy(self.vertices).to(torch.float32),
+                torch.from_numpy(self.triangles).to(torch.int),
+                self.face_labels,
+                points_per_submesh,
+            )
+
+        self.cut_stats = stats.to_dict()
+        return True
 
-        self.estimateCurvatures()
+    def cutMeshMultiLevel(
+        self,
+        sub_mesh_nums: tuple = (100, 400, 1600),
+        points_per_submesh: int = 8192,
+        fps_candidate_num: int = -1,
+        proxy_face_num: int = -1,
+    ) -> bool:
+        self.cut_stats = None
+
+        # every cut_cpp call below records its stages into stats
+        stats = CutStats()
+        with stats:
+            with timeStage(stats, "estimateCurvatures"):
+                self.estimateCurvatures()
+
+            if not self.isValid():
+                print("[ERROR][MeshCutter::cutMeshMultiLevel]")
+                print("\t mesh is not valid!")
+                return False
+
+            # the FPS order is nested, so one run to the finest level gives the
+            # seeds of every coarser level as a prefix
+            max_sub_mesh_num = max(sub_mesh_nums)
+            if fps_candidate_num <= 0:
+                fps_candidate_num = 32 * max_sub_mesh_num
+
+            segment_vertices, segment_triangles = self.toSegmentMesh(proxy_face_num)
+
+            self.fps_seed_faces, self.fps_seed_barycentrics = (
+                farthest_surface_point_sampling(
+                    torch.from_numpy(segment_vertices).to(torch.float32),
+                    torch.from_numpy(segment_triangles).to(torch.int),
+                    max_sub_mesh_num,
+                    fps_candidate_num,
+                )
+            )
+
+            segmentation = run_multi_level_region_growing(
+                segment_vertices,
+                segment_triangles,
+                self.fps_seed_faces.numpy(),
+                self.fps_seed_barycentrics.numpy(),
+                sub_mesh_nums,
+            )
+
+            level_offsets = np.asarray(segmentation.level_offsets, dtype=np.int64)
+            region_offsets = np.asarray(segmentation.region_offsets, dtype=np.int64)
+            face_indices = np.asarray(segmentation.face_indices, dtype=np.int64)
+
+            vertices = torch.from_numpy(self.vertices).to(torch.float32)
+            triangles = torch.from_numpy(self.triangles).to(torch.int)
+
+            self.multi_level_face_labels = []
+            self.multi_level_sample_points = []
+            for i in range(len(sub_mesh_nums)):
+                face_labels = [
+                    face_indices[region_offsets[r] : region_offsets[r + 1]]
+                    for r in range(level_offsets[i], level_offsets[i + 1])
+                ]
+
+                if self.proxy_mesh is not None:
+                    face_labels = project_proxy_face_groups(self.proxy_mesh, face_labels)
+
+                self.multi_level_face_labels.append(face_labels)
+                self.multi_level_sample_points.append(
+                    toSubMeshSamplePoints(
+                        vertices, triangles, face_labels, points_per_submesh
+                    )
+                )
+
+        self.cut_stats = stats.to_dict()
+        return True
 
-        if not self.isValid():
-            print("[ERROR][MeshCutter::cutMesh]")
-            print("\t mesh is not valid!")
+    def extractSubMeshes(self) -> bool:
+        if self.face_labels is None:
+            print("[ERROR][MeshCutter::extractSubMeshes]")
+            print("\t face labels not found! please run cutMesh first!")
             return False
 
-        self.fps_vertex_idxs = farthest_point_sampling(
-            torch.from_numpy(self.vertices).to(torch.float32), sub_mesh_num
-        )
-
-        self.face_labels = run_parallel_region_growing(
-            self.vertices,
-            self.triangles,
-            self.fps_vertex_idxs.numpy(),
-            sub_mesh_num,
-        )
-
-        self.sub_mesh_sample_points = toSubMeshSamplePoints(
+        (
+            self.sub_mesh_vertices,
+            self.sub_mesh_faces,
+            self.sub_mesh_vertex_offsets,
+            self.sub_mesh_face_offsets,
+            self.sub_mesh_vertex_map,
+        ) = extract_submeshes(
             torch.from_numpy(self.vertices).to(torch.float32),
             torch.from_numpy(self.triangles).to(torch.int),
             self.face_labels,
-            points_per_submesh,
         )
         return True
 
+    def buildRegionIndex(self) -> bool:
+        if self.face_labels is None:
+            print("[ERROR][MeshCutter::buildRegionIndex]")
+            print("\t face labels not found! please run cutMesh first!")
+            return False
+
+        # compressed bitmaps per region plus the face -> regions map, for
+        # compact storage and fast overlap queries between regions
+        self.region_index = RegionMembershipIndex(
+            self.face_labels, self.triangles.shape[0]
+        )
+        return True
+
+    def getSubMesh(self, sub_mesh_idx: int) -> tuple:
+        vertex_start, vertex_end = self.sub_mesh_vertex_offsets[
+            sub_mesh_idx : sub_mesh_idx + 2
+        ].tolist()
+        face_start, face_end = self.sub_mesh_face_offsets[
+            sub_mesh_idx : sub_mesh_idx + 2
+        ].tolist()
+        return (
+            self.sub_mesh_vertices[vertex_start:vertex_end],
+            self.sub_mesh_faces[face_start:face_end],
+        )
+
     def visualizeCurvature(self) -> bool:
         if not self.isValid():
             self.estimateCurvatures()
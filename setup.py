@@ -35,6 +35,8 @@ if SYSTEM == "Darwin":
     cut_extra_compile_args.append("-std=c++17")
 elif SYSTEM == "Linux":
     cut_extra_compile_args.append("-std=c++17")
+    cut_extra_compile_args.append("-fopenmp")
+    link_args.append("-fopenmp")
 
 if torch.cuda.is_available():
     cc = torch.cuda.get_device_capability()
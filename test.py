@@ -68,13 +68,20 @@ if __name__ == "__main__":
         mesh_file_path, anchor_num, cover_point_num
     )
 
-    sphere = o3d.geometry.TriangleMesh.create_sphere(radius, 20)
-    sphere.translate(region_centers[0])
+    vertices = np.asarray(mesh.vertices, dtype=np.float64)
+    triangles = np.asarray(mesh.triangles, dtype=np.int64)
 
-    test_sphere_file_path = "./output/test_sphere.obj"
-    createFileFolder(test_sphere_file_path)
-    o3d.io.write_triangle_mesh(test_sphere_file_path, sphere, write_ascii=True)
+    sphere_patches = cut_cpp.cut_mesh_by_spheres(
+        vertices, triangles, region_centers, radius, radius * 1e-3
+    )
+
+    patch = sphere_patches[0]
+    patch_mesh = o3d.geometry.TriangleMesh()
+    patch_mesh.vertices = o3d.utility.Vector3dVector(np.asarray(patch.vertices))
+    patch_mesh.triangles = o3d.utility.Vector3iVector(np.asarray(patch.faces))
 
-    cut_cpp.cutMesh(valid_mesh_file_path, test_sphere_file_path)
+    test_patch_file_path = "./output/test_sphere_patch.obj"
+    createFileFolder(test_patch_file_path)
+    o3d.io.write_triangle_mesh(test_patch_file_path, patch_mesh, write_ascii=True)
 
     print("finish!")
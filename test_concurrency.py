@@ -0,0 +1,117 @@
+import os
+import shutil
+import torch
+import numpy as np
+import open3d as o3d
+from typing import Tuple
+from concurrent.futures import ThreadPoolExecutor
+
+import cut_cpp
+
+from mesh_cut.Method.path import createFileFolder
+
+
+def createStressInputs(save_folder_path: str, job_num: int) -> Tuple[list, str]:
+    # 每个任务一份内容相同的源网格副本，使 cutMesh 的输出文件互不覆盖
+    source_mesh = o3d.geometry.TriangleMesh.create_sphere(1.0, 40)
+    source_mesh_file_path = save_folder_path + "source.obj"
+    createFileFolder(source_mesh_file_path)
+    o3d.io.write_triangle_mesh(source_mesh_file_path, source_mesh, write_ascii=True)
+
+    mesh_file_path_list = []
+    for i in range(job_num):
+        mesh_file_path = save_folder_path + "source_" + str(i) + ".obj"
+        shutil.copyfile(source_mesh_file_path, mesh_file_path)
+        mesh_file_path_list.append(mesh_file_path)
+
+    # 略微倾斜的切割平面，所有任务共用
+    cut_mesh = o3d.geometry.TriangleMesh()
+    cut_mesh.vertices = o3d.utility.Vector3dVector(
+        np.array(
+            [
+                [-2.0, -2.0, 0.1],
+                [2.0, -2.0, 0.2],
+                [2.0, 2.0, 0.15],
+                [-2.0, 2.0, 0.05],
+            ]
+        )
+    )
+    cut_mesh.triangles = o3d.utility.Vector3iVector(np.array([[0, 1, 2], [0, 2, 3]]))
+    cut_mesh_file_path = save_folder_path + "cut_plane.obj"
+    o3d.io.write_triangle_mesh(cut_mesh_file_path, cut_mesh, write_ascii=True)
+    return mesh_file_path_list, cut_mesh_file_path
+
+
+def runCutMesh(mesh_file_path: str, cut_mesh_file_path: str) -> str:
+    cut_cpp.cutMesh(mesh_file_path, cut_mesh_file_path)
+
+    mesh_name = os.path.splitext(os.path.basename(mesh_file_path))[0]
+    cut_name = os.path.splitext(os.path.basename(cut_mesh_file_path))[0]
+    with open("./output/" + mesh_name + "_" + cut_name + ".obj", "r") as f:
+        return f.read()
+
+
+def runExtractSubmeshes(
+    vertices: torch.Tensor, triangles: torch.Tensor, regions: list
+) -> list:
+    return [t.clone() for t in cut_cpp.extract_submeshes(vertices, triangles, regions)]
+
+
+def checkConcurrency(
+    job_num: int = 16, thread_num: int = 8, round_num: int = 4
+) -> bool:
+    os.makedirs("./output/", exist_ok=True)
+    mesh_file_path_list, cut_mesh_file_path = createStressInputs(
+        "./output/stress/", job_num
+    )
+
+    mesh = o3d.io.read_triangle_mesh(mesh_file_path_list[0])
+    vertices = torch.from_numpy(np.asarray(mesh.vertices, dtype=np.float32))
+    triangles = torch.from_numpy(np.asarray(mesh.triangles, dtype=np.int32))
+
+    rng = np.random.default_rng(0)
+    regions_list = []
+    for _ in range(job_num):
+        labels = rng.integers(0, 32, triangles.shape[0])
+        regions_list.append(
+            [np.nonzero(labels == r)[0].tolist() for r in range(32)]
+        )
+
+    # 串行结果作为参考
+    serial_cut_results = [
+        runCutMesh(mesh_file_path, cut_mesh_file_path)
+        for mesh_file_path in mesh_file_path_list
+    ]
+    serial_submesh_results = [
+        runExtractSubmeshes(vertices, triangles, regions) for regions in regions_list
+    ]
+
+    # 多个线程同时在共享的输入上切割与提取子网格
+    with ThreadPoolExecutor(max_workers=thread_num) as executor:
+        for _ in range(round_num):
+            cut_futures = [
+                executor.submit(runCutMesh, mesh_file_path, cut_mesh_file_path)
+                for mesh_file_path in mesh_file_path_list
+            ]
+            submesh_futures = [
+                executor.submit(runExtractSubmeshes, vertices, triangles, regions)
+                for regions in regions_list
+            ]
+
+            for i, future in enumerate(cut_futures):
+                assert future.result() == serial_cut_results[i], i
+
+            for i, future in enumerate(submesh_futures):
+                for result, expected in zip(
+                    future.result(), serial_submesh_results[i]
+                ):
+                    assert torch.equal(result, expected), i
+
+    return True
+
+
+# 示例用法
+if __name__ == "__main__":
+    checkConcurrency()
+
+    print("finish!")
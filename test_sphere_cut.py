@@ -0,0 +1,72 @@
+import numpy as np
+
+import cut_cpp
+
+
+def createGridMesh(grid_size: int) -> tuple:
+    # z = 0 平面上 [-1, 1]^2 的规则三角网格
+    xs = np.linspace(-1.0, 1.0, grid_size + 1)
+    xx, yy = np.meshgrid(xs, xs)
+    vertices = np.stack([xx.ravel(), yy.ravel(), np.zeros(xx.size)], axis=1)
+
+    faces = []
+    for j in range(grid_size):
+        for i in range(grid_size):
+            a = j * (grid_size + 1) + i
+            b = a + 1
+            c = a + grid_size + 1
+            d = c + 1
+            faces.append([a, b, d])
+            faces.append([a, d, c])
+    return vertices, np.asarray(faces, dtype=np.int64)
+
+
+def toFaceAreas(vertices: np.ndarray, faces: np.ndarray) -> np.ndarray:
+    if faces.shape[0] == 0:
+        return np.zeros(0)
+    e1 = vertices[faces[:, 1]] - vertices[faces[:, 0]]
+    e2 = vertices[faces[:, 2]] - vertices[faces[:, 0]]
+    return 0.5 * np.linalg.norm(np.cross(e1, e2), axis=1)
+
+
+def checkSpherePatch(
+    vertices: np.ndarray, faces: np.ndarray, center: list, radius: float
+) -> bool:
+    patch = cut_cpp.cut_mesh_by_spheres(
+        vertices, faces, [center], radius, radius * 1e-4
+    )[0]
+
+    patch_vertices = np.asarray(patch.vertices)
+    patch_faces = np.asarray(patch.faces, dtype=np.int64).reshape(-1, 3)
+    patch_areas = toFaceAreas(patch_vertices, patch_faces)
+
+    # 平面网格被球裁剪后应为半径为 radius 的圆盘
+    area = np.sum(patch_areas)
+    expected_area = np.pi * radius * radius
+    assert abs(area - expected_area) < 1e-3 * expected_area, (area, expected_area)
+
+    # 每个源面片裁剪得到的面积不能超过其自身面积
+    source_areas = toFaceAreas(vertices, faces)
+    clipped_areas = np.bincount(
+        np.asarray(patch.face_map, dtype=np.int64),
+        weights=patch_areas,
+        minlength=faces.shape[0],
+    )
+    assert np.all(clipped_areas <= source_areas * (1.0 + 1e-9))
+    return True
+
+
+# 示例用法
+if __name__ == "__main__":
+    vertices, faces = createGridMesh(60)
+
+    # 网格顶点 (0.3, 0.3) 恰好位于球面上，其出入交点重合
+    checkSpherePatch(vertices, faces, [0.3, -0.2, 0.0], 0.5)
+
+    # 顶点到球面的距离在舍入误差量级
+    checkSpherePatch(vertices, faces, [0.3, -0.2, 1e-13], 0.5)
+
+    # 球面不经过任何顶点
+    checkSpherePatch(vertices, faces, [0.013, 0.021, 0.0], 0.37)
+
+    print("finish!")